@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/utils/randomize.h"
+
+namespace kahypar {
+namespace bench {
+// Instances are copied from tests/end_to_end/test_instances into the build directory.
+static const std::array<std::string, 2> kInstances = { {
+  "ISPD98_ibm01.hgr",
+  "bundle1.mtx.hgr"
+} };
+
+static constexpr int kSeed = 42;
+
+// ! Registers one run per benchmark instance. The instance is selected via state.range(0).
+static inline void allInstances(benchmark::internal::Benchmark* benchmark) {
+  for (size_t i = 0; i < kInstances.size(); ++i) {
+    benchmark->Arg(i);
+  }
+}
+
+// ! Registers one run per benchmark instance for each of the given k.
+static inline void allInstancesWithK(benchmark::internal::Benchmark* benchmark,
+                              const std::vector<PartitionID>& ks) {
+  for (size_t i = 0; i < kInstances.size(); ++i) {
+    for (const PartitionID k : ks) {
+      benchmark->Args({ static_cast<int64_t>(i), k });
+    }
+  }
+}
+
+static inline Hypergraph loadInstance(benchmark::State& state, const PartitionID k = 2) {
+  const std::string& instance = kInstances[state.range(0)];
+  state.SetLabel(instance);
+  Randomize::instance().setSeed(kSeed);
+  return io::createHypergraphFromFile("test_instances/" + instance, k);
+}
+
+// ! Loads the instance into an arbitrary GenericHypergraph instantiation
+// ! (e.g. to compare different memory layouts).
+template <typename HypergraphType>
+static inline HypergraphType loadInstanceAs(benchmark::State& state, const PartitionID k = 2) {
+  const std::string& instance = kInstances[state.range(0)];
+  state.SetLabel(instance);
+  Randomize::instance().setSeed(kSeed);
+  HypernodeID num_hypernodes;
+  HyperedgeID num_hyperedges;
+  HyperedgeIndexVector index_vector;
+  HyperedgeVector edge_vector;
+  HypernodeWeightVector hypernode_weights;
+  HyperedgeWeightVector hyperedge_weights;
+  io::readHypergraphFile("test_instances/" + instance, num_hypernodes, num_hyperedges,
+                         index_vector, edge_vector, &hyperedge_weights, &hypernode_weights);
+  return HypergraphType(num_hypernodes, num_hyperedges, index_vector, edge_vector,
+                        k, &hyperedge_weights, &hypernode_weights);
+}
+
+template <typename HypergraphType>
+static inline void partitionRoundRobin(HypergraphType& hypergraph, const PartitionID k) {
+  PartitionID part = 0;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, part);
+    part = (part + 1) % k;
+  }
+  hypergraph.initializeNumCutHyperedges();
+}
+
+// ! Upper bound on the gain of a move, as used to size bucket queues.
+static inline Gain maxGain(const Hypergraph& hypergraph) {
+  Gain max_gain = 0;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    Gain gain = 0;
+    for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+      gain += hypergraph.edgeWeight(he);
+    }
+    max_gain = std::max(max_gain, gain);
+  }
+  return max_gain;
+}
+
+// ! Gain-like keys in [-max_gain, max_gain] for all hypernodes.
+static inline std::vector<Gain> randomKeys(const Hypergraph& hypergraph, const Gain max_gain) {
+  std::vector<Gain> keys(hypergraph.initialNumNodes());
+  for (Gain& key : keys) {
+    key = Randomize::instance().getRandomInt(-max_gain, max_gain);
+  }
+  return keys;
+}
+}  // namespace bench
+}  // namespace kahypar
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "benchmarks/benchmark_instances.h"
+#include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/bucket_queue.h"
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/kway_priority_queue.h"
+#include "kahypar/datastructure/sparse_map.h"
+#include "kahypar/definitions.h"
+#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+
+namespace kahypar {
+// The priority queue benchmarks mimic one FM pass: all hypernodes are inserted
+// and the queue is emptied via repeated deleteMax operations. Similar to locked
+// nets, the keys of the pins of a hyperedge are only updated the first time one
+// of its pins is removed.
+template <typename PQ>
+static void updateNeighborsAndPopAll(const Hypergraph& hypergraph, const std::vector<Gain>& keys,
+                                     ds::FastResetFlagArray<>& locked, PQ& pq) {
+  locked.reset();
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    pq.push(hn, keys[hn]);
+  }
+  while (!pq.empty()) {
+    const HypernodeID max = pq.top();
+    pq.pop();
+    for (const HyperedgeID& he : hypergraph.incidentEdges(max)) {
+      if (!locked[he]) {
+        locked.set(he, true);
+        for (const HypernodeID& pin : hypergraph.pins(he)) {
+          if (pq.contains(pin)) {
+            pq.updateKeyBy(pin, (pin + he) % 2 == 0 ? 1 : -1);
+          }
+        }
+      }
+    }
+  }
+}
+
+static void BM_BinaryMaxHeap(benchmark::State& state) {
+  const Hypergraph hypergraph(bench::loadInstance(state));
+  const std::vector<Gain> keys = bench::randomKeys(hypergraph, bench::maxGain(hypergraph));
+  ds::FastResetFlagArray<> locked(hypergraph.initialNumEdges());
+  ds::BinaryMaxHeap<HypernodeID, Gain> pq(hypergraph.initialNumNodes());
+  for (auto _ : state) {
+    updateNeighborsAndPopAll(hypergraph, keys, locked, pq);
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumPins());
+}
+BENCHMARK(BM_BinaryMaxHeap)->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+
+static void BM_EnhancedBucketQueue(benchmark::State& state) {
+  const Hypergraph hypergraph(bench::loadInstance(state));
+  // The key of a hypernode changes by at most one per incident hyperedge.
+  Gain max_degree = 0;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    max_degree = std::max(max_degree, static_cast<Gain>(hypergraph.nodeDegree(hn)));
+  }
+  const Gain max_gain = bench::maxGain(hypergraph) + max_degree;
+  const std::vector<Gain> keys = bench::randomKeys(hypergraph, bench::maxGain(hypergraph));
+  ds::FastResetFlagArray<> locked(hypergraph.initialNumEdges());
+  ds::EnhancedBucketQueue<HypernodeID, Gain> pq(hypergraph.initialNumNodes(), max_gain);
+  for (auto _ : state) {
+    updateNeighborsAndPopAll(hypergraph, keys, locked, pq);
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumPins());
+}
+BENCHMARK(BM_EnhancedBucketQueue)->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+
+static void BM_KWayPriorityQueue(benchmark::State& state) {
+  const PartitionID k = state.range(1);
+  const Hypergraph hypergraph(bench::loadInstance(state, k));
+  const std::vector<Gain> keys = bench::randomKeys(hypergraph, bench::maxGain(hypergraph));
+  ds::KWayPriorityQueue<HypernodeID, Gain, std::numeric_limits<Gain> > pq(k);
+  pq.initialize(hypergraph.initialNumNodes());
+  for (auto _ : state) {
+    // Each hypernode is inserted into the PQs of two adjacent blocks.
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      pq.insert(hn, hn % k, keys[hn]);
+      pq.insert(hn, (hn + 1) % k, keys[hn] / 2);
+    }
+    for (PartitionID part = 0; part < k; ++part) {
+      pq.enablePart(part);
+    }
+    HypernodeID max_hn = 0;
+    Gain max_gain = 0;
+    PartitionID max_part = 0;
+    while (!pq.empty()) {
+      pq.deleteMax(max_hn, max_gain, max_part);
+      const PartitionID other_part = max_part == static_cast<PartitionID>(max_hn % k) ?
+                                     (max_hn + 1) % k : max_hn % k;
+      if (pq.contains(max_hn, other_part)) {
+        pq.updateKeyBy(max_hn, other_part, -1);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * hypergraph.currentNumNodes());
+}
+BENCHMARK(BM_KWayPriorityQueue)->Apply([](benchmark::internal::Benchmark* benchmark) {
+    bench::allInstancesWithK(benchmark, { 2, 8, 64 });
+  })->Unit(benchmark::kMillisecond);
+
+// Rating accumulation as done by the VertexPairRater.
+static void BM_SparseMap(benchmark::State& state) {
+  const Hypergraph hypergraph(bench::loadInstance(state));
+  ds::SparseMap<HypernodeID, RatingType> ratings(hypergraph.initialNumNodes());
+  for (auto _ : state) {
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+        const RatingType score = static_cast<RatingType>(hypergraph.edgeWeight(he)) /
+                                 (hypergraph.edgeSize(he) - 1);
+        for (const HypernodeID& pin : hypergraph.pins(he)) {
+          ratings[pin] += score;
+        }
+      }
+      benchmark::DoNotOptimize(ratings.size());
+      ratings.clear();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumNodes());
+}
+BENCHMARK(BM_SparseMap)->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+
+// Deduplicating the neighbors of each hypernode.
+static void BM_FastResetFlagArray(benchmark::State& state) {
+  const Hypergraph hypergraph(bench::loadInstance(state));
+  ds::FastResetFlagArray<> visited(hypergraph.initialNumNodes());
+  for (auto _ : state) {
+    size_t num_neighbors = 0;
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+        for (const HypernodeID& pin : hypergraph.pins(he)) {
+          if (!visited[pin]) {
+            visited.set(pin, true);
+            ++num_neighbors;
+          }
+        }
+      }
+      visited.reset();
+    }
+    benchmark::DoNotOptimize(num_neighbors);
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumNodes());
+}
+BENCHMARK(BM_FastResetFlagArray)->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+
+// Gain cache initialization for a round-robin partition followed by delta updates and rollback.
+static void BM_KwayGainCache(benchmark::State& state) {
+  const PartitionID k = state.range(1);
+  Hypergraph hypergraph(bench::loadInstance(state, k));
+  bench::partitionRoundRobin(hypergraph, k);
+  KwayGainCache<Gain> gain_cache(hypergraph.initialNumNodes(), k);
+  for (auto _ : state) {
+    gain_cache.clear();
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+        for (const PartitionID& part : hypergraph.connectivitySet(he)) {
+          if (part != hypergraph.partID(hn) && !gain_cache.entryExists(hn, part)) {
+            gain_cache.initializeEntry(hn, part, hypergraph.pinCountInPart(he, part));
+          }
+        }
+      }
+    }
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      for (const PartitionID& part : gain_cache.adjacentParts(hn)) {
+        gain_cache.updateExistingEntry(hn, part, 1);
+      }
+    }
+    gain_cache.rollbackDelta();
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumPins());
+}
+BENCHMARK(BM_KwayGainCache)->Apply([](benchmark::internal::Benchmark* benchmark) {
+    bench::allInstancesWithK(benchmark, { 2, 8, 64 });
+  })->Unit(benchmark::kMillisecond);
+}  // namespace kahypar
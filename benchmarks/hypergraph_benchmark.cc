@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "benchmarks/benchmark_instances.h"
+#include "kahypar/definitions.h"
+
+namespace kahypar {
+static constexpr HypernodeID kContractionLimit = 160;
+
+// ! Contracts each hypernode with a pin of its first incident hyperedge until the
+// ! contraction limit is reached (similar to a coarsening pass with a trivial rating).
+static std::vector<Hypergraph::ContractionMemento> contractAll(Hypergraph& hypergraph) {
+  std::vector<Hypergraph::ContractionMemento> contractions;
+  bool contracted = true;
+  while (contracted && hypergraph.currentNumNodes() > kContractionLimit) {
+    contracted = false;
+    const std::vector<HypernodeID> nodes(hypergraph.nodes().first, hypergraph.nodes().second);
+    for (const HypernodeID& u : nodes) {
+      if (!hypergraph.nodeIsEnabled(u) || hypergraph.currentNumNodes() <= kContractionLimit) {
+        continue;
+      }
+      for (const HyperedgeID& he : hypergraph.incidentEdges(u)) {
+        HypernodeID partner = u;
+        for (const HypernodeID& pin : hypergraph.pins(he)) {
+          if (pin != u) {
+            partner = pin;
+            break;
+          }
+        }
+        if (partner != u) {
+          contractions.push_back(hypergraph.contract(u, partner));
+          contracted = true;
+          break;
+        }
+      }
+    }
+  }
+  return contractions;
+}
+
+static void uncontractAll(Hypergraph& hypergraph,
+                          const std::vector<Hypergraph::ContractionMemento>& contractions) {
+  for (auto it = contractions.crbegin(); it != contractions.crend(); ++it) {
+    hypergraph.uncontract(*it);
+  }
+}
+
+static void BM_HypergraphContract(benchmark::State& state) {
+  Hypergraph hypergraph(bench::loadInstance(state));
+  size_t num_contractions = 0;
+  for (auto _ : state) {
+    const std::vector<Hypergraph::ContractionMemento> contractions = contractAll(hypergraph);
+    state.PauseTiming();
+    num_contractions += contractions.size();
+    bench::partitionRoundRobin(hypergraph, 2);
+    uncontractAll(hypergraph, contractions);
+    hypergraph.resetPartitioning();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(num_contractions);
+}
+BENCHMARK(BM_HypergraphContract)->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+
+static void BM_HypergraphUncontract(benchmark::State& state) {
+  Hypergraph hypergraph(bench::loadInstance(state));
+  size_t num_contractions = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    const std::vector<Hypergraph::ContractionMemento> contractions = contractAll(hypergraph);
+    num_contractions += contractions.size();
+    bench::partitionRoundRobin(hypergraph, 2);
+    state.ResumeTiming();
+    uncontractAll(hypergraph, contractions);
+    state.PauseTiming();
+    hypergraph.resetPartitioning();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(num_contractions);
+}
+BENCHMARK(BM_HypergraphUncontract)->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+
+// Moves random hypernodes to random blocks of a k-way partition.
+static void BM_HypergraphChangeNodePart(benchmark::State& state) {
+  const PartitionID k = state.range(1);
+  Hypergraph hypergraph(bench::loadInstance(state, k));
+  bench::partitionRoundRobin(hypergraph, k);
+  std::vector<std::pair<HypernodeID, PartitionID> > moves;
+  for (HypernodeID i = 0; i < hypergraph.initialNumNodes(); ++i) {
+    moves.emplace_back(Randomize::instance().getRandomInt(0, hypergraph.initialNumNodes() - 1),
+                       Randomize::instance().getRandomInt(0, k - 1));
+  }
+  for (auto _ : state) {
+    for (const auto& move : moves) {
+      const PartitionID from = hypergraph.partID(move.first);
+      if (from != move.second) {
+        hypergraph.changeNodePart(move.first, from, move.second);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * moves.size());
+}
+BENCHMARK(BM_HypergraphChangeNodePart)->Apply([](benchmark::internal::Benchmark* benchmark) {
+    bench::allInstancesWithK(benchmark, { 2, 8, 64 });
+  })->Unit(benchmark::kMillisecond);
+
+// The following benchmarks compare the array-of-structs and struct-of-arrays
+// hypergraph layouts on the access patterns of the refinement hot loops.
+template <typename Layout>
+using LayoutHypergraph = ds::GenericHypergraph<HypernodeID, HyperedgeID, HypernodeWeight,
+                                               HyperedgeWeight, PartitionID, meta::Empty,
+                                               meta::Empty, ds::DensePinCountInPart, Layout>;
+
+// Scans weight and block of all pins of all hyperedges, which only touches hot fields.
+template <typename Layout>
+static void BM_HypergraphLayoutPinScan(benchmark::State& state) {
+  using LHypergraph = LayoutHypergraph<Layout>;
+  LHypergraph hypergraph(bench::loadInstanceAs<LHypergraph>(state, 2));
+  bench::partitionRoundRobin(hypergraph, 2);
+  for (auto _ : state) {
+    HypernodeWeight block_weight = 0;
+    for (const HyperedgeID& he : hypergraph.edges()) {
+      for (const HypernodeID& pin : hypergraph.pins(he)) {
+        if (hypergraph.partID(pin) == 0) {
+          block_weight += hypergraph.nodeWeight(pin);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(block_weight);
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumPins());
+}
+BENCHMARK_TEMPLATE(BM_HypergraphLayoutPinScan, ds::ArrayOfStructsLayout)
+->Apply(bench::allInstances)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HypergraphLayoutPinScan, ds::StructOfArraysLayout)
+->Apply(bench::allInstances)->Unit(benchmark::kMicrosecond);
+
+// Counts border nodes, which touches hypernode states and cut hyperedge counters.
+template <typename Layout>
+static void BM_HypergraphLayoutBorderNodes(benchmark::State& state) {
+  using LHypergraph = LayoutHypergraph<Layout>;
+  LHypergraph hypergraph(bench::loadInstanceAs<LHypergraph>(state, 8));
+  bench::partitionRoundRobin(hypergraph, 8);
+  for (auto _ : state) {
+    hypergraph.resetHypernodeState();
+    HypernodeID num_border_nodes = 0;
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      if (hypergraph.isBorderNode(hn)) {
+        hypergraph.activate(hn);
+        ++num_border_nodes;
+      }
+    }
+    benchmark::DoNotOptimize(num_border_nodes);
+  }
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumNodes());
+}
+BENCHMARK_TEMPLATE(BM_HypergraphLayoutBorderNodes, ds::ArrayOfStructsLayout)
+->Apply(bench::allInstances)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HypergraphLayoutBorderNodes, ds::StructOfArraysLayout)
+->Apply(bench::allInstances)->Unit(benchmark::kMicrosecond);
+
+template <typename Layout>
+static void BM_HypergraphLayoutChangeNodePart(benchmark::State& state) {
+  using LHypergraph = LayoutHypergraph<Layout>;
+  const PartitionID k = 8;
+  LHypergraph hypergraph(bench::loadInstanceAs<LHypergraph>(state, k));
+  bench::partitionRoundRobin(hypergraph, k);
+  std::vector<std::pair<HypernodeID, PartitionID> > moves;
+  for (HypernodeID i = 0; i < hypergraph.initialNumNodes(); ++i) {
+    moves.emplace_back(Randomize::instance().getRandomInt(0, hypergraph.initialNumNodes() - 1),
+                       Randomize::instance().getRandomInt(0, k - 1));
+  }
+  for (auto _ : state) {
+    for (const auto& move : moves) {
+      const PartitionID from = hypergraph.partID(move.first);
+      if (from != move.second) {
+        hypergraph.changeNodePart(move.first, from, move.second);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * moves.size());
+}
+BENCHMARK_TEMPLATE(BM_HypergraphLayoutChangeNodePart, ds::ArrayOfStructsLayout)
+->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_HypergraphLayoutChangeNodePart, ds::StructOfArraysLayout)
+->Apply(bench::allInstances)->Unit(benchmark::kMillisecond);
+}  // namespace kahypar
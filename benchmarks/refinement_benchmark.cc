@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "benchmarks/benchmark_instances.h"
+#include "kahypar/definitions.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+
+namespace kahypar {
+using KWayKMinusOneRefinerSimpleStopping = KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch>;
+
+static Context createContext(const Hypergraph& hypergraph, const PartitionID k) {
+  Context context;
+  context.partition.k = k;
+  context.partition.mode = Mode::direct_kway;
+  context.partition.objective = Objective::km1;
+  context.partition.epsilon = 0.03;
+  context.local_search.fm.max_number_of_fruitless_moves = 350;
+  const HypernodeWeight perfect_weight = ceil(hypergraph.totalWeight() / static_cast<double>(k));
+  for (PartitionID i = 0; i < k; ++i) {
+    context.partition.perfect_balance_part_weights.push_back(perfect_weight);
+    context.partition.max_part_weights.push_back((1 + context.partition.epsilon) * perfect_weight);
+  }
+  return context;
+}
+
+// One full k-way FM pass with all hypernodes as refinement nodes, starting from a
+// round-robin partition. Gain cache initialization is included in the measurement.
+static void BM_KWayKMinusOneRefiner(benchmark::State& state) {
+  const PartitionID k = state.range(1);
+  Hypergraph hypergraph(bench::loadInstance(state, k));
+  const Context context = createContext(hypergraph, k);
+  UncontractionGainChanges changes;
+  changes.representative.push_back(0);
+  changes.contraction_partner.push_back(0);
+  std::vector<HypernodeID> refinement_nodes;
+  HyperedgeWeight km1 = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    hypergraph.resetPartitioning();
+    bench::partitionRoundRobin(hypergraph, k);
+    Randomize::instance().setSeed(bench::kSeed);
+    KWayKMinusOneRefinerSimpleStopping refiner(hypergraph, context);
+    Metrics metrics = { metrics::hyperedgeCut(hypergraph),
+                        metrics::km1(hypergraph),
+                        metrics::imbalance(hypergraph, context) };
+    refinement_nodes.assign(hypergraph.nodes().first, hypergraph.nodes().second);
+    state.ResumeTiming();
+
+    refiner.initialize(0);
+    refiner.refine(refinement_nodes, { 0, 0 }, changes, metrics);
+    km1 = metrics.km1;
+  }
+  state.counters["km1"] = km1;
+  state.SetItemsProcessed(state.iterations() * hypergraph.currentNumNodes());
+}
+BENCHMARK(BM_KWayKMinusOneRefiner)->Apply([](benchmark::internal::Benchmark* benchmark) {
+    bench::allInstancesWithK(benchmark, { 2, 8, 32 });
+  })->Unit(benchmark::kMillisecond);
+}  // namespace kahypar
@@ -55,6 +55,9 @@ typedef int kahypar_hypernode_weight_t;
 typedef int kahypar_hyperedge_weight_t;
 typedef int kahypar_partition_id_t;
 
+/* All state of a partitioning call (random number generator, timings and
+ * statistics) is owned by the calling thread and the context. Thus calls that
+ * use different contexts and hypergraphs can be run concurrently. */
 KAHYPAR_API kahypar_context_t* kahypar_context_new();
 KAHYPAR_API void kahypar_context_free(kahypar_context_t* kahypar_context);
 KAHYPAR_API void kahypar_configure_context_from_file(kahypar_context_t* kahypar_context,
@@ -120,6 +123,31 @@ KAHYPAR_API void kahypar_partition(const kahypar_hypernode_id_t num_vertices,
                                    kahypar_partition_id_t* partition);
 
 
+/* Returns the next hyperedge of a hyperedge stream or 0 if all hyperedges have
+ * been read. The (distinct) pins have to stay valid until the next call. */
+typedef int (*kahypar_next_hyperedge_t)(void* stream,
+                                        size_t* num_pins,
+                                        const kahypar_hypernode_id_t** pins,
+                                        kahypar_hyperedge_weight_t* hyperedge_weight);
+/* Restarts a hyperedge stream at its first hyperedge. */
+typedef void (*kahypar_rewind_stream_t)(void* stream);
+
+/* Streaming mode (mode=streaming): Partitions a hypergraph whose hyperedges are
+ * read one at a time via next_hyperedge, i.e., the hypergraph is never stored.
+ * vertex_weights may be NULL (unit weights). rewind_stream is required for
+ * restreaming passes and may be NULL if these are disabled. */
+KAHYPAR_API void kahypar_partition_stream(const kahypar_hypernode_id_t num_vertices,
+                                          const kahypar_hyperedge_id_t num_hyperedges,
+                                          const double epsilon,
+                                          const kahypar_partition_id_t num_blocks,
+                                          const kahypar_hypernode_weight_t* vertex_weights,
+                                          kahypar_next_hyperedge_t next_hyperedge,
+                                          kahypar_rewind_stream_t rewind_stream,
+                                          void* stream,
+                                          kahypar_hyperedge_weight_t* objective,
+                                          kahypar_context_t* kahypar_context,
+                                          kahypar_partition_id_t* partition);
+
 KAHYPAR_API void kahypar_improve_partition(const kahypar_hypernode_id_t num_vertices,
                                            const kahypar_hyperedge_id_t num_hyperedges,
                                            const double epsilon,
@@ -70,6 +70,16 @@ po::options_description createGeneralOptionsDescription(Context& context, const
     po::value<int>(&context.partition.seed)->value_name("<int>"),
     "Seed for random number generator \n"
     "(default: -1)")
+    ("threads,t",
+    po::value<size_t>(&context.partition.num_threads)->value_name("<size_t>"),
+    "Number of threads used by parallel algorithms (e.g., parallel_ml_style coarsening). \n"
+    "Results are deterministic for a fixed seed and number of threads. \n"
+    "(default: 1)")
+    ("rb-parallel",
+    po::value<bool>(&context.partition.parallel_recursive_bisection)->value_name("<bool>"),
+    "Recursive bisection mode: Partition the two subhypergraphs of each bisection \n"
+    "concurrently using --threads threads. Results are deterministic for a fixed seed. \n"
+    "(default: false)")
     ("fixed-vertices,f",
     po::value<std::string>(&context.partition.fixed_vertex_filename)->value_name("<string>"),
     "Fixed vertex filename")
@@ -106,7 +116,8 @@ po::options_description createGeneralOptionsDescription(Context& context, const
     }),
     "Partitioning mode: \n"
     " - (recursive) bisection \n"
-    " - (direct) k-way");
+    " - (direct) k-way \n"
+    " - (streaming): single pass over the hyperedges (see Streaming Options)");
   return options;
 }
 
@@ -208,6 +219,7 @@ po::options_description createCoarseningOptionsDescription(Context& context,
     }),
     "Coarsening Algorithm:\n"
     " - ml_style\n"
+    " - parallel_ml_style\n"
     " - heavy_full\n"
     " - heavy_lazy")
     ((initial_partitioning ? "i-c-s" : "c-s"),
@@ -313,6 +325,7 @@ po::options_description createRefinementOptionsDescription(Context& context,
     " - kway_fm                      : k-way FM algorithm         (direct k-way        : cut)\n"
     " - kway_fm_hyperflow_cutter     : k-way FM + HyperFlowCutter (direct k-way        : cut)\n"
     " - kway_fm_km1                  : k-way FM algorithm         (direct k-way        : km1)\n"
+    " - kway_fm_parallel             : parallel k-way FM          (direct k-way        : cut & km1)\n"
     " - kway_fm_hyperflow_cutter_km1 : k-way FM + HyperFlowCutter (direct k-way        : km1)\n"
     " - kway_hyperflow_cutter        : k-way HyperFlowCutter      (direct k-way        : cut & km1)\n"
     )
@@ -331,6 +344,11 @@ po::options_description createRefinementOptionsDescription(Context& context,
     }),
     "Max. # local search repetitions on each level\n"
     "(no limit:-1)")
+    ((initial_partitioning ? "i-r-uncontraction-batch-size" : "r-uncontraction-batch-size"),
+    po::value<HypernodeID>((initial_partitioning ? &context.initial_partitioning.local_search.uncontraction_batch_size : &context.local_search.uncontraction_batch_size))->value_name("<uint32_t>"),
+    "# Contractions that are undone before local search is started on all uncontracted hypernodes.\n"
+    "Larger batches reduce the number of local search calls at the cost of solution quality.\n"
+    "(default: 1, i.e., n-level refinement)")
     ((initial_partitioning ? "i-r-fm-stop" : "r-fm-stop"),
     po::value<std::string>()->value_name("<string>")->notifier(
       [&context, initial_partitioning](const std::string& stopfm) {
@@ -534,6 +552,14 @@ po::options_description createEvolutionaryOptionsDescription(Context& context,
     }),
     "The Frequency in which diversfication should be performed\n"
     "(default: -1)(-1 disables)")
+    ("migration-interval",
+    po::value<int>()->value_name("<int>")->notifier(
+      [&](const int& migration_interval) {
+      context.evolutionary.migration_interval = migration_interval;
+    }),
+    "Island model (--threads > 1, one population per thread): Number of iterations\n"
+    "after which each island sends its best partition to the next island\n"
+    "(default: 5)(0 disables)")
     ("random-vcycles",
     po::value<bool>()->value_name("<bool>")->notifier(
       [&](const bool& random_vcycle) {
@@ -585,6 +611,25 @@ po::options_description createEvolutionaryOptionsDescription(Context& context,
   return evolutionary_options;
 }
 
+po::options_description createStreamingOptionsDescription(Context& context,
+                                                          const int num_columns) {
+  po::options_description options("Streaming Options", num_columns);
+  options.add_options()
+    ("stream-gamma",
+    po::value<double>(&context.streaming.gamma)->value_name("<double>"),
+    "Exponent of the Fennel balance penalty alpha * gamma * c(V_i)^(gamma-1) \n"
+    "(default: 1.5)")
+    ("stream-passes",
+    po::value<uint32_t>(&context.streaming.restreaming_passes)->value_name("<uint32_t>"),
+    "Max. # restreaming passes that refine windows of consecutive hyperedges using k-way FM \n"
+    "(default: 1)")
+    ("stream-window-size",
+    po::value<size_t>(&context.streaming.window_size)->value_name("<size_t>"),
+    "Max. # pins of a restreaming window \n"
+    "(default: 100000)");
+  return options;
+}
+
 po::options_description createGenericOptionsDescription(Context& context,
                                                         const int num_columns) {
   po::options_description generic_options("Generic Options", num_columns);
@@ -661,6 +706,8 @@ void processCommandLineInput(Context& context, int argc, char* argv[]) {
 
   po::options_description evolutionary_options = createEvolutionaryOptionsDescription(context, num_columns);
 
+  po::options_description streaming_options = createStreamingOptionsDescription(context, num_columns);
+
   po::options_description cmd_line_options;
   cmd_line_options.add(generic_options)
   .add(required_options)
@@ -671,6 +718,7 @@ void processCommandLineInput(Context& context, int argc, char* argv[]) {
   .add(ip_options)
   .add(refinement_options)
   .add(evolutionary_options)
+  .add(streaming_options)
   .add(write_snapshot);
 
   po::variables_map cmd_vm;
@@ -699,7 +747,8 @@ void processCommandLineInput(Context& context, int argc, char* argv[]) {
   .add(coarsening_options)
   .add(ip_options)
   .add(refinement_options)
-  .add(evolutionary_options);
+  .add(evolutionary_options)
+  .add(streaming_options);
 
   po::store(po::parse_config_file(file, ini_line_options, true), cmd_vm);
   po::notify(cmd_vm);
@@ -740,7 +789,8 @@ void parseIniToContext(Context& context, const std::string& ini_filename) {
   .add(createCoarseningOptionsDescription(context, num_columns, false))
   .add(createInitialPartitioningOptionsDescription(context, num_columns))
   .add(createRefinementOptionsDescription(context, num_columns, false))
-  .add(createEvolutionaryOptionsDescription(context, num_columns));
+  .add(createEvolutionaryOptionsDescription(context, num_columns))
+  .add(createStreamingOptionsDescription(context, num_columns));
 
   po::store(po::parse_config_file(file, ini_line_options, true), cmd_vm);
   po::notify(cmd_vm);
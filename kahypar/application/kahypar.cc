@@ -39,9 +39,16 @@ int main(int argc, char* argv[]) {
 
   kahypar::processCommandLineInput(context, argc, argv);
 
+  if (context.partition.mode == kahypar::Mode::streaming) {
+    // The hypergraph is never materialized in streaming mode.
+    kahypar::PartitionerFacade().partitionStream(context);
+    return 0;
+  }
+
   kahypar::Hypergraph hypergraph(
     kahypar::io::createHypergraphFromFile(context.partition.graph_filename,
-                                          context.partition.k));
+                                          context.partition.k,
+                                          context.partition.num_threads));
 
   kahypar::SerializeOnSignal::initialize(hypergraph, context);
 
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace ds {
+/*!
+ * Fixed-size array of unsigned integers that are stored using only
+ * bits_per_entry bits each. Entries may span two consecutive 64-bit words.
+ * Used to store partitions compactly, i.e., with ceil(log2(k)) bits per node.
+ */
+class BitPackedArray {
+  using Word = std::uint64_t;
+  static constexpr size_t kBitsPerWord = 64;
+
+ public:
+  BitPackedArray() :
+    _size(0),
+    _bits_per_entry(1),
+    _mask(1),
+    _words() { }
+
+  BitPackedArray(const size_t size, const size_t max_value) :
+    _size(size),
+    _bits_per_entry(bitsFor(max_value)),
+    _mask(_bits_per_entry == kBitsPerWord ? ~Word(0) : (Word(1) << _bits_per_entry) - 1),
+    _words((size * _bits_per_entry + kBitsPerWord - 1) / kBitsPerWord, 0) { }
+
+  BitPackedArray(const BitPackedArray&) = default;
+  BitPackedArray& operator= (const BitPackedArray&) = default;
+
+  BitPackedArray(BitPackedArray&&) = default;
+  BitPackedArray& operator= (BitPackedArray&&) = default;
+
+  ~BitPackedArray() = default;
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  size_t bitsPerEntry() const {
+    return _bits_per_entry;
+  }
+
+  // ! Number of bytes occupied by the packed entries.
+  size_t sizeInBytes() const {
+    return _words.size() * sizeof(Word);
+  }
+
+  Word operator[] (const size_t i) const {
+    ASSERT(i < _size, V(i) << V(_size));
+    const size_t bit = i * _bits_per_entry;
+    const size_t word = bit / kBitsPerWord;
+    const size_t offset = bit % kBitsPerWord;
+    Word value = _words[word] >> offset;
+    if (offset + _bits_per_entry > kBitsPerWord) {
+      value |= _words[word + 1] << (kBitsPerWord - offset);
+    }
+    return value & _mask;
+  }
+
+  void set(const size_t i, const Word value) {
+    ASSERT(i < _size, V(i) << V(_size));
+    ASSERT((value & ~_mask) == 0, "Value" << value << "needs more than" << _bits_per_entry << "bits");
+    const size_t bit = i * _bits_per_entry;
+    const size_t word = bit / kBitsPerWord;
+    const size_t offset = bit % kBitsPerWord;
+    _words[word] = (_words[word] & ~(_mask << offset)) | (value << offset);
+    if (offset + _bits_per_entry > kBitsPerWord) {
+      const size_t shift = kBitsPerWord - offset;
+      _words[word + 1] = (_words[word + 1] & ~(_mask >> shift)) | (value >> shift);
+    }
+  }
+
+  // ! Number of bits required to store values in [0, max_value].
+  static size_t bitsFor(Word max_value) {
+    size_t bits = 1;
+    while (bits < kBitsPerWord && (max_value >> bits) != 0) {
+      ++bits;
+    }
+    return bits;
+  }
+
+ private:
+  size_t _size;
+  size_t _bits_per_entry;
+  Word _mask;
+  std::vector<Word> _words;
+};
+}  // namespace ds
+}  // namespace kahypar
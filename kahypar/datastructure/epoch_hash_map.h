@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+#include "kahypar/utils/math.h"
+
+namespace kahypar {
+namespace ds {
+/*!
+ * Open addressing hash map with linear probing for integral keys.
+ * In contrast to the dense maps, the memory is proportional to the number of
+ * elements stored between two calls of clear() and not to the key universe.
+ * clear() runs in constant time: entries are tagged with the epoch in which
+ * they were inserted and become invalid as soon as the epoch advances.
+ * The table doubles once it is half full, so a map that is reused for several
+ * rounds grows to the largest round and stays at that size.
+ */
+template <typename Key = Mandatory,
+          typename Value = Mandatory>
+class EpochHashMap {
+ private:
+  using Epoch = std::uint32_t;
+
+  struct Entry {
+    Key key;
+    Value value;
+    Epoch epoch;
+  };
+
+  static constexpr size_t kMinCapacity = 16;
+
+ public:
+  explicit EpochHashMap(const size_t expected_size = 0) :
+    _table(),
+    _mask(0),
+    _shift(0),
+    _size(0),
+    _epoch(1) {
+    allocate(capacityFor(expected_size));
+  }
+
+  EpochHashMap(const EpochHashMap&) = delete;
+  EpochHashMap& operator= (const EpochHashMap&) = delete;
+
+  EpochHashMap(EpochHashMap&&) = default;
+  EpochHashMap& operator= (EpochHashMap&&) = default;
+
+  ~EpochHashMap() = default;
+
+  size_t size() const {
+    return _size;
+  }
+
+  size_t capacity() const {
+    return _table.size();
+  }
+
+  bool contains(const Key key) const {
+    return find(key) != nullptr;
+  }
+
+  // ! Returns a pointer to the value stored for key or nullptr if key is not contained.
+  const Value* find(const Key key) const {
+    for (size_t pos = position(key); _table[pos].epoch == _epoch; pos = (pos + 1) & _mask) {
+      if (_table[pos].key == key) {
+        return &_table[pos].value;
+      }
+    }
+    return nullptr;
+  }
+
+  const Value& get(const Key key) const {
+    const Value* value = find(key);
+    ASSERT(value != nullptr, V(key));
+    return *value;
+  }
+
+  // ! Inserts key if it is not contained yet. Returns true if key was inserted.
+  bool insert(const Key key, const Value value) {
+    if (2 * (_size + 1) > _table.size()) {
+      grow();
+    }
+    size_t pos = position(key);
+    for ( ; _table[pos].epoch == _epoch; pos = (pos + 1) & _mask) {
+      if (_table[pos].key == key) {
+        return false;
+      }
+    }
+    _table[pos] = Entry { key, value, _epoch };
+    ++_size;
+    return true;
+  }
+
+  void reserve(const size_t expected_size) {
+    const size_t capacity = capacityFor(expected_size);
+    if (capacity > _table.size()) {
+      rehash(capacity);
+    }
+  }
+
+  void clear() {
+    _size = 0;
+    if (_epoch == std::numeric_limits<Epoch>::max()) {
+      for (Entry& entry : _table) {
+        entry.epoch = 0;
+      }
+      _epoch = 0;
+    }
+    ++_epoch;
+  }
+
+ private:
+  static size_t capacityFor(const size_t expected_size) {
+    return std::max(kMinCapacity, math::nextPowerOfTwoCeiled(2 * expected_size));
+  }
+
+  size_t position(const Key key) const {
+    // Fibonacci hashing spreads consecutive IDs over the whole table.
+    return (static_cast<std::uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15)) >> _shift;
+  }
+
+  void allocate(const size_t capacity) {
+    ASSERT(capacity >= kMinCapacity && (capacity & (capacity - 1)) == 0, V(capacity));
+    _table.assign(capacity, Entry { Key(), Value(), 0 });
+    _mask = capacity - 1;
+    _shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --_shift;
+    }
+  }
+
+  void grow() {
+    rehash(2 * _table.size());
+  }
+
+  void rehash(const size_t capacity) {
+    std::vector<Entry> old_table;
+    old_table.swap(_table);
+    const Epoch old_epoch = _epoch;
+    allocate(capacity);
+    _size = 0;
+    _epoch = 1;
+    for (const Entry& entry : old_table) {
+      if (entry.epoch == old_epoch) {
+        insert(entry.key, entry.value);
+      }
+    }
+  }
+
+  std::vector<Entry> _table;
+  size_t _mask;
+  size_t _shift;
+  size_t _size;
+  Epoch _epoch;
+};
+}  // namespace ds
+}  // namespace kahypar
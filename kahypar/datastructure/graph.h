@@ -38,6 +38,7 @@
 #include "kahypar/definitions.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
 
 namespace kahypar {
 namespace ds {
@@ -55,10 +56,25 @@ struct IncidentClusterWeight {
     weight(weight) { }
 };
 
+/*!
+ * Scratch space to compute the weights of the clusters incident to a node or
+ * cluster. Threads that query the same graph concurrently need separate
+ * instances.
+ */
+struct IncidentClusterWeights {
+  explicit IncidentClusterWeights(const size_t num_clusters) :
+    weights(num_clusters, IncidentClusterWeight(0, 0.0L)),
+    position(num_clusters) { }
+
+  std::vector<IncidentClusterWeight> weights;
+  SparseMap<ClusterID, size_t> position;
+};
+
 
 class Graph {
  private:
   static constexpr bool enable_heavy_assert = false;
+  static constexpr size_t kChunkSize = 1024;
 
   class NodeIDIterator : public std::iterator<
                            std::forward_iterator_tag,  // iterator_category
@@ -97,7 +113,12 @@ class Graph {
   using EdgeIterator = std::vector<Edge>::const_iterator;
   using IncidentClusterWeightIterator = std::vector<IncidentClusterWeight>::const_iterator;
 
-  Graph(const Hypergraph& hypergraph, const Context& context) :
+  /*!
+   * If a thread pool is given, the graph is constructed in parallel and
+   * contractClusters() uses the pool as well.
+   */
+  Graph(const Hypergraph& hypergraph, const Context& context,
+        ThreadPool* pool = nullptr) :
     _num_nodes(0),
     _num_communities(0),
     _total_weight(0.0L),
@@ -111,7 +132,8 @@ class Graph {
     _incident_cluster_weight(),
     _incident_cluster_weight_position(static_cast<size_t>(hypergraph.initialNumNodes()) +
                                       hypergraph.initialNumEdges()),
-    _hypernode_mapping() {
+    _hypernode_mapping(),
+    _pool(pool) {
     for (const HyperedgeID he : hypergraph.edges()) {
       if (hypergraph.edgeSize(he) > 2) {
         _is_graph = false;
@@ -189,7 +211,8 @@ class Graph {
     }
   }
 
-  Graph(const std::vector<NodeID>& adj_array, const std::vector<Edge>& edges) :
+  Graph(const std::vector<NodeID>& adj_array, const std::vector<Edge>& edges,
+        ThreadPool* pool = nullptr) :
     _num_nodes(adj_array.size() - 1),
     _num_communities(_num_nodes),
     _total_weight(0.0L),
@@ -202,19 +225,11 @@ class Graph {
     _cluster_size(_num_nodes, 1),
     _incident_cluster_weight(_num_nodes, IncidentClusterWeight(0, 0.0L)),
     _incident_cluster_weight_position(_num_nodes),
-    _hypernode_mapping(_num_nodes, kInvalidNode) {
+    _hypernode_mapping(_num_nodes, kInvalidNode),
+    _pool(pool) {
     std::iota(_cluster_id.begin(), _cluster_id.end(), 0);
     std::iota(_hypernode_mapping.begin(), _hypernode_mapping.end(), 0);
-
-    for (const NodeID& node : nodes()) {
-      for (const Edge& e : incidentEdges(node)) {
-        if (node == e.target_node) {
-          _selfloop_weight[node] = e.weight;
-        }
-        _total_weight += e.weight;
-        _weighted_degree[node] += e.weight;
-      }
-    }
+    computeNodeWeights();
   }
 
   Graph(const Graph& other) = delete;
@@ -354,77 +369,18 @@ class Graph {
    */
   std::pair<IncidentClusterWeightIterator,
             IncidentClusterWeightIterator> incidentClusterWeightOfNode(const NodeID node) {
-    _incident_cluster_weight_position.clear();
-    size_t idx = 0;
-
-    if (clusterID(node) != -1) {
-      _incident_cluster_weight[idx] = IncidentClusterWeight(clusterID(node), 0.0L);
-      _incident_cluster_weight_position[clusterID(node)] = idx++;
-    }
-
-    for (const Edge& e : incidentEdges(node)) {
-      const NodeID id = e.target_node;
-      const EdgeWeight w = e.weight;
-      const ClusterID c_id = clusterID(id);
-      if (c_id != -1) {
-        if (_incident_cluster_weight_position.contains(c_id)) {
-          _incident_cluster_weight[_incident_cluster_weight_position[c_id]].weight += w;
-        } else {
-          _incident_cluster_weight[idx] = IncidentClusterWeight(c_id, w);
-          _incident_cluster_weight_position[c_id] = idx++;
-        }
-      }
-    }
-
-    HEAVY_DATA_STRUCTURE_ASSERT([&]() {
-          const auto incident_cluster_weight_range =
-            std::make_pair(_incident_cluster_weight.begin(),
-                           _incident_cluster_weight.begin() + idx);
-          std::set<ClusterID> incident_cluster;
-          if (clusterID(node) != -1) {
-            incident_cluster.insert(clusterID(node));
-          }
-          for (const Edge& e : incidentEdges(node)) {
-            const ClusterID cid = clusterID(e.target_node);
-            if (cid != -1) {
-              incident_cluster.insert(cid);
-            }
-          }
-          for (const auto& cluster : incident_cluster_weight_range) {
-            const ClusterID cid = cluster.clusterID;
-            const EdgeWeight weight = cluster.weight;
-            if (incident_cluster.find(cid) == incident_cluster.end()) {
-              LOG << "ClusterID" << cid << "occurs multiple times or is not incident to node"
-                  << node;
-              return false;
-            }
-            EdgeWeight incident_weight = 0.0L;
-            for (const Edge& e : incidentEdges(node)) {
-              const ClusterID inc_cid = clusterID(e.target_node);
-              if (inc_cid == cid) {
-                incident_weight += e.weight;
-              }
-            }
-            if (std::abs(incident_weight - weight) > kEpsilon) {
-              LOG << "Weight calculation of incident cluster" << cid << "failed!";
-              LOG << V(incident_weight);
-              LOG << V(weight);
-              return false;
-            }
-            incident_cluster.erase(cid);
-          }
-
-          if (incident_cluster.size() > 0) {
-            LOG << "Missing cluster ids in iterator!";
-            for (const ClusterID& cid : incident_cluster) {
-              LOG << V(cid);
-            }
-            return false;
-          }
-          return true;
-        } (), "Incident cluster weight calculation of node" << node << "failed!");
+    return incidentClusterWeightOfNode(node, _incident_cluster_weight,
+                                       _incident_cluster_weight_position);
+  }
 
-    return std::make_pair(_incident_cluster_weight.begin(), _incident_cluster_weight.begin() + idx);
+  /**
+   * Same as above, but uses the given scratch space instead of the one of the graph.
+   * Thus, this variant can be called concurrently as long as no cluster IDs change.
+   */
+  std::pair<IncidentClusterWeightIterator,
+            IncidentClusterWeightIterator> incidentClusterWeightOfNode(const NodeID node,
+                                                                       IncidentClusterWeights& scratch) const {
+    return incidentClusterWeightOfNode(node, scratch.weights, scratch.position);
   }
 
 
@@ -451,11 +407,13 @@ class Graph {
     }
 
     std::vector<NodeID> new_hypernode_mapping(_hypernode_mapping.size(), kInvalidNode);
-    for (HypernodeID hn = 0; hn < _hypernode_mapping.size(); ++hn) {
-      if (_hypernode_mapping[hn] != kInvalidNode) {
-        new_hypernode_mapping[hn] = node_to_contracted_node[_hypernode_mapping[hn]];
-      }
-    }
+    forEachChunk(_hypernode_mapping.size(), [&](const size_t begin, const size_t end) {
+        for (size_t hn = begin; hn < end; ++hn) {
+          if (_hypernode_mapping[hn] != kInvalidNode) {
+            new_hypernode_mapping[hn] = node_to_contracted_node[_hypernode_mapping[hn]];
+          }
+        }
+      });
 
     ASSERT([&]() {
           for (HypernodeID hn = 0; hn < _hypernode_mapping.size(); ++hn) {
@@ -474,44 +432,77 @@ class Graph {
     std::vector<ClusterID> clusterID(new_cid);
     std::iota(clusterID.begin(), clusterID.end(), 0);
 
+    // Bucket the nodes by cluster. Within a cluster, nodes remain sorted by ID.
+    std::vector<NodeID> cluster_begin(static_cast<size_t>(new_cid) + 1, 0);
+    for (const NodeID& node : nodes()) {
+      ++cluster_begin[_cluster_id[node] + 1];
+    }
+    std::partial_sum(cluster_begin.begin(), cluster_begin.end(), cluster_begin.begin());
     std::vector<NodeID> node_ids(_num_nodes);
-    std::iota(node_ids.begin(), node_ids.end(), 0);
-
-    std::sort(node_ids.begin(), node_ids.end(), [&](const NodeID& n1, const NodeID& n2) {
-          return _cluster_id[n1] < _cluster_id[n2] || (_cluster_id[n1] == _cluster_id[n2] && n1 < n2);
-        });
-
-    // Add Sentinels
-    node_ids.push_back(_cluster_id.size());
-    _cluster_id.push_back(new_cid);
+    {
+      std::vector<NodeID> next_pos(cluster_begin.begin(), cluster_begin.end() - 1);
+      for (const NodeID& node : nodes()) {
+        node_ids[next_pos[_cluster_id[node]]++] = node;
+      }
+    }
+    const auto cluster_range = [&](const ClusterID cid) {
+                                 return std::make_pair(node_ids.cbegin() + cluster_begin[cid],
+                                                       node_ids.cbegin() + cluster_begin[cid + 1]);
+                               };
 
-    std::vector<NodeID> new_adj_array(new_cid + 1, 0);
+    std::vector<NodeID> new_adj_array(static_cast<size_t>(new_cid) + 1, 0);
     std::vector<Edge> new_edges;
-    size_t start_idx = 0;
-    for (NodeID i = 0; i < _num_nodes + 1; ++i) {
-      if (_cluster_id[node_ids[start_idx]] != _cluster_id[node_ids[i]]) {
-        const ClusterID cid = _cluster_id[node_ids[start_idx]];
+    if (_pool == nullptr) {
+      for (ClusterID cid = 0; cid < new_cid; ++cid) {
         new_adj_array[cid] = new_edges.size();
-        auto cluster_range = std::make_pair(node_ids.begin() + start_idx,
-                                            node_ids.begin() + i);
-        for (const auto& incident_cluster_weight : incidentClusterWeightOfCluster(cluster_range)) {
+        for (const auto& incident_cluster_weight : incidentClusterWeightOfCluster(cluster_range(cid))) {
           Edge e;
           e.target_node = static_cast<NodeID>(incident_cluster_weight.clusterID);
           e.weight = incident_cluster_weight.weight;
           new_edges.push_back(e);
         }
-        start_idx = i;
       }
+    } else {
+      // The incident cluster weights of each cluster are computed concurrently.
+      // Since each cluster is processed exactly as in the sequential case, the
+      // contracted graph does not depend on the number of threads.
+      std::vector<IncidentClusterWeights> scratch;
+      scratch.reserve(_pool->numThreads());
+      for (size_t i = 0; i < _pool->numThreads(); ++i) {
+        scratch.emplace_back(numNodes());
+      }
+      std::vector<std::vector<Edge> > cluster_edges(new_cid);
+      _pool->parallelFor(0, new_cid, kChunkSize,
+                         [&](const size_t worker, const size_t begin, const size_t end) {
+          for (size_t cid = begin; cid < end; ++cid) {
+            for (const auto& incident_cluster_weight :
+                 incidentClusterWeightOfCluster(cluster_range(cid), scratch[worker].weights,
+                                                scratch[worker].position)) {
+              Edge e;
+              e.target_node = static_cast<NodeID>(incident_cluster_weight.clusterID);
+              e.weight = incident_cluster_weight.weight;
+              cluster_edges[cid].push_back(e);
+            }
+          }
+        });
+      for (ClusterID cid = 0; cid < new_cid; ++cid) {
+        new_adj_array[cid + 1] = new_adj_array[cid] + cluster_edges[cid].size();
+      }
+      new_edges.resize(new_adj_array[new_cid]);
+      _pool->parallelFor(0, new_cid, kChunkSize,
+                         [&](const size_t, const size_t begin, const size_t end) {
+          for (size_t cid = begin; cid < end; ++cid) {
+            std::copy(cluster_edges[cid].begin(), cluster_edges[cid].end(),
+                      new_edges.begin() + new_adj_array[cid]);
+          }
+        });
     }
 
-    // Remove Sentinels
-    node_ids.pop_back();
-    _cluster_id.pop_back();
-
     new_adj_array[new_cid] = new_edges.size();
 
-    return std::make_pair(Graph(new_adj_array, new_edges, new_hypernode_mapping, clusterID),
-                          node_to_contracted_node);
+    return std::make_pair(Graph(std::move(new_adj_array), std::move(new_edges),
+                                std::move(new_hypernode_mapping), std::move(clusterID), _pool),
+                          std::move(node_to_contracted_node));
   }
 
   void printGraph() {
@@ -533,35 +524,141 @@ class Graph {
   FRIEND_TEST(ALouvainKarateClub, DoesLouvainAlgorithm);
 
 
-  Graph(const std::vector<NodeID>& adj_array, const std::vector<Edge>& edges,
-        const std::vector<NodeID>& new_hypernode_mapping,
-        const std::vector<ClusterID>& cluster_id) :
+  Graph(std::vector<NodeID>&& adj_array, std::vector<Edge>&& edges,
+        std::vector<NodeID>&& new_hypernode_mapping,
+        std::vector<ClusterID>&& cluster_id, ThreadPool* pool) :
     _num_nodes(adj_array.size() - 1),
     _num_communities(0),
     _total_weight(0.0L),
     _is_graph(true),
-    _adj_array(adj_array),
-    _edges(edges),
+    _adj_array(std::move(adj_array)),
+    _edges(std::move(edges)),
     _selfloop_weight(_num_nodes, 0.0L),
     _weighted_degree(_num_nodes, 0.0L),
-    _cluster_id(cluster_id),
+    _cluster_id(std::move(cluster_id)),
     _cluster_size(_num_nodes, 0),
     _incident_cluster_weight(_num_nodes, IncidentClusterWeight(0, 0.0L)),
     _incident_cluster_weight_position(_num_nodes),
-    _hypernode_mapping(new_hypernode_mapping) {
+    _hypernode_mapping(std::move(new_hypernode_mapping)),
+    _pool(pool) {
     for (const NodeID& node : nodes()) {
       if (_cluster_size[_cluster_id[node]] == 0) {
         _num_communities++;
       }
       _cluster_size[_cluster_id[node]]++;
-      for (const Edge& e : incidentEdges(node)) {
-        if (node == e.target_node) {
-          _selfloop_weight[node] = e.weight;
+    }
+    computeNodeWeights();
+  }
+
+  // ! Calls f(begin, end) for chunks covering [0, n), concurrently if the graph has a thread pool.
+  template <typename F>
+  void forEachChunk(const size_t n, const F& f) const {
+    if (_pool != nullptr) {
+      _pool->parallelFor(0, n, kChunkSize, [&](const size_t, const size_t begin, const size_t end) {
+          f(begin, end);
+        });
+    } else if (n > 0) {
+      f(0, n);
+    }
+  }
+
+  // ! Computes selfloop weights, weighted degrees and the total weight from the adjacency array.
+  void computeNodeWeights() {
+    forEachChunk(numNodes(), [&](const size_t begin, const size_t end) {
+        for (NodeID node = begin; node < end; ++node) {
+          for (const Edge& e : incidentEdges(node)) {
+            if (node == e.target_node) {
+              _selfloop_weight[node] = e.weight;
+            }
+            _weighted_degree[node] += e.weight;
+          }
+        }
+      });
+    computeTotalWeight();
+  }
+
+  // ! Sums up the weighted degrees in node order, which does not depend on the number of threads.
+  void computeTotalWeight() {
+    _total_weight = 0.0L;
+    for (const NodeID& node : nodes()) {
+      _total_weight += _weighted_degree[node];
+    }
+  }
+
+  std::pair<IncidentClusterWeightIterator,
+            IncidentClusterWeightIterator> incidentClusterWeightOfNode(const NodeID node,
+                                                                       std::vector<IncidentClusterWeight>& weights,
+                                                                       SparseMap<ClusterID, size_t>& position) const {
+    position.clear();
+    size_t idx = 0;
+
+    if (clusterID(node) != -1) {
+      weights[idx] = IncidentClusterWeight(clusterID(node), 0.0L);
+      position[clusterID(node)] = idx++;
+    }
+
+    for (const Edge& e : incidentEdges(node)) {
+      const NodeID id = e.target_node;
+      const EdgeWeight w = e.weight;
+      const ClusterID c_id = clusterID(id);
+      if (c_id != -1) {
+        if (position.contains(c_id)) {
+          weights[position[c_id]].weight += w;
+        } else {
+          weights[idx] = IncidentClusterWeight(c_id, w);
+          position[c_id] = idx++;
         }
-        _total_weight += e.weight;
-        _weighted_degree[node] += e.weight;
       }
     }
+
+    HEAVY_DATA_STRUCTURE_ASSERT([&]() {
+          const auto incident_cluster_weight_range =
+            std::make_pair(weights.cbegin(), weights.cbegin() + idx);
+          std::set<ClusterID> incident_cluster;
+          if (clusterID(node) != -1) {
+            incident_cluster.insert(clusterID(node));
+          }
+          for (const Edge& e : incidentEdges(node)) {
+            const ClusterID cid = clusterID(e.target_node);
+            if (cid != -1) {
+              incident_cluster.insert(cid);
+            }
+          }
+          for (const auto& cluster : incident_cluster_weight_range) {
+            const ClusterID cid = cluster.clusterID;
+            const EdgeWeight weight = cluster.weight;
+            if (incident_cluster.find(cid) == incident_cluster.end()) {
+              LOG << "ClusterID" << cid << "occurs multiple times or is not incident to node"
+                  << node;
+              return false;
+            }
+            EdgeWeight incident_weight = 0.0L;
+            for (const Edge& e : incidentEdges(node)) {
+              const ClusterID inc_cid = clusterID(e.target_node);
+              if (inc_cid == cid) {
+                incident_weight += e.weight;
+              }
+            }
+            if (std::abs(incident_weight - weight) > kEpsilon) {
+              LOG << "Weight calculation of incident cluster" << cid << "failed!";
+              LOG << V(incident_weight);
+              LOG << V(weight);
+              return false;
+            }
+            incident_cluster.erase(cid);
+          }
+
+          if (incident_cluster.size() > 0) {
+            LOG << "Missing cluster ids in iterator!";
+            for (const ClusterID& cid : incident_cluster) {
+              LOG << V(cid);
+            }
+            return false;
+          }
+          return true;
+        } (), "Incident cluster weight calculation of node" << node << "failed!");
+
+    return std::make_pair(weights.cbegin(), weights.cbegin() + idx);
   }
 
   /**
@@ -571,9 +668,17 @@ class Graph {
    */
   std::pair<IncidentClusterWeightIterator,
             IncidentClusterWeightIterator> incidentClusterWeightOfCluster(const std::pair<NodeIterator, NodeIterator>& cluster_range) {
+    return incidentClusterWeightOfCluster(cluster_range, _incident_cluster_weight,
+                                          _incident_cluster_weight_position);
+  }
+
+  std::pair<IncidentClusterWeightIterator,
+            IncidentClusterWeightIterator> incidentClusterWeightOfCluster(const std::pair<NodeIterator, NodeIterator>& cluster_range,
+                                                                          std::vector<IncidentClusterWeight>& weights,
+                                                                          SparseMap<ClusterID, size_t>& position) const {
     ASSERT(std::all_of(cluster_range.first, cluster_range.second,
                        [&](const NodeID i) { return clusterID(i) == clusterID(*cluster_range.first); }));
-    _incident_cluster_weight_position.clear();
+    position.clear();
     size_t idx = 0;
 
     for (const NodeID& node : cluster_range) {
@@ -581,18 +686,17 @@ class Graph {
         const NodeID id = e.target_node;
         const EdgeWeight w = e.weight;
         const ClusterID c_id = clusterID(id);
-        if (_incident_cluster_weight_position.contains(c_id)) {
-          const size_t i = _incident_cluster_weight_position[c_id];
-          _incident_cluster_weight[i].weight += w;
+        if (position.contains(c_id)) {
+          const size_t i = position[c_id];
+          weights[i].weight += w;
         } else {
-          _incident_cluster_weight[idx] = IncidentClusterWeight(c_id, w);
-          _incident_cluster_weight_position[c_id] = idx++;
+          weights[idx] = IncidentClusterWeight(c_id, w);
+          position[c_id] = idx++;
         }
       }
     }
 
-    auto incident_cluster_weight_range = std::make_pair(_incident_cluster_weight.begin(),
-                                                        _incident_cluster_weight.begin() + idx);
+    auto incident_cluster_weight_range = std::make_pair(weights.cbegin(), weights.cbegin() + idx);
 
     ASSERT([&]() {
           std::set<ClusterID> incident_cluster;
@@ -646,10 +750,12 @@ class Graph {
   void constructGraph(const Hypergraph& hg, const EdgeWeightFunction& edgeWeight) {
     NodeID sum_edges = 0;
     NodeID cur_node_id = 0;
+    std::vector<HypernodeID> hypernodes;
 
     // Construct adj. array for all hypernodes.
     // Number of edges is equal to the degree of the corresponding hypernode.
     for (const HypernodeID& hn : hg.nodes()) {
+      hypernodes.push_back(hn);
       _hypernode_mapping[hn] = cur_node_id;
       _adj_array[cur_node_id++] = sum_edges;
       sum_edges += hg.nodeDegree(hn);
@@ -658,22 +764,25 @@ class Graph {
     _adj_array[_num_nodes] = sum_edges;
     _edges.resize(sum_edges);
 
-    for (const HypernodeID& hn : hg.nodes()) {
-      size_t pos = 0;
-      const NodeID graph_node = _hypernode_mapping[hn];
-      for (const HyperedgeID& he : hg.incidentEdges(hn)) {
-        for (const HypernodeID& pin : hg.pins(he)) {
-          if (pin != hn) {
-            Edge e;
-            e.target_node = _hypernode_mapping[pin];
-            e.weight = edgeWeight(hg, he, hn);
-            _total_weight += e.weight;
-            _weighted_degree[graph_node] += e.weight;
-            _edges[_adj_array[graph_node] + pos++] = e;
+    forEachChunk(hypernodes.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const HypernodeID hn = hypernodes[i];
+          size_t pos = 0;
+          const NodeID graph_node = _hypernode_mapping[hn];
+          for (const HyperedgeID& he : hg.incidentEdges(hn)) {
+            for (const HypernodeID& pin : hg.pins(he)) {
+              if (pin != hn) {
+                Edge e;
+                e.target_node = _hypernode_mapping[pin];
+                e.weight = edgeWeight(hg, he, hn);
+                _weighted_degree[graph_node] += e.weight;
+                _edges[_adj_array[graph_node] + pos++] = e;
+              }
+            }
           }
         }
-      }
-    }
+      });
+    computeTotalWeight();
 
     ASSERT([&]() {
           // Check Hypernodes in Graph
@@ -712,10 +821,13 @@ class Graph {
     const auto num_nodes = static_cast<size_t>(hg.initialNumNodes());
 
     NodeID cur_node_id = 0;
+    std::vector<HypernodeID> hypernodes;
+    std::vector<HyperedgeID> hyperedges;
 
     // Construct adj. array for all hypernodes.
     // Number of edges is equal to the degree of the corresponding hypernode.
     for (const HypernodeID& hn : hg.nodes()) {
+      hypernodes.push_back(hn);
       _hypernode_mapping[hn] = cur_node_id;
       _adj_array[cur_node_id++] = sum_edges;
       sum_edges += hg.nodeDegree(hn);
@@ -724,6 +836,7 @@ class Graph {
     // Construct adj. array for all hyperedges.
     // Number of edges is equal to the size of the corresponding hyperedge.
     for (const HyperedgeID& he : hg.edges()) {
+      hyperedges.push_back(he);
       _hypernode_mapping[num_nodes + he] = cur_node_id;
       _adj_array[cur_node_id++] = sum_edges;
       sum_edges += hg.edgeSize(he);
@@ -732,31 +845,35 @@ class Graph {
     _adj_array[_num_nodes] = sum_edges;
     _edges.resize(sum_edges);
 
-    for (const HypernodeID& hn : hg.nodes()) {
-      size_t pos = 0;
-      const NodeID graph_node = _hypernode_mapping[hn];
-      for (const HyperedgeID& he : hg.incidentEdges(hn)) {
-        Edge e;
-        e.target_node = _hypernode_mapping[num_nodes + he];
-        e.weight = edgeWeight(hg, he, hn);
-        _total_weight += e.weight;
-        _weighted_degree[graph_node] += e.weight;
-        _edges[_adj_array[graph_node] + pos++] = e;
-      }
-    }
-
-    for (const HyperedgeID& he : hg.edges()) {
-      size_t pos = 0;
-      for (const HypernodeID& hn : hg.pins(he)) {
-        Edge e;
-        e.target_node = _hypernode_mapping[hn];
-        e.weight = edgeWeight(hg, he, hn);
-        const NodeID cur_node = _hypernode_mapping[num_nodes + he];
-        _total_weight += e.weight;
-        _weighted_degree[cur_node] += e.weight;
-        _edges[_adj_array[cur_node] + pos++] = e;
-      }
-    }
+    // Hypernodes and hyperedges are processed together, each one only writes
+    // its own part of the adjacency array.
+    forEachChunk(hypernodes.size() + hyperedges.size(), [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          size_t pos = 0;
+          if (i < hypernodes.size()) {
+            const HypernodeID hn = hypernodes[i];
+            const NodeID graph_node = _hypernode_mapping[hn];
+            for (const HyperedgeID& he : hg.incidentEdges(hn)) {
+              Edge e;
+              e.target_node = _hypernode_mapping[num_nodes + he];
+              e.weight = edgeWeight(hg, he, hn);
+              _weighted_degree[graph_node] += e.weight;
+              _edges[_adj_array[graph_node] + pos++] = e;
+            }
+          } else {
+            const HyperedgeID he = hyperedges[i - hypernodes.size()];
+            const NodeID cur_node = _hypernode_mapping[num_nodes + he];
+            for (const HypernodeID& hn : hg.pins(he)) {
+              Edge e;
+              e.target_node = _hypernode_mapping[hn];
+              e.weight = edgeWeight(hg, he, hn);
+              _weighted_degree[cur_node] += e.weight;
+              _edges[_adj_array[cur_node] + pos++] = e;
+            }
+          }
+        }
+      });
+    computeTotalWeight();
 
 
     ASSERT([&]() {
@@ -817,6 +934,7 @@ class Graph {
   std::vector<IncidentClusterWeight> _incident_cluster_weight;
   SparseMap<ClusterID, size_t> _incident_cluster_weight_position;
   std::vector<NodeID> _hypernode_mapping;
+  ThreadPool* _pool;
 };
 
 constexpr NodeID Graph::kInvalidNode;
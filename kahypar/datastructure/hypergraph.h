@@ -36,6 +36,9 @@
 
 #include "kahypar/datastructure/connectivity_sets.h"
 #include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/hypergraph_layout.h"
+#include "kahypar/datastructure/metrics_tracker.h"
+#include "kahypar/datastructure/pin_count_in_part.h"
 #include "kahypar/datastructure/sparse_set.h"
 #include "kahypar/macros.h"
 #include "kahypar/meta/empty.h"
@@ -80,6 +83,10 @@ Iterator end(const std::pair<Iterator, Iterator>& x) {
  * \tparam PartitionIDType_ The data type used for block ids
  * \tparam HypernodeData_ Additional data that should be available for each hypernode
  * \tparam HyperedgeData_ Additional data that should be available for each hyperedge
+ * \tparam PinCountInPart_ Data structure used to store the number of pins of each net in
+ * each block (see DensePinCountInPart and SparsePinCountInPart)
+ * \tparam Layout_ Memory layout of hypernodes and hyperedges (see ArrayOfStructsLayout
+ * and StructOfArraysLayout)
  *
  */
 template <typename HypernodeType_ = Mandatory,
@@ -88,7 +95,9 @@ template <typename HypernodeType_ = Mandatory,
           typename HyperedgeWeightType_ = Mandatory,
           typename PartitionIDType_ = Mandatory,
           class HypernodeData_ = meta::Empty,
-          class HyperedgeData_ = meta::Empty>
+          class HyperedgeData_ = meta::Empty,
+          template <typename, typename, typename> class PinCountInPart_ = DensePinCountInPart,
+          class Layout_ = ArrayOfStructsLayout>
 class GenericHypergraph {
  private:
   static constexpr bool debug = false;
@@ -102,48 +111,32 @@ class GenericHypergraph {
   using HyperedgeWeight = HyperedgeWeightType_;
   using HypernodeData = HypernodeData_;
   using HyperedgeData = HyperedgeData_;
+  using PinCountInPart = PinCountInPart_<HypernodeID, HyperedgeID, PartitionID>;
+  using Layout = Layout_;
 
   // seed for edge hashes used for parallel net detection
-  static constexpr size_t kEdgeHashSeed = 42;
+  static constexpr size_t kEdgeHashSeed = kHyperedgeHashSeed;
 
- private:
   /*!
-   * Hypernode traits defining the data types
-   * used to store the weight and the id of a hypernode
+   * Interface for data structures that derive information from the connectivity
+   * sets of the hyperedges (e.g. the quotient graph used by flow-based refinement).
+   * The observer is notified whenever a hyperedge gets its first pin in a block.
+   * Hyperedges that lose a block are not reported, observers have to detect this
+   * lazily via pinCountInPart.
    */
-  struct HypernodeTraits {
-    using WeightType = HypernodeWeight;
-    using IDType = HypernodeID;
-  };
-
-  /*!
-   * Hyperedge traits defining the data types
-   * used to store the weight and the id of a hyperedge
-   */
-  struct HyperedgeTraits {
-    using WeightType = HyperedgeWeight;
-    using IDType = HyperedgeID;
-  };
-
-  // ! Additional information stored at each hyperedge
-  struct AdditionalHyperedgeData : public HyperedgeData {
-    // ! Cardinality \f$ \lambda(e) \f$ of the connectivity set,
-    // ! i.e., number of blocks net \f$e\f$ is connected to
-    PartitionID connectivity = 0;
-    // ! Fingerprint that will be used for parallel net detection
-    size_t hash = kEdgeHashSeed;
-  };
-
-  // ! Additional information stored at each hypernode \f$v\f$
-  struct AdditionalHypernodeData : public HypernodeData {
-    // ! Block \f$b[v]\f$ of the hypernode \f$v\f$
-    PartitionID part_id = kInvalidPartition;
-    // ! Number of nets \f$e \in I(v)\f$ with \f$\lambda(e) > 1 \f$
-    HyperedgeID num_incident_cut_hes = 0;
-    // ! State during local search: inactive/active/marked
-    uint32_t state = 0;
+  class ConnectivityObserver {
+ public:
+    ConnectivityObserver() = default;
+    ConnectivityObserver(const ConnectivityObserver&) = default;
+    ConnectivityObserver& operator= (const ConnectivityObserver&) = default;
+    ConnectivityObserver(ConnectivityObserver&&) = default;
+    ConnectivityObserver& operator= (ConnectivityObserver&&) = default;
+    virtual ~ConnectivityObserver() = default;
+
+    virtual void blockAddedToConnectivitySet(const HyperedgeID he, const PartitionID block) = 0;
   };
 
+ private:
   // ! A dummy data structure that is used in GenericHypergraph::changeNodePart
   // ! for algorithms that do not need non-border-node detection.
   class Dummy {
@@ -154,205 +147,7 @@ class GenericHypergraph {
   };
 
   // ! Constant to denote invalid partition pin counts.
-  static constexpr HypernodeID kInvalidCount = std::numeric_limits<HypernodeID>::max();
-
-  template <typename ElementTypeTraits, class HypergraphElementData>
-  class Vertex : public HypergraphElementData {
- public:
-    using WeightType = typename ElementTypeTraits::WeightType;
-    using IDType = typename ElementTypeTraits::IDType;
-
-    /*!
-     * Constructs a hypernode
-     * \param weight The weight of the hypernode/hyperedge
-     */
-    explicit Vertex(const WeightType weight) :
-      _incident_nets(),
-      _weight(weight) { }
-
-    Vertex() :
-      _incident_nets(),
-      _weight(1) { }
-
-    Vertex(const Vertex&) = default;
-    Vertex& operator= (const Vertex&) = default;
-
-    Vertex(Vertex&&) = default;
-    Vertex& operator= (Vertex&&) = default;
-
-    ~Vertex() = default;
-
-    // ! Disables the hypernode/hyperedge. Disable hypernodes/hyperedges will be skipped
-    // ! when iterating over the set of all nodes/edges.
-    void disable() {
-      ASSERT(!isDisabled());
-      _valid = false;
-    }
-
-    bool isDisabled() const {
-      return _valid == false;
-    }
-
-    void enable() {
-      ASSERT(isDisabled());
-      _valid = true;
-    }
-
-    IDType size() const {
-      ASSERT(!isDisabled());
-      return _incident_nets.size();
-    }
-
-    WeightType weight() const {
-      ASSERT(!isDisabled());
-      return _weight;
-    }
-
-    std::vector<HyperedgeID> & incidentNets() {
-      return _incident_nets;
-    }
-
-    const std::vector<HyperedgeID> & incidentNets() const {
-      return _incident_nets;
-    }
-
-    void setWeight(WeightType weight) {
-      ASSERT(!isDisabled());
-      _weight = weight;
-    }
-
-    bool operator== (const Vertex& rhs) const {
-      return _incident_nets.size() == rhs._incident_nets.size() &&
-             _weight == rhs._weight &&
-             _valid == rhs._valid &&
-             std::is_permutation(_incident_nets.begin(),
-                                 _incident_nets.end(),
-                                 rhs._incident_nets.begin());
-    }
-
-    bool operator!= (const Vertex& rhs) const {
-      return !operator== (this, rhs);
-    }
-
- private:
-    std::vector<HyperedgeID> _incident_nets;
-    // ! Hypernode/Hyperedge weight
-    WeightType _weight = 1;
-    // ! Flag indicating whether or not the element is active.
-    bool _valid = true;
-  };
-
-
-  template <typename ElementTypeTraits, class HypergraphElementData>
-  class HyperEdge : public HypergraphElementData {
- public:
-    using WeightType = typename ElementTypeTraits::WeightType;
-    using IDType = typename ElementTypeTraits::IDType;
-
-    /*!
-     * Constructs a hyperedge.
-     * \param begin The incidence information starts at _incidence_array[begin]
-     * \param size  The number of incident nets (for hypernodes), the number of pins (for hyperedges)
-     * \param weight The weight of the hypernode/hyperedge
-     */
-    HyperEdge(const IDType begin, const IDType size,
-              const WeightType weight) :
-      _begin(begin),
-      _size(size),
-      _weight(weight) { }
-
-    HyperEdge() = default;
-
-    HyperEdge(const HyperEdge&) = default;
-    HyperEdge& operator= (const HyperEdge&) = default;
-
-    HyperEdge(HyperEdge&&) = default;
-    HyperEdge& operator= (HyperEdge&&) = default;
-
-    ~HyperEdge() = default;
-
-    // ! Disables the hypernode/hyperedge. Disable hypernodes/hyperedges will be skipped
-    // ! when iterating over the set of all nodes/edges.
-    void disable() {
-      ASSERT(!isDisabled());
-      _valid = false;
-    }
-
-    bool isDisabled() const {
-      return _valid == false;
-    }
-
-    void enable() {
-      ASSERT(isDisabled());
-      _valid = true;
-    }
-
-    // ! Returns the index of the first element in _incidence_array
-    IDType firstEntry() const {
-      return _begin;
-    }
-
-    // ! Sets the index of the first element in _incidence_array to begin
-    void setFirstEntry(IDType begin) {
-      ASSERT(!isDisabled());
-      _begin = begin;
-      _valid = true;
-    }
-
-    // ! Returns the index of the first element in _incidence_array
-    IDType firstInvalidEntry() const {
-      return _begin + _size;
-    }
-
-    IDType size() const {
-      ASSERT(!isDisabled());
-      return _size;
-    }
-
-    void setSize(IDType size) {
-      ASSERT(!isDisabled());
-      _size = size;
-    }
-
-    void incrementSize() {
-      ASSERT(!isDisabled());
-      ++_size;
-    }
-
-    void decrementSize() {
-      ASSERT(!isDisabled());
-      ASSERT(_size > 0);
-      --_size;
-    }
-
-    WeightType weight() const {
-      ASSERT(!isDisabled());
-      return _weight;
-    }
-
-    void setWeight(WeightType weight) {
-      ASSERT(!isDisabled());
-      _weight = weight;
-    }
-
-    bool operator== (const HyperEdge& rhs) const {
-      return _begin == rhs._begin && _size == rhs._size && _weight == rhs._weight;
-    }
-
-    bool operator!= (const HyperEdge& rhs) const {
-      return !operator== (this, rhs);
-    }
-
- private:
-    // ! Index of the first element in _incidence_array
-    IDType _begin = 0;
-    // ! Number of _incidence_array elements
-    IDType _size = 0;
-    // ! Hypernode/Hyperedge weight
-    WeightType _weight = 1;
-    // ! Flag indicating whether or not the element is active.
-    bool _valid = true;
-  };
+  static constexpr HypernodeID kInvalidCount = PinCountInPart::kInvalidCount;
 
   /*!
    * Iterator for HypergraphElements (Hypernodes/Hyperedges)
@@ -371,14 +166,13 @@ class GenericHypergraph {
    * hypernodes/hyperedges.
    *
    */
-  template <typename ElementType>
+  template <typename IDType, typename Elements>
   class HypergraphElementIterator :
     public std::iterator<std::forward_iterator_tag,    // iterator_category
-                         typename ElementType::IDType,   // value_type
+                         IDType,   // value_type
                          std::ptrdiff_t,   // difference_type
-                         const typename ElementType::IDType*,   // pointer
-                         typename ElementType::IDType>{   // reference
-    using IDType = typename ElementType::IDType;
+                         const IDType*,   // pointer
+                         IDType>{   // reference
 
  public:
     HypergraphElementIterator() = default;
@@ -395,18 +189,18 @@ class GenericHypergraph {
      * Construct a HypergraphElementIterator
      * See GenericHypergraph::nodes() or GenericHypergraph::edges() for usage.
      *
-     * If start_element is invalid, the iterator advances to the first valid
+     * If element id is invalid, the iterator advances to the first valid
      * element.
      *
-     * \param start_element A pointer to the starting position
-     * \param id The index of the element the pointer points to
+     * \param elements The hypernodes/hyperedges of the hypergraph
+     * \param id The index of the starting position
      * \param max_id The maximum index allowed
      */
-    HypergraphElementIterator(const ElementType* start_element, IDType id, IDType max_id) :
+    HypergraphElementIterator(const Elements* elements, IDType id, IDType max_id) :
       _id(id),
       _max_id(max_id),
-      _element(start_element) {
-      if (_id != _max_id && _element->isDisabled()) {
+      _elements(elements) {
+      if (_id != _max_id && _elements->isDisabled(_id)) {
         operator++ ();
       }
     }
@@ -421,8 +215,7 @@ class GenericHypergraph {
       ASSERT(_id < _max_id);
       do {
         ++_id;
-        ++_element;
-      } while (_id < _max_id && _element->isDisabled());
+      } while (_id < _max_id && _elements->isDisabled(_id));
       return *this;
     }
 
@@ -454,17 +247,19 @@ class GenericHypergraph {
     IDType _id = 0;
     // Maximum allowed index
     const IDType _max_id = 0;
-    // HypergraphElement the iterator currently points to
-    const ElementType* _element = nullptr;
+    // Hypernodes/Hyperedges the iterator iterates over
+    const Elements* _elements = nullptr;
   };
 
 
   // ! The data type used to incident nets of vertices and pins of nets
   using VertexID = uint32_t;
-  // ! The data type for hypernodes
-  using Hypernode = Vertex<HypernodeTraits, AdditionalHypernodeData>;
-  // ! The data type for hyperedges
-  using Hyperedge = HyperEdge<HyperedgeTraits, AdditionalHyperedgeData>;
+  // ! The storage of all hypernodes
+  using Hypernodes = typename Layout::template Hypernodes<HypernodeID, HyperedgeID, HypernodeWeight,
+                                                          PartitionID, HypernodeData>;
+  // ! The storage of all hyperedges
+  using Hyperedges = typename Layout::template Hyperedges<HyperedgeID, HyperedgeWeight,
+                                                          PartitionID, HyperedgeData>;
   // ! Iterator that is internally used to iterate over pins of nets and incident edges of vertices.
   using PinHandleIterator = typename std::vector<VertexID>::iterator;
 
@@ -530,9 +325,9 @@ class GenericHypergraph {
   // ! the set of pins of a hyperedge
   using IncidenceIterator = typename std::vector<VertexID>::const_iterator;
   // ! Iterator to iterator over the hypernodes
-  using HypernodeIterator = HypergraphElementIterator<const Hypernode>;
+  using HypernodeIterator = HypergraphElementIterator<HypernodeID, Hypernodes>;
   // ! Iterator to iterator over the hyperedges
-  using HyperedgeIterator = HypergraphElementIterator<const Hyperedge>;
+  using HyperedgeIterator = HypergraphElementIterator<HyperedgeID, Hyperedges>;
 
   // ! An invalid block has id kInvalidPartition
   enum { kInvalidPartition = -1 };
@@ -619,15 +414,17 @@ class GenericHypergraph {
     _current_num_pins(_num_pins),
     _threshold_active(1),
     _threshold_marked(2),
-    _hypernodes(_num_hypernodes, Hypernode(1)),
-    _hyperedges(_num_hyperedges, Hyperedge(0, 0, 1)),
+    _hypernodes(_num_hypernodes),
+    _hyperedges(_num_hyperedges),
     _incidence_array(_num_pins, 0),
     _communities(_num_hypernodes, 0),
     _fixed_vertices(nullptr),
     _fixed_vertex_part_id(),
     _part_info(_k),
-    _pins_in_part(static_cast<size_t>(_num_hyperedges) * k),
+    _pins_in_part(),
     _connectivity_sets(_num_hyperedges),
+    _connectivity_observer(nullptr),
+    _metrics_tracker(),
     _hes_not_containing_u(_num_hyperedges) {
     VertexID edge_vector_index = 0;
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
@@ -635,7 +432,7 @@ class GenericHypergraph {
       for (VertexID pin_index = index_vector[i];
            pin_index < index_vector[static_cast<size_t>(i) + 1]; ++pin_index) {
         hyperedge(i).incrementSize();
-        hyperedge(i).hash += math::hash(edge_vector[pin_index]);
+        hyperedge(i).hash() += math::hash(edge_vector[pin_index]);
         _incidence_array[pin_index] = edge_vector[pin_index];
         ++edge_vector_index;
       }
@@ -649,6 +446,8 @@ class GenericHypergraph {
       }
     }
 
+    initializePinCountInPart();
+
     // sentinel for peeks during uncontraction
     if (num_hyperedges == 0) {
       _hyperedges.emplace_back(0, 0, 0);
@@ -706,6 +505,8 @@ class GenericHypergraph {
     _part_info(_k),
     _pins_in_part(),
     _connectivity_sets(),
+    _connectivity_observer(nullptr),
+    _metrics_tracker(),
     _hes_not_containing_u() { }
 
   GenericHypergraph(GenericHypergraph&&) = default;
@@ -825,7 +626,7 @@ class GenericHypergraph {
   void printNodeState(const HypernodeID u) const {
     if (!hypernode(u).isDisabled()) {
       LOG << "HN" << u << "(w=" << nodeWeight(u)
-          << "block=" << hypernode(u).part_id << "): ";
+          << "block=" << hypernode(u).partID() << "): ";
       for (const HyperedgeID& he : incidentEdges(u)) {
         LLOG << he;
       }
@@ -855,9 +656,8 @@ class GenericHypergraph {
    * iterates over all _num_hypernodes hypernodes.
    */
   std::pair<HypernodeIterator, HypernodeIterator> nodes() const {
-    return std::make_pair(HypernodeIterator(_hypernodes.data(), 0, _num_hypernodes),
-                          HypernodeIterator((_hypernodes.data() + _num_hypernodes),
-                                            _num_hypernodes, _num_hypernodes));
+    return std::make_pair(HypernodeIterator(&_hypernodes, 0, _num_hypernodes),
+                          HypernodeIterator(&_hypernodes, _num_hypernodes, _num_hypernodes));
   }
 
   /*!
@@ -866,9 +666,8 @@ class GenericHypergraph {
    * iterates over all _num_hyperedges hyperedges.
    */
   std::pair<HyperedgeIterator, HyperedgeIterator> edges() const {
-    return std::make_pair(HyperedgeIterator(_hyperedges.data(), 0, _num_hyperedges),
-                          HyperedgeIterator((_hyperedges.data() + _num_hyperedges),
-                                            _num_hyperedges, _num_hyperedges));
+    return std::make_pair(HyperedgeIterator(&_hyperedges, 0, _num_hyperedges),
+                          HyperedgeIterator(&_hyperedges, _num_hyperedges, _num_hyperedges));
   }
 
   /*!
@@ -1019,7 +818,7 @@ class GenericHypergraph {
                                                   << "(while uncontracting: (" << memento.u << "," << memento.v << "))");
 
           if (connectivity(he) > 1) {
-            ++hypernode(memento.v).num_incident_cut_hes;     // because v is connected to that cut HE
+            ++hypernode(memento.v).numIncidentCutHEs();     // because v is connected to that cut HE
           }
 
           // Either the HE could have been removed from the cut before the move, or the HE
@@ -1042,8 +841,8 @@ class GenericHypergraph {
           resetReusedPinSlotToOriginalValue(he, memento);
 
           if (connectivity(he) > 1) {
-            --hypernode(memento.u).num_incident_cut_hes;    // because u is not connected to that cut HE anymore
-            ++hypernode(memento.v).num_incident_cut_hes;    // because v is connected to that cut HE
+            --hypernode(memento.u).numIncidentCutHEs();    // because u is not connected to that cut HE anymore
+            ++hypernode(memento.v).numIncidentCutHEs();    // because v is connected to that cut HE
             // because after uncontraction, u is not connected to that HE anymore
             changes_u -= pinCountInPart(he, partID(memento.u)) == 1 ? edgeWeight(he) : 0;
           } else {
@@ -1070,11 +869,11 @@ class GenericHypergraph {
     }
     restoreRepresentative(memento);
 
-    ASSERT(hypernode(memento.u).num_incident_cut_hes == numIncidentCutHEs(memento.u),
-           V(memento.u) << V(hypernode(memento.u).num_incident_cut_hes)
+    ASSERT(hypernode(memento.u).numIncidentCutHEs() == numIncidentCutHEs(memento.u),
+           V(memento.u) << V(hypernode(memento.u).numIncidentCutHEs())
                         << V(numIncidentCutHEs(memento.u)));
-    ASSERT(hypernode(memento.v).num_incident_cut_hes == numIncidentCutHEs(memento.v),
-           V(memento.v) << V(hypernode(memento.v).num_incident_cut_hes)
+    ASSERT(hypernode(memento.v).numIncidentCutHEs() == numIncidentCutHEs(memento.v),
+           V(memento.v) << V(hypernode(memento.v).numIncidentCutHEs())
                         << V(numIncidentCutHEs(memento.v)));
   }
 
@@ -1113,7 +912,7 @@ class GenericHypergraph {
                                                   << "(while uncontracting: (" << memento.u << "," << memento.v << "))");
 
           if (connectivity(he) > 1) {
-            ++hypernode(memento.v).num_incident_cut_hes;     // because v is connected to that cut HE
+            ++hypernode(memento.v).numIncidentCutHEs();     // because v is connected to that cut HE
           }
 
           ++_current_num_pins;
@@ -1130,25 +929,25 @@ class GenericHypergraph {
           resetReusedPinSlotToOriginalValue(he, memento);
 
           if (connectivity(he) > 1) {
-            --hypernode(memento.u).num_incident_cut_hes;    // because u is not connected to that cut HE anymore
-            ++hypernode(memento.v).num_incident_cut_hes;    // because v is connected to that cut HE
+            --hypernode(memento.u).numIncidentCutHEs();    // because u is not connected to that cut HE anymore
+            ++hypernode(memento.v).numIncidentCutHEs();    // because v is connected to that cut HE
           }
         }
       }
     }
     restoreRepresentative(memento);
 
-    ASSERT(hypernode(memento.u).num_incident_cut_hes == numIncidentCutHEs(memento.u),
-           V(memento.u) << V(hypernode(memento.u).num_incident_cut_hes) << V(numIncidentCutHEs(memento.u)));
-    ASSERT(hypernode(memento.v).num_incident_cut_hes == numIncidentCutHEs(memento.v),
-           V(memento.v) << V(hypernode(memento.v).num_incident_cut_hes) << V(numIncidentCutHEs(memento.v)));
+    ASSERT(hypernode(memento.u).numIncidentCutHEs() == numIncidentCutHEs(memento.u),
+           V(memento.u) << V(hypernode(memento.u).numIncidentCutHEs()) << V(numIncidentCutHEs(memento.u)));
+    ASSERT(hypernode(memento.v).numIncidentCutHEs() == numIncidentCutHEs(memento.v),
+           V(memento.v) << V(hypernode(memento.v).numIncidentCutHEs()) << V(numIncidentCutHEs(memento.v)));
   }
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void restoreMemento(const Memento& memento) {
     DBG << "uncontracting (" << memento.u << "," << memento.v << ")";
     hypernode(memento.v).enable();
     ++_current_num_hypernodes;
-    hypernode(memento.v).part_id = hypernode(memento.u).part_id;
+    hypernode(memento.v).partID() = hypernode(memento.u).partID();
     ++_part_info[partID(memento.u)].size;
     if (isFixedVertex(memento.u)) {
       if (!isFixedVertex(memento.v)) {
@@ -1206,8 +1005,8 @@ class GenericHypergraph {
       if ((no_pins_left_in_source_part && !only_one_pin_in_to_part)) {
         if (pinCountInPart(he, to) == edgeSize(he)) {
           for (const HypernodeID& pin : pins(he)) {
-            --hypernode(pin).num_incident_cut_hes;
-            if (hypernode(pin).num_incident_cut_hes == 0) {
+            --hypernode(pin).numIncidentCutHEs();
+            if (hypernode(pin).numIncidentCutHEs() == 0) {
               // ASSERT(std::find(non_border_hns_to_remove.cbegin(),
               //                  non_border_hns_to_remove.cend(), pin) ==
               //        non_border_hns_to_remove.end(),
@@ -1220,7 +1019,7 @@ class GenericHypergraph {
                  only_one_pin_in_to_part &&
                  pinCountInPart(he, from) == edgeSize(he) - 1) {
         for (const HypernodeID& pin : pins(he)) {
-          ++hypernode(pin).num_incident_cut_hes;
+          ++hypernode(pin).numIncidentCutHEs();
         }
       }
       /**ASSERT([&]() -> bool {
@@ -1236,12 +1035,12 @@ class GenericHypergraph {
     //    for (const HyperedgeID he : incidentEdges(hn)) {
     //    for (const HypernodeID pin : pins(he)) {
     //      if (pin == 1891) {
-    //        LOG << V(hypernode(pin).num_incident_cut_hes);
+    //        LOG << V(hypernode(pin).numIncidentCutHEs());
     //      }
 
-    //    if (hypernode(pin).num_incident_cut_hes != numIncidentCutHEs(pin)) {
+    //    if (hypernode(pin).numIncidentCutHEs() != numIncidentCutHEs(pin)) {
     //    LOG << V(pin);
-    //    LOG << V(hypernode(pin).num_incident_cut_hes);
+    //    LOG << V(hypernode(pin).numIncidentCutHEs());
     //    LOG << V(numIncidentCutHEs(pin));
     //    return false;
     //    }
@@ -1254,9 +1053,9 @@ class GenericHypergraph {
   // ! Returns true if the hypernode is incident to at least one hyperedge connecting multiple blocks
   bool isBorderNode(const HypernodeID hn) const {
     ASSERT(!hypernode(hn).isDisabled(), "Hypernode" << hn << "is disabled");
-    ASSERT(hypernode(hn).num_incident_cut_hes == numIncidentCutHEs(hn), V(hn));
-    ASSERT((hypernode(hn).num_incident_cut_hes > 0) == isBorderNodeInternal(hn), V(hn));
-    return hypernode(hn).num_incident_cut_hes > 0;
+    ASSERT(hypernode(hn).numIncidentCutHEs() == numIncidentCutHEs(hn), V(hn));
+    ASSERT((hypernode(hn).numIncidentCutHEs() > 0) == isBorderNodeInternal(hn), V(hn));
+    return hypernode(hn).numIncidentCutHEs() > 0;
   }
 
 
@@ -1393,7 +1192,7 @@ class GenericHypergraph {
       }
 
       if (connectivity(old_representative) > 1) {
-        ++hypernode(pin).num_incident_cut_hes;
+        ++hypernode(pin).numIncidentCutHEs();
       }
       ++_current_num_pins;
     }
@@ -1402,15 +1201,16 @@ class GenericHypergraph {
   // ! Resets all partitioning related information
   void resetPartitioning() {
     for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
-      hypernode(i).part_id = kInvalidPartition;
-      hypernode(i).num_incident_cut_hes = 0;
+      hypernode(i).partID() = kInvalidPartition;
+      hypernode(i).numIncidentCutHEs() = 0;
     }
     std::fill(_part_info.begin(), _part_info.end(), PartInfo());
-    std::fill(_pins_in_part.begin(), _pins_in_part.end(), 0);
+    _pins_in_part.reset();
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
-      hyperedge(i).connectivity = 0;
+      hyperedge(i).connectivity() = 0;
       _connectivity_sets[i].clear();
     }
+    _metrics_tracker.reset();
     // Recalculate fixed vertex part weights
     HyperedgeWeight fixed_vertex_weight = 0;
     for (const HypernodeID& hn : fixedVertices()) {
@@ -1432,13 +1232,13 @@ class GenericHypergraph {
     resetPartitioning();
     std::fill(_communities.begin(), _communities.end(), 0);
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
-      hyperedge(i).hash = kEdgeHashSeed;
+      hyperedge(i).hash() = kEdgeHashSeed;
       // not using pins(i) because it contains an assertion for hyperedge validity
       auto pins_begin = _incidence_array.cbegin() + hyperedge(i).firstEntry();
       const auto pins_end = _incidence_array.cbegin() + hyperedge(i).firstInvalidEntry();
       for ( ; pins_begin != pins_end; ++pins_begin) {
         const auto pin = *pins_begin;
-        hyperedge(i).hash += math::hash(pin);
+        hyperedge(i).hash() += math::hash(pin);
       }
     }
   }
@@ -1465,11 +1265,19 @@ class GenericHypergraph {
   // internal data structures accordingly.
   void changeK(const PartitionID k) {
     _k = k;
-    _pins_in_part.resize(static_cast<size_t>(_num_hyperedges) * k, 0);
+    initializePinCountInPart();
     _part_info.resize(k, PartInfo());
     _connectivity_sets.resize(_num_hyperedges);
   }
 
+  // ! Registers the observer that is notified about blocks added to connectivity sets.
+  // ! Passing nullptr unregisters the current observer.
+  void setConnectivityObserver(ConnectivityObserver* observer) {
+    ASSERT(observer == nullptr || _connectivity_observer == nullptr ||
+           _connectivity_observer == observer, "Only one connectivity observer is supported");
+    _connectivity_observer = observer;
+  }
+
   void setType(const Type type) {
     _type = type;
   }
@@ -1490,7 +1298,7 @@ class GenericHypergraph {
 
   size_t & edgeHash(const HyperedgeID e) {
     ASSERT(!hyperedge(e).isDisabled(), "Hyperedge" << e << "is disabled");
-    return hyperedge(e).hash;
+    return hyperedge(e).hash();
   }
 
   HypernodeWeight nodeWeight(const HypernodeID u) const {
@@ -1512,12 +1320,13 @@ class GenericHypergraph {
 
   void setEdgeWeight(const HyperedgeID e, const HyperedgeWeight weight) {
     ASSERT(!hyperedge(e).isDisabled(), "Hyperedge" << e << "is disabled");
+    _metrics_tracker.changeWeight(hyperedge(e).weight(), weight, hyperedge(e).connectivity());
     hyperedge(e).setWeight(weight);
   }
 
   PartitionID partID(const HypernodeID u) const {
     ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
-    return hypernode(u).part_id;
+    return hypernode(u).partID();
   }
 
   PartitionID fixedVertexPartID(const HypernodeID u) const {
@@ -1644,42 +1453,42 @@ class GenericHypergraph {
 
   // ! Returns true if the hypernode is marked as active.
   bool active(const HypernodeID u) const {
-    return hypernode(u).state == _threshold_active;
+    return hypernode(u).state() == _threshold_active;
   }
 
   // ! Returns true if the hypernode is marked as marked.
   bool marked(const HypernodeID u) const {
-    return hypernode(u).state == _threshold_marked;
+    return hypernode(u).state() == _threshold_marked;
   }
 
   // ! Marks hypernode as marked.
   void mark(const HypernodeID u) {
-    ASSERT(hypernode(u).state == _threshold_active, V(u));
-    hypernode(u).state = _threshold_marked;
+    ASSERT(hypernode(u).state() == _threshold_active, V(u));
+    hypernode(u).state() = _threshold_marked;
   }
 
   // ! Marks hypernode as rebalanced
   void markRebalanced(const HypernodeID u) {
-    hypernode(u).state = _threshold_marked;
+    hypernode(u).state() = _threshold_marked;
   }
 
   // ! Marks hypernode as active
   void activate(const HypernodeID u) {
-    ASSERT(hypernode(u).state < _threshold_active, V(u));
-    hypernode(u).state = _threshold_active;
+    ASSERT(hypernode(u).state() < _threshold_active, V(u));
+    hypernode(u).state() = _threshold_active;
   }
 
   // ! Marks hypernode as inactive
   void deactivate(const HypernodeID u) {
-    ASSERT(hypernode(u).state == _threshold_active, V(u));
-    --hypernode(u).state;
+    ASSERT(hypernode(u).state() == _threshold_active, V(u));
+    --hypernode(u).state();
   }
 
   // ! Resets the state of all hypernodes to inactive and unmarked.
   void resetHypernodeState() {
     if (_threshold_marked == std::numeric_limits<uint32_t>::max()) {
       for (HypernodeID hn = 0; hn < _num_hypernodes; ++hn) {
-        hypernode(hn).state = 0;
+        hypernode(hn).state() = 0;
       }
       _threshold_active = -2;
       _threshold_marked = -1;
@@ -1698,12 +1507,12 @@ class GenericHypergraph {
     // results. Since hypernodes might be disabled, we bypass assertion in
     // hypernode(.) here and directly access _hypernodes.
     for (HypernodeID hn = 0; hn < _num_hypernodes; ++hn) {
-      _hypernodes[hn].num_incident_cut_hes = 0;
+      _hypernodes[hn].numIncidentCutHEs() = 0;
     }
     for (const HyperedgeID& he : edges()) {
       if (connectivity(he) > 1) {
         for (const HypernodeID& pin : pins(he)) {
-          ++hypernode(pin).num_incident_cut_hes;
+          ++hypernode(pin).numIncidentCutHEs();
         }
       }
     }
@@ -1722,8 +1531,8 @@ class GenericHypergraph {
   HypernodeID pinCountInPart(const HyperedgeID he, const PartitionID id) const {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge" << he << "is disabled");
     ASSERT(id < _k && id != kInvalidPartition, "Partition ID" << id << "is out of bounds");
-    ASSERT(_pins_in_part[static_cast<size_t>(he) * _k + id] != kInvalidCount, V(he) << V(id));
-    return _pins_in_part[static_cast<size_t>(he) * _k + id];
+    ASSERT(_pins_in_part.get(he, id) != kInvalidCount, V(he) << V(id));
+    return _pins_in_part.get(he, id);
   }
 
   bool inPart(const HypernodeID hn, const PartitionID b) const {
@@ -1741,7 +1550,7 @@ class GenericHypergraph {
   // ! Returns the number of blocks a hyperedge connects
   PartitionID connectivity(const HyperedgeID he) const {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge" << he << "is disabled");
-    return hyperedge(he).connectivity;
+    return hyperedge(he).connectivity();
   }
 
   // ! Returns a reference to the partitioning information of all blocks
@@ -1754,6 +1563,21 @@ class GenericHypergraph {
     return _total_weight;
   }
 
+  // ! Returns the total weight of all cut hyperedges
+  HyperedgeWeight cut() const {
+    return _metrics_tracker.cut();
+  }
+
+  // ! Returns the sum of (connectivity - 1) * weight over all hyperedges
+  HyperedgeWeight km1() const {
+    return _metrics_tracker.km1();
+  }
+
+  // ! Returns the sum of connectivity * weight over all cut hyperedges
+  HyperedgeWeight soed() const {
+    return _metrics_tracker.soed();
+  }
+
   // ! Returns the sum of the weights of all fixed vertices
   HypernodeWeight fixedVertexTotalWeight() const {
     return _fixed_vertex_total_weight;
@@ -1776,9 +1600,9 @@ class GenericHypergraph {
 
   void resetEdgeHashes() {
     for (const HyperedgeID& he : edges()) {
-      hyperedge(he).hash = kEdgeHashSeed;
+      hyperedge(he).hash() = kEdgeHashSeed;
       for (const HypernodeID& pin : pins(he)) {
-        hyperedge(he).hash += math::hash(pin);
+        hyperedge(he).hash() += math::hash(pin);
       }
     }
   }
@@ -1805,13 +1629,13 @@ class GenericHypergraph {
   // ! Returns a reference to additional data stored on a hypernode
   HypernodeData & hypernodeData(const HypernodeID hn) {
     ASSERT(!hypernode(hn).isDisabled(), "Hypernode" << hn << "is disabled");
-    return hypernode(hn);
+    return hypernode(hn).data();
   }
 
   // ! Returns a reference to additional data stored on a hyperedge
   HyperedgeData & hyperedgeData(const HyperedgeID he) {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge" << he << "is disabled");
-    return hyperedge(he);
+    return hyperedge(he).data();
   }
 
  private:
@@ -1868,8 +1692,8 @@ class GenericHypergraph {
   void updatePartInfo(const HypernodeID u, const PartitionID id) {
     ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
     ASSERT(id < _k && id != kInvalidPartition, "Part ID" << id << "out of bounds!");
-    ASSERT(hypernode(u).part_id == kInvalidPartition, "HN" << u << "is already assigned to part" << id);
-    hypernode(u).part_id = id;
+    ASSERT(hypernode(u).partID() == kInvalidPartition, "HN" << u << "is already assigned to part" << id);
+    hypernode(u).partID() = id;
     _part_info[id].weight += nodeWeight(u);
     ++_part_info[id].size;
   }
@@ -1879,8 +1703,8 @@ class GenericHypergraph {
     ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
     ASSERT(from < _k && from != kInvalidPartition, "Part ID" << from << "out of bounds!");
     ASSERT(to < _k && to != kInvalidPartition, "Part ID" << to << "out of bounds!");
-    ASSERT(hypernode(u).part_id == from, "HN" << u << "is not in part" << from);
-    hypernode(u).part_id = to;
+    ASSERT(hypernode(u).partID() == from, "HN" << u << "is not in part" << from);
+    hypernode(u).partID() = to;
     _part_info[from].weight -= nodeWeight(u);
     --_part_info[from].size;
     _part_info[to].weight += nodeWeight(u);
@@ -1893,13 +1717,12 @@ class GenericHypergraph {
     ASSERT(pinCountInPart(he, id) > 0,
            "HE" << he << "does not have any pins in partition" << id);
     ASSERT(id < _k && id != kInvalidPartition, "Part ID" << id << "out of bounds!");
-    ASSERT(_pins_in_part[static_cast<size_t>(he) * _k + id] > 0, "invalid decrease");
-    const size_t offset = static_cast<size_t>(he) * _k + id;
-    _pins_in_part[offset] -= 1;
-    const bool connectivity_decreased = _pins_in_part[offset] == 0;
+    const bool connectivity_decreased = _pins_in_part.decrement(he, id) == 0;
     if (connectivity_decreased) {
       _connectivity_sets[he].remove(id);
-      hyperedge(he).connectivity -= 1;
+      hyperedge(he).connectivity() -= 1;
+      _metrics_tracker.changeConnectivity(hyperedge(he).weight(), hyperedge(he).connectivity() + 1,
+                                          hyperedge(he).connectivity());
     }
     return connectivity_decreased;
   }
@@ -1911,12 +1734,15 @@ class GenericHypergraph {
            "HE" << he << ": pin_count[" << id << "]=" << pinCountInPart(he, id)
                 << "edgesize=" << edgeSize(he));
     ASSERT(id < _k && id != kInvalidPartition, "Part ID" << id << "out of bounds!");
-    const size_t offset = static_cast<size_t>(he) * _k + id;
-    _pins_in_part[offset] += 1;
-    const bool connectivity_increased = _pins_in_part[offset] == 1;
+    const bool connectivity_increased = _pins_in_part.increment(he, id) == 1;
     if (connectivity_increased) {
-      hyperedge(he).connectivity += 1;
+      hyperedge(he).connectivity() += 1;
       _connectivity_sets[he].add(id);
+      _metrics_tracker.changeConnectivity(hyperedge(he).weight(), hyperedge(he).connectivity() - 1,
+                                          hyperedge(he).connectivity());
+      if (_connectivity_observer != nullptr) {
+        _connectivity_observer->blockAddedToConnectivitySet(he, id);
+      }
     }
     return connectivity_increased;
   }
@@ -1925,19 +1751,24 @@ class GenericHypergraph {
   void invalidatePartitionPinCounts(const HyperedgeID he) {
     ASSERT(hyperedge(he).isDisabled(),
            "Invalidation of pin counts only allowed for disabled hyperedges");
-    for (PartitionID part = 0; part < _k; ++part) {
-      _pins_in_part[static_cast<size_t>(he) * _k + part] = kInvalidCount;
-    }
-    hyperedge(he).connectivity = 0;
+    _pins_in_part.invalidate(he);
+    _metrics_tracker.remove(hyperedge(he).weight(), hyperedge(he).connectivity());
+    hyperedge(he).connectivity() = 0;
     _connectivity_sets[he].clear();
   }
 
   // ! Resets the number of pins in each block to zero.
   void resetPartitionPinCounts(const HyperedgeID he) {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge" << he << "is disabled");
-    for (PartitionID part = 0; part < _k; ++part) {
-      _pins_in_part[static_cast<size_t>(he) * _k + part] = 0;
-    }
+    _pins_in_part.reset(he);
+  }
+
+  // ! (Re-)initializes the pin counts of all nets. Nets never grow beyond
+  // ! the size they have at this point.
+  void initializePinCountInPart() {
+    _pins_in_part.initialize(_num_hyperedges, _k, [&](const HyperedgeID he) {
+        return _hyperedges[he].firstInvalidEntry() - _hyperedges[he].firstEntry();
+      });
   }
 
   void enableEdge(const HyperedgeID e) {
@@ -2013,7 +1844,7 @@ class GenericHypergraph {
    * GenericHypergraph::removeIncidentEdgeFromHypernode.
    */
   template <typename Handle1, typename Element>
-  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void removeIncidence(const Handle1 to_remove, Element& element) {
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void removeIncidence(const Handle1 to_remove, Element&& element) {
     using std::swap;
     ASSERT(!element.isDisabled());
 
@@ -2079,26 +1910,26 @@ class GenericHypergraph {
   }
 
   // ! Accessor for hypernode-related information
-  const Hypernode & hypernode(const HypernodeID u) const {
+  typename Hypernodes::ConstReference hypernode(const HypernodeID u) const {
     ASSERT(u < _num_hypernodes, "Hypernode" << u << "does not exist");
     return _hypernodes[u];
   }
 
   // ! Accessor for hyperedge-related information
-  const Hyperedge & hyperedge(const HyperedgeID e) const {
+  typename Hyperedges::ConstReference hyperedge(const HyperedgeID e) const {
     // <= instead of < because of sentinel
     ASSERT(e <= _num_hyperedges, "Hyperedge" << e << "does not exist");
     return _hyperedges[e];
   }
 
-  // ! To avoid code duplication we implement non-const version in terms of const version
-  Hypernode & hypernode(const HypernodeID u) {
-    return const_cast<Hypernode&>(static_cast<const GenericHypergraph&>(*this).hypernode(u));
+  typename Hypernodes::Reference hypernode(const HypernodeID u) {
+    ASSERT(u < _num_hypernodes, "Hypernode" << u << "does not exist");
+    return _hypernodes[u];
   }
 
-  // ! To avoid code duplication we implement non-const version in terms of const version
-  Hyperedge & hyperedge(const HyperedgeID e) {
-    return const_cast<Hyperedge&>(static_cast<const GenericHypergraph&>(*this).hyperedge(e));
+  typename Hyperedges::Reference hyperedge(const HyperedgeID e) {
+    ASSERT(e <= _num_hyperedges, "Hyperedge" << e << "does not exist");
+    return _hyperedges[e];
   }
 
   // ! Original number of hypernodes |V|
@@ -2129,9 +1960,9 @@ class GenericHypergraph {
   uint32_t _threshold_marked;
 
   // ! The hypernodes of the hypergraph
-  std::vector<Hypernode> _hypernodes;
+  Hypernodes _hypernodes;
   // ! The hyperedges of the hypergraph
-  std::vector<Hyperedge> _hyperedges;
+  Hyperedges _hyperedges;
   // ! Incidence structure containing the ids of of pins of all hyperedges
   // ! and the ids of the incident edges of all hypernodes.
   std::vector<VertexID> _incidence_array;
@@ -2146,9 +1977,13 @@ class GenericHypergraph {
   // ! Weight and size information for all blocks.
   std::vector<PartInfo> _part_info;
   // ! For each hyperedge and each block, _pins_in_part stores the number of pins in that block
-  std::vector<HypernodeID> _pins_in_part;
+  PinCountInPart _pins_in_part;
   // ! For each hyperedge, _connectivity_sets stores the blocks the hyperedge connects
   ConnectivitySets<PartitionID, HyperedgeID> _connectivity_sets;
+  // ! Optional observer that is notified about blocks added to connectivity sets
+  ConnectivityObserver* _connectivity_observer;
+  // ! Cut, (connectivity - 1) and soed metric of the current partition
+  MetricsTracker<HyperedgeWeight, PartitionID> _metrics_tracker;
 
   /*!
    * Used during uncontraction to decide how to perform the uncontraction operation.
@@ -2241,12 +2076,13 @@ bool verifyEquivalenceWithPartitionInfo(const Hypergraph& expected, const Hyperg
 
   ASSERT(expected._part_info == actual._part_info, "Error");
   ASSERT(expected._pins_in_part == actual._pins_in_part, "Error");
+  ASSERT(expected._metrics_tracker == actual._metrics_tracker, "Error");
   ASSERT(expected._communities == actual._communities, "Error");
 
   bool connectivity_sets_valid = true;
   for (const HyperedgeID& he : actual.edges()) {
-    ASSERT(expected.hyperedge(he).connectivity == actual.hyperedge(he).connectivity, V(he));
-    if (expected.hyperedge(he).connectivity != actual.hyperedge(he).connectivity ||
+    ASSERT(expected.hyperedge(he).connectivity() == actual.hyperedge(he).connectivity(), V(he));
+    if (expected.hyperedge(he).connectivity() != actual.hyperedge(he).connectivity() ||
         expected.connectivitySet(he).size() != actual.connectivitySet(he).size() ||
         !std::equal(expected.connectivitySet(he).begin(),
                     expected.connectivitySet(he).end(),
@@ -2260,10 +2096,10 @@ bool verifyEquivalenceWithPartitionInfo(const Hypergraph& expected, const Hyperg
   bool num_incident_cut_hes_valid = true;
   bool community_structure_valid = true;
   for (const HypernodeID& hn : actual.nodes()) {
-    ASSERT(expected.hypernode(hn).num_incident_cut_hes == actual.hypernode(hn).num_incident_cut_hes,
+    ASSERT(expected.hypernode(hn).numIncidentCutHEs() == actual.hypernode(hn).numIncidentCutHEs(),
            V(hn));
     ASSERT(expected._communities[hn] == actual._communities[hn], V(hn));
-    if (expected.hypernode(hn).num_incident_cut_hes != actual.hypernode(hn).num_incident_cut_hes) {
+    if (expected.hypernode(hn).numIncidentCutHEs() != actual.hypernode(hn).numIncidentCutHEs()) {
       num_incident_cut_hes_valid = false;
       break;
     }
@@ -2275,6 +2111,7 @@ bool verifyEquivalenceWithPartitionInfo(const Hypergraph& expected, const Hyperg
   return verifyEquivalenceWithoutPartitionInfo(expected, actual) &&
          expected._part_info == actual._part_info &&
          expected._pins_in_part == actual._pins_in_part &&
+         expected._metrics_tracker == actual._metrics_tracker &&
          num_incident_cut_hes_valid &&
          community_structure_valid &&
          connectivity_sets_valid;
@@ -2325,7 +2162,7 @@ reindex(const Hypergraph& hypergraph) {
     reindexed_hypergraph->_hyperedges[num_hyperedges].setFirstEntry(pin_index);
     for (const HypernodeID& pin : hypergraph.pins(he)) {
       reindexed_hypergraph->hyperedge(num_hyperedges).incrementSize();
-      reindexed_hypergraph->hyperedge(num_hyperedges).hash += math::hash(original_to_reindexed[pin]);
+      reindexed_hypergraph->hyperedge(num_hyperedges).hash() += math::hash(original_to_reindexed[pin]);
       reindexed_hypergraph->_incidence_array.push_back(original_to_reindexed[pin]);
       ++pin_index;
     }
@@ -2341,7 +2178,7 @@ reindex(const Hypergraph& hypergraph) {
 
   ASSERT(reindexed_hypergraph->_incidence_array.size() == num_pins);
   reindexed_hypergraph->_incidence_array.resize(num_pins);
-  reindexed_hypergraph->_pins_in_part.resize(static_cast<size_t>(num_hyperedges) * hypergraph._k);
+  reindexed_hypergraph->initializePinCountInPart();
   reindexed_hypergraph->_hes_not_containing_u.setSize(num_hyperedges);
 
   reindexed_hypergraph->_connectivity_sets.initialize(num_hyperedges);
@@ -2429,7 +2266,7 @@ extractPartAsUnpartitionedHypergraphForBisection(const Hypergraph& hypergraph,
         for (const HypernodeID& pin : hypergraph.pins(he)) {
           if (hypergraph.partID(pin) == part) {
             subhypergraph->hyperedge(num_hyperedges).incrementSize();
-            subhypergraph->hyperedge(num_hyperedges).hash += math::hash(hypergraph_to_subhypergraph[pin]);
+            subhypergraph->hyperedge(num_hyperedges).hash() += math::hash(hypergraph_to_subhypergraph[pin]);
             subhypergraph->_incidence_array.push_back(hypergraph_to_subhypergraph[pin]);
             ++pin_index;
           }
@@ -2443,8 +2280,8 @@ extractPartAsUnpartitionedHypergraphForBisection(const Hypergraph& hypergraph,
           continue;
         }
         if (*hypergraph.connectivitySet(he).begin() == part) {
-          ASSERT(hypergraph.hyperedge(he).connectivity == 1,
-                 V(he) << V(hypergraph.hyperedge(he).connectivity));
+          ASSERT(hypergraph.hyperedge(he).connectivity() == 1,
+                 V(he) << V(hypergraph.hyperedge(he).connectivity()));
           ASSERT(hypergraph.edgeSize(he) > 1, V(he));
           subhypergraph->_hyperedges.emplace_back(0, 0, hypergraph.edgeWeight(he));
           ++subhypergraph->_num_hyperedges;
@@ -2452,7 +2289,7 @@ extractPartAsUnpartitionedHypergraphForBisection(const Hypergraph& hypergraph,
           for (const HypernodeID& pin : hypergraph.pins(he)) {
             ASSERT(hypergraph.partID(pin) == part, V(pin));
             subhypergraph->hyperedge(num_hyperedges).incrementSize();
-            subhypergraph->hyperedge(num_hyperedges).hash += math::hash(hypergraph_to_subhypergraph[pin]);
+            subhypergraph->hyperedge(num_hyperedges).hash() += math::hash(hypergraph_to_subhypergraph[pin]);
             subhypergraph->_incidence_array.push_back(hypergraph_to_subhypergraph[pin]);
             ++pin_index;
           }
@@ -2487,8 +2324,7 @@ static void setupInternalStructure(const Hypergraph& reference,
 
   ASSERT(subhypergraph._incidence_array.size() == num_pins);
   subhypergraph._incidence_array.resize(static_cast<size_t>(num_pins));
-  subhypergraph._pins_in_part.resize(static_cast<size_t>(num_hyperedges) *
-                                     static_cast<size_t>(new_k));
+  subhypergraph.initializePinCountInPart();
   subhypergraph._hes_not_containing_u.setSize(num_hyperedges);
 
   subhypergraph._connectivity_sets.initialize(num_hyperedges);
@@ -2576,7 +2412,7 @@ removeFixedVertices(const Hypergraph& hypergraph) {
         for (const HypernodeID& pin : hypergraph.pins(he)) {
           if (!hypergraph.isFixedVertex(pin)) {
             subhypergraph->hyperedge(num_hyperedges).incrementSize();
-            subhypergraph->hyperedge(num_hyperedges).hash += math::hash(hypergraph_to_subhypergraph[pin]);
+            subhypergraph->hyperedge(num_hyperedges).hash() += math::hash(hypergraph_to_subhypergraph[pin]);
             subhypergraph->_incidence_array.push_back(hypergraph_to_subhypergraph[pin]);
             ++pin_index;
           }
@@ -0,0 +1,720 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+
+namespace kahypar {
+namespace ds {
+// ! Seed for hyperedge fingerprints used for parallel net detection
+static constexpr size_t kHyperedgeHashSeed = 42;
+
+/*!
+ * Array-of-structs storage of hypernodes: all information of a hypernode
+ * (incident nets, weight, block, number of incident cut nets and local search
+ * state) is stored in a single struct. Accessing a hypernode yields a reference
+ * to its struct.
+ */
+template <typename HypernodeID = Mandatory,
+          typename HyperedgeID = Mandatory,
+          typename HypernodeWeight = Mandatory,
+          typename PartitionID = Mandatory,
+          class HypernodeData = Mandatory>
+class AoSHypernodes {
+ public:
+  class Hypernode : public HypernodeData {
+ public:
+    explicit Hypernode(const HypernodeWeight weight) :
+      HypernodeData(),
+      _incident_nets(),
+      _weight(weight) { }
+
+    Hypernode() :
+      Hypernode(1) { }
+
+    Hypernode(const Hypernode&) = default;
+    Hypernode& operator= (const Hypernode&) = default;
+
+    Hypernode(Hypernode&&) = default;
+    Hypernode& operator= (Hypernode&&) = default;
+
+    ~Hypernode() = default;
+
+    // ! Disables the hypernode. Disabled hypernodes will be skipped
+    // ! when iterating over the set of all nodes.
+    void disable() {
+      ASSERT(!isDisabled());
+      _valid = false;
+    }
+
+    bool isDisabled() const {
+      return _valid == false;
+    }
+
+    void enable() {
+      ASSERT(isDisabled());
+      _valid = true;
+    }
+
+    HypernodeID size() const {
+      ASSERT(!isDisabled());
+      return _incident_nets.size();
+    }
+
+    HypernodeWeight weight() const {
+      ASSERT(!isDisabled());
+      return _weight;
+    }
+
+    void setWeight(const HypernodeWeight weight) {
+      ASSERT(!isDisabled());
+      _weight = weight;
+    }
+
+    std::vector<HyperedgeID> & incidentNets() {
+      return _incident_nets;
+    }
+
+    const std::vector<HyperedgeID> & incidentNets() const {
+      return _incident_nets;
+    }
+
+    PartitionID & partID() {
+      return _part_id;
+    }
+
+    PartitionID partID() const {
+      return _part_id;
+    }
+
+    HyperedgeID & numIncidentCutHEs() {
+      return _num_incident_cut_hes;
+    }
+
+    HyperedgeID numIncidentCutHEs() const {
+      return _num_incident_cut_hes;
+    }
+
+    uint32_t & state() {
+      return _state;
+    }
+
+    uint32_t state() const {
+      return _state;
+    }
+
+    HypernodeData & data() {
+      return *this;
+    }
+
+    bool operator== (const Hypernode& rhs) const {
+      return _incident_nets.size() == rhs._incident_nets.size() &&
+             _weight == rhs._weight &&
+             _valid == rhs._valid &&
+             std::is_permutation(_incident_nets.begin(),
+                                 _incident_nets.end(),
+                                 rhs._incident_nets.begin());
+    }
+
+    bool operator!= (const Hypernode& rhs) const {
+      return !operator== (rhs);
+    }
+
+ private:
+    // ! Block \f$b[v]\f$ of the hypernode \f$v\f$
+    PartitionID _part_id = -1;
+    // ! Number of nets \f$e \in I(v)\f$ with \f$\lambda(e) > 1 \f$
+    HyperedgeID _num_incident_cut_hes = 0;
+    // ! State during local search: inactive/active/marked
+    uint32_t _state = 0;
+    std::vector<HyperedgeID> _incident_nets;
+    HypernodeWeight _weight = 1;
+    // ! Flag indicating whether or not the hypernode is active.
+    bool _valid = true;
+  };
+
+  using Reference = Hypernode &;
+  using ConstReference = const Hypernode &;
+
+  AoSHypernodes() :
+    _hypernodes() { }
+
+  explicit AoSHypernodes(const HypernodeID num_hypernodes) :
+    _hypernodes(num_hypernodes, Hypernode(1)) { }
+
+  AoSHypernodes(const AoSHypernodes&) = delete;
+  AoSHypernodes& operator= (const AoSHypernodes&) = delete;
+
+  AoSHypernodes(AoSHypernodes&&) = default;
+  AoSHypernodes& operator= (AoSHypernodes&&) = default;
+
+  ~AoSHypernodes() = default;
+
+  void resize(const HypernodeID num_hypernodes) {
+    _hypernodes.resize(num_hypernodes, Hypernode(1));
+  }
+
+  Reference operator[] (const HypernodeID u) {
+    return _hypernodes[u];
+  }
+
+  ConstReference operator[] (const HypernodeID u) const {
+    return _hypernodes[u];
+  }
+
+  bool isDisabled(const HypernodeID u) const {
+    return _hypernodes[u].isDisabled();
+  }
+
+  bool operator== (const AoSHypernodes& other) const {
+    return _hypernodes == other._hypernodes;
+  }
+
+ private:
+  std::vector<Hypernode> _hypernodes;
+};
+
+/*!
+ * Array-of-structs storage of hyperedges: the incidence information, weight,
+ * connectivity and fingerprint of a hyperedge are stored in a single struct.
+ */
+template <typename HyperedgeID = Mandatory,
+          typename HyperedgeWeight = Mandatory,
+          typename PartitionID = Mandatory,
+          class HyperedgeData = Mandatory>
+class AoSHyperedges {
+ public:
+  class Hyperedge : public HyperedgeData {
+ public:
+    /*!
+     * Constructs a hyperedge.
+     * \param begin The pins start at _incidence_array[begin]
+     * \param size  The number of pins
+     * \param weight The weight of the hyperedge
+     */
+    Hyperedge(const HyperedgeID begin, const HyperedgeID size,
+              const HyperedgeWeight weight) :
+      HyperedgeData(),
+      _begin(begin),
+      _size(size),
+      _weight(weight) { }
+
+    Hyperedge() = default;
+
+    Hyperedge(const Hyperedge&) = default;
+    Hyperedge& operator= (const Hyperedge&) = default;
+
+    Hyperedge(Hyperedge&&) = default;
+    Hyperedge& operator= (Hyperedge&&) = default;
+
+    ~Hyperedge() = default;
+
+    // ! Disables the hyperedge. Disabled hyperedges will be skipped
+    // ! when iterating over the set of all edges.
+    void disable() {
+      ASSERT(!isDisabled());
+      _valid = false;
+    }
+
+    bool isDisabled() const {
+      return _valid == false;
+    }
+
+    void enable() {
+      ASSERT(isDisabled());
+      _valid = true;
+    }
+
+    // ! Returns the index of the first element in _incidence_array
+    HyperedgeID firstEntry() const {
+      return _begin;
+    }
+
+    // ! Sets the index of the first element in _incidence_array to begin
+    void setFirstEntry(const HyperedgeID begin) {
+      ASSERT(!isDisabled());
+      _begin = begin;
+      _valid = true;
+    }
+
+    // ! Returns the index of the first element after the pins in _incidence_array
+    HyperedgeID firstInvalidEntry() const {
+      return _begin + _size;
+    }
+
+    HyperedgeID size() const {
+      ASSERT(!isDisabled());
+      return _size;
+    }
+
+    void setSize(const HyperedgeID size) {
+      ASSERT(!isDisabled());
+      _size = size;
+    }
+
+    void incrementSize() {
+      ASSERT(!isDisabled());
+      ++_size;
+    }
+
+    void decrementSize() {
+      ASSERT(!isDisabled());
+      ASSERT(_size > 0);
+      --_size;
+    }
+
+    HyperedgeWeight weight() const {
+      ASSERT(!isDisabled());
+      return _weight;
+    }
+
+    void setWeight(const HyperedgeWeight weight) {
+      ASSERT(!isDisabled());
+      _weight = weight;
+    }
+
+    PartitionID & connectivity() {
+      return _connectivity;
+    }
+
+    PartitionID connectivity() const {
+      return _connectivity;
+    }
+
+    size_t & hash() {
+      return _hash;
+    }
+
+    size_t hash() const {
+      return _hash;
+    }
+
+    HyperedgeData & data() {
+      return *this;
+    }
+
+    bool operator== (const Hyperedge& rhs) const {
+      return _begin == rhs._begin && _size == rhs._size && _weight == rhs._weight;
+    }
+
+    bool operator!= (const Hyperedge& rhs) const {
+      return !operator== (rhs);
+    }
+
+ private:
+    // ! Cardinality \f$ \lambda(e) \f$ of the connectivity set,
+    // ! i.e., number of blocks net \f$e\f$ is connected to
+    PartitionID _connectivity = 0;
+    // ! Fingerprint that will be used for parallel net detection
+    size_t _hash = kHyperedgeHashSeed;
+    // ! Index of the first element in _incidence_array
+    HyperedgeID _begin = 0;
+    // ! Number of _incidence_array elements
+    HyperedgeID _size = 0;
+    HyperedgeWeight _weight = 1;
+    // ! Flag indicating whether or not the hyperedge is active.
+    bool _valid = true;
+  };
+
+  using Reference = Hyperedge &;
+  using ConstReference = const Hyperedge &;
+
+  AoSHyperedges() :
+    _hyperedges() { }
+
+  explicit AoSHyperedges(const HyperedgeID num_hyperedges) :
+    _hyperedges(num_hyperedges, Hyperedge(0, 0, 1)) { }
+
+  AoSHyperedges(const AoSHyperedges&) = delete;
+  AoSHyperedges& operator= (const AoSHyperedges&) = delete;
+
+  AoSHyperedges(AoSHyperedges&&) = default;
+  AoSHyperedges& operator= (AoSHyperedges&&) = default;
+
+  ~AoSHyperedges() = default;
+
+  void emplace_back(const HyperedgeID begin, const HyperedgeID size,
+                    const HyperedgeWeight weight) {
+    _hyperedges.emplace_back(begin, size, weight);
+  }
+
+  Reference operator[] (const HyperedgeID e) {
+    return _hyperedges[e];
+  }
+
+  ConstReference operator[] (const HyperedgeID e) const {
+    return _hyperedges[e];
+  }
+
+  bool isDisabled(const HyperedgeID e) const {
+    return _hyperedges[e].isDisabled();
+  }
+
+  bool operator== (const AoSHyperedges& other) const {
+    return _hyperedges == other._hyperedges;
+  }
+
+ private:
+  std::vector<Hyperedge> _hyperedges;
+};
+
+/*!
+ * Struct-of-arrays storage of hypernodes. Fields that are scanned or accessed
+ * for many hypernodes during coarsening and local search (weight, block, number
+ * of incident cut nets, state and the enabled flag) are stored in dense separate
+ * arrays, the incident nets and additional hypernode data are stored elsewhere.
+ * Accessing a hypernode yields a lightweight handle that offers the same interface
+ * as AoSHypernodes::Hypernode.
+ */
+template <typename HypernodeID = Mandatory,
+          typename HyperedgeID = Mandatory,
+          typename HypernodeWeight = Mandatory,
+          typename PartitionID = Mandatory,
+          class HypernodeData = Mandatory>
+class SoAHypernodes {
+ private:
+  template <typename Storage>
+  class Handle {
+ public:
+    Handle(Storage& storage, const HypernodeID u) :
+      _storage(storage),
+      _u(u) { }
+
+    void disable() const {
+      ASSERT(!isDisabled());
+      _storage._valid[_u] = false;
+    }
+
+    bool isDisabled() const {
+      return !_storage._valid[_u];
+    }
+
+    void enable() const {
+      ASSERT(isDisabled());
+      _storage._valid[_u] = true;
+    }
+
+    HypernodeID size() const {
+      ASSERT(!isDisabled());
+      return _storage._incident_nets[_u].size();
+    }
+
+    HypernodeWeight weight() const {
+      ASSERT(!isDisabled());
+      return _storage._weight[_u];
+    }
+
+    void setWeight(const HypernodeWeight weight) const {
+      ASSERT(!isDisabled());
+      _storage._weight[_u] = weight;
+    }
+
+    auto& incidentNets() const {
+      return _storage._incident_nets[_u];
+    }
+
+    auto& partID() const {
+      return _storage._part_id[_u];
+    }
+
+    auto& numIncidentCutHEs() const {
+      return _storage._num_incident_cut_hes[_u];
+    }
+
+    auto& state() const {
+      return _storage._state[_u];
+    }
+
+    auto& data() const {
+      return _storage._data[_u];
+    }
+
+ private:
+    Storage& _storage;
+    const HypernodeID _u;
+  };
+
+ public:
+  using Reference = Handle<SoAHypernodes>;
+  using ConstReference = Handle<const SoAHypernodes>;
+
+  SoAHypernodes() :
+    _weight(),
+    _part_id(),
+    _num_incident_cut_hes(),
+    _state(),
+    _valid(),
+    _incident_nets(),
+    _data() { }
+
+  explicit SoAHypernodes(const HypernodeID num_hypernodes) :
+    SoAHypernodes() {
+    resize(num_hypernodes);
+  }
+
+  SoAHypernodes(const SoAHypernodes&) = delete;
+  SoAHypernodes& operator= (const SoAHypernodes&) = delete;
+
+  SoAHypernodes(SoAHypernodes&&) = default;
+  SoAHypernodes& operator= (SoAHypernodes&&) = default;
+
+  ~SoAHypernodes() = default;
+
+  void resize(const HypernodeID num_hypernodes) {
+    _weight.resize(num_hypernodes, 1);
+    _part_id.resize(num_hypernodes, -1);
+    _num_incident_cut_hes.resize(num_hypernodes, 0);
+    _state.resize(num_hypernodes, 0);
+    _valid.resize(num_hypernodes, true);
+    _incident_nets.resize(num_hypernodes);
+    _data.resize(num_hypernodes);
+  }
+
+  Reference operator[] (const HypernodeID u) {
+    return Reference(*this, u);
+  }
+
+  ConstReference operator[] (const HypernodeID u) const {
+    return ConstReference(*this, u);
+  }
+
+  bool isDisabled(const HypernodeID u) const {
+    return !_valid[u];
+  }
+
+  bool operator== (const SoAHypernodes& other) const {
+    if (_valid != other._valid || _weight != other._weight) {
+      return false;
+    }
+    for (size_t u = 0; u < _incident_nets.size(); ++u) {
+      if (_incident_nets[u].size() != other._incident_nets[u].size() ||
+          !std::is_permutation(_incident_nets[u].begin(), _incident_nets[u].end(),
+                               other._incident_nets[u].begin())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  // hot
+  std::vector<HypernodeWeight> _weight;
+  std::vector<PartitionID> _part_id;
+  std::vector<HyperedgeID> _num_incident_cut_hes;
+  std::vector<uint32_t> _state;
+  std::vector<uint8_t> _valid;
+  // cold
+  std::vector<std::vector<HyperedgeID> > _incident_nets;
+  std::vector<HypernodeData> _data;
+};
+
+/*!
+ * Struct-of-arrays storage of hyperedges. The incidence information (first entry
+ * and size), weight, connectivity and enabled flag are stored in dense separate
+ * arrays, while fingerprints and additional hyperedge data, which are only needed
+ * during preprocessing and coarsening, are stored elsewhere.
+ */
+template <typename HyperedgeID = Mandatory,
+          typename HyperedgeWeight = Mandatory,
+          typename PartitionID = Mandatory,
+          class HyperedgeData = Mandatory>
+class SoAHyperedges {
+ private:
+  template <typename Storage>
+  class Handle {
+ public:
+    Handle(Storage& storage, const HyperedgeID e) :
+      _storage(storage),
+      _e(e) { }
+
+    void disable() const {
+      ASSERT(!isDisabled());
+      _storage._valid[_e] = false;
+    }
+
+    bool isDisabled() const {
+      return !_storage._valid[_e];
+    }
+
+    void enable() const {
+      ASSERT(isDisabled());
+      _storage._valid[_e] = true;
+    }
+
+    HyperedgeID firstEntry() const {
+      return _storage._begin[_e];
+    }
+
+    void setFirstEntry(const HyperedgeID begin) const {
+      ASSERT(!isDisabled());
+      _storage._begin[_e] = begin;
+      _storage._valid[_e] = true;
+    }
+
+    HyperedgeID firstInvalidEntry() const {
+      return _storage._begin[_e] + _storage._size[_e];
+    }
+
+    HyperedgeID size() const {
+      ASSERT(!isDisabled());
+      return _storage._size[_e];
+    }
+
+    void setSize(const HyperedgeID size) const {
+      ASSERT(!isDisabled());
+      _storage._size[_e] = size;
+    }
+
+    void incrementSize() const {
+      ASSERT(!isDisabled());
+      ++_storage._size[_e];
+    }
+
+    void decrementSize() const {
+      ASSERT(!isDisabled());
+      ASSERT(_storage._size[_e] > 0);
+      --_storage._size[_e];
+    }
+
+    HyperedgeWeight weight() const {
+      ASSERT(!isDisabled());
+      return _storage._weight[_e];
+    }
+
+    void setWeight(const HyperedgeWeight weight) const {
+      ASSERT(!isDisabled());
+      _storage._weight[_e] = weight;
+    }
+
+    auto& connectivity() const {
+      return _storage._connectivity[_e];
+    }
+
+    auto& hash() const {
+      return _storage._hash[_e];
+    }
+
+    auto& data() const {
+      return _storage._data[_e];
+    }
+
+ private:
+    Storage& _storage;
+    const HyperedgeID _e;
+  };
+
+ public:
+  using Reference = Handle<SoAHyperedges>;
+  using ConstReference = Handle<const SoAHyperedges>;
+
+  SoAHyperedges() :
+    _begin(),
+    _size(),
+    _weight(),
+    _connectivity(),
+    _valid(),
+    _hash(),
+    _data() { }
+
+  explicit SoAHyperedges(const HyperedgeID num_hyperedges) :
+    _begin(num_hyperedges, 0),
+    _size(num_hyperedges, 0),
+    _weight(num_hyperedges, 1),
+    _connectivity(num_hyperedges, 0),
+    _valid(num_hyperedges, true),
+    _hash(num_hyperedges, kHyperedgeHashSeed),
+    _data(num_hyperedges) { }
+
+  SoAHyperedges(const SoAHyperedges&) = delete;
+  SoAHyperedges& operator= (const SoAHyperedges&) = delete;
+
+  SoAHyperedges(SoAHyperedges&&) = default;
+  SoAHyperedges& operator= (SoAHyperedges&&) = default;
+
+  ~SoAHyperedges() = default;
+
+  void emplace_back(const HyperedgeID begin, const HyperedgeID size,
+                    const HyperedgeWeight weight) {
+    _begin.push_back(begin);
+    _size.push_back(size);
+    _weight.push_back(weight);
+    _connectivity.push_back(0);
+    _valid.push_back(true);
+    _hash.push_back(kHyperedgeHashSeed);
+    _data.emplace_back();
+  }
+
+  Reference operator[] (const HyperedgeID e) {
+    return Reference(*this, e);
+  }
+
+  ConstReference operator[] (const HyperedgeID e) const {
+    return ConstReference(*this, e);
+  }
+
+  bool isDisabled(const HyperedgeID e) const {
+    return !_valid[e];
+  }
+
+  bool operator== (const SoAHyperedges& other) const {
+    return _begin == other._begin && _size == other._size && _weight == other._weight;
+  }
+
+ private:
+  // hot
+  std::vector<HyperedgeID> _begin;
+  std::vector<HyperedgeID> _size;
+  std::vector<HyperedgeWeight> _weight;
+  std::vector<PartitionID> _connectivity;
+  std::vector<uint8_t> _valid;
+  // cold
+  std::vector<size_t> _hash;
+  std::vector<HyperedgeData> _data;
+};
+
+// ! Stores each hypernode and each hyperedge in a single struct (default).
+struct ArrayOfStructsLayout {
+  template <typename HypernodeID, typename HyperedgeID, typename HypernodeWeight,
+            typename PartitionID, class HypernodeData>
+  using Hypernodes = AoSHypernodes<HypernodeID, HyperedgeID, HypernodeWeight,
+                                   PartitionID, HypernodeData>;
+  template <typename HyperedgeID, typename HyperedgeWeight, typename PartitionID,
+            class HyperedgeData>
+  using Hyperedges = AoSHyperedges<HyperedgeID, HyperedgeWeight, PartitionID, HyperedgeData>;
+};
+
+// ! Stores the fields of all hypernodes and all hyperedges in separate arrays.
+struct StructOfArraysLayout {
+  template <typename HypernodeID, typename HyperedgeID, typename HypernodeWeight,
+            typename PartitionID, class HypernodeData>
+  using Hypernodes = SoAHypernodes<HypernodeID, HyperedgeID, HypernodeWeight,
+                                   PartitionID, HypernodeData>;
+  template <typename HyperedgeID, typename HyperedgeWeight, typename PartitionID,
+            class HyperedgeData>
+  using Hyperedges = SoAHyperedges<HyperedgeID, HyperedgeWeight, PartitionID, HyperedgeData>;
+};
+}  // namespace ds
+}  // namespace kahypar
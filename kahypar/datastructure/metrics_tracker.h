@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "kahypar/meta/mandatory.h"
+
+namespace kahypar {
+namespace ds {
+/*!
+ * Keeps the hyperedge cut, the (connectivity - 1) metric and the sum of
+ * external degrees of a partitioned hypergraph up to date.
+ * All three metrics are sums of per-hyperedge contributions that only depend
+ * on the weight and the connectivity of the hyperedge. Therefore the hypergraph
+ * only has to report weight and connectivity changes of its enabled hyperedges.
+ */
+template <typename HyperedgeWeight = Mandatory,
+          typename PartitionID = Mandatory>
+class MetricsTracker {
+ public:
+  MetricsTracker() :
+    _cut(0),
+    _km1(0),
+    _soed(0) { }
+
+  MetricsTracker(const MetricsTracker&) = default;
+  MetricsTracker& operator= (const MetricsTracker&) = default;
+
+  MetricsTracker(MetricsTracker&&) = default;
+  MetricsTracker& operator= (MetricsTracker&&) = default;
+
+  ~MetricsTracker() = default;
+
+  HyperedgeWeight cut() const {
+    return _cut;
+  }
+
+  HyperedgeWeight km1() const {
+    return _km1;
+  }
+
+  HyperedgeWeight soed() const {
+    return _soed;
+  }
+
+  // ! Accounts for a hyperedge that becomes part of the hypergraph
+  void add(const HyperedgeWeight weight, const PartitionID connectivity) {
+    if (connectivity > 1) {
+      _cut += weight;
+      _km1 += (connectivity - 1) * weight;
+      _soed += connectivity * weight;
+    }
+  }
+
+  // ! Accounts for a hyperedge that is no longer part of the hypergraph
+  void remove(const HyperedgeWeight weight, const PartitionID connectivity) {
+    if (connectivity > 1) {
+      _cut -= weight;
+      _km1 -= (connectivity - 1) * weight;
+      _soed -= connectivity * weight;
+    }
+  }
+
+  void changeConnectivity(const HyperedgeWeight weight, const PartitionID from,
+                          const PartitionID to) {
+    remove(weight, from);
+    add(weight, to);
+  }
+
+  void changeWeight(const HyperedgeWeight from, const HyperedgeWeight to,
+                    const PartitionID connectivity) {
+    remove(from, connectivity);
+    add(to, connectivity);
+  }
+
+  void reset() {
+    _cut = 0;
+    _km1 = 0;
+    _soed = 0;
+  }
+
+  bool operator== (const MetricsTracker& other) const {
+    return _cut == other._cut && _km1 == other._km1 && _soed == other._soed;
+  }
+
+ private:
+  HyperedgeWeight _cut;
+  HyperedgeWeight _km1;
+  HyperedgeWeight _soed;
+};
+}  // namespace ds
+}  // namespace kahypar
@@ -0,0 +1,298 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+#include "kahypar/utils/math.h"
+
+namespace kahypar {
+namespace ds {
+/*!
+ * Stores \f$\Phi(e,V_i)\f$, i.e., the number of pins of each net \f$e\f$ in each
+ * block \f$V_i\f$, as a dense \f$|E| \times k\f$ array. This is the fastest
+ * representation as long as \f$|E| \cdot k\f$ counters fit into memory.
+ */
+template <typename HypernodeID = Mandatory,
+          typename HyperedgeID = Mandatory,
+          typename PartitionID = Mandatory>
+class DensePinCountInPart {
+ public:
+  // ! Constant to denote invalid partition pin counts.
+  static constexpr HypernodeID kInvalidCount = std::numeric_limits<HypernodeID>::max();
+
+  DensePinCountInPart() :
+    _k(0),
+    _pins_in_part() { }
+
+  DensePinCountInPart(const DensePinCountInPart&) = delete;
+  DensePinCountInPart& operator= (const DensePinCountInPart&) = delete;
+
+  DensePinCountInPart(DensePinCountInPart&&) = default;
+  DensePinCountInPart& operator= (DensePinCountInPart&&) = default;
+
+  ~DensePinCountInPart() = default;
+
+  /*!
+   * (Re-)initializes the pin counts of num_hyperedges nets for a k-way partition.
+   * All counts are set to zero. The size of each net is not needed by this representation.
+   */
+  template <typename EdgeSizeFunc>
+  void initialize(const HyperedgeID num_hyperedges, const PartitionID k, const EdgeSizeFunc&) {
+    _k = k;
+    _pins_in_part.assign(static_cast<size_t>(num_hyperedges) * k, 0);
+  }
+
+  HypernodeID get(const HyperedgeID he, const PartitionID id) const {
+    ASSERT(id < _k, V(id));
+    return _pins_in_part[static_cast<size_t>(he) * _k + id];
+  }
+
+  // ! Increments the pin count of net he in block id and returns the new value.
+  HypernodeID increment(const HyperedgeID he, const PartitionID id) {
+    ASSERT(id < _k, V(id));
+    return ++_pins_in_part[static_cast<size_t>(he) * _k + id];
+  }
+
+  // ! Decrements the pin count of net he in block id and returns the new value.
+  HypernodeID decrement(const HyperedgeID he, const PartitionID id) {
+    ASSERT(id < _k, V(id));
+    ASSERT(_pins_in_part[static_cast<size_t>(he) * _k + id] > 0, "invalid decrease");
+    return --_pins_in_part[static_cast<size_t>(he) * _k + id];
+  }
+
+  void invalidate(const HyperedgeID he) {
+    std::fill_n(_pins_in_part.begin() + static_cast<size_t>(he) * _k, _k, kInvalidCount);
+  }
+
+  void reset(const HyperedgeID he) {
+    std::fill_n(_pins_in_part.begin() + static_cast<size_t>(he) * _k, _k, 0);
+  }
+
+  void reset() {
+    std::fill(_pins_in_part.begin(), _pins_in_part.end(), 0);
+  }
+
+  size_t memoryConsumption() const {
+    return _pins_in_part.size() * sizeof(HypernodeID);
+  }
+
+  bool operator== (const DensePinCountInPart& other) const {
+    return _k == other._k && _pins_in_part == other._pins_in_part;
+  }
+
+ private:
+  PartitionID _k;
+  std::vector<HypernodeID> _pins_in_part;
+};
+
+/*!
+ * Stores \f$\Phi(e,V_i)\f$ only for the blocks \f$V_i \in \Lambda(e)\f$ that net \f$e\f$
+ * is actually connected to. Each net owns a small open-addressing hash table
+ * (linear probing with backward-shift deletion) whose capacity is a power of two
+ * with room for \f$\min(k, |e|)\f$ entries at a load factor of at most 1/2.
+ * The total memory therefore is bounded by \f$O(|P|)\f$ instead of \f$O(|E| \cdot k)\f$.
+ *
+ * Block IDs are used directly as hash values. If a net has at least k/2 pins,
+ * its table has \f$\geq k\f$ slots, i.e., it degenerates to direct addressing
+ * and lookups never probe.
+ *
+ * Since nets never grow beyond their initial size (contractions only shrink them),
+ * the capacity computed during initialization is sufficient for the entire
+ * multilevel hierarchy.
+ */
+template <typename HypernodeID = Mandatory,
+          typename HyperedgeID = Mandatory,
+          typename PartitionID = Mandatory>
+class SparsePinCountInPart {
+ private:
+  static constexpr PartitionID kEmptySlot = -1;
+
+  struct Entry {
+    PartitionID part;
+    HypernodeID count;
+  };
+
+ public:
+  static constexpr HypernodeID kInvalidCount = std::numeric_limits<HypernodeID>::max();
+
+  SparsePinCountInPart() :
+    _k(0),
+    _offsets(),
+    _entries() { }
+
+  SparsePinCountInPart(const SparsePinCountInPart&) = delete;
+  SparsePinCountInPart& operator= (const SparsePinCountInPart&) = delete;
+
+  SparsePinCountInPart(SparsePinCountInPart&&) = default;
+  SparsePinCountInPart& operator= (SparsePinCountInPart&&) = default;
+
+  ~SparsePinCountInPart() = default;
+
+  /*!
+   * (Re-)initializes the pin counts of num_hyperedges nets for a k-way partition.
+   * edge_size(he) has to return the maximum size net he can have, which is used
+   * to determine the capacity of its hash table.
+   */
+  template <typename EdgeSizeFunc>
+  void initialize(const HyperedgeID num_hyperedges, const PartitionID k,
+                  const EdgeSizeFunc& edge_size) {
+    _k = k;
+    const size_t direct_capacity = math::nextPowerOfTwoCeiled(static_cast<size_t>(k));
+    _offsets.resize(static_cast<size_t>(num_hyperedges) + 1);
+    _offsets[0] = 0;
+    for (HyperedgeID he = 0; he < num_hyperedges; ++he) {
+      const size_t max_connectivity = std::min(static_cast<size_t>(k),
+                                               static_cast<size_t>(edge_size(he)));
+      const size_t capacity = std::min(direct_capacity,
+                                       math::nextPowerOfTwoCeiled(
+                                         std::max(static_cast<size_t>(1), 2 * max_connectivity)));
+      _offsets[static_cast<size_t>(he) + 1] = _offsets[he] + capacity;
+    }
+    _entries.assign(_offsets.back(), Entry { kEmptySlot, 0 });
+  }
+
+  HypernodeID get(const HyperedgeID he, const PartitionID id) const {
+    ASSERT(id < _k, V(id));
+    const size_t begin = _offsets[he];
+    const size_t mask = _offsets[static_cast<size_t>(he) + 1] - begin - 1;
+    for (size_t slot = id & mask; ; slot = (slot + 1) & mask) {
+      const Entry& entry = _entries[begin + slot];
+      if (entry.part == id) {
+        return entry.count;
+      } else if (entry.part == kEmptySlot) {
+        return 0;
+      }
+    }
+  }
+
+  // ! Increments the pin count of net he in block id and returns the new value.
+  HypernodeID increment(const HyperedgeID he, const PartitionID id) {
+    ASSERT(id < _k, V(id));
+    const size_t begin = _offsets[he];
+    const size_t mask = _offsets[static_cast<size_t>(he) + 1] - begin - 1;
+    for (size_t slot = id & mask; ; slot = (slot + 1) & mask) {
+      Entry& entry = _entries[begin + slot];
+      if (entry.part == id) {
+        return ++entry.count;
+      } else if (entry.part == kEmptySlot) {
+        entry.part = id;
+        entry.count = 1;
+        return 1;
+      }
+    }
+  }
+
+  // ! Decrements the pin count of net he in block id and returns the new value.
+  HypernodeID decrement(const HyperedgeID he, const PartitionID id) {
+    ASSERT(id < _k, V(id));
+    const size_t begin = _offsets[he];
+    const size_t mask = _offsets[static_cast<size_t>(he) + 1] - begin - 1;
+    size_t slot = id & mask;
+    while (_entries[begin + slot].part != id) {
+      ASSERT(_entries[begin + slot].part != kEmptySlot, "invalid decrease");
+      slot = (slot + 1) & mask;
+    }
+    ASSERT(_entries[begin + slot].count > 0, "invalid decrease");
+    const HypernodeID count = --_entries[begin + slot].count;
+    if (count == 0) {
+      removeSlot(begin, mask, slot);
+    }
+    return count;
+  }
+
+  // ! Invalidated nets do not have any pins in any block.
+  void invalidate(const HyperedgeID he) {
+    reset(he);
+  }
+
+  void reset(const HyperedgeID he) {
+    std::fill(_entries.begin() + _offsets[he],
+              _entries.begin() + _offsets[static_cast<size_t>(he) + 1],
+              Entry { kEmptySlot, 0 });
+  }
+
+  void reset() {
+    std::fill(_entries.begin(), _entries.end(), Entry { kEmptySlot, 0 });
+  }
+
+  size_t memoryConsumption() const {
+    return _offsets.size() * sizeof(size_t) + _entries.size() * sizeof(Entry);
+  }
+
+  // ! Two instances are equal if all nets have the same pin counts, independent
+  // ! of the position of the entries in the hash tables.
+  bool operator== (const SparsePinCountInPart& other) const {
+    if (_k != other._k || _offsets != other._offsets) {
+      return false;
+    }
+    for (size_t he = 0; he + 1 < _offsets.size(); ++he) {
+      int64_t num_entries = 0;
+      for (size_t i = _offsets[he]; i < _offsets[he + 1]; ++i) {
+        if (_entries[i].part != kEmptySlot) {
+          ++num_entries;
+          if (other.get(he, _entries[i].part) != _entries[i].count) {
+            return false;
+          }
+        }
+        if (other._entries[i].part != kEmptySlot) {
+          --num_entries;
+        }
+      }
+      if (num_entries != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  // ! Backward-shift deletion keeps probe sequences intact without tombstones.
+  void removeSlot(const size_t begin, const size_t mask, size_t hole) {
+    _entries[begin + hole] = Entry { kEmptySlot, 0 };
+    size_t next = (hole + 1) & mask;
+    while (_entries[begin + next].part != kEmptySlot) {
+      const size_t home = _entries[begin + next].part & mask;
+      // The entry may only be moved into the hole if its home slot
+      // does not lie cyclically in (hole, next].
+      const bool home_in_between = hole <= next ?
+                                   (hole < home && home <= next) :
+                                   (hole < home || home <= next);
+      if (!home_in_between) {
+        _entries[begin + hole] = _entries[begin + next];
+        _entries[begin + next] = Entry { kEmptySlot, 0 };
+        hole = next;
+      }
+      next = (next + 1) & mask;
+    }
+  }
+
+  PartitionID _k;
+  std::vector<size_t> _offsets;
+  std::vector<Entry> _entries;
+};
+}  // namespace ds
+}  // namespace kahypar
@@ -37,9 +37,27 @@ using HyperedgeWeight = int32_t;
 using PartitionID = int32_t;
 using Gain = HyperedgeWeight;
 
+#ifdef KAHYPAR_USE_SOA_HYPERGRAPH_LAYOUT
+using HypergraphLayout = kahypar::ds::StructOfArraysLayout;
+#else
+using HypergraphLayout = kahypar::ds::ArrayOfStructsLayout;
+#endif
+
+#ifdef KAHYPAR_USE_SPARSE_PIN_COUNTS
+using Hypergraph = kahypar::ds::GenericHypergraph<HypernodeID,
+                                                  HyperedgeID, HypernodeWeight,
+                                                  HyperedgeWeight, PartitionID,
+                                                  kahypar::meta::Empty, kahypar::meta::Empty,
+                                                  kahypar::ds::SparsePinCountInPart,
+                                                  HypergraphLayout>;
+#else
 using Hypergraph = kahypar::ds::GenericHypergraph<HypernodeID,
                                                   HyperedgeID, HypernodeWeight,
-                                                  HyperedgeWeight, PartitionID>;
+                                                  HyperedgeWeight, PartitionID,
+                                                  kahypar::meta::Empty, kahypar::meta::Empty,
+                                                  kahypar::ds::DensePinCountInPart,
+                                                  HypergraphLayout>;
+#endif
 
 using RatingType = double;
 using HypergraphType = Hypergraph::Type;
@@ -0,0 +1,312 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace io {
+/*!
+ * Binary hypergraph format (native byte order):
+ *
+ *   BinaryHypergraphHeader
+ *   size_t          index_vector[num_hyperedges + 1]
+ *   HypernodeID     edge_vector[num_pins]
+ *   HyperedgeWeight hyperedge_weights[num_hyperedges]   (if kHasHyperedgeWeights)
+ *   HypernodeWeight hypernode_weights[num_hypernodes]   (if kHasHypernodeWeights)
+ *   PartitionID     fixed_vertex_parts[num_hypernodes]  (if kHasFixedVertices, -1 = free)
+ *   PartitionID     communities[num_hypernodes]         (if kHasCommunities)
+ *
+ * Each array starts at an offset that is a multiple of 8 bytes. Thus a
+ * memory-mapped file can be used directly without any parsing.
+ */
+struct BinaryHypergraphHeader {
+  static constexpr char kMagic[8] = { 'K', 'a', 'H', 'y', 'P', 'a', 'r', 'B' };
+  static constexpr uint32_t kVersion = 1;
+
+  static constexpr uint32_t kHasHyperedgeWeights = 1;
+  static constexpr uint32_t kHasHypernodeWeights = 2;
+  static constexpr uint32_t kHasFixedVertices = 4;
+  static constexpr uint32_t kHasCommunities = 8;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  uint64_t num_hypernodes;
+  uint64_t num_hyperedges;
+  uint64_t num_pins;
+};
+
+static_assert(sizeof(BinaryHypergraphHeader) % 8 == 0, "Header has to preserve alignment");
+static_assert(sizeof(size_t) == 8, "Binary format requires 64-bit hyperedge indices");
+
+static inline size_t binarySectionSize(const size_t num_elements, const size_t element_size) {
+  return (num_elements * element_size + 7) / 8 * 8;
+}
+
+static inline bool isBinaryHypergraphFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(BinaryHypergraphHeader::kMagic)];
+  return file.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, BinaryHypergraphHeader::kMagic, sizeof(magic)) == 0;
+}
+
+/*!
+ * Read-only view of a binary hypergraph file. On POSIX systems, the file is
+ * memory-mapped, i.e., the arrays point directly into the page cache.
+ */
+class BinaryHypergraphFile {
+ public:
+  explicit BinaryHypergraphFile(const std::string& filename) :
+    _file(filename),
+    _data(_file.begin()),
+    _size(_file.size()) {
+    if (_size < sizeof(BinaryHypergraphHeader) ||
+        std::memcmp(header().magic, BinaryHypergraphHeader::kMagic,
+                    sizeof(BinaryHypergraphHeader::kMagic)) != 0) {
+      std::cerr << "Error: " << filename << " is not a binary hypergraph file" << std::endl;
+      std::exit(1);
+    }
+    if (header().version != BinaryHypergraphHeader::kVersion) {
+      std::cerr << "Error: Unsupported binary hypergraph version " << header().version
+                << " (expected " << BinaryHypergraphHeader::kVersion << ")" << std::endl;
+      std::exit(1);
+    }
+    if (_size != expectedFileSize()) {
+      std::cerr << "Error: Binary hypergraph file " << filename << " is truncated or corrupted"
+                << std::endl;
+      std::exit(1);
+    }
+    ASSERT(indexVector()[0] == 0 && indexVector()[numHyperedges()] == header().num_pins,
+           "Invalid index vector");
+  }
+
+  BinaryHypergraphFile(const BinaryHypergraphFile&) = delete;
+  BinaryHypergraphFile& operator= (const BinaryHypergraphFile&) = delete;
+
+  BinaryHypergraphFile(BinaryHypergraphFile&&) = delete;
+  BinaryHypergraphFile& operator= (BinaryHypergraphFile&&) = delete;
+
+  ~BinaryHypergraphFile() = default;
+
+  HypernodeID numHypernodes() const {
+    return header().num_hypernodes;
+  }
+
+  HyperedgeID numHyperedges() const {
+    return header().num_hyperedges;
+  }
+
+  const size_t* indexVector() const {
+    return reinterpret_cast<const size_t*>(section(0));
+  }
+
+  const HypernodeID* edgeVector() const {
+    return reinterpret_cast<const HypernodeID*>(section(1));
+  }
+
+  // ! Returns nullptr if the hypergraph is unweighted.
+  const HyperedgeWeight* hyperedgeWeights() const {
+    return reinterpret_cast<const HyperedgeWeight*>(
+      optionalSection(2, BinaryHypergraphHeader::kHasHyperedgeWeights));
+  }
+
+  // ! Returns nullptr if the hypergraph is unweighted.
+  const HypernodeWeight* hypernodeWeights() const {
+    return reinterpret_cast<const HypernodeWeight*>(
+      optionalSection(3, BinaryHypergraphHeader::kHasHypernodeWeights));
+  }
+
+  // ! Returns nullptr if the file does not contain fixed vertices.
+  const PartitionID* fixedVertexParts() const {
+    return reinterpret_cast<const PartitionID*>(
+      optionalSection(4, BinaryHypergraphHeader::kHasFixedVertices));
+  }
+
+  // ! Returns nullptr if the file does not contain communities.
+  const PartitionID* communities() const {
+    return reinterpret_cast<const PartitionID*>(
+      optionalSection(5, BinaryHypergraphHeader::kHasCommunities));
+  }
+
+ private:
+  const BinaryHypergraphHeader& header() const {
+    return *reinterpret_cast<const BinaryHypergraphHeader*>(_data);
+  }
+
+  // ! Size of the i-th array of the format in bytes (including padding).
+  size_t sectionSize(const size_t i) const {
+    const size_t n = header().num_hypernodes;
+    const size_t m = header().num_hyperedges;
+    switch (i) {
+      case 0: return binarySectionSize(m + 1, sizeof(size_t));
+      case 1: return binarySectionSize(header().num_pins, sizeof(HypernodeID));
+      case 2: return header().flags & BinaryHypergraphHeader::kHasHyperedgeWeights ?
+                     binarySectionSize(m, sizeof(HyperedgeWeight)) : 0;
+      case 3: return header().flags & BinaryHypergraphHeader::kHasHypernodeWeights ?
+                     binarySectionSize(n, sizeof(HypernodeWeight)) : 0;
+      case 4: return header().flags & BinaryHypergraphHeader::kHasFixedVertices ?
+                     binarySectionSize(n, sizeof(PartitionID)) : 0;
+      case 5: return header().flags & BinaryHypergraphHeader::kHasCommunities ?
+                     binarySectionSize(n, sizeof(PartitionID)) : 0;
+      default: return 0;
+    }
+  }
+
+  const char* section(const size_t i) const {
+    size_t offset = sizeof(BinaryHypergraphHeader);
+    for (size_t j = 0; j < i; ++j) {
+      offset += sectionSize(j);
+    }
+    return _data + offset;
+  }
+
+  const char* optionalSection(const size_t i, const uint32_t flag) const {
+    return header().flags & flag ? section(i) : nullptr;
+  }
+
+  size_t expectedFileSize() const {
+    return section(6) - _data;
+  }
+
+  const MemoryMappedFile _file;
+  const char* _data;
+  size_t _size;
+};
+
+static inline void writeBinarySection(std::ofstream& out_stream, const void* data,
+                                      const size_t num_elements, const size_t element_size) {
+  static constexpr char padding[8] = { 0 };
+  out_stream.write(static_cast<const char*>(data), num_elements * element_size);
+  out_stream.write(padding, binarySectionSize(num_elements, element_size) -
+                   num_elements * element_size);
+}
+
+/*!
+ * Writes the hypergraph in binary format. Fixed vertices are written if the
+ * hypergraph contains any, communities are written if they are non-trivial.
+ * The hypergraph must not have been modified by contractions.
+ */
+static inline void writeBinaryHypergraphFile(const Hypergraph& hypergraph,
+                                             const std::string& filename) {
+  ASSERT(!filename.empty(), "No filename for binary hypergraph file specified");
+  const HypernodeID num_hypernodes = hypergraph.initialNumNodes();
+  const HyperedgeID num_hyperedges = hypergraph.initialNumEdges();
+
+  std::vector<size_t> index_vector(1, 0);
+  std::vector<HypernodeID> edge_vector;
+  std::vector<HyperedgeWeight> hyperedge_weights;
+  for (const HyperedgeID& he : hypergraph.edges()) {
+    for (const HypernodeID& pin : hypergraph.pins(he)) {
+      edge_vector.push_back(pin);
+    }
+    index_vector.push_back(edge_vector.size());
+    hyperedge_weights.push_back(hypergraph.edgeWeight(he));
+  }
+  std::vector<HypernodeWeight> hypernode_weights;
+  std::vector<PartitionID> fixed_vertex_parts;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypernode_weights.push_back(hypergraph.nodeWeight(hn));
+    fixed_vertex_parts.push_back(hypergraph.fixedVertexPartID(hn));
+  }
+  const std::vector<PartitionID>& communities = hypergraph.communities();
+  const bool has_communities = std::any_of(communities.begin(), communities.end(),
+                                           [](const PartitionID community) {
+        return community != 0;
+      });
+
+  BinaryHypergraphHeader header;
+  std::memcpy(header.magic, BinaryHypergraphHeader::kMagic, sizeof(header.magic));
+  header.version = BinaryHypergraphHeader::kVersion;
+  header.flags = 0;
+  if (hypergraph.type() == HypergraphType::EdgeWeights ||
+      hypergraph.type() == HypergraphType::EdgeAndNodeWeights) {
+    header.flags |= BinaryHypergraphHeader::kHasHyperedgeWeights;
+  }
+  if (hypergraph.type() == HypergraphType::NodeWeights ||
+      hypergraph.type() == HypergraphType::EdgeAndNodeWeights) {
+    header.flags |= BinaryHypergraphHeader::kHasHypernodeWeights;
+  }
+  if (hypergraph.containsFixedVertices()) {
+    header.flags |= BinaryHypergraphHeader::kHasFixedVertices;
+  }
+  if (has_communities) {
+    header.flags |= BinaryHypergraphHeader::kHasCommunities;
+  }
+  header.num_hypernodes = num_hypernodes;
+  header.num_hyperedges = num_hyperedges;
+  header.num_pins = edge_vector.size();
+
+  std::ofstream out_stream(filename.c_str(), std::ios::binary);
+  out_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  writeBinarySection(out_stream, index_vector.data(), index_vector.size(), sizeof(size_t));
+  writeBinarySection(out_stream, edge_vector.data(), edge_vector.size(), sizeof(HypernodeID));
+  if (header.flags & BinaryHypergraphHeader::kHasHyperedgeWeights) {
+    writeBinarySection(out_stream, hyperedge_weights.data(), num_hyperedges,
+                       sizeof(HyperedgeWeight));
+  }
+  if (header.flags & BinaryHypergraphHeader::kHasHypernodeWeights) {
+    writeBinarySection(out_stream, hypernode_weights.data(), num_hypernodes,
+                       sizeof(HypernodeWeight));
+  }
+  if (header.flags & BinaryHypergraphHeader::kHasFixedVertices) {
+    writeBinarySection(out_stream, fixed_vertex_parts.data(), num_hypernodes,
+                       sizeof(PartitionID));
+  }
+  if (has_communities) {
+    writeBinarySection(out_stream, communities.data(), num_hypernodes, sizeof(PartitionID));
+  }
+  out_stream.close();
+}
+
+static inline Hypergraph createHypergraphFromBinaryFile(const std::string& filename,
+                                                        const PartitionID num_parts) {
+  const BinaryHypergraphFile file(filename);
+  Hypergraph hypergraph(file.numHypernodes(), file.numHyperedges(), file.indexVector(),
+                        file.edgeVector(), num_parts, file.hyperedgeWeights(),
+                        file.hypernodeWeights());
+  if (file.fixedVertexParts() != nullptr) {
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      if (file.fixedVertexParts()[hn] != Hypergraph::kInvalidPartition) {
+        hypergraph.setFixedVertex(hn, file.fixedVertexParts()[hn]);
+      }
+    }
+  }
+  if (file.communities() != nullptr) {
+    hypergraph.setCommunities(std::vector<PartitionID>(file.communities(),
+                                                       file.communities() +
+                                                       file.numHypernodes()));
+  }
+  return hypergraph;
+}
+}  // namespace io
+}  // namespace kahypar
@@ -32,6 +32,8 @@
 #include <cstdlib>
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/binary_hypergraph_io.h"
+#include "kahypar/io/parallel_hypergraph_io.h"
 
 namespace kahypar {
 namespace io {
@@ -60,6 +62,22 @@ static inline void readHypergraphFile(const std::string& filename, HypernodeID&
                                       HyperedgeWeightVector* hyperedge_weights = nullptr,
                                       HypernodeWeightVector* hypernode_weights = nullptr) {
   ASSERT(!filename.empty(), "No filename for hypergraph file specified");
+  if (isBinaryHypergraphFile(filename)) {
+    const BinaryHypergraphFile file(filename);
+    num_hypernodes = file.numHypernodes();
+    num_hyperedges = file.numHyperedges();
+    index_vector.assign(file.indexVector(), file.indexVector() + num_hyperedges + 1);
+    edge_vector.assign(file.edgeVector(), file.edgeVector() + index_vector.back());
+    if (hyperedge_weights != nullptr && file.hyperedgeWeights() != nullptr) {
+      hyperedge_weights->assign(file.hyperedgeWeights(),
+                                file.hyperedgeWeights() + num_hyperedges);
+    }
+    if (hypernode_weights != nullptr && file.hypernodeWeights() != nullptr) {
+      hypernode_weights->assign(file.hypernodeWeights(),
+                                file.hypernodeWeights() + num_hypernodes);
+    }
+    return;
+  }
   HypergraphType hypergraph_type = HypergraphType::Unweighted;
   std::ifstream file(filename);
   if (file) {
@@ -189,15 +207,19 @@ static inline void readHypergraphFile(const std::string& filename,
 
 
 static inline Hypergraph createHypergraphFromFile(const std::string& filename,
-                                                  const PartitionID num_parts) {
+                                                  const PartitionID num_parts,
+                                                  const size_t num_threads = 1) {
+  if (isBinaryHypergraphFile(filename)) {
+    return createHypergraphFromBinaryFile(filename, num_parts);
+  }
   HypernodeID num_hypernodes;
   HyperedgeID num_hyperedges;
   HyperedgeIndexVector index_vector;
   HyperedgeVector edge_vector;
   HypernodeWeightVector hypernode_weights;
   HyperedgeWeightVector hyperedge_weights;
-  readHypergraphFile(filename, num_hypernodes, num_hyperedges,
-                     index_vector, edge_vector, &hyperedge_weights, &hypernode_weights);
+  readHypergraphFileParallel(filename, num_hypernodes, num_hyperedges, index_vector, edge_vector,
+                             &hyperedge_weights, &hypernode_weights, num_threads);
   return Hypergraph(num_hypernodes, num_hyperedges, index_vector, edge_vector,
                     num_parts, &hyperedge_weights, &hypernode_weights);
 }
@@ -405,24 +427,22 @@ static inline void writePartitionFile(const Hypergraph& hypergraph, const std::s
   }
 }
 
-static inline void readFixedVertexFile(Hypergraph& hypergraph, const std::string& filename) {
-  ASSERT(!filename.empty(), "No filename for partition file specified");
-  std::ifstream file(filename);
-  if (file) {
-    PartitionID part;
-    HypernodeID hn = 0;
-    while (file >> part) {
-      if (part != -1) {
-        hypergraph.setFixedVertex(hn, part);
-      }
-      hn++;
+static inline void writePartitionFile(const std::vector<PartitionID>& partition,
+                                      const std::string& filename) {
+  if (!filename.empty()) {
+    std::ofstream out_stream(filename.c_str());
+    for (const PartitionID& part : partition) {
+      out_stream << part << std::endl;
     }
-    file.close();
-  } else {
-    std::cerr << "Error: File not found: " << filename << std::endl;
+    out_stream.close();
   }
 }
 
+static inline void readFixedVertexFile(Hypergraph& hypergraph, const std::string& filename,
+                                       const size_t num_threads = 1) {
+  readFixedVertexFileParallel(hypergraph, filename, num_threads);
+}
+
 static inline void writeFixedVertexFile(const Hypergraph& hypergraph, const std::string& filename) {
   ASSERT(!filename.empty(), "No filename for partition file specified");
   std::ofstream out_stream(filename.c_str());
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace io {
+/*!
+ * Reads the hyperedges of an hMetis file one at a time without materializing
+ * the hypergraph. Only the hypernode weights (which hMetis stores after the
+ * hyperedges) are kept in memory, i.e., the stream uses O(n + max |e|) space.
+ * Duplicate pins of a hyperedge are removed.
+ */
+class HMetisNetStream {
+ public:
+  explicit HMetisNetStream(const std::string& filename) :
+    _file(filename),
+    _num_nodes(0),
+    _num_nets(0),
+    _next_net(0),
+    _has_hyperedge_weights(false),
+    _first_net(),
+    _node_weights(),
+    _line() {
+    if (!_file) {
+      std::cerr << "Error: File not found: " << filename << std::endl;
+      std::exit(1);
+    }
+    if (isBinaryHypergraphFile(filename)) {
+      std::cerr << "Error: Streaming mode only supports hypergraphs in hMetis format" << std::endl;
+      std::exit(1);
+    }
+    HypergraphType type = HypergraphType::Unweighted;
+    readHGRHeader(_file, _num_nets, _num_nodes, type);
+    _has_hyperedge_weights = type == HypergraphType::EdgeWeights ||
+                             type == HypergraphType::EdgeAndNodeWeights;
+    _first_net = _file.tellg();
+
+    if (type == HypergraphType::NodeWeights || type == HypergraphType::EdgeAndNodeWeights) {
+      // Hypernode weights follow the hyperedges. We skip the hyperedges once
+      // and then start over at the first hyperedge.
+      while (_next_net < _num_nets) {
+        nextLine();
+        ++_next_net;
+      }
+      _node_weights.resize(_num_nodes);
+      for (HypernodeID hn = 0; hn < _num_nodes; ++hn) {
+        nextLine();
+        std::istringstream line_stream(_line);
+        line_stream >> _node_weights[hn];
+      }
+      rewind();
+    }
+  }
+
+  HMetisNetStream(const HMetisNetStream&) = delete;
+  HMetisNetStream& operator= (const HMetisNetStream&) = delete;
+
+  HMetisNetStream(HMetisNetStream&&) = default;
+  HMetisNetStream& operator= (HMetisNetStream&&) = default;
+
+  ~HMetisNetStream() = default;
+
+  HypernodeID numNodes() const {
+    return _num_nodes;
+  }
+
+  HyperedgeID numNets() const {
+    return _num_nets;
+  }
+
+  HypernodeWeight nodeWeight(const HypernodeID hn) const {
+    ASSERT(hn < _num_nodes, V(hn));
+    return _node_weights.empty() ? 1 : _node_weights[hn];
+  }
+
+  // ! Reads the next hyperedge. Returns false if all hyperedges have been read.
+  bool next(std::vector<HypernodeID>& pins, HyperedgeWeight& weight) {
+    if (_next_net == _num_nets) {
+      return false;
+    }
+    nextLine();
+    std::istringstream line_stream(_line);
+    if (line_stream.peek() == EOF) {
+      std::cerr << "Error: Hyperedge " << _next_net << " is empty" << std::endl;
+      std::exit(1);
+    }
+    weight = 1;
+    if (_has_hyperedge_weights) {
+      line_stream >> weight;
+    }
+    pins.clear();
+    HypernodeID pin = 0;
+    while (line_stream >> pin) {
+      // Hypernode IDs start from 0
+      --pin;
+      ASSERT(pin < _num_nodes, "Invalid hypernode ID");
+      pins.push_back(pin);
+    }
+    std::sort(pins.begin(), pins.end());
+    pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+    ++_next_net;
+    return true;
+  }
+
+  // ! Starts over at the first hyperedge.
+  void rewind() {
+    _file.clear();
+    _file.seekg(_first_net);
+    _next_net = 0;
+  }
+
+ private:
+  void nextLine() {
+    std::getline(_file, _line);
+    // skip any comments
+    while (_file && _line[0] == '%') {
+      std::getline(_file, _line);
+    }
+  }
+
+  std::ifstream _file;
+  HypernodeID _num_nodes;
+  HyperedgeID _num_nets;
+  HyperedgeID _next_net;
+  bool _has_hyperedge_weights;
+  std::streampos _first_net;
+  std::vector<HypernodeWeight> _node_weights;
+  std::string _line;
+};
+}  // namespace io
+}  // namespace kahypar
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kahypar {
+namespace io {
+/*!
+ * Read-only view of the content of a file. On POSIX systems, the file is
+ * memory-mapped, on Windows it is read into a buffer. In both cases, the
+ * data is aligned to 8 bytes.
+ */
+class MemoryMappedFile {
+ public:
+  explicit MemoryMappedFile(const std::string& filename) :
+    _data(nullptr),
+    _size(0),
+    _buffer() {
+#if defined(_WIN32)
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+      std::cerr << "Error: File not found: " << filename << std::endl;
+      std::exit(1);
+    }
+    const std::string content((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    _buffer.resize((content.size() + 7) / 8);
+    std::memcpy(_buffer.data(), content.data(), content.size());
+    _data = reinterpret_cast<const char*>(_buffer.data());
+    _size = content.size();
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Error: File not found: " << filename << std::endl;
+      std::exit(1);
+    }
+    struct stat file_info;
+    fstat(fd, &file_info);
+    _size = file_info.st_size;
+    if (_size > 0) {
+      void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        std::cerr << "Error: Could not map file: " << filename << std::endl;
+        std::exit(1);
+      }
+      _data = static_cast<const char*>(data);
+    }
+    close(fd);
+#endif
+  }
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator= (const MemoryMappedFile&) = delete;
+
+  MemoryMappedFile(MemoryMappedFile&&) = delete;
+  MemoryMappedFile& operator= (MemoryMappedFile&&) = delete;
+
+  ~MemoryMappedFile() {
+#if !defined(_WIN32)
+    if (_data != nullptr) {
+      munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+  }
+
+  const char* begin() const {
+    return _data;
+  }
+
+  const char* end() const {
+    return _data + _size;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  const char* _data;
+  size_t _size;
+  // ! Only used if the file cannot be mapped. uint64_t guarantees the alignment.
+  std::vector<uint64_t> _buffer;
+};
+}  // namespace io
+}  // namespace kahypar
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/definitions.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+#include "kahypar/utils/thread_pool.h"
+
+namespace kahypar {
+namespace io {
+namespace internal {
+// ! Files are split into line-aligned chunks of roughly this many bytes.
+static constexpr size_t kParserChunkSize = 1 << 20;
+
+static inline bool isWhitespace(const char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+// ! Returns the position of the '\n' terminating the line that contains pos (or end).
+static inline const char* lineEnd(const char* pos, const char* end) {
+  const void* newline = std::memchr(pos, '\n', end - pos);
+  return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+static inline const char* nextLine(const char* pos, const char* end) {
+  const char* line_end = lineEnd(pos, end);
+  return line_end == end ? end : line_end + 1;
+}
+
+/*!
+ * Parses the next integer in [pos, end) and advances pos behind it.
+ * Like operator>> of std::istream, leading whitespace is skipped and false is
+ * returned if no integer could be read.
+ */
+template <typename T>
+static inline bool scanInteger(const char*& pos, const char* end, T& value) {
+  while (pos != end && isWhitespace(*pos)) {
+    ++pos;
+  }
+  const bool negative = pos != end && *pos == '-';
+  if (pos != end && (*pos == '-' || *pos == '+')) {
+    ++pos;
+  }
+  if (pos == end || *pos < '0' || *pos > '9') {
+    return false;
+  }
+  T result = 0;
+  while (pos != end && *pos >= '0' && *pos <= '9') {
+    result = 10 * result + static_cast<T>(*pos - '0');
+    ++pos;
+  }
+  value = negative ? static_cast<T>(0 - result) : result;
+  return true;
+}
+
+// ! Splits [begin, end) into chunks of roughly chunk_size bytes that start at the beginning of a line.
+static inline std::vector<const char*> lineAlignedChunks(const char* begin, const char* end,
+                                                         const size_t chunk_size) {
+  std::vector<const char*> boundaries = { begin };
+  while (boundaries.back() != end) {
+    const char* chunk_begin = boundaries.back();
+    const size_t size = std::min(chunk_size, static_cast<size_t>(end - chunk_begin));
+    boundaries.push_back(nextLine(chunk_begin + size - 1, end));
+  }
+  return boundaries;
+}
+
+// ! Calls f(line_begin, line_end) for each line of the chunk that is not a comment.
+template <typename F>
+static inline void forEachDataLine(const char* begin, const char* end, const F& f) {
+  const char* pos = begin;
+  while (pos != end) {
+    const char* line_end = lineEnd(pos, end);
+    if (*pos != '%') {
+      f(pos, line_end);
+    }
+    pos = line_end == end ? end : line_end + 1;
+  }
+}
+
+struct ParsedChunk {
+  std::vector<HypernodeID> pins;
+  std::vector<std::pair<HyperedgeID, HypernodeID> > duplicate_pins;
+};
+}  // namespace internal
+
+/*!
+ * Multi-threaded variant of readHypergraphFile for hMetis files.
+ *
+ * The file is memory-mapped and split into line-aligned chunks. A first pass
+ * counts the non-comment lines of each chunk, which determines the hyperedge
+ * or hypernode the lines of each chunk belong to. The second pass parses all
+ * chunks in parallel. Hyperedge sizes are stored in the index vector, which
+ * is turned into offsets via a prefix sum, before the pins of each chunk are
+ * copied to their final position in the edge vector.
+ *
+ * The result (including warnings and errors) is identical to that of the
+ * sequential parser.
+ */
+static inline void readHypergraphFileParallel(const std::string& filename,
+                                              HypernodeID& num_hypernodes,
+                                              HyperedgeID& num_hyperedges,
+                                              HyperedgeIndexVector& index_vector,
+                                              HyperedgeVector& edge_vector,
+                                              HyperedgeWeightVector* hyperedge_weights,
+                                              HypernodeWeightVector* hypernode_weights,
+                                              const size_t num_threads,
+                                              const size_t chunk_size = internal::kParserChunkSize) {
+  ASSERT(!filename.empty(), "No filename for hypergraph file specified");
+  ASSERT(chunk_size > 0, V(chunk_size));
+  const MemoryMappedFile file(filename);
+
+  const char* header = file.begin();
+  while (header != file.end() && *header == '%') {
+    header = internal::nextLine(header, file.end());
+  }
+  const char* header_end = internal::lineEnd(header, file.end());
+  int type = 0;
+  num_hyperedges = 0;
+  num_hypernodes = 0;
+  if (internal::scanInteger(header, header_end, num_hyperedges) &&
+      internal::scanInteger(header, header_end, num_hypernodes)) {
+    internal::scanInteger(header, header_end, type);
+  }
+  const HypergraphType hypergraph_type = static_cast<HypergraphType>(type);
+  ASSERT(hypergraph_type == HypergraphType::Unweighted ||
+         hypergraph_type == HypergraphType::EdgeWeights ||
+         hypergraph_type == HypergraphType::NodeWeights ||
+         hypergraph_type == HypergraphType::EdgeAndNodeWeights,
+         "Hypergraph in file has wrong type");
+
+  const bool has_hyperedge_weights = hypergraph_type == HypergraphType::EdgeWeights ||
+                                     hypergraph_type == HypergraphType::EdgeAndNodeWeights;
+  const bool has_hypernode_weights = hypergraph_type == HypergraphType::NodeWeights ||
+                                     hypergraph_type == HypergraphType::EdgeAndNodeWeights;
+  const bool read_hyperedge_weights = has_hyperedge_weights && hyperedge_weights != nullptr;
+  const bool read_hypernode_weights = has_hypernode_weights && hypernode_weights != nullptr;
+  if (has_hyperedge_weights && !read_hyperedge_weights) {
+    LOG << "****** ignoring hyperedge weights ******";
+  }
+  if (has_hypernode_weights && !read_hypernode_weights) {
+    LOG << " ****** ignoring hypernode weights ******";
+  }
+
+  const std::vector<const char*> chunks =
+    internal::lineAlignedChunks(header_end == file.end() ? file.end() : header_end + 1,
+                                file.end(), chunk_size);
+  const size_t num_chunks = chunks.size() - 1;
+  ThreadPool pool(num_threads);
+
+  // first_line[c] is the number of non-comment lines preceding chunk c. The
+  // first num_hyperedges lines are hyperedges, the next num_hypernodes lines
+  // are hypernode weights.
+  std::vector<size_t> first_line(num_chunks + 1, 0);
+  pool.parallelFor(0, num_chunks, 1, [&](const size_t, const size_t begin, const size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        internal::forEachDataLine(chunks[c], chunks[c + 1], [&](const char*, const char*) {
+            ++first_line[c + 1];
+          });
+      }
+    });
+  std::partial_sum(first_line.begin(), first_line.end(), first_line.begin());
+
+  index_vector.assign(static_cast<size_t>(num_hyperedges) +  /*sentinel*/ 1, 0);
+  if (read_hyperedge_weights) {
+    hyperedge_weights->assign(num_hyperedges, 0);
+  }
+  if (read_hypernode_weights) {
+    hypernode_weights->assign(num_hypernodes, 0);
+  }
+
+  constexpr size_t kNoError = std::numeric_limits<size_t>::max();
+  std::vector<internal::ParsedChunk> parsed_chunks(num_chunks);
+  std::vector<ds::FastResetFlagArray<> > contained_pins;
+  for (size_t i = 0; i < pool.numThreads(); ++i) {
+    contained_pins.emplace_back(num_hypernodes);
+  }
+  std::vector<size_t> first_empty_hyperedge(num_chunks, kNoError);
+  std::vector<size_t> first_invalid_hyperedge(num_chunks, kNoError);
+  std::vector<size_t> first_zero_weight_hypernode(num_chunks, kNoError);
+  pool.parallelFor(0, num_chunks, 1, [&](const size_t worker, const size_t begin,
+                                         const size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        internal::ParsedChunk& parsed = parsed_chunks[c];
+        size_t line = first_line[c];
+        internal::forEachDataLine(chunks[c], chunks[c + 1], [&](const char* pos,
+                                                                const char* line_end) {
+            if (line < num_hyperedges) {
+              const HyperedgeID he = line;
+              if (pos == line_end) {
+                first_empty_hyperedge[c] = std::min(first_empty_hyperedge[c], line);
+              }
+              if (has_hyperedge_weights) {
+                HyperedgeWeight edge_weight = 0;
+                internal::scanInteger(pos, line_end, edge_weight);
+                if (read_hyperedge_weights) {
+                  (*hyperedge_weights)[he] = edge_weight;
+                }
+              }
+              ds::FastResetFlagArray<>& contained = contained_pins[worker];
+              contained.reset();
+              const size_t first_pin = parsed.pins.size();
+              HypernodeID pin;
+              while (internal::scanInteger(pos, line_end, pin)) {
+                // Hypernode IDs start from 0
+                --pin;
+                if (pin >= num_hypernodes) {
+                  first_invalid_hyperedge[c] = std::min(first_invalid_hyperedge[c], line);
+                  break;
+                }
+                if (contained[pin]) {
+                  parsed.duplicate_pins.emplace_back(he, pin);
+                  continue;
+                }
+                contained.set(pin);
+                parsed.pins.push_back(pin);
+              }
+              index_vector[static_cast<size_t>(he) + 1] = parsed.pins.size() - first_pin;
+            } else if (read_hypernode_weights && line < num_hyperedges + num_hypernodes) {
+              const HypernodeID hn = line - num_hyperedges;
+              HypernodeWeight node_weight = 0;
+              internal::scanInteger(pos, line_end, node_weight);
+              if (node_weight == 0) {
+                first_zero_weight_hypernode[c] = std::min(first_zero_weight_hypernode[c],
+                                                          static_cast<size_t>(hn));
+              }
+              (*hypernode_weights)[hn] = node_weight;
+            }
+            ++line;
+          });
+      }
+    });
+
+  const size_t first_empty = std::min(first_line.back() < num_hyperedges ?
+                                      first_line.back() : kNoError,
+                                      *std::min_element(first_empty_hyperedge.begin(),
+                                                        first_empty_hyperedge.end()));
+  for (const internal::ParsedChunk& parsed : parsed_chunks) {
+    for (const auto& duplicate : parsed.duplicate_pins) {
+      if (duplicate.first < first_empty) {
+        std::cerr << "Warning: Ignoring duplicate pin " << duplicate.second
+                  << " of hyperedge " << duplicate.first << std::endl;
+      }
+    }
+  }
+  if (first_empty != kNoError) {
+    std::cerr << "Error: Hyperedge " << first_empty << " is empty" << std::endl;
+    exit(1);
+  }
+  const size_t first_invalid = *std::min_element(first_invalid_hyperedge.begin(),
+                                                 first_invalid_hyperedge.end());
+  if (first_invalid != kNoError) {
+    std::cerr << "Error: Hyperedge " << first_invalid << " contains an invalid hypernode ID"
+              << std::endl;
+    exit(1);
+  }
+  if (read_hypernode_weights && (first_line.back() < num_hyperedges + num_hypernodes ||
+                                 *std::min_element(first_zero_weight_hypernode.begin(),
+                                                   first_zero_weight_hypernode.end()) !=
+                                 kNoError)) {
+    std::cerr << "Vertices with a weight of 0 are not supported. The minimum allowed vertex weight is 1." << std::endl;
+    std::exit(-1);
+  }
+
+  std::partial_sum(index_vector.begin(), index_vector.end(), index_vector.begin());
+  edge_vector.resize(index_vector.back());
+  pool.parallelFor(0, num_chunks, 1, [&](const size_t, const size_t begin, const size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        const size_t first_hyperedge = std::min(first_line[c], static_cast<size_t>(num_hyperedges));
+        std::copy(parsed_chunks[c].pins.begin(), parsed_chunks[c].pins.end(),
+                  edge_vector.begin() + index_vector[first_hyperedge]);
+      }
+    });
+}
+
+/*!
+ * Multi-threaded variant of readFixedVertexFile. The file is parsed in
+ * parallel, fixed vertices are then assigned sequentially.
+ */
+static inline void readFixedVertexFileParallel(Hypergraph& hypergraph,
+                                               const std::string& filename,
+                                               const size_t num_threads,
+                                               const size_t chunk_size = internal::kParserChunkSize) {
+  ASSERT(!filename.empty(), "No filename for partition file specified");
+  const MemoryMappedFile file(filename);
+  const std::vector<const char*> chunks =
+    internal::lineAlignedChunks(file.begin(), file.end(), chunk_size);
+  const size_t num_chunks = chunks.size() - 1;
+
+  // Like operator>>, parsing stops at the first token that is not an integer.
+  std::vector<std::vector<PartitionID> > parts(num_chunks);
+  std::vector<bool> reached_end_of_input(num_chunks, false);
+  ThreadPool pool(num_threads);
+  pool.parallelFor(0, num_chunks, 1, [&](const size_t, const size_t begin, const size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        const char* pos = chunks[c];
+        PartitionID part;
+        while (internal::scanInteger(pos, chunks[c + 1], part)) {
+          parts[c].push_back(part);
+        }
+        reached_end_of_input[c] = pos == chunks[c + 1];
+      }
+    });
+
+  HypernodeID hn = 0;
+  for (size_t c = 0; c < num_chunks; ++c) {
+    for (const PartitionID part : parts[c]) {
+      if (part != -1) {
+        hypergraph.setFixedVertex(hn, part);
+      }
+      hn++;
+    }
+    if (!reached_end_of_input[c]) {
+      break;
+    }
+  }
+}
+}  // namespace io
+}  // namespace kahypar
@@ -228,7 +228,7 @@ inline void printPartitioningResults(const Hypergraph& hypergraph,
     LOG << "\nPartition sizes and weights: ";
     printPartSizesAndWeights(hypergraph);
 
-    const auto& timings = Timer::instance().result();
+    const auto& timings = context.timer->result();
 
     LOG << "\nTimings:";
     LOG << "Partition time                     =" << elapsed_seconds.count() << "s";
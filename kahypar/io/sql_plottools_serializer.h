@@ -41,7 +41,7 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
   if (!context.partition.sp_process_output) {
     return;
   }
-  const auto& timings = Timer::instance().result();
+  const auto& timings = context.timer->result();
 
   std::stringstream algo_name;
 
@@ -49,6 +49,8 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
     algo_name << "r";
   } else if (context.partition.mode == Mode::direct_kway) {
     algo_name << "k";
+  } else if (context.partition.mode == Mode::streaming) {
+    algo_name << "s";
   } else {
     algo_name << "UnknownMode";
   }
@@ -172,7 +174,8 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
       << context.initial_partitioning.local_search.iterations_per_level;
   if (context.initial_partitioning.local_search.algorithm == RefinementAlgorithm::twoway_fm ||
       context.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm ||
-      context.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm_km1) {
+      context.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      context.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm_parallel) {
     oss << " IP_local_search_fm_stopping_rule="
         << context.initial_partitioning.local_search.fm.stopping_rule
         << " IP_local_search_fm_max_number_of_fruitless_moves="
@@ -184,7 +187,8 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
       << " local_search_iterations_per_level=" << context.local_search.iterations_per_level;
   if (context.local_search.algorithm == RefinementAlgorithm::twoway_fm ||
       context.local_search.algorithm == RefinementAlgorithm::kway_fm ||
-      context.local_search.algorithm == RefinementAlgorithm::kway_fm_km1) {
+      context.local_search.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      context.local_search.algorithm == RefinementAlgorithm::kway_fm_parallel) {
     oss << " local_search_fm_stopping_rule=" << context.local_search.fm.stopping_rule
         << " local_search_fm_max_number_of_fruitless_moves="
         << context.local_search.fm.max_number_of_fruitless_moves
@@ -251,6 +255,58 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
   std::cout << oss.str() << std::endl;
 }
 
+// ! RESULT line of streaming mode, in which the hypergraph is never materialized.
+template <typename StreamingPartitioner>
+static inline void serializeStreaming(const Context& context, const StreamingPartitioner& partitioner,
+                                      const HypernodeID num_hypernodes,
+                                      const HyperedgeID num_hyperedges,
+                                      const HypernodeWeight total_weight,
+                                      const std::chrono::duration<double>& elapsed_seconds) {
+  if (!context.partition.sp_process_output) {
+    return;
+  }
+  const auto& timings = context.timer->result();
+
+  std::ostringstream oss;
+  oss << "RESULT"
+      << " algorithm=sKaHyPar"
+      << " graph=" << context.partition.graph_filename.substr(context.partition.graph_filename.find_last_of('/') + 1)
+      << " numHNs=" << num_hypernodes
+      << " numHEs=" << num_hyperedges
+      << " mode=" << context.partition.mode
+      << " objective=" << context.partition.objective
+      << " k=" << context.partition.k
+      << " epsilon=" << context.partition.epsilon
+      << " seed=" << context.partition.seed
+      << " total_graph_weight=" << total_weight
+      << " L_opt=" << context.partition.perfect_balance_part_weights[0]
+      << " L_max=" << context.partition.max_part_weights[0]
+      << " stream_gamma=" << context.streaming.gamma
+      << " stream_restreaming_passes=" << context.streaming.restreaming_passes
+      << " stream_window_size=" << context.streaming.window_size;
+  for (PartitionID i = 0; i != context.partition.k; ++i) {
+    oss << " partSize" << i << "=" << partitioner.partSize(i);
+  }
+  for (PartitionID i = 0; i != context.partition.k; ++i) {
+    oss << " partWeight" << i << "=" << partitioner.partWeight(i);
+  }
+  oss << " cut=" << partitioner.cut()
+      << " km1=" << partitioner.km1()
+      << " imbalance=" << partitioner.imbalance()
+      << " totalPartitionTime=" << elapsed_seconds.count()
+      << " minHashSparsifierTime=" << timings.pre_sparsifier
+      << " communityDetectionTime=" << timings.pre_community_detection
+      << " coarseningTime=" << timings.total_coarsening
+      << " initialPartitionTime=" << timings.total_initial_partitioning
+      << " uncoarseningRefinementTime=" << timings.total_local_search
+      << " flowTime=" << timings.total_flow_refinement
+      << " postMinHashSparsifierTime=" << timings.post_sparsifier_restore
+      << " git=" << STR(KaHyPar_BUILD_VERSION)
+      << std::endl;
+
+  std::cout << oss.str() << std::endl;
+}
+
 static inline void serializeEvolutionary(const Context& context, const Hypergraph& hg) {
   std::ostringstream oss;
   if (context.partition.quiet_mode) {
@@ -276,7 +332,7 @@ static inline void serializeEvolutionary(const Context& context, const Hypergrap
   oss << "RESULT "
       << "connectivity=" << metrics::km1(hg)
       << " action=" << context.evolutionary.action.decision()
-      << " time-total=" << Timer::instance().evolutionaryResult().total_evolutionary
+      << " time-total=" << context.timer->evolutionaryResult().total_evolutionary
       << " iteration=" << context.evolutionary.iteration
       << " replace-strategy=" << context.evolutionary.replace_strategy
       << " combine-strategy=" << combine_strat
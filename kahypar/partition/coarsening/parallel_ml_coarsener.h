@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+#include "kahypar/partition/coarsening/i_coarsener.h"
+#include "kahypar/partition/coarsening/policies/fixed_vertex_acceptance_policy.h"
+#include "kahypar/partition/coarsening/policies/rating_acceptance_policy.h"
+#include "kahypar/partition/coarsening/policies/rating_community_policy.h"
+#include "kahypar/partition/coarsening/policies/rating_heavy_node_penalty_policy.h"
+#include "kahypar/partition/coarsening/policies/rating_partition_policy.h"
+#include "kahypar/partition/coarsening/policies/rating_score_policy.h"
+#include "kahypar/partition/coarsening/policies/rating_tie_breaking_policy.h"
+#include "kahypar/partition/coarsening/vertex_pair_coarsener_base.h"
+#include "kahypar/partition/coarsening/vertex_pair_rater.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
+
+namespace kahypar {
+/*!
+ * Multi-threaded variant of the MLCoarsener.
+ *
+ * Each pass consists of two phases:
+ *  1.) All nodes of the current hypergraph are rated concurrently. Since the
+ *      hypergraph is not modified in this phase, every node determines its
+ *      preferred contraction partner w.r.t. the hypergraph at the beginning of the pass.
+ *  2.) The preferred contractions are applied sequentially in the (random) order
+ *      of the pass. Contested targets are resolved in favor of the node that comes
+ *      first: contractions whose representative or partner has already been
+ *      contracted are dropped, and all other contractions are only performed if
+ *      they still satisfy the node weight threshold and the fixed vertex policy.
+ *
+ * Since all contractions are performed via CoarsenerBase::performContraction,
+ * the contraction history can be replayed by VertexPairCoarsenerBase::doUncoarsen.
+ *
+ * The nodes of a pass are split into chunks of fixed size. Each chunk uses its
+ * own random number generator that is seeded based on the pass seed and the
+ * chunk index. Thus the tie-breaking of the ratings and therefore the resulting
+ * hierarchy does not depend on which thread processes which chunk.
+ */
+template <class ScorePolicy = HeavyEdgeScore,
+          class HeavyNodePenaltyPolicy = NoWeightPenalty,
+          class CommunityPolicy = UseCommunityStructure,
+          class RatingPartitionPolicy = NormalPartitionPolicy,
+          class AcceptancePolicy = BestRatingPreferringUnmatched<>,
+          class FixedVertexPolicy = AllowFreeOnFixedFreeOnFreeFixedOnFixed,
+          typename RatingType = RatingType>
+class ParallelMLCoarsener final : public ICoarsener,
+                                  private VertexPairCoarsenerBase<>{
+ private:
+  static constexpr bool debug = false;
+
+  static constexpr HypernodeID kInvalidTarget = std::numeric_limits<HypernodeID>::max();
+  static constexpr size_t kChunkSize = 1024;
+
+  using Base = VertexPairCoarsenerBase;
+  using Rater = VertexPairRater<ScorePolicy,
+                                HeavyNodePenaltyPolicy,
+                                CommunityPolicy,
+                                RatingPartitionPolicy,
+                                AcceptancePolicy,
+                                FixedVertexPolicy,
+                                RatingType>;
+  using Rating = typename Rater::Rating;
+
+ public:
+  ParallelMLCoarsener(Hypergraph& hypergraph, const Context& context,
+                      const HypernodeWeight weight_of_heaviest_node) :
+    Base(hypergraph, context, weight_of_heaviest_node),
+    _pool(context.partition.num_threads),
+    _raters(),
+    _targets(_hg.initialNumNodes(), kInvalidTarget) {
+    for (size_t i = 0; i < _pool.numThreads(); ++i) {
+      _raters.emplace_back(std::make_unique<Rater>(_hg, _context));
+    }
+  }
+
+  ~ParallelMLCoarsener() override = default;
+
+  ParallelMLCoarsener(const ParallelMLCoarsener&) = delete;
+  ParallelMLCoarsener& operator= (const ParallelMLCoarsener&) = delete;
+
+  ParallelMLCoarsener(ParallelMLCoarsener&&) = delete;
+  ParallelMLCoarsener& operator= (ParallelMLCoarsener&&) = delete;
+
+ private:
+  void coarsenImpl(const HypernodeID limit) override final {
+    int pass_nr = 0;
+    std::vector<HypernodeID> current_hns;
+    while (_hg.currentNumFreeVertices() > limit) {
+      DBG << V(pass_nr);
+      DBG << V(_hg.currentNumNodes());
+      DBG << V(_hg.currentNumEdges());
+      current_hns.clear();
+      const HypernodeID num_hns_before_pass = _hg.currentNumNodes();
+      for (const HypernodeID& hn : _hg.nodes()) {
+        current_hns.push_back(hn);
+      }
+      Randomize::instance().shuffleVector(current_hns, current_hns.size());
+
+      rateNodes(current_hns, Randomize::instance().newRandomSeed());
+
+      for (const HypernodeID& hn : current_hns) {
+        const HypernodeID target = _targets[hn];
+        if (target != kInvalidTarget && acceptContraction(hn, target)) {
+          performContraction(hn, target);
+          if (_hg.currentNumFreeVertices() <= limit) {
+            break;
+          }
+        }
+      }
+      std::fill(_targets.begin(), _targets.end(), kInvalidTarget);
+
+      if (num_hns_before_pass == _hg.currentNumNodes()) {
+        break;
+      }
+      ++pass_nr;
+    }
+
+    finalizeProgressBar();
+  }
+
+  bool uncoarsenImpl(IRefiner& refiner) override final {
+    return doUncoarsen(refiner);
+  }
+
+  // ! Computes the preferred contraction partner of each node in hns concurrently.
+  void rateNodes(const std::vector<HypernodeID>& hns, const int pass_seed) {
+    _pool.parallelFor(0, hns.size(), kChunkSize,
+                      [&](const size_t worker, const size_t begin, const size_t end) {
+        // The tie-breaking policies use the random number generator of the
+        // calling thread. It is reseeded for each chunk and restored afterwards
+        // to keep the random sequence of the main thread independent of the
+        // number of threads.
+        Randomize& randomize = Randomize::instance();
+        const std::mt19937 generator = randomize.getGenerator();
+        randomize.setSeed(pass_seed ^ static_cast<int>(begin / kChunkSize));
+        Rater& rater = *_raters[worker];
+        for (size_t i = begin; i < end; ++i) {
+          const Rating rating = rater.rate(hns[i]);
+          if (rating.valid) {
+            _targets[hns[i]] = rating.target;
+          }
+        }
+        randomize.getGenerator() = generator;
+      });
+  }
+
+  // ! Checks whether the contraction proposed at the beginning of the pass is still valid.
+  bool acceptContraction(const HypernodeID rep_node, const HypernodeID contracted_node) const {
+    return _hg.nodeIsEnabled(rep_node) && _hg.nodeIsEnabled(contracted_node) &&
+           _hg.nodeWeight(rep_node) + _hg.nodeWeight(contracted_node) <=
+           _context.coarsening.max_allowed_node_weight &&
+           FixedVertexPolicy::acceptContraction(_hg, _context, rep_node, contracted_node);
+  }
+
+  using Base::_pq;
+  using Base::_hg;
+  using Base::_context;
+  using Base::_history;
+  ThreadPool _pool;
+  std::vector<std::unique_ptr<Rater> > _raters;
+  std::vector<HypernodeID> _targets;
+};
+}  // namespace kahypar
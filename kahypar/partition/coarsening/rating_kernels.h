@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define KAHYPAR_HAS_X86_RATING_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace kahypar {
+namespace rating {
+/*!
+ * Batched kernels used by the VertexPairRater to turn the accumulated scores
+ * of all contraction candidates into ratings:
+ *
+ *   rating[i] = score[i] / penalty'[i], where
+ *   penalty'[i] = penalty[i] != 0 ? penalty[i] : max(weight_u, weight[i], 1)
+ *
+ * The AVX2 and AVX-512 versions are compiled via target attributes and chosen
+ * at runtime based on the features of the CPU. Since IEEE division is exact
+ * up to rounding, all versions compute bit-identical ratings.
+ */
+enum class Kernel : uint8_t {
+  scalar,
+  avx2,
+  avx512
+};
+
+static inline std::string toString(const Kernel kernel) {
+  switch (kernel) {
+    case Kernel::scalar: return "scalar";
+    case Kernel::avx2: return "avx2";
+    case Kernel::avx512: return "avx512";
+  }
+  return "UNDEFINED";
+}
+
+using KernelFunction = void (*)(const RatingType*, const HypernodeWeight*, const HypernodeWeight*,
+                                HypernodeWeight, size_t, RatingType*);
+
+static inline void computeRatingsScalar(const RatingType* score, const HypernodeWeight* penalty,
+                                        const HypernodeWeight* weight, const HypernodeWeight weight_u,
+                                        const size_t n, RatingType* rating) {
+  for (size_t i = 0; i < n; ++i) {
+    const HypernodeWeight p = penalty[i] == 0 ? std::max(std::max(weight_u, weight[i]), 1) : penalty[i];
+    rating[i] = score[i] / static_cast<double>(p);
+  }
+}
+
+#ifdef KAHYPAR_HAS_X86_RATING_KERNELS
+__attribute__((target("avx2")))
+static inline void computeRatingsAVX2(const RatingType* score, const HypernodeWeight* penalty,
+                                      const HypernodeWeight* weight, const HypernodeWeight weight_u,
+                                      const size_t n, RatingType* rating) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i fallback_min = _mm_max_epi32(_mm_set1_epi32(weight_u), _mm_set1_epi32(1));
+  size_t i = 0;
+  for ( ; i + 4 <= n; i += 4) {
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(penalty + i));
+    const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weight + i));
+    const __m128i fallback = _mm_max_epi32(fallback_min, w);
+    const __m128i fixed_penalty = _mm_blendv_epi8(p, fallback, _mm_cmpeq_epi32(p, zero));
+    const __m256d s = _mm256_loadu_pd(score + i);
+    _mm256_storeu_pd(rating + i, _mm256_div_pd(s, _mm256_cvtepi32_pd(fixed_penalty)));
+  }
+  computeRatingsScalar(score + i, penalty + i, weight + i, weight_u, n - i, rating + i);
+}
+
+__attribute__((target("avx512f")))
+static inline void computeRatingsAVX512(const RatingType* score, const HypernodeWeight* penalty,
+                                        const HypernodeWeight* weight, const HypernodeWeight weight_u,
+                                        const size_t n, RatingType* rating) {
+  const __m256i fallback_min = _mm256_max_epi32(_mm256_set1_epi32(weight_u), _mm256_set1_epi32(1));
+  size_t i = 0;
+  for ( ; i + 8 <= n; i += 8) {
+    const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(penalty + i));
+    const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weight + i));
+    const __m256i fallback = _mm256_max_epi32(fallback_min, w);
+    const __m256i fixed_penalty = _mm256_blendv_epi8(p, fallback,
+                                                     _mm256_cmpeq_epi32(p, _mm256_setzero_si256()));
+    const __m512d s = _mm512_loadu_pd(score + i);
+    _mm512_storeu_pd(rating + i, _mm512_div_pd(s, _mm512_cvtepi32_pd(fixed_penalty)));
+  }
+  computeRatingsScalar(score + i, penalty + i, weight + i, weight_u, n - i, rating + i);
+}
+#endif
+
+// ! Best kernel supported by the CPU.
+static inline Kernel detectKernel() {
+#ifdef KAHYPAR_HAS_X86_RATING_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) {
+    return Kernel::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernel::avx2;
+  }
+#endif
+  return Kernel::scalar;
+}
+
+static inline KernelFunction kernelFunction(const Kernel kernel) {
+  switch (kernel) {
+#ifdef KAHYPAR_HAS_X86_RATING_KERNELS
+    case Kernel::avx512: return &computeRatingsAVX512;
+    case Kernel::avx2: return &computeRatingsAVX2;
+#endif
+    default: return &computeRatingsScalar;
+  }
+}
+
+static inline bool isSupported(const Kernel kernel) {
+  switch (detectKernel()) {
+    case Kernel::avx512: return true;
+    case Kernel::avx2: return kernel != Kernel::avx512;
+    default: return kernel == Kernel::scalar;
+  }
+}
+
+static inline KernelFunction& activeKernelFunction() {
+  static KernelFunction kernel = kernelFunction(detectKernel());
+  return kernel;
+}
+
+// ! Overrides the automatically selected kernel (e.g., for benchmarks).
+static inline void useKernel(const Kernel kernel) {
+  ASSERT(isSupported(kernel), toString(kernel));
+  activeKernelFunction() = kernelFunction(kernel);
+}
+
+static inline void computeRatings(const RatingType* score, const HypernodeWeight* penalty,
+                                  const HypernodeWeight* weight, const HypernodeWeight weight_u,
+                                  const size_t n, RatingType* rating) {
+  activeKernelFunction()(score, penalty, weight, weight_u, n, rating);
+}
+}  // namespace rating
+}  // namespace kahypar
@@ -92,6 +92,7 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
     UncontractionGainChanges changes;
     changes.representative.push_back(0);
     changes.contraction_partner.push_back(0);
+    UncontractionGainChanges batch_changes;
 
     ProgressBar uncontraction_progress_bar(
       _hg.initialNumNodes(), current_metrics.getMetric(
@@ -118,17 +119,24 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
       }
 
       refinement_nodes.clear();
-      refinement_nodes.push_back(_history.back().contraction_memento.u);
-      refinement_nodes.push_back(_history.back().contraction_memento.v);
-
-      uncontract(changes);
-
-      CoarsenerBase::performLocalSearch(refiner, refinement_nodes, current_metrics, changes);
-      changes.representative[0] = 0;
-      changes.contraction_partner[0] = 0;
+      size_t num_uncontractions = 1;
+      if (_context.local_search.uncontraction_batch_size > 1) {
+        num_uncontractions = uncontractBatch(refinement_nodes, changes, batch_changes);
+        CoarsenerBase::performLocalSearch(refiner, refinement_nodes, current_metrics,
+                                          batch_changes);
+      } else {
+        refinement_nodes.push_back(_history.back().contraction_memento.u);
+        refinement_nodes.push_back(_history.back().contraction_memento.v);
+
+        uncontract(changes);
+
+        CoarsenerBase::performLocalSearch(refiner, refinement_nodes, current_metrics, changes);
+        changes.representative[0] = 0;
+        changes.contraction_partner[0] = 0;
+      }
 
       // Update Progress Bar
-      uncontraction_progress_bar += 1;
+      uncontraction_progress_bar += num_uncontractions;
       uncontraction_progress_bar.setObjective(current_metrics.getMetric(
         _context.partition.mode, _context.partition.objective));
     }
@@ -188,6 +196,36 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
     _history.pop_back();
   }
 
+  // ! Undoes up to uncontraction_batch_size contractions at once. Each uncontracted
+  // ! hypernode is added to refinement_nodes exactly once, while the gain changes
+  // ! of the individual uncontractions are collected in uncontraction order.
+  size_t uncontractBatch(std::vector<HypernodeID>& refinement_nodes,
+                         UncontractionGainChanges& changes,
+                         UncontractionGainChanges& batch_changes) {
+    batch_changes.representative.clear();
+    batch_changes.contraction_partner.clear();
+    batch_changes.uncontracted_pairs.clear();
+    const size_t batch_size = std::min(_history.size(),
+                                       static_cast<size_t>(
+                                         _context.local_search.uncontraction_batch_size));
+    for (size_t i = 0; i < batch_size; ++i) {
+      const HypernodeID u = _history.back().contraction_memento.u;
+      const HypernodeID v = _history.back().contraction_memento.v;
+      uncontract(changes);
+      batch_changes.representative.push_back(changes.representative[0]);
+      batch_changes.contraction_partner.push_back(changes.contraction_partner[0]);
+      batch_changes.uncontracted_pairs.emplace_back(u, v);
+      changes.representative[0] = 0;
+      changes.contraction_partner[0] = 0;
+      refinement_nodes.push_back(u);
+      refinement_nodes.push_back(v);
+    }
+    std::sort(refinement_nodes.begin(), refinement_nodes.end());
+    refinement_nodes.erase(std::unique(refinement_nodes.begin(), refinement_nodes.end()),
+                           refinement_nodes.end());
+    return batch_size;
+  }
+
   template <typename Rater>
   void rateAllHypernodes(Rater& rater,
                          std::vector<HypernodeID>& target) {
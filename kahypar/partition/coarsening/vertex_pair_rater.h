@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <limits>
 #include <stack>
+#include <type_traits>
 #include <vector>
 
 #include "kahypar/datastructure/fast_reset_flag_array.h"
@@ -36,6 +37,7 @@
 #include "kahypar/partition/coarsening/policies/rating_partition_policy.h"
 #include "kahypar/partition/coarsening/policies/rating_score_policy.h"
 #include "kahypar/partition/coarsening/policies/rating_tie_breaking_policy.h"
+#include "kahypar/partition/coarsening/rating_kernels.h"
 #include "kahypar/partition/context.h"
 
 namespace kahypar {
@@ -82,7 +84,12 @@ class VertexPairRater {
     _hg(hypergraph),
     _context(context),
     _tmp_ratings(_hg.initialNumNodes()),
-    _already_matched(_hg.initialNumNodes()) { }
+    _already_matched(_hg.initialNumNodes()),
+    _candidate_target(),
+    _candidate_score(),
+    _candidate_penalty(),
+    _candidate_weight(),
+    _candidate_rating() { }
 
   VertexPairRater(const VertexPairRater&) = delete;
   VertexPairRater& operator= (const VertexPairRater&) = delete;
@@ -108,18 +115,23 @@ class VertexPairRater {
       }
     }
 
+    // The candidates are processed in three steps:
+    //  1.) Candidates in the same community as u are gathered into flat arrays
+    //      together with their penalty and weight.
+    //  2.) The ratings of all candidates are computed by a (vectorized) kernel.
+    //  3.) The best rating is selected in the same order as before. Since the
+    //      tie-breaking policies may draw random numbers, this step is not
+    //      vectorized to keep the random sequence and thus the results unchanged.
+    const size_t num_candidates = gatherCandidates(u, weight_u);
+    computeRatings(weight_u, num_candidates);
+
     RatingType max_rating = std::numeric_limits<RatingType>::min();
     HypernodeID target = std::numeric_limits<HypernodeID>::max();
-    for (auto it = _tmp_ratings.end() - 1; it >= _tmp_ratings.begin(); --it) {
-      const HypernodeID tmp_target = it->key;
-      const HypernodeWeight target_weight = _hg.nodeWeight(tmp_target);
-      HypernodeWeight penalty = HeavyNodePenaltyPolicy::penalty(weight_u,
-                                                                target_weight);
-      penalty = penalty == 0 ? std::max(std::max(weight_u, target_weight), 1) : penalty;
-      const RatingType tmp_rating = it->value / static_cast<double>(penalty);
+    for (size_t i = 0; i < num_candidates; ++i) {
+      const HypernodeID tmp_target = _candidate_target[i];
+      const RatingType tmp_rating = _candidate_rating[i];
       DBG << "r(" << u << "," << tmp_target << ")=" << tmp_rating;
-      if (CommunityPolicy::sameCommunity(_hg.communities(), u, tmp_target) &&
-          AcceptancePolicy::acceptRating(tmp_rating, max_rating,
+      if (AcceptancePolicy::acceptRating(tmp_rating, max_rating,
                                          target, tmp_target, _already_matched) &&
           FixedVertexPolicy::acceptContraction(_hg, _context, u, tmp_target)) {
         max_rating = tmp_rating;
@@ -154,6 +166,45 @@ class VertexPairRater {
   }
 
  private:
+  // ! Collects all candidates in the same community as u (in reverse insertion order).
+  size_t gatherCandidates(const HypernodeID u, const HypernodeWeight weight_u) {
+    if (_candidate_target.size() < _tmp_ratings.size()) {
+      _candidate_target.resize(_tmp_ratings.size());
+      _candidate_score.resize(_tmp_ratings.size());
+      _candidate_penalty.resize(_tmp_ratings.size());
+      _candidate_weight.resize(_tmp_ratings.size());
+      _candidate_rating.resize(_tmp_ratings.size());
+    }
+    size_t num_candidates = 0;
+    for (auto it = _tmp_ratings.end() - 1; it >= _tmp_ratings.begin(); --it) {
+      const HypernodeID tmp_target = it->key;
+      if (CommunityPolicy::sameCommunity(_hg.communities(), u, tmp_target)) {
+        const HypernodeWeight target_weight = _hg.nodeWeight(tmp_target);
+        _candidate_target[num_candidates] = tmp_target;
+        _candidate_score[num_candidates] = it->value;
+        _candidate_penalty[num_candidates] = HeavyNodePenaltyPolicy::penalty(weight_u, target_weight);
+        _candidate_weight[num_candidates] = target_weight;
+        ++num_candidates;
+      }
+    }
+    return num_candidates;
+  }
+
+  void computeRatings(const HypernodeWeight weight_u, const size_t num_candidates) {
+    if constexpr (std::is_same<RatingType, double>::value) {
+      rating::computeRatings(_candidate_score.data(), _candidate_penalty.data(),
+                             _candidate_weight.data(), weight_u, num_candidates,
+                             _candidate_rating.data());
+    } else {
+      for (size_t i = 0; i < num_candidates; ++i) {
+        const HypernodeWeight penalty = _candidate_penalty[i] == 0 ?
+                                        std::max(std::max(weight_u, _candidate_weight[i]), 1) :
+                                        _candidate_penalty[i];
+        _candidate_rating[i] = _candidate_score[i] / static_cast<double>(penalty);
+      }
+    }
+  }
+
   bool belowThresholdNodeWeight(const HypernodeWeight weight_u,
                                 const HypernodeWeight weight_v) const {
     return weight_v + weight_u <= _context.coarsening.max_allowed_node_weight;
@@ -163,5 +214,10 @@ class VertexPairRater {
   const Context& _context;
   ds::SparseMap<HypernodeID, RatingType> _tmp_ratings;
   ds::FastResetFlagArray<> _already_matched;
+  std::vector<HypernodeID> _candidate_target;
+  std::vector<RatingType> _candidate_score;
+  std::vector<HypernodeWeight> _candidate_penalty;
+  std::vector<HypernodeWeight> _candidate_weight;
+  std::vector<RatingType> _candidate_rating;
 };
 }  // namespace kahypar
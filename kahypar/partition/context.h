@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <iomanip>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -34,6 +35,7 @@
 #include "kahypar/partition/context_enum_classes.h"
 #include "kahypar/partition/evolutionary/action.h"
 #include "kahypar/utils/stats.h"
+#include "kahypar/utils/timer.h"
 
 namespace kahypar {
 struct MinHashSparsifierParameters {
@@ -209,6 +211,7 @@ struct LocalSearchParameters {
   HyperFlowCutter hyperflowcutter { };
   RefinementAlgorithm algorithm = RefinementAlgorithm::UNDEFINED;
   int iterations_per_level = std::numeric_limits<int>::max();
+  HypernodeID uncontraction_batch_size = 1;
 };
 
 
@@ -216,9 +219,11 @@ inline std::ostream& operator<< (std::ostream& str, const LocalSearchParameters&
   str << "Local Search Parameters:" << std::endl;
   str << "  Algorithm:                          " << params.algorithm << std::endl;
   str << "  iterations per level:               " << params.iterations_per_level << std::endl;
+  str << "  uncontraction batch size:           " << params.uncontraction_batch_size << std::endl;
   if (params.algorithm == RefinementAlgorithm::twoway_fm ||
       params.algorithm == RefinementAlgorithm::kway_fm ||
       params.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      params.algorithm == RefinementAlgorithm::kway_fm_parallel ||
       params.algorithm == RefinementAlgorithm::twoway_fm_hyperflow_cutter ||
       params.algorithm == RefinementAlgorithm::kway_fm_hyperflow_cutter_km1 ||
       params.algorithm == RefinementAlgorithm::kway_fm_hyperflow_cutter) {
@@ -308,6 +313,8 @@ struct PartitioningParameters {
   PartitionID rb_lower_k = 0;
   PartitionID rb_upper_k = 0;
   int seed = 0;
+  size_t num_threads = 1;
+  bool parallel_recursive_bisection = false;
   uint32_t global_search_iterations = std::numeric_limits<uint32_t>::max();
 
   bool time_limited_repeated_partitioning = false;
@@ -356,6 +363,11 @@ inline std::ostream& operator<< (std::ostream& str, const PartitioningParameters
   str << "  k:                                  " << params.k << std::endl;
   str << "  epsilon:                            " << params.epsilon << std::endl;
   str << "  seed:                               " << params.seed << std::endl;
+  str << "  # threads:                          " << params.num_threads << std::endl;
+  if (params.mode == Mode::recursive_bisection) {
+    str << "  parallel recursive bisection:       " << std::boolalpha
+        << params.parallel_recursive_bisection << std::endl;
+  }
   str << "  # V-cycles:                         " << params.global_search_iterations << std::endl;
   str << "  time limit:                         " << params.time_limit << "s" << std::endl;
   str << "  hyperedge size ignore threshold:    " << params.hyperedge_size_threshold << std::endl;
@@ -403,6 +415,7 @@ struct EvolutionaryParameters {
   mutable std::vector<ClusterID> communities;
   bool unlimited_coarsening_contraction;
   bool random_vcycles;
+  int migration_interval = 5;  // island model only, 0 disables migration
 };
 
 inline std::ostream& operator<< (std::ostream& str, const EvolutionaryParameters& params) {
@@ -414,6 +427,24 @@ inline std::ostream& operator<< (std::ostream& str, const EvolutionaryParameters
   str << "  Combine Strategy                    " << params.combine_strategy << std::endl;
   str << "  Mutation Strategy                   " << params.mutate_strategy << std::endl;
   str << "  Diversification Interval            " << params.diversify_interval << std::endl;
+  str << "  Migration Interval                  " << params.migration_interval << std::endl;
+  return str;
+}
+
+struct StreamingParameters {
+  // exponent of the Fennel balance penalty
+  double gamma = 1.5;
+  // 0 disables restreaming
+  uint32_t restreaming_passes = 1;
+  // maximum number of pins of a restreaming window
+  size_t window_size = 100000;
+};
+
+inline std::ostream& operator<< (std::ostream& str, const StreamingParameters& params) {
+  str << "Streaming Parameters:                 " << std::endl;
+  str << "  gamma:                              " << params.gamma << std::endl;
+  str << "  # restreaming passes:               " << params.restreaming_passes << std::endl;
+  str << "  window size (# pins):               " << params.window_size << std::endl;
   return str;
 }
 
@@ -427,12 +458,16 @@ class Context {
   InitialPartitioningParameters initial_partitioning { };
   LocalSearchParameters local_search { };
   EvolutionaryParameters evolutionary { };
+  StreamingParameters streaming { };
   ContextType type = ContextType::main;
   mutable PartitioningStats stats;
+  // ! Copies of a context share the timer of the original context.
+  std::shared_ptr<Timer> timer;
   bool partition_evolutionary = false;
 
   Context() :
-    stats(*this) { }
+    stats(*this),
+    timer(std::make_shared<Timer>()) { }
 
   ~Context() { }
 
@@ -443,8 +478,10 @@ class Context {
     initial_partitioning(other.initial_partitioning),
     local_search(other.local_search),
     evolutionary(other.evolutionary),
+    streaming(other.streaming),
     type(other.type),
     stats(*this, &other.stats.topLevel()),
+    timer(other.timer),
     partition_evolutionary(other.partition_evolutionary) { }
 
   Context& operator= (const Context&) = delete;
@@ -508,8 +545,13 @@ inline std::ostream& operator<< (std::ostream& str, const Context& context) {
       << "*******************************************************************************\n"
       << context.partition
       << "-------------------------------------------------------------------------------"
-      << std::endl
-      << context.preprocessing
+      << std::endl;
+  if (context.partition.mode == Mode::streaming) {
+    // streaming mode neither coarsens nor uses the initial partitioner
+    return str << context.streaming
+               << "-------------------------------------------------------------------------------";
+  }
+  str << context.preprocessing
       << "-------------------------------------------------------------------------------"
       << std::endl
       << context.coarsening
@@ -527,6 +569,7 @@ inline std::ostream& operator<< (std::ostream& str, const Context& context) {
 static inline void checkRecursiveBisectionMode(RefinementAlgorithm& algo) {
   if (algo == RefinementAlgorithm::kway_fm ||
       algo == RefinementAlgorithm::kway_fm_km1 ||
+      algo == RefinementAlgorithm::kway_fm_parallel ||
       algo == RefinementAlgorithm::kway_hyperflow_cutter ||
       algo == RefinementAlgorithm::kway_fm_hyperflow_cutter ||
       algo == RefinementAlgorithm::kway_fm_hyperflow_cutter_km1) {
@@ -539,7 +582,8 @@ static inline void checkRecursiveBisectionMode(RefinementAlgorithm& algo) {
     std::cin >> answer;
     answer = std::toupper(answer);
     if (answer == 'Y') {
-      if (algo == RefinementAlgorithm::kway_fm || algo == RefinementAlgorithm::kway_fm_km1) {
+      if (algo == RefinementAlgorithm::kway_fm || algo == RefinementAlgorithm::kway_fm_km1 ||
+          algo == RefinementAlgorithm::kway_fm_parallel) {
         algo = RefinementAlgorithm::twoway_fm;
       } else if (algo == RefinementAlgorithm::kway_hyperflow_cutter) {
         algo = RefinementAlgorithm::twoway_hyperflow_cutter;
@@ -581,6 +625,17 @@ static inline void checkDirectKwayMode(RefinementAlgorithm& algo, Objective& obj
   }
 }
 
+static inline void checkStreamingMode(const Context& context) {
+  if (context.streaming.gamma < 1.0) {
+    LOG << "Streaming mode requires --stream-gamma >= 1.";
+    std::exit(0);
+  }
+  if (context.streaming.window_size == 0) {
+    LOG << "Streaming mode requires --stream-window-size > 0.";
+    std::exit(0);
+  }
+}
+
 static inline void sanityCheck(const Hypergraph& hypergraph, Context& context) {
   switch (context.partition.mode) {
     case Mode::recursive_bisection:
@@ -616,6 +671,9 @@ static inline void sanityCheck(const Hypergraph& hypergraph, Context& context) {
                     << context.initial_partitioning.technique);
       checkDirectKwayMode(context.local_search.algorithm, context.partition.objective);
       break;
+    case Mode::streaming:
+      checkStreamingMode(context);
+      break;
     default:
       // should never happen, because partitioning is either done via RB or directly
       break;
@@ -662,6 +720,17 @@ static inline void sanityCheck(const Hypergraph& hypergraph, Context& context) {
     }
   }
 
+  if (context.local_search.uncontraction_batch_size == 0 ||
+      context.initial_partitioning.local_search.uncontraction_batch_size == 0) {
+    LOG << "Uncontraction batch size has to be at least one.";
+    std::exit(0);
+  }
+
+  if (context.partition.num_threads == 0) {
+    LOG << "Number of threads has to be at least one.";
+    std::exit(0);
+  }
+
   if (context.local_search.hyperflowcutter.snapshot_scaling > 1.0 &&
       context.local_search.hyperflowcutter.flowhypergraph_size_constraint != FlowHypergraphSizeConstraint::scaled_max_part_weight_fraction_minus_opposite_side) {
     LOG << "Scaling parameter for flow problem sizes > 1.0 only supported for --r-hfc-scaling = mf-style.";
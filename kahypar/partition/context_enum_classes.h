@@ -38,6 +38,7 @@ enum class ContextType : bool {
 enum class Mode : uint8_t {
   recursive_bisection,
   direct_kway,
+  streaming,
   UNDEFINED
 };
 
@@ -88,6 +89,7 @@ enum class CoarseningAlgorithm : uint8_t {
   heavy_full,
   heavy_lazy,
   ml_style,
+  parallel_ml_style,
   do_nothing,
   UNDEFINED
 };
@@ -96,6 +98,7 @@ enum class RefinementAlgorithm : uint8_t {
   twoway_fm,
   kway_fm,
   kway_fm_km1,
+  kway_fm_parallel,
   twoway_fm_hyperflow_cutter,
   twoway_hyperflow_cutter,
   kway_hyperflow_cutter,
@@ -240,6 +243,7 @@ static std::ostream& operator<< (std::ostream& os, const Mode& mode) {
   switch (mode) {
     case Mode::recursive_bisection: return os << "recursive";
     case Mode::direct_kway: return os << "direct";
+    case Mode::streaming: return os << "streaming";
     case Mode::UNDEFINED: return os << "UNDEFINED";
       // omit default case to trigger compiler warning for missing cases
   }
@@ -331,6 +335,7 @@ static std::ostream& operator<< (std::ostream& os, const CoarseningAlgorithm& al
     case CoarseningAlgorithm::heavy_full: return os << "heavy_full";
     case CoarseningAlgorithm::heavy_lazy: return os << "heavy_lazy";
     case CoarseningAlgorithm::ml_style: return os << "ml_style";
+    case CoarseningAlgorithm::parallel_ml_style: return os << "parallel_ml_style";
     case CoarseningAlgorithm::do_nothing: return os << "do_nothing";
     case CoarseningAlgorithm::UNDEFINED: return os << "UNDEFINED";
       // omit default case to trigger compiler warning for missing cases
@@ -343,6 +348,7 @@ static std::ostream& operator<< (std::ostream& os, const RefinementAlgorithm& al
     case RefinementAlgorithm::twoway_fm: return os << "twoway_fm";
     case RefinementAlgorithm::kway_fm: return os << "kway_fm";
     case RefinementAlgorithm::kway_fm_km1: return os << "kway_fm_km1";
+    case RefinementAlgorithm::kway_fm_parallel: return os << "kway_fm_parallel";
     case RefinementAlgorithm::twoway_hyperflow_cutter: return os << "twoway_hyperflow_cutter";
     case RefinementAlgorithm::twoway_fm_hyperflow_cutter: return os << "twoway_fm_hyperflow_cutter";
     case RefinementAlgorithm::kway_hyperflow_cutter: return os << "kway_hyperflow_cutter";
@@ -526,6 +532,8 @@ static CoarseningAlgorithm coarseningAlgorithmFromString(const std::string& type
     return CoarseningAlgorithm::heavy_lazy;
   } else if (type == "ml_style") {
     return CoarseningAlgorithm::ml_style;
+  } else if (type == "parallel_ml_style") {
+    return CoarseningAlgorithm::parallel_ml_style;
   } else if (type == "do_nothing") {
     return CoarseningAlgorithm::do_nothing;
   }
@@ -541,6 +549,8 @@ static RefinementAlgorithm refinementAlgorithmFromString(const std::string& type
     return RefinementAlgorithm::kway_fm;
   } else if (type == "kway_fm_km1") {
     return RefinementAlgorithm::kway_fm_km1;
+  } else if (type == "kway_fm_parallel") {
+    return RefinementAlgorithm::kway_fm_parallel;
   } else if (type == "twoway_hyperflow_cutter") {
     return RefinementAlgorithm::twoway_hyperflow_cutter;
   } else if (type == "kway_hyperflow_cutter") {
@@ -623,6 +633,8 @@ static Mode modeFromString(const std::string& mode) {
     return Mode::recursive_bisection;
   } else if (mode == "direct") {
     return Mode::direct_kway;
+  } else if (mode == "streaming") {
+    return Mode::streaming;
   }
   LOG << "Illegal option:" << mode;
   exit(0);
@@ -47,8 +47,8 @@ static inline bool partitionVCycle(Hypergraph& hypergraph, ICoarsener& coarsener
   HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
   coarsener.coarsen(context.coarsening.contraction_limit);
   HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::v_cycle_coarsening,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::v_cycle_coarsening,
+                     std::chrono::duration<double>(end - start).count());
 
   if (context.partition.verbose_output && context.type == ContextType::main) {
     io::printHypergraphInfo(hypergraph, "Coarsened Hypergraph");
@@ -61,8 +61,8 @@ static inline bool partitionVCycle(Hypergraph& hypergraph, ICoarsener& coarsener
   start = std::chrono::high_resolution_clock::now();
   const bool improved_quality = coarsener.uncoarsen(refiner);
   end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::v_cycle_local_search,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::v_cycle_local_search,
+                     std::chrono::duration<double>(end - start).count());
 
   io::printLocalSearchResults(context, hypergraph);
   return improved_quality;
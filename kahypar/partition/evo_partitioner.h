@@ -23,6 +23,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest_prod.h"
@@ -35,6 +39,7 @@
 #include "kahypar/partition/evolutionary/mutate.h"
 #include "kahypar/partition/evolutionary/population.h"
 #include "kahypar/partition/evolutionary/probability_tables.h"
+#include "kahypar/utils/thread_pool.h"
 
 
 namespace kahypar {
@@ -42,19 +47,125 @@ class EvoPartitioner {
  private:
   static constexpr bool debug = false;
 
+  // ! Partitions that migrate from one island to its successor in the ring of islands.
+  struct Mailbox {
+    std::mutex mutex;
+    std::vector<std::vector<PartitionID> > partitions;
+  };
+
  public:
   explicit EvoPartitioner(const Context& context) :
     _timelimit(),
-    _population() {
+    _population(),
+    _inbox(nullptr),
+    _outbox(nullptr) {
     _timelimit = context.partition.time_limit;
   }
 
+  EvoPartitioner(const EvoPartitioner&) = delete;
+  EvoPartitioner& operator= (const EvoPartitioner&) = delete;
+
+  EvoPartitioner(EvoPartitioner&&) = delete;
+  EvoPartitioner& operator= (EvoPartitioner&&) = delete;
+
   inline void partition(Hypergraph& hg, Context& context) {
     context.partition_evolutionary = true;
 
+    if (context.partition.num_threads > 1) {
+      partitionWithIslands(hg, context);
+      return;
+    }
+
     generateInitialPopulation(hg, context);
+    evolve(hg, context);
+    hg.reset();
+    hg.setPartition(_population.individualAt(_population.best()).partition());
+  }
+
+  std::vector<PartitionID> bestPartition() const {
+    return _population.individualAt(_population.best()).partition();
+  }
+
+ private:
+  FRIEND_TEST(TheEvoPartitioner, ProperlyGeneratesTheInitialPopulation);
+  FRIEND_TEST(TheEvoPartitioner, RespectsLimitsOfTheInitialPopulation);
+  FRIEND_TEST(TheEvoPartitioner, IsCorrectlyDecidingTheActions);
+  FRIEND_TEST(TheEvoPartitioner, MigratesTheBestIndividualToTheNextIsland);
+  FRIEND_TEST(TheEvoPartitioner, EvolvesIslandsInParallel);
+
+  /*!
+   * Island model: Each of the context.partition.num_threads islands evolves
+   * its own population on its own copy of the hypergraph until the time limit
+   * is reached. Every migration_interval iterations, an island sends its best
+   * partition to the next island of a ring and inserts the partitions it
+   * received from its predecessor into its population.
+   *
+   * Each island uses its own timer, such that the time limit applies to the
+   * wall-clock time of each island. Afterwards, the population containing the
+   * overall best individual becomes the population of this partitioner.
+   */
+  inline void partitionWithIslands(Hypergraph& hg, Context& context) {
+    const size_t num_islands = context.partition.num_threads;
+    const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+
+    // Islands (and thus their contexts) are created and destroyed by the calling thread,
+    // because the statistics of the contexts are merged into those of context on destruction.
+    std::vector<std::unique_ptr<Context> > contexts;
+    std::vector<std::unique_ptr<Hypergraph> > hypergraphs;
+    std::vector<std::unique_ptr<EvoPartitioner> > islands;
+    std::vector<Mailbox> mailboxes(num_islands);
+    std::vector<int> seeds;
+    for (size_t i = 0; i < num_islands; ++i) {
+      contexts.emplace_back(std::make_unique<Context>(context));
+      contexts.back()->partition.num_threads = 1;
+      contexts.back()->timer = std::make_shared<Timer>();
+      auto copy = ds::reindex(hg);
+      ASSERT(copy.first->initialNumNodes() == hg.initialNumNodes(),
+             "Hypergraph contains disabled hypernodes");
+      hypergraphs.emplace_back(std::move(copy.first));
+      islands.emplace_back(std::make_unique<EvoPartitioner>(*contexts.back()));
+      islands.back()->_inbox = &mailboxes[i];
+      islands.back()->_outbox = &mailboxes[(i + 1) % num_islands];
+      seeds.push_back(Randomize::instance().newRandomSeed());
+    }
+
+    ThreadPool pool(num_islands);
+    pool.parallelFor(0, num_islands, 1, [&](const size_t, const size_t begin, const size_t end) {
+        // The random number generator of the calling thread participates
+        // in the evolution and is therefore restored afterwards.
+        Randomize& randomize = Randomize::instance();
+        const std::mt19937 generator = randomize.getGenerator();
+        for (size_t i = begin; i < end; ++i) {
+          randomize.setSeed(seeds[i]);
+          islands[i]->generateInitialPopulation(*hypergraphs[i], *contexts[i]);
+          islands[i]->evolve(*hypergraphs[i], *contexts[i]);
+        }
+        randomize.getGenerator() = generator;
+      });
 
-    while (Timer::instance().evolutionaryResult().total_evolutionary <= _timelimit) {
+    size_t best_island = 0;
+    context.evolutionary.iteration = 0;
+    for (size_t i = 0; i < num_islands; ++i) {
+      DBG << V(i) << V(contexts[i]->evolutionary.iteration)
+          << V(islands[i]->_population.bestFitness());
+      context.evolutionary.iteration += contexts[i]->evolutionary.iteration;
+      if (islands[i]->_population.bestFitness() <
+          islands[best_island]->_population.bestFitness()) {
+        best_island = i;
+      }
+    }
+    _population = std::move(islands[best_island]->_population);
+
+    const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    context.timer->add(context, Timepoint::evolutionary,
+                       std::chrono::duration<double>(end - start).count());
+
+    hg.reset();
+    hg.setPartition(_population.individualAt(_population.best()).partition());
+  }
+
+  inline void evolve(Hypergraph& hg, Context& context) {
+    while (context.timer->evolutionaryResult().total_evolutionary <= _timelimit) {
       ++context.evolutionary.iteration;
 
 
@@ -79,33 +190,57 @@ class EvoPartitioner {
           LOG << "Error in evo_partitioner.h: Non-covered case in decision making";
           std::exit(EXIT_FAILURE);
       }
+
+      if (_inbox != nullptr && context.evolutionary.migration_interval > 0 &&
+          context.evolutionary.iteration % context.evolutionary.migration_interval == 0) {
+        migrate(hg, context);
+      }
     }
-    hg.reset();
-    hg.setPartition(_population.individualAt(_population.best()).partition());
   }
 
-  const std::vector<PartitionID> & bestPartition() const {
-    return _population.individualAt(_population.best()).partition();
+  // ! Sends the best partition of this island to the next island and
+  // ! inserts the partitions received from the previous island.
+  inline void migrate(Hypergraph& hg, const Context& context) {
+    HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    if (_outbox != _inbox) {
+      std::vector<PartitionID> best_partition = _population.individualAt(_population.best()).partition();
+      std::lock_guard<std::mutex> lock(_outbox->mutex);
+      // Only the most recent partition of an island is kept, if its successor
+      // did not receive the previous one yet.
+      _outbox->partitions.clear();
+      _outbox->partitions.emplace_back(std::move(best_partition));
+    }
+
+    std::vector<std::vector<PartitionID> > immigrants;
+    {
+      std::lock_guard<std::mutex> lock(_inbox->mutex);
+      immigrants.swap(_inbox->partitions);
+    }
+    for (const std::vector<PartitionID>& partition : immigrants) {
+      hg.setPartition(partition);
+      const size_t insert_position = _population.insert(Individual(hg, context), context);
+      DBG << "Immigrant" << V(metrics::correctMetric(hg, context)) << V(insert_position);
+    }
+    hg.reset();
+    HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    context.timer->add(context, Timepoint::evolutionary,
+                       std::chrono::duration<double>(end - start).count());
   }
 
- private:
-  FRIEND_TEST(TheEvoPartitioner, ProperlyGeneratesTheInitialPopulation);
-  FRIEND_TEST(TheEvoPartitioner, RespectsLimitsOfTheInitialPopulation);
-  FRIEND_TEST(TheEvoPartitioner, IsCorrectlyDecidingTheActions);
   inline void generateInitialPopulation(Hypergraph& hg, Context& context) {
     // INITIAL POPULATION
     if (context.evolutionary.dynamic_population_size) {
       HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
       _population.generateIndividual(hg, context);
       HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-      Timer::instance().add(context, Timepoint::evolutionary,
-                            std::chrono::duration<double>(end - start).count());
+      context.timer->add(context, Timepoint::evolutionary,
+                         std::chrono::duration<double>(end - start).count());
 
       ++context.evolutionary.iteration;
       io::serializer::serializeEvolutionary(context, hg);
       int dynamic_population_size = std::round(context.evolutionary.dynamic_population_amount_of_time
                                                * context.partition.time_limit
-                                               / Timer::instance().evolutionaryResult().total_evolutionary);
+                                               / context.timer->evolutionaryResult().total_evolutionary);
       int minimal_size = std::max(dynamic_population_size, 3);
 
       context.evolutionary.population_size = std::min(minimal_size, 50);
@@ -116,13 +251,13 @@ class EvoPartitioner {
     DBG << "EDGE-FREQUENCY-AMOUNT";
     DBG << context.evolutionary.edge_frequency_amount;
     while (_population.size() < context.evolutionary.population_size &&
-           Timer::instance().evolutionaryResult().total_evolutionary <= _timelimit) {
+           context.timer->evolutionaryResult().total_evolutionary <= _timelimit) {
       ++context.evolutionary.iteration;
       HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
       _population.generateIndividual(hg, context);
       HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-      Timer::instance().add(context, Timepoint::evolutionary,
-                            std::chrono::duration<double>(end - start).count());
+      context.timer->add(context, Timepoint::evolutionary,
+                         std::chrono::duration<double>(end - start).count());
       io::serializer::serializeEvolutionary(context, hg);
       verbose(context, 0);
       DBG << _population;
@@ -225,5 +360,7 @@ class EvoPartitioner {
 
   int _timelimit;
   Population _population;
+  Mailbox* _inbox;
+  Mailbox* _outbox;
 };
 }  // namespace kahypar
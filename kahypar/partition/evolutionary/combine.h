@@ -41,23 +41,27 @@ Individual partitions(Hypergraph& hg,
   DBG << V(context.evolutionary.action.decision());
   DBG << "Parent 1: initial" << V(parents.first.fitness());
   DBG << "Parent 2: initial" << V(parents.second.fitness());
-  context.evolutionary.parent1 = &parents.first.partition();
-  context.evolutionary.parent2 = &parents.second.partition();
+  // Individuals store their partitions bit-packed, the rating partition policy
+  // needs direct access to both parent partitions during coarsening.
+  const std::vector<PartitionID> parent1 = parents.first.partition();
+  const std::vector<PartitionID> parent2 = parents.second.partition();
+  context.evolutionary.parent1 = &parent1;
+  context.evolutionary.parent2 = &parent2;
 #ifndef NDEBUG
-  ASSERT(parents.first.fitness() == ([](Hypergraph& hg, const Parents& parents) -> int {
-        hg.setPartition(parents.first.partition());
+  ASSERT(parents.first.fitness() == ([](Hypergraph& hg, const std::vector<PartitionID>& parent1) -> int {
+        hg.setPartition(parent1);
         HyperedgeWeight metric = metrics::km1(hg);
         hg.reset();
         return metric;
-      })(hg, parents));
+      })(hg, parent1));
   DBG << "initial" << V(metrics::km1(hg)) << V(metrics::imbalance(hg, context));
 
-  ASSERT(parents.second.fitness() == ([](Hypergraph& hg, const Parents& parents) -> int {
-        hg.setPartition(parents.second.partition());
+  ASSERT(parents.second.fitness() == ([](Hypergraph& hg, const std::vector<PartitionID>& parent2) -> int {
+        hg.setPartition(parent2);
         HyperedgeWeight metric = metrics::km1(hg);
         hg.reset();
         return metric;
-      })(hg, parents));
+      })(hg, parent2));
 
 #endif
 
@@ -69,10 +73,12 @@ Individual partitions(Hypergraph& hg,
   }
 
   Partitioner().partition(hg, context);
+  context.evolutionary.parent1 = nullptr;
+  context.evolutionary.parent2 = nullptr;
 
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::evolutionary,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::evolutionary,
+                     std::chrono::duration<double>(end - start).count());
 
   context.coarsening.contraction_limit_multiplier = original_contraction_limit_multiplier;
   DBG << "Offspring" << V(metrics::km1(hg)) << V(metrics::imbalance(hg, context));
@@ -121,8 +127,8 @@ Individual edgeFrequency(Hypergraph& hg, const Context& context, const Populatio
   Partitioner().partition(hg, temporary_context);
 
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::evolutionary,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::evolutionary,
+                     std::chrono::duration<double>(end - start).count());
 
 
   DBG << "final result" << V(metrics::km1(hg)) << V(metrics::imbalance(hg, context));
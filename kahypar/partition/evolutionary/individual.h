@@ -20,59 +20,104 @@
 ******************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <utility>
 #include <vector>
 
+#include "kahypar/datastructure/bit_packed_array.h"
 #include "kahypar/definitions.h"
 #include "kahypar/partition/metrics.h"
+#include "kahypar/utils/math.h"
 
 namespace kahypar {
+/*!
+ * An individual of the population of the evolutionary partitioner.
+ *
+ * To keep large populations in memory, the partition is bit-packed using
+ * ceil(log2(k)) bits per hypernode. The strong cut edges (each cut edge e
+ * occurs lambda(e) - 1 times) are represented by the sorted cut edges and
+ * their packed connectivities. In addition, each individual stores bottom-k
+ * min-hash sketches of both edge sets, which allow the population to
+ * estimate the difference of two individuals in O(k) time.
+ */
 class Individual {
  private:
   static constexpr bool debug = false;
 
  public:
+  using HashValue = uint64_t;
+  // ! Sorted hash values of the kSketchSize smallest hashes of an edge set.
+  using Sketch = std::vector<HashValue>;
+  static constexpr size_t kSketchSize = 64;
+
   Individual() :
     _partition(),
     _cut_edges(),
-    _strong_cut_edges(),
+    _connectivity(),
+    _num_strong_cut_edges(0),
+    _cut_edge_sketch(),
+    _strong_cut_edge_sketch(),
     _fitness() { }
 
   explicit Individual(const HyperedgeWeight fitness) :
     _partition(),
     _cut_edges(),
-    _strong_cut_edges(),
+    _connectivity(),
+    _num_strong_cut_edges(0),
+    _cut_edge_sketch(),
+    _strong_cut_edge_sketch(),
     _fitness(fitness) { }
 
   explicit Individual(const std::vector<PartitionID>& partition) :
-    _partition(std::move(partition)),
+    _partition(),
     _cut_edges(),
-    _strong_cut_edges(),
-    _fitness(std::numeric_limits<HyperedgeWeight>::max()) { }
+    _connectivity(),
+    _num_strong_cut_edges(0),
+    _cut_edge_sketch(),
+    _strong_cut_edge_sketch(),
+    _fitness(std::numeric_limits<HyperedgeWeight>::max()) {
+    const PartitionID max_part = partition.empty() ? 0 :
+                                 *std::max_element(partition.cbegin(), partition.cend());
+    _partition = ds::BitPackedArray(partition.size(), max_part);
+    for (size_t i = 0; i < partition.size(); ++i) {
+      _partition.set(i, partition[i]);
+    }
+  }
 
   explicit Individual(const Hypergraph& hypergraph, const Context& context) :
-    _partition(),
+    _partition(hypergraph.currentNumNodes(), std::max(hypergraph.k() - 1, 0)),
     _cut_edges(),
-    _strong_cut_edges(),
+    _connectivity(),
+    _num_strong_cut_edges(0),
+    _cut_edge_sketch(),
+    _strong_cut_edge_sketch(),
     _fitness() {
+    size_t i = 0;
     for (const HypernodeID& hn : hypergraph.nodes()) {
-      _partition.push_back(hypergraph.partID(hn));
+      _partition.set(i++, hypergraph.partID(hn));
     }
 
     _fitness = metrics::correctMetric(hypergraph, context);
 
+    std::vector<PartitionID> connectivity;
     for (const HyperedgeID& he : hypergraph.edges()) {
       if (hypergraph.connectivity(he) > 1) {
         _cut_edges.push_back(he);
         // The general idea is to add the connectivity (#blocks - 1)
         // instead of the # of blocks (However there should not be that much of a difference)
-        // Edit: For Test Purposes this loop starts with 1.
-        for (PartitionID i = 1; i < hypergraph.connectivity(he); ++i) {
-          _strong_cut_edges.push_back(he);
-        }
+        // Edit: For Test Purposes the strong cut edges contain each cut edge
+        // connectivity - 1 times.
+        connectivity.push_back(hypergraph.connectivity(he) - 1);
+        _num_strong_cut_edges += hypergraph.connectivity(he) - 1;
       }
     }
+    _connectivity = ds::BitPackedArray(connectivity.size(), std::max(hypergraph.k() - 1, 0));
+    for (size_t j = 0; j < connectivity.size(); ++j) {
+      _connectivity.set(j, connectivity[j]);
+    }
+    computeSketches(connectivity);
     DBG << "New individual" << V(_fitness);
   }
 
@@ -87,28 +132,57 @@ class Individual {
     return _fitness;
   }
 
+  inline PartitionID partID(const HypernodeID hn) const {
+    return _partition[hn];
+  }
 
-  inline const std::vector<PartitionID> & partition() const {
+  // ! Unpacks the partition.
+  inline std::vector<PartitionID> partition() const {
     ASSERT(!_partition.empty());
-    return _partition;
+    std::vector<PartitionID> partition(_partition.size());
+    for (size_t i = 0; i < _partition.size(); ++i) {
+      partition[i] = _partition[i];
+    }
+    return partition;
   }
+
   inline const std::vector<HyperedgeID> & cutEdges() const {
     ASSERT(!_cut_edges.empty());
     return _cut_edges;
   }
 
-  inline const std::vector<HyperedgeID> & strongCutEdges() const {
-    ASSERT(!_strong_cut_edges.empty());
-    return _strong_cut_edges;
+  // ! lambda(e) - 1 of the i-th cut edge.
+  inline PartitionID cutEdgeMultiplicity(const size_t i) const {
+    return _connectivity[i];
+  }
+
+  inline size_t numStrongCutEdges() const {
+    return _num_strong_cut_edges;
+  }
+
+  // ! Unpacks the strong cut edges, i.e., each cut edge e occurs lambda(e) - 1 times.
+  inline std::vector<HyperedgeID> strongCutEdges() const {
+    ASSERT(!_cut_edges.empty());
+    std::vector<HyperedgeID> strong_cut_edges;
+    strong_cut_edges.reserve(_num_strong_cut_edges);
+    for (size_t i = 0; i < _cut_edges.size(); ++i) {
+      strong_cut_edges.insert(strong_cut_edges.end(), _connectivity[i], _cut_edges[i]);
+    }
+    return strong_cut_edges;
   }
+
+  inline const Sketch & cutEdgeSketch(const bool strong_set) const {
+    return strong_set ? _strong_cut_edge_sketch : _cut_edge_sketch;
+  }
+
   inline void print() const {
     LOG << "Fitness:" << _fitness;
   }
   inline void printDebug() const {
     LOG << "Fitness:" << _fitness;
     LOG << "Partition :---------------------------------------";
-    for (const PartitionID part : _partition) {
-      LLOG << part;
+    for (size_t i = 0; i < _partition.size(); ++i) {
+      LLOG << _partition[i];
     }
     LOG << "\n--------------------------------------------------";
     LOG << "Cut Edges :---------------------------------------";
@@ -117,23 +191,49 @@ class Individual {
     }
     LOG << "\n--------------------------------------------------";
     LOG << "Strong Cut Edges :--------------------------------";
-    for (const HyperedgeID strong_cut_edge :  _strong_cut_edges) {
+    for (const HyperedgeID strong_cut_edge :  strongCutEdges()) {
       LLOG << strong_cut_edge;
     }
     LOG << "\n--------------------------------------------------";
   }
 
  private:
-  std::vector<PartitionID> _partition;
+  void computeSketches(const std::vector<PartitionID>& connectivity) {
+    const math::MurmurHash<uint64_t> hash;
+    for (size_t i = 0; i < _cut_edges.size(); ++i) {
+      const uint64_t he = _cut_edges[i];
+      _cut_edge_sketch.push_back(hash(he << 32));
+      // The j-th occurrence of a strong cut edge is hashed as (he, j).
+      for (PartitionID j = 0; j < connectivity[i]; ++j) {
+        _strong_cut_edge_sketch.push_back(hash((he << 32) | static_cast<uint64_t>(j + 1)));
+      }
+    }
+    shrinkToSmallest(_cut_edge_sketch);
+    shrinkToSmallest(_strong_cut_edge_sketch);
+  }
+
+  static void shrinkToSmallest(Sketch& sketch) {
+    if (sketch.size() > kSketchSize) {
+      std::nth_element(sketch.begin(), sketch.begin() + kSketchSize, sketch.end());
+      sketch.resize(kSketchSize);
+    }
+    std::sort(sketch.begin(), sketch.end());
+    sketch.shrink_to_fit();
+  }
+
+  ds::BitPackedArray _partition;
   std::vector<HyperedgeID> _cut_edges;
-  std::vector<HyperedgeID> _strong_cut_edges;
+  ds::BitPackedArray _connectivity;
+  size_t _num_strong_cut_edges;
+  Sketch _cut_edge_sketch;
+  Sketch _strong_cut_edge_sketch;
   HyperedgeWeight _fitness;
 };
 std::ostream& operator<< (std::ostream& os, const Individual& individual) {
   os << "Fitness: " << individual.fitness() << std::endl;
   os << "Partition:------------------------------------" << std::endl;
-  for (size_t i = 0; i < individual.partition().size(); ++i) {
-    os << individual.partition()[i] << " ";
+  for (const PartitionID part : individual.partition()) {
+    os << part << " ";
   }
   return os;
 }
@@ -48,8 +48,8 @@ Individual vCycleWithNewInitialPartitioning(Hypergraph& hg, const Individual& in
   Partitioner().partition(hg, temporary_context);
 
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::evolutionary,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::evolutionary,
+                     std::chrono::duration<double>(end - start).count());
 
 
   DBG << "after mutate" << V(metrics::km1(hg)) << V(metrics::imbalance(hg, context));
@@ -75,8 +75,8 @@ Individual vCycle(Hypergraph& hg, const Individual& in,
   Partitioner().partition(hg, temporary_context);
 
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::evolutionary,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::evolutionary,
+                     std::chrono::duration<double>(end - start).count());
 
   DBG << "after mutate" << V(metrics::km1(hg)) << V(metrics::imbalance(hg, context));
   io::serializer::serializeEvolutionary(temporary_context, hg);
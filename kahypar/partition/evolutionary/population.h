@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -201,32 +202,81 @@ class Population {
       _individuals[i].printDebug();
     }
   }
+  // ! Exact size of the symmetric difference of the (strong) cut edge sets.
   inline size_t difference(const Individual& individual, const size_t position,
                            const bool strong_set) const {
-    std::vector<HyperedgeID> output_diff;
-    if (strong_set) {
-      ASSERT(std::is_sorted(_individuals[position].strongCutEdges().begin(),
-                            _individuals[position].strongCutEdges().end()));
-      ASSERT(std::is_sorted(individual.strongCutEdges().begin(),
-                            individual.strongCutEdges().end()));
-      std::set_symmetric_difference(_individuals[position].strongCutEdges().begin(),
-                                    _individuals[position].strongCutEdges().end(),
-                                    individual.strongCutEdges().begin(),
-                                    individual.strongCutEdges().end(),
-                                    std::back_inserter(output_diff));
-    } else {
-      ASSERT(std::is_sorted(_individuals[position].cutEdges().begin(),
-                            _individuals[position].cutEdges().end()));
-      ASSERT(std::is_sorted(individual.cutEdges().begin(),
-                            individual.cutEdges().end()));
-      std::set_symmetric_difference(_individuals[position].cutEdges().begin(),
-                                    _individuals[position].cutEdges().end(),
-                                    individual.cutEdges().begin(),
-                                    individual.cutEdges().end(),
-                                    std::back_inserter(output_diff));
+    const Individual& other = _individuals[position];
+    const std::vector<HyperedgeID>& a = other.cutEdges();
+    const std::vector<HyperedgeID>& b = individual.cutEdges();
+    ASSERT(std::is_sorted(a.begin(), a.end()));
+    ASSERT(std::is_sorted(b.begin(), b.end()));
+    // Merge walk over the sorted cut edges. In the strong set, each cut edge e
+    // occurs lambda(e) - 1 times.
+    const auto multiplicity = [strong_set](const Individual& in, const size_t i) -> size_t {
+                                return strong_set ? in.cutEdgeMultiplicity(i) : 1;
+                              };
+    size_t diff = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+      if (a[i] < b[j]) {
+        diff += multiplicity(other, i++);
+      } else if (b[j] < a[i]) {
+        diff += multiplicity(individual, j++);
+      } else {
+        const size_t m_a = multiplicity(other, i++);
+        const size_t m_b = multiplicity(individual, j++);
+        diff += m_a > m_b ? m_a - m_b : m_b - m_a;
+      }
+    }
+    for ( ; i < a.size(); ++i) {
+      diff += multiplicity(other, i);
+    }
+    for ( ; j < b.size(); ++j) {
+      diff += multiplicity(individual, j);
+    }
+    DBG << V(diff);
+    return diff;
+  }
+
+  /*!
+   * Estimates the size of the symmetric difference of the (strong) cut edge
+   * sets using the bottom-k min-hash sketches of both individuals.
+   * The Jaccard index J is estimated from the kSketchSize smallest hashes of
+   * the union and |A ^ B| = (|A| + |B|) * (1 - J) / (1 + J). If both sets are
+   * smaller than kSketchSize, the result is exact.
+   */
+  inline size_t estimatedDifference(const Individual& individual, const size_t position,
+                                    const bool strong_set) const {
+    const Individual& other = _individuals[position];
+    const Individual::Sketch& a = other.cutEdgeSketch(strong_set);
+    const Individual::Sketch& b = individual.cutEdgeSketch(strong_set);
+    const size_t size_a = strong_set ? other.numStrongCutEdges() : other.cutEdges().size();
+    const size_t size_b = strong_set ? individual.numStrongCutEdges() : individual.cutEdges().size();
+
+    size_t union_size = 0;
+    size_t shared = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (union_size < Individual::kSketchSize && (i < a.size() || j < b.size())) {
+      if (j == b.size() || (i < a.size() && a[i] < b[j])) {
+        ++i;
+      } else if (i == a.size() || b[j] < a[i]) {
+        ++j;
+      } else {
+        ++i;
+        ++j;
+        ++shared;
+      }
+      ++union_size;
+    }
+    if (union_size == 0) {
+      return 0;
     }
-    DBG << V(output_diff.size());
-    return output_diff.size();
+    const double jaccard = static_cast<double>(shared) / union_size;
+    const double diff = (size_a + size_b) * (1.0 - jaccard) / (1.0 + jaccard);
+    DBG << V(shared) << V(union_size) << V(diff);
+    return static_cast<size_t>(std::lround(diff));
   }
 
  private:
@@ -239,7 +289,7 @@ class Population {
     }
     for (size_t i = 0; i < size(); ++i) {
       if (_individuals[i].fitness() >= individual.fitness()) {
-        const size_t similarity = difference(individual, i, strong_set);
+        const size_t similarity = estimatedDifference(individual, i, strong_set);
         DBG << "SYMMETRIC DIFFERENCE:" << similarity << " from" << i;
         if (similarity < max_similarity) {
           max_similarity = similarity;
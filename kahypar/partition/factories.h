@@ -27,6 +27,7 @@
 #include "kahypar/partition/coarsening/i_coarsener.h"
 #include "kahypar/partition/coarsening/lazy_vertex_pair_coarsener.h"
 #include "kahypar/partition/coarsening/ml_coarsener.h"
+#include "kahypar/partition/coarsening/parallel_ml_coarsener.h"
 #include "kahypar/partition/coarsening/policies/rating_acceptance_policy.h"
 #include "kahypar/partition/coarsening/policies/rating_community_policy.h"
 #include "kahypar/partition/coarsening/policies/rating_heavy_node_penalty_policy.h"
@@ -39,6 +40,7 @@
 #include "kahypar/partition/refinement/i_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_parallel_refiner.h"
 #include "kahypar/partition/refinement/policies/fm_stop_policy.h"
 #include "kahypar/partition/bin_packing/i_bin_packer.h"
 
@@ -63,6 +65,10 @@ using MLCoarseningDispatcher = meta::StaticMultiDispatchFactory<MLCoarsener,
                                                                 ICoarsener,
                                                                 RatingPolicies>;
 
+using ParallelMLCoarseningDispatcher = meta::StaticMultiDispatchFactory<ParallelMLCoarsener,
+                                                                        ICoarsener,
+                                                                        RatingPolicies>;
+
 using FullCoarseningDispatcher = meta::StaticMultiDispatchFactory<FullVertexPairCoarsener,
                                                                   ICoarsener,
                                                                   RatingPolicies>;
@@ -83,6 +89,10 @@ using KWayKMinusOneFactoryDispatcher = meta::StaticMultiDispatchFactory<KWayKMin
                                                                         IRefiner,
                                                                         meta::Typelist<StoppingPolicyClasses> >;
 
+using KWayParallelFMFactoryDispatcher = meta::StaticMultiDispatchFactory<KWayParallelFMRefiner,
+                                                                         IRefiner,
+                                                                         meta::Typelist<StoppingPolicyClasses> >;
+
 using TwoWayHyperFlowCutterFactoryDispatcher = meta::StaticMultiDispatchFactory<TwoWayHyperFlowCutterRefiner,
                                                                                 IRefiner,
                                                                                 meta::Typelist<FlowExecutionPolicyClasses> >;
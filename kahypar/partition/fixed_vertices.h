@@ -23,8 +23,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
-#include <queue>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -32,15 +33,11 @@
 #include "kahypar/definitions.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/partition/context.h"
+#include "kahypar/partition/metrics.h"
 
 namespace kahypar {
 namespace fixed_vertices {
-using NodeID = int32_t;
-using Flow = HyperedgeWeight;
-
-using AdjacencyMatrix = std::vector<std::vector<HyperedgeWeight> >;
 using Matching = std::vector<std::pair<PartitionID, PartitionID> >;
-using VertexCover = std::vector<NodeID>;
 
 static constexpr bool debug = false;
 static constexpr bool debug_permutations = false;
@@ -62,299 +59,96 @@ static bool verify(const Matching& matching, const PartitionID k) {
 }
 
 
-class BipartiteMaximumFlow {
+/**
+ * Weighted bipartite graph between the fixed vertex blocks (left side)
+ * and the blocks of the current partition (right side). Only pairs of
+ * blocks which share hyperedges are stored explicitly. All other pairs
+ * have weight zero. Pairs whose assignment would violate the balance
+ * constraint have weight infeasibleWeight() instead.
+ */
+class BipartiteMatchingGraph {
  public:
-  explicit BipartiteMaximumFlow(const AdjacencyMatrix& graph) :
-    _num_nodes(static_cast<size_t>(graph.size()) * 2 + 2),
-    _residualGraph(_num_nodes, std::vector<HypernodeWeight>(_num_nodes, 0)),
-    _visited(_num_nodes),
-    _parent(_num_nodes, -1),
-    _source(_num_nodes - 2),
-    _sink(_num_nodes - 1) {
-    // Converts the bipartite graph representation into a general
-    // adjacency matrix. Therefore nodes are relabeled.
-    const PartitionID k = graph.size();
-    for (PartitionID i = 0; i < k; ++i) {
-      for (PartitionID j = 0; j < k; ++j) {
-        if (graph[i][j]) {
-          // All nodes from left side of the bipartite graph are labeled from 0..(k-1)
-          // All nodes from right side of the bipartite graph are labeled from k..(2k-1)
-          const NodeID u = i;
-          const NodeID v = j + k;
-          _residualGraph[u][v] = 1;
-        }
-      }
-    }
+  using Edge = std::pair<PartitionID, HyperedgeWeight>;
 
-    // Connect source to all left side nodes of the bipartite graph (Source Node: 2k)
-    for (PartitionID i = 0; i < k; ++i) {
-      _residualGraph[_source][i] = 1;
-    }
+  explicit BipartiteMatchingGraph(const PartitionID k) :
+    _adjacent_blocks(k),
+    _fixed_vertex_part_weight(k, 0),
+    _part_weight(k, 0),
+    _max_part_weight(k, std::numeric_limits<HypernodeWeight>::max()),
+    _infeasible_weight(0) { }
 
-    // Connect all right side nodes of the bipartite graph to sink (Sink Node: 2k + 1)
-    for (PartitionID i = 0; i < k; ++i) {
-      _residualGraph[i + k][_sink] = 1;
-    }
-  }
+  BipartiteMatchingGraph(const BipartiteMatchingGraph&) = delete;
+  BipartiteMatchingGraph& operator= (const BipartiteMatchingGraph&) = delete;
 
-  BipartiteMaximumFlow(const BipartiteMaximumFlow&) = delete;
-  BipartiteMaximumFlow(BipartiteMaximumFlow&&) = delete;
-  BipartiteMaximumFlow& operator= (const BipartiteMaximumFlow&) = delete;
-  BipartiteMaximumFlow& operator= (BipartiteMaximumFlow&&) = delete;
-  ~BipartiteMaximumFlow() = default;
-
-  /**
-   * Edmond-Karps Maximum Flow Algorithm
-   * Returns the value of the maximum flow.
-   */
-  Flow maximumFlow() {
-    Flow max_flow = 0;
-    while (bfs(_source)) {
-      max_flow += augment(_sink);
-    }
-    ASSERT(!bfs(_source), "There still exists an augmenting path in the residual graph");
-    return max_flow;
-  }
-
- private:
-  /**
-   * Increases the flow along the augmenting path found
-   * by the BFS traversal of the residual graph.
-   * Returns the amount of flow which is send over
-   * the augmenting path.
-   * NOTE: Function should be called with sink node.
-   */
-  Flow augment(const NodeID u, const Flow flow = std::numeric_limits<Flow>::max()) {
-    if (_parent[u] == -1) {
-      return flow;
-    }
-    const Flow min_flow = augment(_parent[u], std::min(flow, _residualGraph[_parent[u]][u]));
-    _residualGraph[_parent[u]][u] -= min_flow;
-    _residualGraph[u][_parent[u]] += min_flow;
-    return min_flow;
-  }
+  BipartiteMatchingGraph(BipartiteMatchingGraph&&) = default;
+  BipartiteMatchingGraph& operator= (BipartiteMatchingGraph&&) = default;
 
- protected:
-  /**
-   * Breath-First-Search starting from a specific node
-   * and searching for the sink node in the residual graph.
-   * Returns true, if a path from node to _sink in the residual
-   * graph exists.
-   */
-  bool bfs(const NodeID node, const bool reset = true) {
-    if (reset) {
-      _visited.reset();
-    }
-    std::queue<NodeID> q;
-    q.push(node);
-    _visited.set(node, true);
-    _parent[node] = -1;
-
-    while (!q.empty()) {
-      const NodeID u = q.front();
-      q.pop();
-      if (u == _sink) {
-        return true;
-      }
+  ~BipartiteMatchingGraph() = default;
 
-      for (NodeID v = 0; v < _num_nodes; ++v) {
-        if (!_visited[v] && _residualGraph[u][v]) {
-          q.push(v);
-          _visited.set(v, true);
-          _parent[v] = u;
-        }
-      }
-    }
-    return false;
+  PartitionID k() const {
+    return _adjacent_blocks.size();
   }
 
-  NodeID _num_nodes;
-  AdjacencyMatrix _residualGraph;
-  ds::FastResetFlagArray<> _visited;
-  std::vector<NodeID> _parent;
-  NodeID _source;
-  NodeID _sink;
-};
-
-class MaximumBipartiteMatching : public BipartiteMaximumFlow {
- public:
-  explicit MaximumBipartiteMatching(const AdjacencyMatrix& graph) :
-    BipartiteMaximumFlow(graph) { }
-
-  MaximumBipartiteMatching(const MaximumBipartiteMatching&) = delete;
-  MaximumBipartiteMatching(MaximumBipartiteMatching&&) = delete;
-  MaximumBipartiteMatching& operator= (const MaximumBipartiteMatching&) = delete;
-  MaximumBipartiteMatching& operator= (MaximumBipartiteMatching&&) = delete;
-  ~MaximumBipartiteMatching() = default;
-
-  /**
-   * Function computes a maximum matching in an unweighted
-   * bipartite graph. There exists a duality between a
-   * maximum flow and a maximum bipartite matching. The size
-   * of a maximum bipartite matching is equal to the value of
-   * the maximum flow f. Each edge (u,v), where f(u,v) = 1 is part
-   * of the maximum bipartite matching.
-   */
-  Matching findMaximumBipartiteMatching() {
-    Matching matching;
-    const PartitionID k = _num_nodes / 2 - 1;
-
-    const Flow max_flow = maximumFlow();
-    unused(max_flow);
-
-    // Iterate over L-vertices
-    for (PartitionID i = 0; i < k; ++i) {
-      // Iterate over R-vertices
-      for (PartitionID j = 0; j < k; ++j) {
-        // Map L- and R-vertices to their corresponding
-        // nodes of the flow graph
-        const NodeID u = i;
-        const NodeID v = j + k;
-        // If (i,j) is part of maximum bipartite matching,
-        // then edge (v,u) must be in the residual graph
-        // of a maximum flow.
-        if (_residualGraph[v][u]) {
-          matching.push_back(std::make_pair(i, j));
-        }
-      }
-    }
-
-    ASSERT(verify(matching, k), "Invalid matching");
-    ASSERT(static_cast<size_t>(max_flow) == matching.size(),
-           "Size of maximum matching not equal to value of maximum flow");
+  // ! Each pair (i,j) must be added at most once.
+  void addEdge(const PartitionID i, const PartitionID j, const HyperedgeWeight weight) {
+    ASSERT(std::none_of(_adjacent_blocks[i].begin(), _adjacent_blocks[i].end(),
+                        [j](const Edge& edge) {
+          return edge.first == j;
+        }), "Edge" << V(i) << V(j) << "already exists");
+    _adjacent_blocks[i].emplace_back(j, weight);
+  }
 
-    return matching;
+  const std::vector<Edge>& adjacentBlocks(const PartitionID i) const {
+    return _adjacent_blocks[i];
   }
 
- protected:
-  using BipartiteMaximumFlow::_num_nodes;
-  using BipartiteMaximumFlow::_residualGraph;
-};
+  // ! Assigning the fixed vertices of block i to block j is feasible,
+  // ! if fixed_vertex_part_weight[i] + part_weight[j] <= max_part_weight[i].
+  void setBalanceConstraint(std::vector<HypernodeWeight>&& fixed_vertex_part_weight,
+                            std::vector<HypernodeWeight>&& part_weight,
+                            std::vector<HypernodeWeight>&& max_part_weight,
+                            const HyperedgeWeight infeasible_weight) {
+    ASSERT(fixed_vertex_part_weight.size() == _adjacent_blocks.size() &&
+           part_weight.size() == _adjacent_blocks.size() &&
+           max_part_weight.size() == _adjacent_blocks.size());
+    _fixed_vertex_part_weight = std::move(fixed_vertex_part_weight);
+    _part_weight = std::move(part_weight);
+    _max_part_weight = std::move(max_part_weight);
+    _infeasible_weight = infeasible_weight;
+  }
 
-class MinimumBipartiteVertexCover final : public MaximumBipartiteMatching {
- public:
-  explicit MinimumBipartiteVertexCover(const AdjacencyMatrix& graph) :
-    MaximumBipartiteMatching(graph),
-    _bipartite_graph(graph),
-    _maximum_matching_already_calculated(false),
-    _maximum_matching() { }
-
-  MinimumBipartiteVertexCover(const MinimumBipartiteVertexCover&) = delete;
-  MinimumBipartiteVertexCover(MinimumBipartiteVertexCover&&) = delete;
-  MinimumBipartiteVertexCover& operator= (const MinimumBipartiteVertexCover&) = delete;
-  MinimumBipartiteVertexCover& operator= (MinimumBipartiteVertexCover&&) = delete;
-  ~MinimumBipartiteVertexCover() = default;
-
-  /**
-   * Function computes a minimum vertex cover in an unweighted
-   * bipartite graph. There exists a duality between a
-   * minimum vertex cover and a maximum bipartite matching.
-   */
-  VertexCover findMinimumBipartiteVertexCover() {
-    VertexCover cover;
-    const PartitionID k = _num_nodes / 2 - 1;
-
-    computeMaximumBipartiteMatching();
-
-    // Compute all unmatched left side vertices
-    _visited.reset();
-    for (auto matched_edge : _maximum_matching) {
-      const NodeID l = matched_edge.first;
-      _visited.set(l, true);
-    }
-    std::vector<NodeID> unmatched_vertices;
-    for (NodeID u = 0; u < k; ++u) {
-      if (!_visited[u]) {
-        unmatched_vertices.push_back(u);
-      }
-    }
+  bool isFeasible(const PartitionID i, const PartitionID j) const {
+    return _fixed_vertex_part_weight[i] + _part_weight[j] <= _max_part_weight[i];
+  }
 
-    // Remove source and sink from residual graph
-    for (NodeID u = 0; u < k; ++u) {
-      _residualGraph[_source][u] = 0;
-      _residualGraph[u][_source] = 0;
-      _residualGraph[u + k][_sink] = 0;
-      _residualGraph[_sink][u + k] = 0;
-    }
+  HyperedgeWeight infeasibleWeight() const {
+    return _infeasible_weight;
+  }
 
-    // Construct set H of vertices reachable via an alternating
-    // path from unmatched vertices of the left side.
-    // NOTE: Set H is marked as visited after BFS
-    _visited.reset();
-    for (NodeID u : unmatched_vertices) {
-      bfs(u, false);
+  HyperedgeWeight weight(const PartitionID i, const PartitionID j) const {
+    if (!isFeasible(i, j)) {
+      return _infeasible_weight;
     }
-    // Let L be the left side and R be the right side
-    // of the bipartite graph, then a minimum vertex
-    // cover is defined as follows C := (L \ H) \cup (R \cap H)
-    // L \ H:
-    for (NodeID u = 0; u < k; ++u) {
-      if (!_visited[u]) {
-        cover.push_back(u);
+    for (const Edge& edge : _adjacent_blocks[i]) {
+      if (edge.first == j) {
+        return edge.second;
       }
     }
-    // R \cap H:
-    for (NodeID u = k; u < 2 * k; ++u) {
-      if (_visited[u]) {
-        cover.push_back(u);
-      }
-    }
-
-    ASSERT(cover.size() == _maximum_matching.size(),
-           "Size of minimum vertex cover is not equal with size of the maximum matching");
-    // Verify, that the vertex cover found is an valid vertex cover.
-    ASSERT([&]() {
-          // Remove all edges covered by the vertex cover
-          for (NodeID u : cover) {
-            if (u < k) {
-              for (PartitionID i = 0; i < k; ++i) {
-                _bipartite_graph[u][i] = 0;
-              }
-            } else {
-              for (PartitionID i = 0; i < k; ++i) {
-                _bipartite_graph[i][u - k] = 0;
-              }
-            }
-          }
-          // If there is still an edge left in the graph, than
-          // our vertex cover is not an valid vertex cover
-          for (PartitionID i = 0; i < k; ++i) {
-            for (PartitionID j = 0; j < k; ++j) {
-              if (_bipartite_graph[i][j]) {
-                LOG << "Unmatched edge found (" << i << "," << j << ")";
-                return false;
-              }
-            }
-          }
-          return true;
-        } (), "Invalid vertex cover");
-    return cover;
-  }
-
-  Matching computeMaximumBipartiteMatching() {
-    if (!_maximum_matching_already_calculated) {
-      _maximum_matching = findMaximumBipartiteMatching();
-      _maximum_matching_already_calculated = true;
-    }
-    return _maximum_matching;
+    return 0;
   }
 
  private:
-  using BipartiteMaximumFlow::_num_nodes;
-  using BipartiteMaximumFlow::_residualGraph;
-  using BipartiteMaximumFlow::_visited;
-  using BipartiteMaximumFlow::_source;
-  using BipartiteMaximumFlow::_sink;
-
-  AdjacencyMatrix _bipartite_graph;
-  bool _maximum_matching_already_calculated;
-  Matching _maximum_matching;
+  std::vector<std::vector<Edge> > _adjacent_blocks;
+  std::vector<HypernodeWeight> _fixed_vertex_part_weight;
+  std::vector<HypernodeWeight> _part_weight;
+  std::vector<HypernodeWeight> _max_part_weight;
+  HyperedgeWeight _infeasible_weight;
 };
 
-static inline AdjacencyMatrix setupWeightedBipartiteMatchingGraph(Hypergraph& input_hypergraph,
-                                                                  const Context& original_context) {
+static inline BipartiteMatchingGraph setupWeightedBipartiteMatchingGraph(Hypergraph& input_hypergraph,
+                                                                         const Context& original_context) {
   const PartitionID k = original_context.partition.k;
-  AdjacencyMatrix graph(k, std::vector<HyperedgeWeight>(k, 0));
+  BipartiteMatchingGraph graph(k);
 
   std::vector<std::vector<HypernodeID> > fixed_vertices(k, std::vector<HypernodeID>());
   for (const HypernodeID& hn : input_hypergraph.fixedVertices()) {
@@ -378,9 +172,25 @@ static inline AdjacencyMatrix setupWeightedBipartiteMatchingGraph(Hypergraph& in
     }
   }
 
+  // Only blocks sharing a hyperedge with the fixed vertices of block i
+  // get an explicit edge in the bipartite graph. Their weights are
+  // accumulated in a dense row, which is reset after each block.
+  std::vector<HyperedgeWeight> row(k, 0);
+  std::vector<PartitionID> adjacent_blocks;
+  ds::FastResetFlagArray<> is_adjacent(k);
+  auto add_weight = [&](const PartitionID j, const HyperedgeWeight weight) {
+                      if (!is_adjacent[j]) {
+                        is_adjacent.set(j, true);
+                        adjacent_blocks.push_back(j);
+                      }
+                      row[j] += weight;
+                    };
+
   ds::FastResetFlagArray<> visited(input_hypergraph.initialNumEdges());
   for (PartitionID i = 0; i < k; ++i) {
     visited.reset();
+    is_adjacent.reset();
+    adjacent_blocks.clear();
     for (const HypernodeID& hn : fixed_vertices[i]) {
       for (const HyperedgeID& he : input_hypergraph.incidentEdges(hn)) {
         if (!visited[he]) {
@@ -400,7 +210,7 @@ static inline AdjacencyMatrix setupWeightedBipartiteMatchingGraph(Hypergraph& in
             //       solve a maximum weighted bipartite matching problem
             //       to optimize the km1 metric (proposed by kPaToH)
             for (PartitionID j : input_hypergraph.connectivitySet(he)) {
-              graph[i][j] += input_hypergraph.edgeWeight(he);
+              add_weight(j, input_hypergraph.edgeWeight(he));
             }
           } else if (original_context.partition.objective == Objective::cut) {
             // The cut metric only increases if we would make a non-cut
@@ -413,7 +223,7 @@ static inline AdjacencyMatrix setupWeightedBipartiteMatchingGraph(Hypergraph& in
             // the cut metric.
             if (input_hypergraph.connectivity(he) == 1 && fixed_connectivity[he] == 1) {
               for (PartitionID j : input_hypergraph.connectivitySet(he)) {
-                graph[i][j] += input_hypergraph.edgeWeight(he);
+                add_weight(j, input_hypergraph.edgeWeight(he));
               }
             }
           }
@@ -421,26 +231,35 @@ static inline AdjacencyMatrix setupWeightedBipartiteMatchingGraph(Hypergraph& in
         }
       }
     }
-    // Discard assignment of fixed vertices to a block which violates
-    // balanced contraint
-    for (PartitionID j = 0; j < k; ++j) {
-      if (input_hypergraph.fixedVertexPartWeight(i) + input_hypergraph.partWeight(j) >
-          original_context.partition.max_part_weights[i]) {
-        graph[i][j] = -total_hyperedge_weight;
-      }
+    for (const PartitionID j : adjacent_blocks) {
+      graph.addEdge(i, j, row[j]);
+      row[j] = 0;
     }
   }
 
+  // Discard assignment of fixed vertices to a block which violates
+  // balanced contraint
+  std::vector<HypernodeWeight> fixed_vertex_part_weight(k, 0);
+  std::vector<HypernodeWeight> part_weight(k, 0);
+  for (PartitionID i = 0; i < k; ++i) {
+    fixed_vertex_part_weight[i] = input_hypergraph.fixedVertexPartWeight(i);
+    part_weight[i] = input_hypergraph.partWeight(i);
+  }
+  graph.setBalanceConstraint(std::move(fixed_vertex_part_weight), std::move(part_weight),
+                             std::vector<HypernodeWeight>(original_context.partition.max_part_weights),
+                             -total_hyperedge_weight);
+
   return graph;
 }
 
-static inline void printAdjacencyMatrix(const AdjacencyMatrix& graph, bool weighted = false) {
+
+static inline void printBipartiteMatchingGraph(const BipartiteMatchingGraph& graph) {
   if (debug) {
-    const PartitionID k = graph.size();
-    LOG << (weighted ? "WEIGHTED" : "UNWEIGHTED") << " MATCHING GRAPH:";
+    const PartitionID k = graph.k();
+    LOG << "WEIGHTED MATCHING GRAPH:";
     for (PartitionID i = 0; i < k; ++i) {
       for (PartitionID j = 0; j < k; ++j) {
-        LLOG << graph[i][j] << " ";
+        LLOG << graph.weight(i, j) << " ";
       }
       LOG << "";
     }
@@ -457,14 +276,6 @@ static inline void printMatching(const Matching& matching) {
     }
   }
 }
-static inline void printVertexCover(const VertexCover& cover, const PartitionID k) {
-  if (debug) {
-    DBG << "Calculated Vertex Cover (Size:" << cover.size() << "):";
-    for (const NodeID u : cover) {
-      DBG << (u < k ? "Left-Side Vertex" : "Right-Side Vertex") << (u < k ? u : (u - k));
-    }
-  }
-}
 
 
 /**
@@ -482,145 +293,135 @@ static inline void printVertexCover(const VertexCover& cover, const PartitionID
  * The minimum weighted cover problem is to find a cover of
  * minimum cost.
  *
- * The basic idea is to construct a subgraph G' which contains
- * an edge (i,j) (with i \in L and j \in R) between each pair of
- * nodes where u[i] + v[j] = w[i][j]. If we find a perfect matching
- * in that subgraph, we are done and can report the maximum weighted
- * bipartite matching. Otherwise, we have to adapt the weights of
- * the cover u and v and repeat the procedure until we find a perfect
- * matching in the subgraph.
+ * The left side vertices are added to the matching one after another.
+ * For each vertex, we grow a tree of alternating paths along tight
+ * edges (u[i] + v[j] == w[i][j]) in the manner of Dijkstra's algorithm,
+ * where the slack of the remaining edges is maintained per right side
+ * vertex. Whenever no tight edge leaves the tree, the cover is adjusted
+ * by the minimum slack. As soon as the tree reaches an unmatched right
+ * side vertex, the matching is augmented along the tree path.
  *
  * Time complexity: O(k^3)
- *
- * Input:
- * The input of the function is an adjacency matrix which contains
- * the L-vertices as columns and the R-vertices as rows . A value
- * w := graph[i][j] indicates that there is an edge between L-vertex i
- * and R-vertex j with a weight of w.
+ * Memory: O(k) in addition to the sparse input graph. The weights of a
+ * left side vertex are scattered into a dense row whenever it is scanned.
  *
  * References:
  * Kuhn, Harold W.
  * "The Hungarian method for the assignment problem."
  * Naval Research Logistics (NRL) 2.1‐2 (1955): 83-97.
  *
- * The implementation is similiar as proposed in the following
- * online resource:
- * https://www.ti.inf.ethz.ch/ew/lehre/GT03/lectures/PDF/lecture6f.pdf
+ * Jonker, Roy, and Anton Volgenant.
+ * "A shortest augmenting path algorithm for dense and sparse linear assignment problems."
+ * Computing 38.4 (1987): 325-340.
  */
-static inline Matching findMaximumWeightedBipartiteMatching(const AdjacencyMatrix& graph) {
-  const PartitionID k = graph.size();
-
-  // Initialize Weighted Cover
-  std::vector<HyperedgeWeight> u(k, 0);
-  std::vector<HyperedgeWeight> v(k, 0);
-  for (PartitionID i = 0; i < k; ++i) {
-    u[i] = *std::max_element(graph[i].begin(), graph[i].end());
-  }
-
-  // Lambda function to construct the subgraph which contains
-  // an edge between each pair of nodes (i,j) of the bipartite
-  // graph where u[i] + v[j] == graph[i][j].
-  auto construct_matching_graph = [&u, &v, &graph, k]() {
-                                    AdjacencyMatrix matching_graph(k, std::vector<HyperedgeWeight>(k, 0));
-                                    for (PartitionID i = 0; i < k; ++i) {
-                                      for (PartitionID j = 0; j < k; ++j) {
-                                        if (u[i] + v[j] == graph[i][j]) {
-                                          matching_graph[i][j] = 1;
-                                        }
-                                      }
-                                    }
-                                    return matching_graph;
-                                  };
-
-  // Excess function which is important to adjust the
-  // weights of the weighted cover.
-  auto excess = [&u, &v, &graph](PartitionID i, PartitionID j) {
-                  return u[i] + v[j] - graph[i][j];
-                };
-
-  Matching matching;
-  size_t iteration = 1;
-  while (true) {
-    DBG << "Maximum Weighted Bipartite Matching - Iteration" << iteration;
-    if (debug) {
-      for (PartitionID i = 0; i < k; ++i) {
-        DBG << V(i) << V(u[i]) << V(v[i]);
+static inline Matching findMaximumWeightedBipartiteMatching(const BipartiteMatchingGraph& graph) {
+  using Label = int64_t;
+  const PartitionID k = graph.k();
+  const Label kInfinity = std::numeric_limits<Label>::max();
+  static constexpr PartitionID kUnmatched = -1;
+
+  // Weighted cover labels of the left (u) and right (v) side vertices
+  std::vector<Label> u(k, 0);
+  std::vector<Label> v(k, 0);
+  // matched_left[j] is the left side vertex matched to right side vertex j
+  std::vector<PartitionID> matched_left(k, kUnmatched);
+  // Right side vertex matched to the left side vertex through which j was
+  // reached in the alternating tree (kUnmatched, if it was reached from the root)
+  std::vector<PartitionID> parent(k, kUnmatched);
+  std::vector<Label> slack(k, kInfinity);
+  std::vector<bool> in_tree(k, false);
+  std::vector<PartitionID> tree;
+  std::vector<HyperedgeWeight> row(k, 0);
+
+  for (PartitionID root = 0; root < k; ++root) {
+    std::fill(slack.begin(), slack.end(), kInfinity);
+    std::fill(in_tree.begin(), in_tree.end(), false);
+    tree.clear();
+
+    PartitionID current_left = root;
+    PartitionID current_right = kUnmatched;
+    while (true) {
+      for (const auto& edge : graph.adjacentBlocks(current_left)) {
+        row[edge.first] = edge.second;
       }
-    }
 
-    ASSERT([&]() {
-          for (PartitionID i = 0; i < k; ++i) {
-            for (PartitionID j = 0; j < k; ++j) {
-              if (u[i] + v[j] < graph[i][j]) {
-                LOG << V(i) << V(j) << "=>" << V(u[i]) << "+" << V(v[j]) << ">=" << V(graph[i][j]);
-                return false;
-              }
-            }
+      // Update slacks of all right side vertices not contained in the tree
+      // and determine the one with minimum slack
+      Label delta = kInfinity;
+      PartitionID next_right = kUnmatched;
+      for (PartitionID j = 0; j < k; ++j) {
+        if (!in_tree[j]) {
+          const Label w = graph.isFeasible(current_left, j) ? row[j] : graph.infeasibleWeight();
+          const Label excess = u[current_left] + v[j] - w;
+          if (excess < slack[j]) {
+            slack[j] = excess;
+            parent[j] = current_right;
+          }
+          if (slack[j] < delta) {
+            delta = slack[j];
+            next_right = j;
           }
-          return true;
-        } (), "Minimum weighted cover invariant violated");
-
-    // Compute matching subgraph
-    AdjacencyMatrix matching_graph = construct_matching_graph();
-    printAdjacencyMatrix(matching_graph);
-
-    // Compute maximum matching
-    // NOTE: matching_graph is a unweighted bipartite graph
-    MinimumBipartiteVertexCover vertex_cover(matching_graph);
-    matching = vertex_cover.computeMaximumBipartiteMatching();
-    printMatching(matching);
-
-    if (matching.size() == static_cast<size_t>(k)) {
-      // If we found a perfect matching we are done and
-      // report the maximum bipartite weighted matching
-      DBG << "Maximum bipartite weighted matching found";
-      break;
-    } else {
-      // Otherwise we have to adapt the weights of the
-      // weighted cover.
-      DBG << "Maximum matching is not a perfect matching";
-      // Therefore we compute a minimum vertex cover in
-      // the subgraph.
-      VertexCover cover = vertex_cover.findMinimumBipartiteVertexCover();
-      printVertexCover(cover, k);
-
-      // (Un)Matched vertices (not contained in the vertex cover)
-      // from left and right side of bipartite graph
-      std::vector<bool> L(k, false);
-      std::vector<bool> R(k, false);
-      for (NodeID u : cover) {
-        if (u < k) {
-          L[u] = true;
-        } else {
-          R[u - k] = true;
         }
       }
 
-      // Compute minimum excess between all vertices not in the vertex cover
-      HyperedgeWeight min_excess = std::numeric_limits<HyperedgeWeight>::max();
-      for (PartitionID i = 0; i < k; ++i) {
-        for (PartitionID j = 0; j < k; ++j) {
-          if (!L[i] && !R[j]) {
-            min_excess = std::min(excess(i, j), min_excess);
-          }
-        }
+      for (const auto& edge : graph.adjacentBlocks(current_left)) {
+        row[edge.first] = 0;
       }
-      DBG << V(min_excess);
+      ASSERT(next_right != kUnmatched);
 
-      // Update weighted cover vectors
-      for (PartitionID i = 0; i < k; ++i) {
-        if (!L[i]) {
-          u[i] -= min_excess;
-        }
-        if (R[i]) {
-          v[i] += min_excess;
+      // Adjust the weighted cover such that the edge to next_right becomes tight
+      u[root] -= delta;
+      for (const PartitionID j : tree) {
+        u[matched_left[j]] -= delta;
+        v[j] += delta;
+      }
+      for (PartitionID j = 0; j < k; ++j) {
+        if (!in_tree[j]) {
+          slack[j] -= delta;
         }
       }
+
+      in_tree[next_right] = true;
+      tree.push_back(next_right);
+      current_right = next_right;
+      if (matched_left[next_right] == kUnmatched) {
+        break;
+      }
+      current_left = matched_left[next_right];
     }
-    DBG << "================================================================";
-    ++iteration;
+
+    // Augment the matching along the alternating path
+    while (current_right != kUnmatched) {
+      const PartitionID previous_right = parent[current_right];
+      matched_left[current_right] = previous_right == kUnmatched ? root : matched_left[previous_right];
+      current_right = previous_right;
+    }
+  }
+
+  Matching matching;
+  for (PartitionID j = 0; j < k; ++j) {
+    ASSERT(matched_left[j] != kUnmatched);
+    matching.push_back(std::make_pair(matched_left[j], j));
   }
+  printMatching(matching);
 
+  ASSERT([&]() {
+        for (PartitionID i = 0; i < k; ++i) {
+          for (PartitionID j = 0; j < k; ++j) {
+            if (u[i] + v[j] < graph.weight(i, j)) {
+              LOG << V(i) << V(j) << "=>" << V(u[i]) << "+" << V(v[j]) << ">=" << V(graph.weight(i, j));
+              return false;
+            }
+          }
+        }
+        for (const auto& matched_edge : matching) {
+          if (u[matched_edge.first] + v[matched_edge.second] !=
+              graph.weight(matched_edge.first, matched_edge.second)) {
+            return false;
+          }
+        }
+        return true;
+      } (), "Matching is not a maximum weighted matching");
   ASSERT(verify(matching, k), "Invalid matching");
 
   return matching;
@@ -667,8 +468,8 @@ static inline void partition(Hypergraph& input_hypergraph,
   // Aykanat, Cevdet, B. Barla Cambazoglu, and Bora Uçar.
   // "Multi-level direct k-way hypergraph partitioning with multiple constraints and fixed vertices."
   // Journal of Parallel and Distributed Computing 68.5 (2008): 609-625.
-  AdjacencyMatrix graph = setupWeightedBipartiteMatchingGraph(input_hypergraph, original_context);
-  printAdjacencyMatrix(graph, true);
+  const BipartiteMatchingGraph graph = setupWeightedBipartiteMatchingGraph(input_hypergraph, original_context);
+  printBipartiteMatchingGraph(graph);
 
   Matching maximum_weighted_matching = findMaximumWeightedBipartiteMatching(graph);
   ASSERT(maximum_weighted_matching.size() == static_cast<size_t>(original_context.partition.k),
@@ -687,8 +488,8 @@ static inline void partition(Hypergraph& input_hypergraph,
     partition_permutation[from] = to;
     if (debug || original_context.initial_partitioning.verbose_output) {
       LOG << "Block" << from << "assigned to fixed vertices with id"
-          << to << "with weight" << graph[to][from];
-      matching_weight += graph[to][from];
+          << to << "with weight" << graph.weight(to, from);
+      matching_weight += graph.weight(to, from);
     }
   }
   if (debug || original_context.initial_partitioning.verbose_output) {
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <memory>
+#include <random>
 #include <stack>
 #include <vector>
 
@@ -36,6 +38,7 @@
 #include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
 #include "kahypar/partition/refinement/policies/fm_stop_policy.h"
 #include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
 
 namespace kahypar {
 template <typename Derived = Mandatory>
@@ -45,6 +48,13 @@ class InitialPartitionerBase {
   static constexpr HypernodeID kInvalidNode = std::numeric_limits<HypernodeID>::max();
   static constexpr bool debug = false;
 
+  // ! Partition of the hypergraph computed by an independent initial partitioning trial.
+  struct TrialResult {
+    HyperedgeWeight quality = std::numeric_limits<HyperedgeWeight>::max();
+    double imbalance = std::numeric_limits<double>::max();
+    std::vector<PartitionID> partition;
+  };
+
  public:
   InitialPartitionerBase(Hypergraph& hypergraph,
                          Context& context,
@@ -107,6 +117,10 @@ class InitialPartitionerBase {
   }
 
   void multipleRunsInitialPartitioning() {
+    if (_context.partition.num_threads > 1 && _context.initial_partitioning.nruns > 1) {
+      parallelMultipleRunsInitialPartitioning();
+      return;
+    }
     Objective obj = _context.partition.objective;
     HyperedgeWeight best_quality = std::numeric_limits<HyperedgeWeight>::max();
     double best_imbalance = std::numeric_limits<double>::max();
@@ -120,15 +134,8 @@ class InitialPartitionerBase {
       const double current_imbalance = metrics::imbalance(_hg, _context);
       DBG << V(obj) << V(current_quality) << V(current_imbalance);
 
-      const bool equal_metric = current_quality == best_quality;
-      const bool improved_metric = current_quality < best_quality;
-      const bool improved_imbalance = current_imbalance < best_imbalance;
-      const bool is_feasible_partition = current_imbalance <= _context.partition.epsilon;
-      const bool is_best_cut_feasible_paritition = best_imbalance <= _context.partition.epsilon;
-
-      if ((improved_metric && (is_feasible_partition || improved_imbalance)) ||
-          (equal_metric && improved_imbalance) ||
-          (is_feasible_partition && !is_best_cut_feasible_paritition)) {
+      if (isBetterPartition(current_quality, current_imbalance, best_quality, best_imbalance,
+                            _context.partition.epsilon)) {
         best_quality = current_quality;
         best_imbalance = current_imbalance;
         for (const HypernodeID& hn : _hg.nodes()) {
@@ -153,6 +160,114 @@ class InitialPartitionerBase {
       } (), "Fixed Vertices are not correctly assigned!");
   }
 
+  /*!
+   * Parallel version of multipleRunsInitialPartitioning(): each of the nruns
+   * runs is performed by its own instance of the initial partitioner on its own
+   * copy of the hypergraph (see runTrialsInParallel()). The best partition is
+   * selected in the order of the runs.
+   */
+  void parallelMultipleRunsInitialPartitioning() {
+    const std::vector<TrialResult> results = runTrialsInParallel(
+      _context.initial_partitioning.nruns,
+      [](const size_t, Hypergraph& hypergraph, Context& context) {
+        Derived partitioner(hypergraph, context);
+        partitioner.initialPartition();
+      });
+
+    size_t best_run = 0;
+    for (size_t run = 1; run < results.size(); ++run) {
+      if (isBetterPartition(results[run].quality, results[run].imbalance,
+                            results[best_run].quality, results[best_run].imbalance,
+                            _context.partition.epsilon)) {
+        best_run = run;
+      }
+    }
+    DBG << V(best_run) << V(results[best_run].quality) << V(results[best_run].imbalance);
+
+    _hg.resetPartitioning();
+    for (const HypernodeID& hn : _hg.nodes()) {
+      _hg.setNodePart(hn, results[best_run].partition[hn]);
+    }
+
+    ASSERT([&]() {
+        for (const HypernodeID& hn : _hg.fixedVertices()) {
+          if (_hg.partID(hn) != _hg.fixedVertexPartID(hn)) {
+            LOG << V(hn) << V(_hg.partID(hn)) << V(_hg.fixedVertexPartID(hn));
+            return false;
+          }
+        }
+        return true;
+      } (), "Fixed Vertices are not correctly assigned!");
+  }
+
+  /*!
+   * Performs num_trials independent initial partitioning trials using
+   * context.partition.num_threads threads. Trial i calls
+   * run_trial(i, hypergraph, context) on its own copy of the hypergraph and
+   * the context, which leaves the hypergraph partitioned.
+   *
+   * The random seeds of all trials are drawn from the random number generator
+   * of the calling thread beforehand. Therefore, the results neither depend on
+   * the number of threads nor on the thread that executes a trial.
+   */
+  template <typename RunTrial>
+  std::vector<TrialResult> runTrialsInParallel(const size_t num_trials,
+                                               const RunTrial& run_trial) {
+    std::vector<int> seeds(num_trials);
+    // The contexts are created and destroyed by the calling thread, because
+    // their statistics are merged into the statistics of _context on destruction.
+    std::vector<std::unique_ptr<Context> > contexts;
+    for (size_t trial = 0; trial < num_trials; ++trial) {
+      seeds[trial] = Randomize::instance().newRandomSeed();
+      contexts.emplace_back(std::make_unique<Context>(_context));
+      contexts.back()->partition.num_threads = 1;
+      contexts.back()->initial_partitioning.nruns = 1;
+    }
+
+    std::vector<TrialResult> results(num_trials);
+    ThreadPool pool(std::min(_context.partition.num_threads, num_trials));
+    pool.parallelFor(0, num_trials, 1,
+                     [&](const size_t, const size_t begin, const size_t end) {
+        // The random number generator of the calling thread participates
+        // in the trials and is therefore restored afterwards.
+        Randomize& randomize = Randomize::instance();
+        const std::mt19937 generator = randomize.getGenerator();
+        for (size_t trial = begin; trial < end; ++trial) {
+          randomize.setSeed(seeds[trial]);
+          auto copy = ds::reindex(_hg);
+          Hypergraph& hypergraph = *copy.first;
+          run_trial(trial, hypergraph, *contexts[trial]);
+
+          TrialResult& result = results[trial];
+          result.quality = _context.partition.objective == Objective::cut ?
+                           metrics::hyperedgeCut(hypergraph) : metrics::km1(hypergraph);
+          result.imbalance = metrics::imbalance(hypergraph, _context);
+          result.partition.assign(_hg.initialNumNodes(), kInvalidPart);
+          for (const HypernodeID& hn : hypergraph.nodes()) {
+            result.partition[copy.second[hn]] = hypergraph.partID(hn);
+          }
+        }
+        randomize.getGenerator() = generator;
+      });
+    return results;
+  }
+
+  // ! Decides whether a partition of the given quality and imbalance is preferred
+  // ! over the best partition found so far.
+  static bool isBetterPartition(const HyperedgeWeight quality, const double imbalance,
+                                const HyperedgeWeight best_quality, const double best_imbalance,
+                                const double epsilon) {
+    const bool equal_metric = quality == best_quality;
+    const bool improved_metric = quality < best_quality;
+    const bool improved_imbalance = imbalance < best_imbalance;
+    const bool is_feasible_partition = imbalance <= epsilon;
+    const bool is_best_cut_feasible_paritition = best_imbalance <= epsilon;
+
+    return (improved_metric && (is_feasible_partition || improved_imbalance)) ||
+           (equal_metric && improved_imbalance) ||
+           (is_feasible_partition && !is_best_cut_feasible_paritition);
+  }
+
   void performFMRefinement() {
     if (_context.initial_partitioning.refinement) {
       std::unique_ptr<IRefiner> refiner;
@@ -105,20 +105,33 @@ class PoolInitialPartitioner : public IInitialPartitioner,
   PoolInitialPartitioner& operator= (PoolInitialPartitioner&&) = delete;
 
  private:
+  // ! Statistics about the partitions computed by the algorithms of the pool.
+  struct PoolResults {
+    explicit PoolResults(const Objective obj) :
+      best_cut(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, kInvalidImbalance),
+      min_cut(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, 0.0),
+      max_cut(InitialPartitionerAlgorithm::pool, obj, -1, 0.0),
+      min_imbalance(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, kInvalidImbalance),
+      max_imbalance(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, -0.1) { }
+
+    PartitioningResult best_cut;
+    PartitioningResult min_cut;
+    PartitioningResult max_cut;
+    PartitioningResult min_imbalance;
+    PartitioningResult max_imbalance;
+  };
+
   void partitionImpl() override final {
-    Base::multipleRunsInitialPartitioning();
+    if (_context.partition.num_threads > 1) {
+      parallelInitialPartition();
+    } else {
+      Base::multipleRunsInitialPartitioning();
+    }
   }
 
-  void initialPartition() {
-    Objective obj = _context.partition.objective;
-    PartitioningResult best_cut(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, kInvalidImbalance);
-    PartitioningResult min_cut(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, 0.0);
-    PartitioningResult max_cut(InitialPartitionerAlgorithm::pool, obj, -1, 0.0);
-    PartitioningResult min_imbalance(InitialPartitionerAlgorithm::pool, obj, kInvalidCut,
-                                     kInvalidImbalance);
-    PartitioningResult max_imbalance(InitialPartitionerAlgorithm::pool, obj, kInvalidCut, -0.1);
-
-    std::vector<PartitionID> best_partition(_hg.initialNumNodes());
+  // ! Algorithms of the pool that are selected by pool_type.
+  std::vector<InitialPartitionerAlgorithm> selectedAlgorithms() const {
+    std::vector<InitialPartitionerAlgorithm> algorithms;
     unsigned int n = _partitioner_pool.size() - 1;
     for (unsigned int i = 0; i <= n; ++i) {
       // If the (n-i)th bit of pool_type is set we execute the corresponding
@@ -133,6 +146,17 @@ class PoolInitialPartitioner : public IInitialPartitioner,
         DBG << "skipping maxpin";
         continue;
       }
+      algorithms.push_back(algo);
+    }
+    return algorithms;
+  }
+
+  void initialPartition() {
+    Objective obj = _context.partition.objective;
+    PoolResults results(obj);
+
+    std::vector<PartitionID> best_partition(_hg.initialNumNodes());
+    for (const InitialPartitionerAlgorithm& algo : selectedAlgorithms()) {
       std::unique_ptr<IInitialPartitioner> partitioner(
         InitialPartitioningFactory::getInstance().createObject(algo, _hg, _context));
       partitioner->partition();
@@ -141,40 +165,96 @@ class PoolInitialPartitioner : public IInitialPartitioner,
       double current_imbalance = metrics::imbalance(_hg, _context);
       DBG << algo << V(obj) << V(current_quality) << V(current_imbalance);
 
-      const bool equal_metric = current_quality == best_cut.quality;
-      const bool improved_metric = current_quality < best_cut.quality;
-      const bool improved_imbalance = current_imbalance < best_cut.imbalance;
-      const bool is_feasible_partition = current_imbalance <= _context.partition.epsilon;
-      const bool is_best_cut_feasible_paritition = best_cut.imbalance <= _context.partition.epsilon;
-
-      if ((improved_metric && (is_feasible_partition || improved_imbalance)) ||
-          (equal_metric && improved_imbalance) ||
-          (is_feasible_partition && !is_best_cut_feasible_paritition)) {
+      if (addResult(results, current_quality, current_imbalance, algo)) {
         for (const HypernodeID& hn : _hg.nodes()) {
           best_partition[hn] = _hg.partID(hn);
         }
-        applyPartitioningResults(best_cut, current_quality, current_imbalance, algo);
-      }
-      if (current_quality < min_cut.quality) {
-        applyPartitioningResults(min_cut, current_quality, current_imbalance, algo);
       }
-      if (current_quality > max_cut.quality) {
-        applyPartitioningResults(max_cut, current_quality, current_imbalance, algo);
-      }
-      if (current_imbalance < min_imbalance.imbalance) {
-        applyPartitioningResults(min_imbalance, current_quality, current_imbalance, algo);
+    }
+
+    applyBestPartition(results, best_partition);
+
+    // Pool Partitioner executes each initial partitioner nruns times.
+    // To prevent pool partitioner to execute himself nruns times, we
+    // set the nruns parameter to 1.
+    _context.initial_partitioning.nruns = 1;
+  }
+
+  /*!
+   * Executes each run of each algorithm of the pool as an independent trial
+   * (see InitialPartitionerBase::runTrialsInParallel()). Afterwards, the best
+   * run of each algorithm and the best algorithm are selected in the same order
+   * as in the sequential version.
+   */
+  void parallelInitialPartition() {
+    const Objective obj = _context.partition.objective;
+    const std::vector<InitialPartitionerAlgorithm> algorithms = selectedAlgorithms();
+    const size_t nruns = _context.initial_partitioning.nruns;
+    ASSERT(!algorithms.empty(), "No initial partitioning algorithm selected");
+    const std::vector<TrialResult> trials = Base::runTrialsInParallel(
+      algorithms.size() * nruns,
+      [&](const size_t trial, Hypergraph& hypergraph, Context& context) {
+        std::unique_ptr<IInitialPartitioner> partitioner(
+          InitialPartitioningFactory::getInstance().createObject(algorithms[trial / nruns],
+                                                                 hypergraph, context));
+        partitioner->partition();
+      });
+
+    PoolResults results(obj);
+    size_t best_trial = 0;
+    for (size_t i = 0; i < algorithms.size(); ++i) {
+      size_t best_run = i * nruns;
+      for (size_t trial = best_run + 1; trial < (i + 1) * nruns; ++trial) {
+        if (Base::isBetterPartition(trials[trial].quality, trials[trial].imbalance,
+                                    trials[best_run].quality, trials[best_run].imbalance,
+                                    _context.partition.epsilon)) {
+          best_run = trial;
+        }
       }
-      if (current_imbalance > max_imbalance.imbalance) {
-        applyPartitioningResults(max_imbalance, current_quality, current_imbalance, algo);
+      DBG << algorithms[i] << V(obj) << V(trials[best_run].quality)
+          << V(trials[best_run].imbalance);
+      if (addResult(results, trials[best_run].quality, trials[best_run].imbalance,
+                    algorithms[i])) {
+        best_trial = best_run;
       }
     }
 
+    applyBestPartition(results, trials[best_trial].partition);
+  }
+
+  // ! Updates the statistics and returns true if the partition is the new best partition.
+  bool addResult(PoolResults& results, const HyperedgeWeight current_quality,
+                 const double current_imbalance, const InitialPartitionerAlgorithm algo) const {
+    const bool is_best = Base::isBetterPartition(current_quality, current_imbalance,
+                                                 results.best_cut.quality,
+                                                 results.best_cut.imbalance,
+                                                 _context.partition.epsilon);
+    if (is_best) {
+      applyPartitioningResults(results.best_cut, current_quality, current_imbalance, algo);
+    }
+    if (current_quality < results.min_cut.quality) {
+      applyPartitioningResults(results.min_cut, current_quality, current_imbalance, algo);
+    }
+    if (current_quality > results.max_cut.quality) {
+      applyPartitioningResults(results.max_cut, current_quality, current_imbalance, algo);
+    }
+    if (current_imbalance < results.min_imbalance.imbalance) {
+      applyPartitioningResults(results.min_imbalance, current_quality, current_imbalance, algo);
+    }
+    if (current_imbalance > results.max_imbalance.imbalance) {
+      applyPartitioningResults(results.max_imbalance, current_quality, current_imbalance, algo);
+    }
+    return is_best;
+  }
+
+  void applyBestPartition(const PoolResults& results,
+                          const std::vector<PartitionID>& best_partition) {
     if (_context.initial_partitioning.verbose_output) {
-      min_cut.print_result("Minimum Quality  ");
-      max_cut.print_result("Maximum Quality  ");
-      min_imbalance.print_result("Minimum Imbalance");
-      max_imbalance.print_result("Maximum Imbalance");
-      best_cut.print_result("==> Best Quality ");
+      results.min_cut.print_result("Minimum Quality  ");
+      results.max_cut.print_result("Maximum Quality  ");
+      results.min_imbalance.print_result("Minimum Imbalance");
+      results.max_imbalance.print_result("Maximum Imbalance");
+      results.best_cut.print_result("==> Best Quality ");
     }
 
     const PartitionID unassigned_part = _context.initial_partitioning.unassigned_part;
@@ -197,11 +277,6 @@ class PoolInitialPartitioner : public IInitialPartitioner,
         }
         return true;
       } (), "There are unassigned hypernodes!");
-
-    // Pool Partitioner executes each initial partitioner nruns times.
-    // To prevent pool partitioner to execute himself nruns times, we
-    // set the nruns parameter to 1.
-    _context.initial_partitioning.nruns = 1;
   }
 
   void applyPartitioningResults(PartitioningResult& result, const HyperedgeWeight quality,
@@ -212,6 +287,7 @@ class PoolInitialPartitioner : public IInitialPartitioner,
     result.algo = algo;
   }
 
+  using TrialResult = Base::TrialResult;
   using Base::_hg;
   using Base::_context;
   std::vector<InitialPartitionerAlgorithm> _partitioner_pool;
@@ -35,7 +35,7 @@ struct Metrics {
   double imbalance;
 
   void updateMetric(const HyperedgeWeight value, const Mode mode, const Objective objective) {
-    if (mode == Mode::direct_kway) {
+    if (mode == Mode::direct_kway || mode == Mode::streaming) {
       switch (objective) {
         case Objective::cut:
           cut = value;
@@ -54,7 +54,7 @@ struct Metrics {
   }
 
   HyperedgeWeight getMetric(const Mode mode, const Objective objective) {
-    if (mode == Mode::direct_kway) {
+    if (mode == Mode::direct_kway || mode == Mode::streaming) {
       switch (objective) {
         case Objective::cut: return cut;
         case Objective::km1: return km1;
@@ -72,8 +72,13 @@ struct Metrics {
 
 namespace metrics {
 static constexpr bool debug = false;
+static constexpr bool enable_heavy_assert = false;
 
-static inline HyperedgeWeight hyperedgeCut(const Hypergraph& hg) {
+// The hypergraph maintains cut, km1 and soed incrementally whenever the
+// connectivity or the weight of a hyperedge changes. The following functions
+// recompute the metrics from scratch and are used to validate the tracked values.
+namespace internal {
+inline HyperedgeWeight hyperedgeCut(const Hypergraph& hg) {
   HyperedgeWeight cut = 0;
   for (const HyperedgeID& he : hg.edges()) {
     if (hg.connectivity(he) > 1) {
@@ -84,7 +89,7 @@ static inline HyperedgeWeight hyperedgeCut(const Hypergraph& hg) {
   return cut;
 }
 
-static inline HyperedgeWeight soed(const Hypergraph& hg) {
+inline HyperedgeWeight soed(const Hypergraph& hg) {
   HyperedgeWeight soed = 0;
   for (const HyperedgeID& he : hg.edges()) {
     if (hg.connectivity(he) > 1) {
@@ -94,13 +99,32 @@ static inline HyperedgeWeight soed(const Hypergraph& hg) {
   return soed;
 }
 
-static inline HyperedgeWeight km1(const Hypergraph& hg) {
+inline HyperedgeWeight km1(const Hypergraph& hg) {
   HyperedgeWeight k_minus_1 = 0;
   for (const HyperedgeID& he : hg.edges()) {
     k_minus_1 += std::max(hg.connectivity(he) - 1, 0) * hg.edgeWeight(he);
   }
   return k_minus_1;
 }
+}  // namespace internal
+
+static inline HyperedgeWeight hyperedgeCut(const Hypergraph& hg) {
+  HEAVY_DATA_STRUCTURE_ASSERT(hg.cut() == internal::hyperedgeCut(hg),
+                              V(hg.cut()) << V(internal::hyperedgeCut(hg)));
+  return hg.cut();
+}
+
+static inline HyperedgeWeight soed(const Hypergraph& hg) {
+  HEAVY_DATA_STRUCTURE_ASSERT(hg.soed() == internal::soed(hg),
+                              V(hg.soed()) << V(internal::soed(hg)));
+  return hg.soed();
+}
+
+static inline HyperedgeWeight km1(const Hypergraph& hg) {
+  HEAVY_DATA_STRUCTURE_ASSERT(hg.km1() == internal::km1(hg),
+                              V(hg.km1()) << V(internal::km1(hg)));
+  return hg.km1();
+}
 
 static inline double absorption(const Hypergraph& hg) {
   double absorption_val = 0.0;
@@ -47,8 +47,8 @@ static inline void partition(Hypergraph& hypergraph,
   HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
   coarsener.coarsen(context.coarsening.contraction_limit);
   HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::coarsening,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::coarsening,
+                     std::chrono::duration<double>(end - start).count());
 
   if (!context.partition.quiet_mode && context.partition.verbose_output && context.type == ContextType::main) {
     io::printHypergraphInfo(hypergraph, "Coarsened Hypergraph");
@@ -63,8 +63,8 @@ static inline void partition(Hypergraph& hypergraph,
     start = std::chrono::high_resolution_clock::now();
     initial::partition(hypergraph, context);
     end = std::chrono::high_resolution_clock::now();
-    Timer::instance().add(context, Timepoint::initial_partitioning,
-                          std::chrono::duration<double>(end - start).count());
+    context.timer->add(context, Timepoint::initial_partitioning,
+                       std::chrono::duration<double>(end - start).count());
 
     hypergraph.initializeNumCutHyperedges();
     if (!context.partition.quiet_mode && context.partition.verbose_output && context.type == ContextType::main) {
@@ -122,8 +122,8 @@ static inline void partition(Hypergraph& hypergraph,
   coarsener.uncoarsen(refiner);
   end = std::chrono::high_resolution_clock::now();
 
-  Timer::instance().add(context, Timepoint::local_search,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::local_search,
+                     std::chrono::duration<double>(end - start).count());
 
   io::printLocalSearchResults(context, hypergraph);
 }
@@ -40,6 +40,7 @@
 #include "kahypar/partition/preprocessing/single_node_hyperedge_remover.h"
 #include "kahypar/partition/preprocessing/large_he_remover.h"
 #include "kahypar/partition/recursive_bisection.h"
+#include "kahypar/partition/streaming.h"
 
 namespace kahypar {
 // Workaround for bug in gtest
@@ -79,6 +80,9 @@ static inline void partition(Hypergraph& hypergraph, const Context& context) {
       case Mode::direct_kway:
         direct_kway::partition(hypergraph, context);
         break;
+      case Mode::streaming:
+        streaming::partition(hypergraph, context);
+        break;
       case Mode::UNDEFINED:
         LOG << "Partitioning Mode undefined!";
         std::exit(-1);
@@ -257,8 +261,8 @@ inline void Partitioner::preprocess(Hypergraph& hypergraph, Hypergraph& sparse_h
   sparse_hypergraph = _pin_sparsifier.buildSparsifiedHypergraph(hypergraph, context);
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
 
-  Timer::instance().add(context, Timepoint::pre_sparsifier,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::pre_sparsifier,
+                     std::chrono::duration<double>(end - start).count());
 
   if (context.partition.verbose_output) {
     LOG << "Performing sparsification::";
@@ -280,8 +284,8 @@ inline void Partitioner::postprocess(Hypergraph& hypergraph, Hypergraph& sparse_
   const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
   _pin_sparsifier.applyPartition(sparse_hypergraph, hypergraph);
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-  Timer::instance().add(context, Timepoint::post_sparsifier_restore,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::post_sparsifier_restore,
+                     std::chrono::duration<double>(end - start).count());
   postprocess(hypergraph, context);
 }
 
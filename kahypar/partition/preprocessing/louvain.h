@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "kahypar/datastructure/graph.h"
@@ -33,11 +34,20 @@
 #include "kahypar/partition/preprocessing/modularity.h"
 #include "kahypar/utils/randomize.h"
 #include "kahypar/utils/stats.h"
+#include "kahypar/utils/thread_pool.h"
 #include "kahypar/utils/timer.h"
 
 static constexpr bool debug = false;
 
 namespace kahypar {
+/*!
+ * Louvain community detection.
+ *
+ * If context.partition.num_threads > 1, the graph hierarchy is constructed and
+ * contracted in parallel and each louvain pass uses parallel local moving
+ * (see parallelLouvainPass). The parallel local moving optimizes modularity
+ * directly and does not use the QualityMeasure.
+ */
 template <class QualityMeasure = Mandatory,
           bool RandomizeNodes = true>
 class Louvain {
@@ -45,22 +55,29 @@ class Louvain {
   using Edge = ds::Edge;
   using Graph = ds::Graph;
 
+  static constexpr size_t kChunkSize = 256;
+  // Number of synchronous sub-rounds per local moving iteration. Nodes of the
+  // same sub-round do not see each other's moves.
+  static constexpr size_t kNumSubRounds = 16;
+
  public:
   Louvain(const Hypergraph& hypergraph,
           const Context& context) :
+    _pool(makePool(context)),
     _graph_hierarchy(),
     _random_node_order(),
     _context(context) {
-    _graph_hierarchy.emplace_back(hypergraph, context);
+    _graph_hierarchy.emplace_back(hypergraph, context, _pool.get());
   }
 
   Louvain(const std::vector<NodeID>& adj_array,
           const std::vector<Edge>& edges,
           const Context& context) :
+    _pool(makePool(context)),
     _graph_hierarchy(),
     _random_node_order(),
     _context(context) {
-    _graph_hierarchy.emplace_back(adj_array, edges);
+    _graph_hierarchy.emplace_back(adj_array, edges, _pool.get());
   }
 
   EdgeWeight run() {
@@ -100,7 +117,8 @@ class Louvain {
 
       old_quality = cur_quality;
       HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
-      cur_quality = louvain_pass(_graph_hierarchy[cur_idx], quality);
+      cur_quality = _pool ? parallelLouvainPass(_graph_hierarchy[cur_idx]) :
+                    louvain_pass(_graph_hierarchy[cur_idx], quality);
       HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
       std::chrono::duration<double> elapsed_seconds = end - start;
       DBG << "Louvain-Pass #" << iteration << "Time:" << elapsed_seconds.count() << "s";
@@ -110,7 +128,6 @@ class Louvain {
           << "to" << cur_quality;
 
       if (improvement) {
-        cur_quality = quality.quality();
         DBG << "Starting Contraction of communities...";
         start = std::chrono::high_resolution_clock::now();
         auto contraction = _graph_hierarchy[cur_idx++].contractClusters();
@@ -155,6 +172,13 @@ class Louvain {
   FRIEND_TEST(ALouvainAlgorithm, AssingsMappingToNextLevelFinerGraph);
   FRIEND_TEST(ALouvainKarateClub, DoesLouvainAlgorithm);
 
+  static std::unique_ptr<ThreadPool> makePool(const Context& context) {
+    if (context.partition.num_threads > 1) {
+      return std::make_unique<ThreadPool>(context.partition.num_threads);
+    }
+    return nullptr;
+  }
+
   void assignClusterToNextLevelFinerGraph(Graph& fine_graph, const Graph& coarse_graph,
                                           const std::vector<NodeID>& mapping) {
     for (const NodeID& node : fine_graph.nodes()) {
@@ -244,6 +268,150 @@ class Louvain {
     return quality.quality();
   }
 
+  /*!
+   * Parallel local moving. Each iteration processes the nodes in random order,
+   * split into kNumSubRounds sub-rounds. Within a sub-round, all nodes compute
+   * their best cluster concurrently w.r.t. the clustering at the beginning of
+   * the sub-round. Afterwards, the moves are applied in node order.
+   * Thus the result only depends on the random node order and not on the
+   * number of threads.
+   *
+   * @return Modularity of the resulting clustering
+   */
+  EdgeWeight parallelLouvainPass(Graph& graph) {
+    ASSERT(_pool);
+    const size_t num_nodes = graph.numNodes();
+    size_t node_moves = 0;
+    uint32_t iterations = 0;
+
+    _random_node_order.clear();
+    for (const NodeID& node : graph.nodes()) {
+      _random_node_order.push_back(node);
+    }
+    if (RandomizeNodes) {
+      Randomize::instance().shuffleVector(_random_node_order, _random_node_order.size());
+    }
+
+    std::vector<EdgeWeight> cluster_volume(num_nodes, 0.0L);
+    for (const NodeID& node : graph.nodes()) {
+      ASSERT(static_cast<NodeID>(graph.clusterID(node)) == node);
+      cluster_volume[node] = graph.weightedDegree(node);
+    }
+    std::vector<ClusterID> target(num_nodes);
+    std::vector<ds::IncidentClusterWeights> scratch;
+    scratch.reserve(_pool->numThreads());
+    for (size_t i = 0; i < _pool->numThreads(); ++i) {
+      scratch.emplace_back(num_nodes);
+    }
+
+    // Same time stamp optimization as in louvain_pass: node u is only
+    // considered if one of its incident clusters changed since u was processed.
+    std::vector<size_t> node_time_stamp(num_nodes, 0);
+    std::vector<size_t> cluster_time_stamp(num_nodes, 1);
+    size_t time_stamp = 1;
+
+    const EdgeWeight m2 = graph.totalWeight();
+    const size_t sub_round_size = std::max(static_cast<size_t>(1),
+                                           (num_nodes + kNumSubRounds - 1) / kNumSubRounds);
+    do {
+      ++iterations;
+      DBG << "######## Starting Parallel-Louvain-Pass-Iteration #" << iterations << "########";
+      node_moves = 0;
+      for (size_t begin = 0; begin < num_nodes; begin += sub_round_size) {
+        const size_t end = std::min(begin + sub_round_size, num_nodes);
+        _pool->parallelFor(begin, end, kChunkSize,
+                           [&](const size_t worker, const size_t chunk_begin, const size_t chunk_end) {
+            for (size_t i = chunk_begin; i < chunk_end; ++i) {
+              const NodeID node = _random_node_order[i];
+              const ClusterID cur_cid = graph.clusterID(node);
+              target[node] = cur_cid;
+
+              bool incident_cluster_changed = node_time_stamp[node] < cluster_time_stamp[cur_cid];
+              for (const Edge& e : graph.incidentEdges(node)) {
+                if (node_time_stamp[node] < cluster_time_stamp[graph.clusterID(e.target_node)]) {
+                  incident_cluster_changed = true;
+                  break;
+                }
+              }
+              node_time_stamp[node] = time_stamp;
+              if (!incident_cluster_changed || m2 == 0.0L) {
+                continue;
+              }
+
+              // Modularity gain of inserting node into a cluster after removing
+              // it from its current cluster (see Modularity::gain).
+              const EdgeWeight w_degree = graph.weightedDegree(node);
+              EdgeWeight best_gain = 0.0L;
+              for (const auto& cluster : graph.incidentClusterWeightOfNode(node, scratch[worker])) {
+                const ClusterID cid = cluster.clusterID;
+                if (cid == cur_cid) {
+                  // The current cluster is always the first one.
+                  best_gain = cluster.weight - graph.selfloopWeight(node) -
+                              (cluster_volume[cid] - w_degree) * w_degree / m2;
+                } else {
+                  const EdgeWeight gain = cluster.weight - cluster_volume[cid] * w_degree / m2;
+                  if (gain > best_gain) {
+                    best_gain = gain;
+                    target[node] = cid;
+                  }
+                }
+              }
+            }
+          });
+
+        for (size_t i = begin; i < end; ++i) {
+          const NodeID node = _random_node_order[i];
+          const ClusterID from = graph.clusterID(node);
+          const ClusterID to = target[node];
+          if (from != to) {
+            cluster_volume[from] -= graph.weightedDegree(node);
+            cluster_volume[to] += graph.weightedDegree(node);
+            cluster_time_stamp[from] = time_stamp + 1;
+            cluster_time_stamp[to] = time_stamp + 1;
+            graph.setClusterID(node, to);
+            ++node_moves;
+          }
+        }
+        ++time_stamp;
+      }
+
+      DBG << "Iteration #" << iterations << ": Moving" << node_moves << "nodes to new communities.";
+    } while (node_moves > 0 &&
+             iterations < _context.preprocessing.community_detection.max_pass_iterations);
+
+    return modularity(graph, cluster_volume);
+  }
+
+  // ! Modularity of the clustering of graph, computed as in Modularity::quality.
+  EdgeWeight modularity(const Graph& graph, const std::vector<EdgeWeight>& cluster_volume) {
+    const size_t num_nodes = graph.numNodes();
+    std::vector<EdgeWeight> internal_weight_of_node(num_nodes, 0.0L);
+    _pool->parallelFor(0, num_nodes, kChunkSize,
+                       [&](const size_t, const size_t begin, const size_t end) {
+        for (NodeID node = begin; node < end; ++node) {
+          for (const Edge& e : graph.incidentEdges(node)) {
+            if (graph.clusterID(e.target_node) == graph.clusterID(node)) {
+              internal_weight_of_node[node] += e.weight;
+            }
+          }
+        }
+      });
+
+    std::vector<EdgeWeight> internal_weight(num_nodes, 0.0L);
+    for (const NodeID& node : graph.nodes()) {
+      internal_weight[graph.clusterID(node)] += internal_weight_of_node[node];
+    }
+    EdgeWeight q = 0.0L;
+    const EdgeWeight m2 = std::max(graph.totalWeight(), static_cast<EdgeWeight>(1));
+    for (ClusterID cid = 0; static_cast<size_t>(cid) < num_nodes; ++cid) {
+      if (cluster_volume[cid] > Graph::kEpsilon) {
+        q += internal_weight[cid] - (cluster_volume[cid] * cluster_volume[cid]) / m2;
+      }
+    }
+    return q / m2;
+  }
+
+  std::unique_ptr<ThreadPool> _pool;
   std::vector<Graph> _graph_hierarchy;
   std::vector<NodeID> _random_node_order;
   const Context& _context;
@@ -265,8 +433,8 @@ inline std::vector<ClusterID> detectCommunities(const Hypergraph& hypergraph,
   const EdgeWeight quality = louvain.run();
   HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> elapsed_seconds = end - start;
-  Timer::instance().add(context, Timepoint::pre_community_detection,
-                        std::chrono::duration<double>(end - start).count());
+  context.timer->add(context, Timepoint::pre_community_detection,
+                     std::chrono::duration<double>(end - start).count());
   if (context.type == ContextType::main) {
     context.stats.set(StatTag::Preprocessing, "Communities", louvain.numCommunities());
     context.stats.set(StatTag::Preprocessing, "Modularity", quality);
@@ -21,6 +21,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <numeric>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "kahypar/definitions.h"
@@ -32,6 +37,8 @@
 #include "kahypar/partition/multilevel.h"
 #include "kahypar/partition/preprocessing/louvain.h"
 #include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
 
 namespace kahypar {
 namespace recursive_bisection {
@@ -210,8 +217,118 @@ static inline Context createCurrentBisectionContext(const Context& original_cont
   return current_context;
 }
 
-static inline void partition(Hypergraph& input_hypergraph,
-                             const Context& original_context) {
+/*!
+ * Bisects current_hypergraph, which contains the nodes that have to be
+ * partitioned into blocks k1..k2 of the input hypergraph. Block 0 of the
+ * bisection will be partitioned into the first floor(k / 2) of these blocks.
+ * Returns false, if the bin packing restart mechanism detected that no
+ * balanced partition exists for the current hypergraph.
+ */
+static inline bool bisect(Hypergraph& current_hypergraph,
+                          const Hypergraph& input_hypergraph,
+                          const Context& original_context,
+                          const PartitionID k1,
+                          const PartitionID k2,
+                          const BalancingLevel level,
+                          const int bisection_number) {
+  const bool restart_if_imbalanced = original_context.initial_partitioning.enable_early_restart
+                                     || original_context.initial_partitioning.enable_late_restart;
+  const PartitionID k = k2 - k1 + 1;
+  const PartitionID km = k / 2;
+  bool is_feasible = true;
+
+  Context current_context =
+    createCurrentBisectionContext(original_context, input_hypergraph,
+                                  current_hypergraph, k, km, k - km, k1);
+  current_context.partition.rb_lower_k = k1;
+  current_context.partition.rb_upper_k = k2;
+
+  const bool direct_kway_verbose =
+    current_context.type == ContextType::initial_partitioning &&
+    current_context.initial_partitioning.verbose_output;
+  const bool recursive_bisection_verbose =
+    current_context.type == ContextType::main &&
+    current_context.partition.verbose_output;
+  const bool verbose_output = direct_kway_verbose || recursive_bisection_verbose;
+
+  if (verbose_output) {
+    LOG << "Recursive Bisection No." << bisection_number << ": Computing blocks ("
+        << current_context.partition.rb_lower_k << ".."
+        << current_context.partition.rb_upper_k << ")";
+    LOG << "L_max0:" << current_context.partition.max_part_weights[0];
+    LOG << "L_max1:" << current_context.partition.max_part_weights[1];
+    LOG << R"(========================================)"
+           R"(========================================)";
+  }
+
+  if (current_context.preprocessing.enable_community_detection) {
+    if (recursive_bisection_verbose) {
+      LOG << "******************************************"
+             "**************************************";
+      LOG << "*                               Preprocessing..."
+             "                               *";
+      LOG << "*********************************************"
+             "***********************************";
+    }
+
+    // For both recursive bisection and direct k-way partitioning mode, we allow to reuse
+    // community structure information. Direct k-way partitioning uses recursive bisection
+    // as initial partitioning mode. Using the reuse_communities flag, we can therefore
+    // decide whether or not the community structure found before the first bisection
+    // (which corresponds to the community structure of the input hypergraph for recursive
+    // bisection based partitioning and to the community structure of the coarse hypergraph
+    // for direct k-way partitioning) should be reused in subsequent bisections. Note that
+    // the community structure computed in the top level preprocessing phase of direct k-way
+    // partitioning is not used here, because we clear the communities vector before calling
+    // the initial partitioner (see initial_partition.h).
+    const bool detect_communities =
+      !current_context.preprocessing.community_detection.reuse_communities ||
+      bisection_number == 1;
+    if (detect_communities && current_hypergraph.initialNumNodes() > 0) {
+      detectCommunities(current_hypergraph, current_context);
+    } else if (verbose_output) {
+      LOG << "Reusing community structure computed in first bisection";
+    }
+  }
+
+
+  if (current_hypergraph.initialNumNodes() > 0 && restart_if_imbalanced && k > 2) {
+    std::vector<HypernodeWeight> max_bin_weights;
+    for (PartitionID i = k1; i <= k2; ++i) {
+      max_bin_weights.push_back(original_context.partition.max_part_weights[i]);
+    }
+    std::unique_ptr<IBinPacker> bin_packer(
+      BinPackerFactory::getInstance().createObject(original_context.initial_partitioning.bp_algo));
+    is_feasible = bin_packer->currentBinImbalance(current_hypergraph, max_bin_weights) <= 0;
+    multilevel::partitionRepeatedOnInfeasible(current_hypergraph, current_context, original_context.stats, level, max_bin_weights,
+                                              is_feasible && current_context.initial_partitioning.enable_early_restart);
+  } else if (current_hypergraph.initialNumNodes() > 0) {
+    std::unique_ptr<ICoarsener> coarsener(
+      CoarsenerFactory::getInstance().createObject(
+        current_context.coarsening.algorithm,
+        current_hypergraph, current_context,
+        current_hypergraph.weightOfHeaviestNode()));
+    std::unique_ptr<IRefiner> refiner(
+      RefinerFactory::getInstance().createObject(
+        current_context.local_search.algorithm,
+        current_hypergraph, current_context));
+    ASSERT(coarsener.get() != nullptr, "coarsener not found");
+    ASSERT(refiner.get() != nullptr, "refiner not found");
+
+    multilevel::partition(current_hypergraph, *coarsener, *refiner, current_context);
+  }
+
+  if (verbose_output) {
+    LOG << R"(========================================)"
+           R"(========================================)";
+  }
+  return is_feasible;
+}
+
+// ! Depth-first recursive bisection of a hypergraph without fixed vertices.
+static inline void sequentialPartition(const Hypergraph& input_hypergraph,
+                                       Hypergraph& input_hypergraph_without_fixed_vertices,
+                                       const Context& original_context) {
   // Custom deleters for Hypergraphs stored in hypergraph_stack. The top-level
   // hypergraph is the input hypergraph, which is not supposed to be deleted.
   // All extracted hypergraphs however can be deleted as soon as they are not needed
@@ -221,51 +338,25 @@ static inline void partition(Hypergraph& input_hypergraph,
                              delete h;
                            };
 
-  HypergraphPtr input_hypergraph_without_fixed_vertices = HypergraphPtr(nullptr, no_delete);
-  std::vector<HypernodeID> fixed_vertex_free_to_input;
-  if (input_hypergraph.containsFixedVertices()) {
-    // Remove fixed vertices from input hypergraph. Fixed vertices are
-    // added in a postprocessing step to the hypergraph after recursive
-    // bisection finished.
-    auto hg_without_fixed_vertices = ds::removeFixedVertices(input_hypergraph);
-    // The 'new' hypergraph without fixed vertices should be deleted.
-    input_hypergraph_without_fixed_vertices =
-      HypergraphPtr(hg_without_fixed_vertices.first.release(),
-                    delete_hypergraph);
-    fixed_vertex_free_to_input = hg_without_fixed_vertices.second;
-  } else {
-    // The original input hypergraph that did not contain any fixed vertices should not
-    // be deleted.
-    input_hypergraph_without_fixed_vertices = HypergraphPtr(&input_hypergraph, no_delete);
-  }
-
   std::vector<RBState> hypergraph_stack;
   MappingStack mapping_stack;
 
-  hypergraph_stack.emplace_back(HypergraphPtr(input_hypergraph_without_fixed_vertices.get(), no_delete),
+  hypergraph_stack.emplace_back(HypergraphPtr(&input_hypergraph_without_fixed_vertices, no_delete),
                                 RBHypergraphState::unpartitioned, 0,
                                 (original_context.partition.k - 1));
 
-  const bool restart_if_imbalanced = original_context.initial_partitioning.enable_early_restart
-                                     || original_context.initial_partitioning.enable_late_restart;
   int bisection_counter = 0;
 
-  if ((original_context.type == ContextType::main && original_context.partition.verbose_output) ||
-      (original_context.type == ContextType::initial_partitioning &&
-       original_context.initial_partitioning.verbose_output)) {
-    LOG << "================================================================================";
-  }
-
   while (!hypergraph_stack.empty()) {
     Hypergraph& current_hypergraph = *hypergraph_stack.back().hypergraph;
 
     if (hypergraph_stack.back().lower_k == hypergraph_stack.back().upper_k) {
       for (const HypernodeID& hn : current_hypergraph.nodes()) {
         const HypernodeID original_hn = originalHypernode(hn, mapping_stack);
-        const PartitionID current_part = input_hypergraph_without_fixed_vertices->partID(original_hn);
+        const PartitionID current_part = input_hypergraph_without_fixed_vertices.partID(original_hn);
         ASSERT(current_part != Hypergraph::kInvalidPartition, V(current_part));
         if (current_part != hypergraph_stack.back().lower_k) {
-          input_hypergraph_without_fixed_vertices->changeNodePart(original_hn, current_part,
+          input_hypergraph_without_fixed_vertices.changeNodePart(original_hn, current_part,
                                                                   hypergraph_stack.back().lower_k);
         }
       }
@@ -315,92 +406,12 @@ static inline void partition(Hypergraph& input_hypergraph,
           break;
         }
       case RBHypergraphState::unpartitioned: {
-          Context current_context =
-            createCurrentBisectionContext(original_context,
-                                          *input_hypergraph_without_fixed_vertices,
-                                          current_hypergraph, k, km, k - km, k1);
-          current_context.partition.rb_lower_k = k1;
-          current_context.partition.rb_upper_k = k2;
-          ++bisection_counter;
-
-          const bool direct_kway_verbose =
-            current_context.type == ContextType::initial_partitioning &&
-            current_context.initial_partitioning.verbose_output;
-          const bool recursive_bisection_verbose =
-            current_context.type == ContextType::main &&
-            current_context.partition.verbose_output;
-          const bool verbose_output = direct_kway_verbose || recursive_bisection_verbose;
-
-          if (verbose_output) {
-            LOG << "Recursive Bisection No." << bisection_counter << ": Computing blocks ("
-                << current_context.partition.rb_lower_k << ".."
-                << current_context.partition.rb_upper_k << ")";
-            LOG << "L_max0:" << current_context.partition.max_part_weights[0];
-            LOG << "L_max1:" << current_context.partition.max_part_weights[1];
-            LOG << R"(========================================)"
-                   R"(========================================)";
-          }
-
-          if (current_context.preprocessing.enable_community_detection) {
-            if (recursive_bisection_verbose) {
-              LOG << "******************************************"
-                     "**************************************";
-              LOG << "*                               Preprocessing..."
-                     "                               *";
-              LOG << "*********************************************"
-                     "***********************************";
-            }
-
-            // For both recursive bisection and direct k-way partitioning mode, we allow to reuse
-            // community structure information. Direct k-way partitioning uses recursive bisection
-            // as initial partitioning mode. Using the reuse_communities flag, we can therefore
-            // decide whether or not the community structure found before the first bisection
-            // (which corresponds to the community structure of the input hypergraph for recursive
-            // bisection based partitioning and to the community structure of the coarse hypergraph
-            // for direct k-way partitioning) should be reused in subsequent bisections. Note that
-            // the community structure computed in the top level preprocessing phase of direct k-way
-            // partitioning is not used here, because we clear the communities vector before calling
-            // the initial partitioner (see initial_partition.h).
-            const bool detect_communities =
-              !current_context.preprocessing.community_detection.reuse_communities ||
-              bisection_counter == 1;
-            if (detect_communities && current_hypergraph.initialNumNodes() > 0) {
-              detectCommunities(current_hypergraph, current_context);
-            } else if (verbose_output) {
-              LOG << "Reusing community structure computed in first bisection";
-            }
-          }
-
-
-          if (current_hypergraph.initialNumNodes() > 0 && restart_if_imbalanced && k > 2) {
-            std::vector<HypernodeWeight> max_bin_weights;
-            for (PartitionID i = k1; i <= k2; ++i) {
-              max_bin_weights.push_back(original_context.partition.max_part_weights[i]);
-            }
-            std::unique_ptr<IBinPacker> bin_packer(
-              BinPackerFactory::getInstance().createObject(original_context.initial_partitioning.bp_algo));
-            const bool feasible = bin_packer->currentBinImbalance(current_hypergraph, max_bin_weights) <= 0;
-            hypergraph_stack.back().is_feasible = feasible;
-            multilevel::partitionRepeatedOnInfeasible(current_hypergraph, current_context, original_context.stats, level, max_bin_weights,
-                                                      feasible && current_context.initial_partitioning.enable_early_restart);
-          } else if (current_hypergraph.initialNumNodes() > 0) {
-            std::unique_ptr<ICoarsener> coarsener(
-              CoarsenerFactory::getInstance().createObject(
-                current_context.coarsening.algorithm,
-                current_hypergraph, current_context,
-                current_hypergraph.weightOfHeaviestNode()));
-            std::unique_ptr<IRefiner> refiner(
-              RefinerFactory::getInstance().createObject(
-                current_context.local_search.algorithm,
-                current_hypergraph, current_context));
-            ASSERT(coarsener.get() != nullptr, "coarsener not found");
-            ASSERT(refiner.get() != nullptr, "refiner not found");
-
-            multilevel::partition(current_hypergraph, *coarsener, *refiner, current_context);
-          }
+          hypergraph_stack.back().is_feasible =
+            bisect(current_hypergraph, input_hypergraph_without_fixed_vertices,
+                   original_context, k1, k2, level, ++bisection_counter);
 
           auto extractedHypergraph_1 = ds::extractPartAsUnpartitionedHypergraphForBisection(
-            current_hypergraph, 1, current_context.partition.objective);
+            current_hypergraph, 1, original_context.partition.objective);
           mapping_stack.emplace_back(std::move(extractedHypergraph_1.second));
 
           hypergraph_stack.back().state =
@@ -408,11 +419,6 @@ static inline void partition(Hypergraph& input_hypergraph,
           hypergraph_stack.emplace_back(HypergraphPtr(extractedHypergraph_1.first.release(),
                                                       delete_hypergraph),
                                         RBHypergraphState::unpartitioned, k1 + km, k2);
-
-          if (verbose_output) {
-            LOG << R"(========================================)"
-                   R"(========================================)";
-          }
           break;
         }
       case RBHypergraphState::partitionedAndPart1Extracted: {
@@ -431,6 +437,189 @@ static inline void partition(Hypergraph& input_hypergraph,
         break;
     }
   }
+}
+
+// ! Shared state of the tasks of parallel recursive bisection.
+struct ParallelRBData {
+  ParallelRBData(const Context& c, const Hypergraph& hypergraph, ThreadPool& p) :
+    context(c),
+    input_hypergraph(hypergraph),
+    pool(p),
+    partition(hypergraph.initialNumNodes(), Hypergraph::kInvalidPartition),
+    bisection_counter(0) { }
+
+  const Context& context;
+  const Hypergraph& input_hypergraph;
+  ThreadPool& pool;
+  // Final block of each node of the input hypergraph. Concurrent tasks write
+  // disjoint entries.
+  std::vector<PartitionID> partition;
+  std::atomic<int> bisection_counter;
+};
+
+/*!
+ * Recursively partitions current_hypergraph into blocks k1..k2. The two
+ * subhypergraphs of each bisection are independent, therefore the second one
+ * is partitioned by another task of the thread pool. to_input maps the nodes
+ * of current_hypergraph to the nodes of the input hypergraph, i.e., it is the
+ * composition of all mappings of the path to the root of the recursion.
+ *
+ * Each task seeds the (thread-local) random number generator with a seed
+ * drawn by its parent. Thus, the result only depends on the seed of the root.
+ */
+static inline void parallelPartition(ParallelRBData& rb,
+                                     Hypergraph& current_hypergraph,
+                                     const std::vector<HypernodeID>& to_input,
+                                     const PartitionID k1,
+                                     const PartitionID k2,
+                                     const int seed) {
+  if (k1 == k2) {
+    for (const HypernodeID& hn : current_hypergraph.nodes()) {
+      rb.partition[to_input[hn]] = k1;
+    }
+    return;
+  }
+
+  const Context& original_context = rb.context;
+  const PartitionID k = k2 - k1 + 1;
+  const PartitionID km = k / 2;
+  BalancingLevel level = BalancingLevel::none;
+  int current_seed = seed;
+  while (true) {
+    Randomize& randomize = Randomize::instance();
+    randomize.setSeed(current_seed);
+    const bool is_feasible = bisect(current_hypergraph, rb.input_hypergraph, original_context,
+                                    k1, k2, level, ++rb.bisection_counter);
+    const int seed_0 = randomize.newRandomSeed();
+    const int seed_1 = randomize.newRandomSeed();
+    // Waiting for the second subproblem executes other tasks on this thread,
+    // which reseed its random number generator.
+    const int restart_seed = randomize.newRandomSeed();
+
+    {
+      auto extracted_hypergraph_1 = ds::extractPartAsUnpartitionedHypergraphForBisection(
+        current_hypergraph, 1, original_context.partition.objective);
+      auto extracted_hypergraph_0 = ds::extractPartAsUnpartitionedHypergraphForBisection(
+        current_hypergraph, 0, original_context.partition.objective);
+      std::vector<HypernodeID> to_input_1(extracted_hypergraph_1.second.size());
+      for (size_t hn = 0; hn < to_input_1.size(); ++hn) {
+        to_input_1[hn] = to_input[extracted_hypergraph_1.second[hn]];
+      }
+      std::vector<HypernodeID> to_input_0(extracted_hypergraph_0.second.size());
+      for (size_t hn = 0; hn < to_input_0.size(); ++hn) {
+        to_input_0[hn] = to_input[extracted_hypergraph_0.second[hn]];
+      }
+
+      std::future<void> part_1 = rb.pool.submit([&]() {
+          parallelPartition(rb, *extracted_hypergraph_1.first, to_input_1, k1 + km, k2, seed_1);
+        });
+      parallelPartition(rb, *extracted_hypergraph_0.first, to_input_0, k1, k1 + km - 1, seed_0);
+      rb.pool.wait(part_1);
+    }
+
+    if (!original_context.initial_partitioning.enable_late_restart || k <= 2) {
+      break;
+    }
+    std::vector<HypernodeWeight> part_weights(k, 0);
+    for (const HypernodeID& hn : current_hypergraph.nodes()) {
+      part_weights[rb.partition[to_input[hn]] - k1] += current_hypergraph.nodeWeight(hn);
+    }
+    bool balanced = true;
+    for (PartitionID i = k1; i <= k2; ++i) {
+      if (part_weights[i - k1] > original_context.partition.max_part_weights[i]) {
+        balanced = false;
+      }
+    }
+    level = bin_packing::increaseBalancingRestrictions(level,
+                                                       original_context.initial_partitioning.use_heuristic_prepacking);
+    if (balanced || !is_feasible || level == BalancingLevel::STOP) {
+      break;
+    }
+
+    current_hypergraph.reset();
+    current_seed = restart_seed;
+    std::string key("restarts_late_level_");
+    key += std::to_string(static_cast<uint8_t>(level));
+    original_context.stats.add(StatTag::InitialPartitioning, key, 1.0);
+  }
+}
+
+/*!
+ * Task-parallel recursive bisection of a hypergraph without fixed vertices
+ * using context.partition.num_threads threads. The result is deterministic
+ * for a fixed seed, but differs from the sequential recursive bisection.
+ */
+static inline void parallelPartition(Hypergraph& hypergraph, const Context& original_context) {
+  // Parallelism is only exploited across independent bisections. Each
+  // bisection is computed sequentially to avoid oversubscription.
+  Context context(original_context);
+  context.partition.num_threads = 1;
+
+  ThreadPool pool(original_context.partition.num_threads);
+  ParallelRBData rb(context, hypergraph, pool);
+  std::vector<HypernodeID> identity(hypergraph.initialNumNodes());
+  std::iota(identity.begin(), identity.end(), 0);
+
+  Randomize& randomize = Randomize::instance();
+  const int seed = randomize.newRandomSeed();
+  // The calling thread participates in the tasks, so its random number
+  // generator is restored afterwards.
+  const std::mt19937 generator = randomize.getGenerator();
+  parallelPartition(rb, hypergraph, identity, 0, original_context.partition.k - 1, seed);
+  randomize.getGenerator() = generator;
+
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    const PartitionID current_part = hypergraph.partID(hn);
+    ASSERT(current_part != Hypergraph::kInvalidPartition, V(current_part));
+    ASSERT(rb.partition[hn] != Hypergraph::kInvalidPartition, V(hn));
+    if (current_part != rb.partition[hn]) {
+      hypergraph.changeNodePart(hn, current_part, rb.partition[hn]);
+    }
+  }
+}
+
+static inline void partition(Hypergraph& input_hypergraph,
+                             const Context& original_context) {
+  // Custom deleters for Hypergraphs stored in hypergraph_stack. The top-level
+  // hypergraph is the input hypergraph, which is not supposed to be deleted.
+  // All extracted hypergraphs however can be deleted as soon as they are not needed
+  // anymore.
+  auto no_delete = [](Hypergraph*) { };
+  auto delete_hypergraph = [](Hypergraph* h) {
+                             delete h;
+                           };
+
+  HypergraphPtr input_hypergraph_without_fixed_vertices = HypergraphPtr(nullptr, no_delete);
+  std::vector<HypernodeID> fixed_vertex_free_to_input;
+  if (input_hypergraph.containsFixedVertices()) {
+    // Remove fixed vertices from input hypergraph. Fixed vertices are
+    // added in a postprocessing step to the hypergraph after recursive
+    // bisection finished.
+    auto hg_without_fixed_vertices = ds::removeFixedVertices(input_hypergraph);
+    // The 'new' hypergraph without fixed vertices should be deleted.
+    input_hypergraph_without_fixed_vertices =
+      HypergraphPtr(hg_without_fixed_vertices.first.release(),
+                    delete_hypergraph);
+    fixed_vertex_free_to_input = hg_without_fixed_vertices.second;
+  } else {
+    // The original input hypergraph that did not contain any fixed vertices should not
+    // be deleted.
+    input_hypergraph_without_fixed_vertices = HypergraphPtr(&input_hypergraph, no_delete);
+  }
+
+  if ((original_context.type == ContextType::main && original_context.partition.verbose_output) ||
+      (original_context.type == ContextType::initial_partitioning &&
+       original_context.initial_partitioning.verbose_output)) {
+    LOG << "================================================================================";
+  }
+
+  if (original_context.partition.parallel_recursive_bisection &&
+      original_context.partition.num_threads > 1) {
+    parallelPartition(*input_hypergraph_without_fixed_vertices, original_context);
+  } else {
+    sequentialPartition(input_hypergraph, *input_hypergraph_without_fixed_vertices,
+                        original_context);
+  }
 
   if (input_hypergraph.containsFixedVertices()) {
     io::printMaximumWeightedBipartiteMatchingBanner(original_context);
@@ -180,15 +180,38 @@ class TwoWayFMRefiner final : public IRefiner,
 
   void updateGainCacheAfterUncontraction(std::vector<HypernodeID>& refinement_nodes,
                                          const UncontractionGainChanges& changes) {
+    ASSERT(changes.representative.size() == changes.contraction_partner.size(),
+           V(changes.representative.size()) << V(changes.contraction_partner.size()));
+    if (changes.uncontracted_pairs.empty()) {
+      ASSERT(changes.representative.size() == 1, V(changes.representative.size()));
+      updateGainCacheAfterUncontraction(refinement_nodes[0], refinement_nodes[1],
+                                        changes.representative[0],
+                                        changes.contraction_partner[0]);
+    } else {
+      // The gain changes of a batch of uncontractions have to be applied in the
+      // order of the uncontractions, because a contraction partner may become
+      // the representative of a subsequent uncontraction.
+      ASSERT(changes.uncontracted_pairs.size() == changes.representative.size());
+      for (size_t i = 0; i < changes.uncontracted_pairs.size(); ++i) {
+        updateGainCacheAfterUncontraction(changes.uncontracted_pairs[i].first,
+                                          changes.uncontracted_pairs[i].second,
+                                          changes.representative[i],
+                                          changes.contraction_partner[i]);
+      }
+    }
+  }
+
+  void updateGainCacheAfterUncontraction(const HypernodeID representative,
+                                         const HypernodeID contraction_partner,
+                                         const Gain representative_change,
+                                         const Gain contraction_partner_change) {
     // Will always be the case in the first FM pass, since the just uncontracted HN
     // was not seen before.
-    ASSERT(changes.representative.size() == 1, V(changes.representative.size()));
-    ASSERT(changes.contraction_partner.size() == 1, V(changes.contraction_partner.size()));
-    if (!_gain_cache.isCached(refinement_nodes[1]) && _gain_cache.isCached(refinement_nodes[0])) {
+    if (!_gain_cache.isCached(contraction_partner) && _gain_cache.isCached(representative)) {
       // In further FM passes, changes will be set to 0 by the caller.
-      _gain_cache.setValue(refinement_nodes[1], _gain_cache.value(refinement_nodes[0])
-                           + changes.contraction_partner[0]);
-      _gain_cache.updateValue(refinement_nodes[0], changes.representative[0]);
+      _gain_cache.setValue(contraction_partner, _gain_cache.value(representative)
+                           + contraction_partner_change);
+      _gain_cache.updateValue(representative, representative_change);
     }
   }
 
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -69,6 +70,8 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
     extractor(hypergraph, context),
     hfc(extractor.flow_hg_builder, context.partition.seed),
     _quotient_graph(nullptr),
+    _own_quotient_graph(),
+    _flow_result(),
     _ignore_flow_execution_policy(false),
     b0(0),
     b1(1) {
@@ -91,10 +94,119 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
 
   RefinementResult refinement_result = RefinementResult::NoImprovement;
 
+  // ! Outcome of a single flow computation on the configured block pair.
+  struct FlowResult {
+    bool should_update = false;
+    RefinementResult refinement_result = RefinementResult::NoImprovement;
+    HyperedgeWeight cut_at_stake = 0;
+    HyperedgeWeight new_cut = 0;
+    HypernodeWeight max_weight_b0 = 0;
+    HypernodeWeight max_weight_b1 = 0;
+    std::vector<Move> moves;
+  };
+
   void reportRunningTime() {
     hfc.timer.report(std::cout);
   }
 
+  // ! Records applied moves in the journal of the k-way flow refiner, which
+  // ! is responsible for rolling back the moves.
+  void shareMoveJournal(FlowMoveJournal& journal) {
+    Base::useMoveJournal(journal);
+  }
+
+  /*!
+   * Solves one flow problem on the cut between the configured blocks b0 and b1
+   * and stores the moves of the resulting bipartition in result.
+   * The hypergraph is only read. Thus, several refiners may compute improvements
+   * for disjoint block pairs concurrently, as long as nobody modifies the hypergraph
+   * meanwhile. The improvement is applied via applyFlowImprovement.
+   */
+  void computeFlowImprovement(std::vector<HyperedgeID>& cut_hes, FlowResult& result) {
+    result.should_update = false;
+    result.refinement_result = RefinementResult::NoImprovement;
+    result.cut_at_stake = 0;
+    result.new_cut = 0;
+    result.moves.clear();
+
+    // If the solution returned from the refinement is imbalanced, it is necessary to adjust the max block weights
+    // accordingly. Then, the hyperflow cutter can at least calculate an imbalanced solution. (Otherwise, a runtime
+    // exception would be thrown.)
+    result.max_weight_b0 = std::max(_hg.partWeight(b0), _context.partition.max_part_weights[b0]);
+    result.max_weight_b1 = std::max(_hg.partWeight(b1), _context.partition.max_part_weights[b1]);
+    hfc.cs.setMaxBlockWeight(0, result.max_weight_b0);
+    hfc.cs.setMaxBlockWeight(1, result.max_weight_b1);
+
+    HyperedgeWeight cut_weight = 0;
+    for (HyperedgeID e : cut_hes) {
+      cut_weight += _hg.edgeWeight(e);
+      if (cut_weight > 10)
+        break;
+    }
+
+    if (cut_weight <= 10 && !isRefinementOnLastLevel()) {
+      return;
+    }
+
+    hfc.timer.start("Extract Flow Snapshot");
+    auto STF = extractor.run(_hg, _context, cut_hes, b0, b1, hfc.cs.borderNodes.distance);
+    hfc.timer.stop("Extract Flow Snapshot");
+
+    if (STF.cutAtStake - STF.baseCut <= 0) {
+      return;
+    }
+
+    if (should_write_snapshot) {
+      writeSnapshot(STF);
+    }
+
+    hfc.reset();
+    hfc.upperFlowBound = STF.cutAtStake - STF.baseCut;
+    bool flowcutter_succeeded = hfc.runUntilBalancedOrFlowBoundExceeded(STF.source, STF.target);
+    result.cut_at_stake = STF.cutAtStake;
+    result.new_cut = STF.baseCut + hfc.cs.flowValue;
+
+    if (flowcutter_succeeded) {
+      result.should_update = determineRefinementResult(result.new_cut, STF.cutAtStake,
+                                                       result.refinement_result);
+    }
+
+    if (result.should_update) {
+      for (const whfc::Node uLocal : extractor.localNodeIDs()) {
+        if (uLocal == STF.source || uLocal == STF.target)
+          continue;
+        const HypernodeID uGlobal = extractor.local2global(uLocal);
+        PartitionID from = _hg.partID(uGlobal);
+        ASSERT(from == b0 || from == b1);
+        PartitionID to = hfc.cs.n.isSource(uLocal) ? b0 : b1;
+        if (from != to)
+          result.moves.emplace_back(uGlobal, from, to);
+      }
+    }
+  }
+
+  // ! Assigns the new partition IDs computed by computeFlowImprovement.
+  void applyFlowImprovement(const FlowResult& result, Metrics& best_metrics) {
+    ASSERT(result.should_update);
+    for (const Move& move : result.moves) {
+      ASSERT(_hg.partID(move.hn) == move.from);
+      Base::changeNodePart(*_quotient_graph, move.hn, move.from, move.to);
+    }
+
+    ASSERT(result.cut_at_stake >= result.new_cut);
+    best_metrics.km1 -= (result.cut_at_stake - result.new_cut);
+    best_metrics.imbalance = metrics::imbalance(_hg, _context);
+    HEAVY_REFINEMENT_ASSERT(best_metrics.km1 == metrics::km1(_hg), V(best_metrics.km1) << V(metrics::km1(_hg)));
+
+    DBG << "Update partition" << V(metrics::imbalance(_hg, _context)) << V(b0) << V(b1) << V(_hg.currentNumNodes());
+    if (_hg.partWeight(b0) > result.max_weight_b0 || _hg.partWeight(b1) > result.max_weight_b1) {
+      LOG << "HFC refinement violated imbalance" << std::fixed << std::setprecision(12) << V(_context.partition.epsilon) << V(metrics::imbalance(_hg, _context));
+      LOG << V(_hg.partWeight(b0)) << V(result.max_weight_b0) << V(_hg.partWeight(b1)) << V(result.max_weight_b1);
+      LOG << "This is a bug. Please send us an email.";
+      throw std::runtime_error("imbalance violated");
+    }
+  }
+
  private:
   std::vector<Move> rollbackImpl() override final {
     return Base::rollback();
@@ -112,21 +224,18 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
       Base::storeOriginalPartitionIDs();        // for updating fm gain caches, when only 2-way is used
     }
 
-    bool delete_quotientgraph_after_flow = false;
+    // If no quotient graph is provided (i.e., 2-way refinement), we use our own.
+    // It is kept alive across uncoarsening levels and maintained incrementally.
+    bool reset_quotientgraph_after_flow = false;
     if (!_quotient_graph) {
-      delete_quotientgraph_after_flow = true;
-      _quotient_graph = new QuotientGraphBlockScheduler(_hg, _context);
-      _quotient_graph->buildQuotientGraph();
+      reset_quotientgraph_after_flow = true;
+      if (!_own_quotient_graph) {
+        _own_quotient_graph = std::make_unique<QuotientGraphBlockScheduler>(_hg, _context);
+      }
+      _own_quotient_graph->buildQuotientGraph();
+      _quotient_graph = _own_quotient_graph.get();
     }
 
-    // If the solution returned from the refinement is imbalanced, it is necessary to adjust the max block weights
-    // accordingly. Then, the hyperflow cutter can at least calculate an imbalanced solution. (Otherwise, a runtime
-    // exception would be thrown.)
-    const HypernodeWeight max_weight_b0 = std::max(_hg.partWeight(b0), _context.partition.max_part_weights[b0]);
-    const HypernodeWeight max_weight_b1 = std::max(_hg.partWeight(b1), _context.partition.max_part_weights[b1]);
-    hfc.cs.setMaxBlockWeight(0, max_weight_b0);
-    hfc.cs.setMaxBlockWeight(1, max_weight_b1);
-
     DBG << "2way HFC. Refine " << V(b0) << "and" << V(b1);
 
     bool improved = false;
@@ -135,82 +244,26 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
 
     while (should_continue) {
       std::vector<HyperedgeID>& cut_hes = _quotient_graph->exposeBlockPairCutHyperedges(b0, b1);
+      computeFlowImprovement(cut_hes, _flow_result);
+      refinement_result = std::max(refinement_result, _flow_result.refinement_result);
 
-      HyperedgeWeight cut_weight = 0;
-      for (HyperedgeID e : cut_hes) {
-        cut_weight += _hg.edgeWeight(e);
-        if (cut_weight > 10)
-          break;
-      }
-
-      if (cut_weight <= 10 && !isRefinementOnLastLevel()) {
-        break;
-      }
-
-      hfc.timer.start("Extract Flow Snapshot");
-      auto STF = extractor.run(_hg, _context, cut_hes, b0, b1, hfc.cs.borderNodes.distance);
-      hfc.timer.stop("Extract Flow Snapshot");
-
-      if (STF.cutAtStake - STF.baseCut <= 0) {
-        break;
-      }
-  
-      if (should_write_snapshot) {
-        writeSnapshot(STF);
-      }
-      
-      hfc.reset();
-      hfc.upperFlowBound = STF.cutAtStake - STF.baseCut;
-      bool flowcutter_succeeded = hfc.runUntilBalancedOrFlowBoundExceeded(STF.source, STF.target);
-      HyperedgeWeight newCut = STF.baseCut + hfc.cs.flowValue;
-
-      bool should_update = false;
-      if (flowcutter_succeeded) {
-        should_update = determineRefinementResult(newCut, STF.cutAtStake);
-      }
-
-      // assign new partition IDs
-      if (should_update) {
+      if (_flow_result.should_update) {
         improved = true;
-        for (const whfc::Node uLocal : extractor.localNodeIDs()) {
-          if (uLocal == STF.source || uLocal == STF.target)
-            continue;
-          const HypernodeID uGlobal = extractor.local2global(uLocal);
-          PartitionID from = _hg.partID(uGlobal);
-          ASSERT(from == b0 || from == b1);
-          PartitionID to = hfc.cs.n.isSource(uLocal) ? b0 : b1;
-          if (from != to)
-            _quotient_graph->changeNodePart(uGlobal, from, to);
-        }
-        
-        ASSERT(STF.cutAtStake >= newCut);
-        best_metrics.km1 -= (STF.cutAtStake - newCut);
-        best_metrics.imbalance = metrics::imbalance(_hg, _context);
-        HEAVY_REFINEMENT_ASSERT(best_metrics.km1 == metrics::km1(_hg), V(best_metrics.km1) << V(metrics::km1(_hg)));
-
-        DBG << "Update partition" << V(metrics::imbalance(_hg, _context)) << V(b0) << V(b1) << V(_hg.currentNumNodes());
-        if (_hg.partWeight(b0) > max_weight_b0 || _hg.partWeight(b1) > max_weight_b1) {
-          LOG << "HFC refinement violated imbalance" << std::fixed << std::setprecision(12) << V(_context.partition.epsilon) << V(metrics::imbalance(_hg, _context));
-          LOG << V(_hg.partWeight(b0)) << V(max_weight_b0) << V(_hg.partWeight(b1)) << V(max_weight_b1);
-          LOG << "This is a bug. Please send us an email.";
-          throw std::runtime_error("imbalance violated");
-        }
+        applyFlowImprovement(_flow_result, best_metrics);
       }
 
       // Heuristic (gottesbueren): if only balance was improved we don't continue
-      should_continue = should_update && newCut < STF.cutAtStake;
+      should_continue = _flow_result.should_update && _flow_result.new_cut < _flow_result.cut_at_stake;
     }
 
     DBG << "HFC refinement done";
 
-    // Delete quotient graph
-    if (delete_quotientgraph_after_flow) {
-      delete _quotient_graph;
+    if (reset_quotientgraph_after_flow) {
       _quotient_graph = nullptr;
     }
 
     HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
-    Timer::instance().add(_context, Timepoint::flow_refinement, std::chrono::duration<double>(end - start).count());
+    _context.timer->add(_context, Timepoint::flow_refinement, std::chrono::duration<double>(end - start).count());
 
     time_limit::isSoftTimeLimitExceeded(_context);
 
@@ -256,9 +309,10 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
     whfc::WHFC_IO::writeAdditionalInformation(hg_filename, i, hfc.cs.rng);
   }
 
-  bool determineRefinementResult(HyperedgeWeight newCut, HyperedgeWeight cutAtStake) {
+  bool determineRefinementResult(HyperedgeWeight newCut, HyperedgeWeight cutAtStake,
+                                 RefinementResult& result) const {
     if (newCut < cutAtStake) {
-      refinement_result = std::max(refinement_result, RefinementResult::MetricImproved);
+      result = std::max(result, RefinementResult::MetricImproved);
       return true;
     } else if (newCut == cutAtStake) {
       double prevLocalImbalance = -2.0, prevGlobalImbalance = -2.0, newLocalImbalance = -2.0, newGlobalImbalance = -2.0;
@@ -278,9 +332,9 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
       }
 
       if (newGlobalImbalance < prevGlobalImbalance) {
-        refinement_result = std::max(refinement_result, RefinementResult::GlobalBalanceImproved);
+        result = std::max(result, RefinementResult::GlobalBalanceImproved);
       } else if (newLocalImbalance < prevLocalImbalance) {
-        refinement_result = std::max(refinement_result, RefinementResult::LocalBalanceImproved);
+        result = std::max(result, RefinementResult::LocalBalanceImproved);
       } else {
       	// cut did not get better or worse. balance stayed the same. --> don't update partition
         return false;
@@ -300,7 +354,6 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
   using IRefiner::_is_initialized;
   using Base::_hg;
   using Base::_context;
-  using Base::_original_part_id;
   using Base::_flow_execution_policy;
 
   bool should_write_snapshot = false;
@@ -308,6 +361,8 @@ class TwoWayHyperFlowCutterRefiner final : public IRefiner,
   whfcInterface::FlowHypergraphExtractor extractor;
   whfc::HyperFlowCutter<whfc::Dinic> hfc;
   QuotientGraphBlockScheduler* _quotient_graph;
+  std::unique_ptr<QuotientGraphBlockScheduler> _own_quotient_graph;
+  FlowResult _flow_result;
   bool _ignore_flow_execution_policy;
   PartitionID b0;
   PartitionID b1;
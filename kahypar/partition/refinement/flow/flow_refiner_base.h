@@ -21,12 +21,78 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/refinement/move.h"
 
 namespace kahypar {
+/*!
+ * Journal of the hypernodes moved by flow-based refinement. For each moved hypernode,
+ * the block it was assigned to when the journal was cleared is recorded. Clearing and
+ * rolling back the journal therefore only takes time proportional to the number of
+ * moved hypernodes instead of the number of hypernodes of the hypergraph.
+ */
+class FlowMoveJournal {
+ public:
+  explicit FlowMoveJournal(const HypernodeID num_hypernodes) :
+    _original_part_id(num_hypernodes, Hypergraph::kInvalidPartition),
+    _moved_hns() { }
+
+  FlowMoveJournal(const FlowMoveJournal&) = delete;
+  FlowMoveJournal& operator= (const FlowMoveJournal&) = delete;
+
+  FlowMoveJournal(FlowMoveJournal&&) = default;
+  FlowMoveJournal& operator= (FlowMoveJournal&&) = default;
+
+  // ! Records that hn is about to be moved away from block from.
+  void record(const HypernodeID hn, const PartitionID from) {
+    ASSERT(hn < _original_part_id.size(), V(hn));
+    if (_original_part_id[hn] == Hypergraph::kInvalidPartition) {
+      _original_part_id[hn] = from;
+      _moved_hns.push_back(hn);
+    }
+  }
+
+  void clear() {
+    for (const HypernodeID& hn : _moved_hns) {
+      _original_part_id[hn] = Hypergraph::kInvalidPartition;
+    }
+    _moved_hns.clear();
+  }
+
+  /*!
+   * Moves all recorded hypernodes back to their original blocks and returns the
+   * reverted moves (i.e., from original block to the block before the rollback)
+   * in increasing order of the hypernode IDs. Hypernodes that are already in their
+   * original block are skipped.
+   */
+  std::vector<Move> rollback(Hypergraph& hypergraph) {
+    std::sort(_moved_hns.begin(), _moved_hns.end());
+    std::vector<Move> moves;
+    for (const HypernodeID& hn : _moved_hns) {
+      ASSERT(hypergraph.partID(hn) != Hypergraph::kInvalidPartition, V(hn));
+      const PartitionID from = _original_part_id[hn];
+      const PartitionID to = hypergraph.partID(hn);
+      if (from != to) {
+        moves.emplace_back(hn, from, to);
+        hypergraph.changeNodePart(hn, to, from);
+      }
+    }
+    clear();
+    return moves;
+  }
+
+  size_t size() const {
+    return _moved_hns.size();
+  }
+
+ private:
+  std::vector<PartitionID> _original_part_id;
+  std::vector<HypernodeID> _moved_hns;
+};
+
 template <class FlowExecutionPolicy>
 class FlowRefinerBase {
  public:
@@ -34,7 +100,8 @@ class FlowRefinerBase {
     _hg(hypergraph),
     _context(context),
     _flow_execution_policy(),
-    _original_part_id(_hg.initialNumNodes(), -1) { }
+    _own_move_journal(_hg.initialNumNodes()),
+    _move_journal(&_own_move_journal) { }
 
   virtual ~FlowRefinerBase() = default;
 
@@ -46,29 +113,31 @@ class FlowRefinerBase {
 
  protected:
   std::vector<Move> rollback() {
-    std::vector<Move> tmp_moves;
-    for (const HypernodeID& hn : _hg.nodes()) {
-      ASSERT(_hg.partID(hn) != Hypergraph::kInvalidPartition, V(hn));
-      PartitionID from = _original_part_id[hn];
-      PartitionID to = _hg.partID(hn);
-      if (from != to) {
-        tmp_moves.emplace_back(hn, from, to);
-        _hg.changeNodePart(hn, to, from);
-      }
-    }
-    return tmp_moves;
+    return _move_journal->rollback(_hg);
   }
 
+  // ! Starts a new journal, i.e., the current partition becomes the rollback target.
   void storeOriginalPartitionIDs() {
-    for (const HypernodeID& hn : _hg.nodes()) {
-      ASSERT(_hg.partID(hn) != Hypergraph::kInvalidPartition, V(hn));
-      _original_part_id[hn] = _hg.partID(hn);
-    }
+    _move_journal->clear();
+  }
+
+  // ! Moves hn via the quotient graph and records the move in the journal.
+  template <typename QuotientGraph>
+  void changeNodePart(QuotientGraph& quotient_graph, const HypernodeID hn,
+                      const PartitionID from, const PartitionID to) {
+    _move_journal->record(hn, from);
+    quotient_graph.changeNodePart(hn, from, to);
+  }
+
+  // ! Records all moves in journal instead of the own journal.
+  void useMoveJournal(FlowMoveJournal& journal) {
+    _move_journal = &journal;
   }
 
   Hypergraph& _hg;
   const Context& _context;
   FlowExecutionPolicy _flow_execution_policy;
-  std::vector<PartitionID> _original_part_id;
+  FlowMoveJournal _own_move_journal;
+  FlowMoveJournal* _move_journal;
 };
 }  // namespace kahypar
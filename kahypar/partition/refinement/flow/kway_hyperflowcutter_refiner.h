@@ -24,7 +24,9 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
 #include <queue>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,6 +41,8 @@
 #include "kahypar/partition/refinement/flow/flow_refiner_base.h"
 #include "kahypar/partition/refinement/flow/quotient_graph_block_scheduler.h"
 #include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
 #include "kahypar/utils/time_limit.h"
 
 namespace kahypar {
@@ -51,13 +55,35 @@ class KWayHyperFlowCutterRefiner final : public IRefiner,
                                          private FlowRefinerBase<FlowExecutionPolicy>{
  private:
   using Base = FlowRefinerBase<FlowExecutionPolicy>;
+  using TwoWayFlowRefiner = TwoWayHyperFlowCutterRefiner<FlowExecutionPolicy>;
+  using FlowResult = typename TwoWayFlowRefiner::FlowResult;
+  using BlockPair = std::pair<PartitionID, PartitionID>;
   static constexpr bool debug = false;
 
  public:
   KWayHyperFlowCutterRefiner(Hypergraph& hypergraph, const Context& context) :
     Base(hypergraph, context),
     _twoway_flow_refiner(_hg, _context),
-    _num_improvements(context.partition.k, std::vector<size_t>(context.partition.k, 0)) { }
+    _scheduler(_hg, _context),
+    _num_improvements(context.partition.k, std::vector<size_t>(context.partition.k, 0)),
+    _pool(makePool(context)),
+    _flow_refiners(),
+    _pending_pairs(),
+    _deferred_pairs(),
+    _batch(),
+    _batch_cut_hes(),
+    _batch_seeds(),
+    _flow_results(),
+    _block_in_batch(context.partition.k) {
+    // All moves are applied by the 2-way refiner. Thus it records them in our journal.
+    _twoway_flow_refiner.shareMoveJournal(*Base::_move_journal);
+    if (_pool) {
+      // Each thread solves its flow problems on a separate flow hypergraph and WHFC instance.
+      for (size_t i = 1; i < _pool->numThreads(); ++i) {
+        _flow_refiners.emplace_back(std::make_unique<TwoWayFlowRefiner>(_hg, _context));
+      }
+    }
+  }
 
   KWayHyperFlowCutterRefiner(const KWayHyperFlowCutterRefiner&) = delete;
   KWayHyperFlowCutterRefiner(KWayHyperFlowCutterRefiner&&) = delete;
@@ -88,8 +114,9 @@ class KWayHyperFlowCutterRefiner final : public IRefiner,
     DBG << V(_hg.currentNumNodes()) << V(_hg.initialNumNodes());
     printMetric();
 
-    QuotientGraphBlockScheduler scheduler(_hg, _context);
-    scheduler.buildQuotientGraph();
+    // The quotient graph is only built from scratch on the first call and
+    // maintained incrementally on all subsequent uncoarsening levels.
+    _scheduler.buildQuotientGraph();
 
     // Active Block Scheduling
     bool improvement = false;
@@ -97,40 +124,47 @@ class KWayHyperFlowCutterRefiner final : public IRefiner,
     std::vector<bool> active_blocks(_context.partition.k, true);
     size_t current_round = 1;
     while (active_block_exist && !time_limit::isSoftTimeLimitExceeded(_context)) {
-      scheduler.randomShuffleQuotientEdges();
+      _scheduler.randomShuffleQuotientEdges();
       std::vector<bool> tmp_active_blocks(_context.partition.k, false);
       active_block_exist = false;
-      for (const auto& e : scheduler.quotientGraphEdges()) {
-        const PartitionID block_0 = e.first;
-        const PartitionID block_1 = e.second;
-
-        // Heuristic: If a flow refinement never improved a bipartition,
-        //            we ignore the refinement for these blocks in the
-        //            second iteration of active block scheduling
-        if (current_round > 1 && _num_improvements[block_0][block_1] == 0)
-          continue;
-
-        if (active_blocks[block_0] || active_blocks[block_1]) {
-          _twoway_flow_refiner.updateConfiguration(block_0, block_1, &scheduler, true);
-          const bool improved = _twoway_flow_refiner.refine(refinement_nodes, max_allowed_part_weights, changes, best_metrics);
-          if (improved) {
-            // DBG << "Improvement found beetween blocks " << block_0 << " and " << block_1 << " in round #" << current_round;
-            // printMetric();
-            improvement = true;
-            if (_twoway_flow_refiner.refinement_result >= RefinementResult::GlobalBalanceImproved) {
-              // don't mark blocks as active, if cut stayed the same and global balance did not improve.
-              // haven't observed it yet, but only reducing the weight difference between block_0 and block_1
-              // might lead to an infinite loop for k > 2
-              active_block_exist = true;
-              tmp_active_blocks[block_0] = true;
-              tmp_active_blocks[block_1] = true;
-              _num_improvements[block_0][block_1]++;
+      if (_pool) {
+        improvement |= parallelActiveBlockSchedulingRound(active_blocks, tmp_active_blocks,
+                                                          current_round, best_metrics);
+        active_block_exist = std::find(tmp_active_blocks.begin(), tmp_active_blocks.end(),
+                                       true) != tmp_active_blocks.end();
+      } else {
+        for (const auto& e : _scheduler.quotientGraphEdges()) {
+          const PartitionID block_0 = e.first;
+          const PartitionID block_1 = e.second;
+
+          // Heuristic: If a flow refinement never improved a bipartition,
+          //            we ignore the refinement for these blocks in the
+          //            second iteration of active block scheduling
+          if (current_round > 1 && _num_improvements[block_0][block_1] == 0)
+            continue;
+
+          if (active_blocks[block_0] || active_blocks[block_1]) {
+            _twoway_flow_refiner.updateConfiguration(block_0, block_1, &_scheduler, true);
+            const bool improved = _twoway_flow_refiner.refine(refinement_nodes, max_allowed_part_weights, changes, best_metrics);
+            if (improved) {
+              // DBG << "Improvement found beetween blocks " << block_0 << " and " << block_1 << " in round #" << current_round;
+              // printMetric();
+              improvement = true;
+              if (_twoway_flow_refiner.refinement_result >= RefinementResult::GlobalBalanceImproved) {
+                // don't mark blocks as active, if cut stayed the same and global balance did not improve.
+                // haven't observed it yet, but only reducing the weight difference between block_0 and block_1
+                // might lead to an infinite loop for k > 2
+                active_block_exist = true;
+                tmp_active_blocks[block_0] = true;
+                tmp_active_blocks[block_1] = true;
+                _num_improvements[block_0][block_1]++;
+              }
             }
           }
-        }
 
-        if (_context.partition.time_limit_triggered) {
-          break;
+          if (_context.partition.time_limit_triggered) {
+            break;
+          }
         }
       }
       current_round++;
@@ -144,6 +178,122 @@ class KWayHyperFlowCutterRefiner final : public IRefiner,
     return improvement;
   }
 
+  /*!
+   * Parallel version of one round of active block scheduling. Flow problems of block
+   * pairs that share no block only read disjoint parts of the partition. Therefore,
+   * the eligible block pairs are greedily grouped into batches of pairwise disjoint
+   * pairs (i.e., matchings of the quotient graph) and the flow problems of a batch
+   * are solved concurrently without modifying the hypergraph. Afterwards, the moves
+   * are committed sequentially. Since each block is owned by at most one pair of
+   * the batch, the moves of different pairs do not interfere with each other.
+   *
+   * In contrast to the sequential version, each block pair is refined with only one
+   * flow computation per batch. Pairs that improved stay active for the next round.
+   */
+  bool parallelActiveBlockSchedulingRound(const std::vector<bool>& active_blocks,
+                                          std::vector<bool>& next_active_blocks,
+                                          const size_t current_round,
+                                          Metrics& best_metrics) {
+    _pending_pairs.clear();
+    for (const auto& e : _scheduler.quotientGraphEdges()) {
+      // Heuristic: see refineImpl
+      if (current_round > 1 && _num_improvements[e.first][e.second] == 0)
+        continue;
+      if (active_blocks[e.first] || active_blocks[e.second]) {
+        _pending_pairs.push_back(e);
+      }
+    }
+
+    bool improvement = false;
+    while (!_pending_pairs.empty() && !_context.partition.time_limit_triggered) {
+      _batch.clear();
+      _deferred_pairs.clear();
+      _block_in_batch.reset();
+      for (const BlockPair& pair : _pending_pairs) {
+        if (!_block_in_batch[pair.first] && !_block_in_batch[pair.second]) {
+          _block_in_batch.set(pair.first, true);
+          _block_in_batch.set(pair.second, true);
+          _batch.push_back(pair);
+        } else {
+          _deferred_pairs.push_back(pair);
+        }
+      }
+      std::swap(_pending_pairs, _deferred_pairs);
+      improvement |= refineBatch(next_active_blocks, best_metrics);
+      time_limit::isSoftTimeLimitExceeded(_context);
+    }
+    return improvement;
+  }
+
+  bool refineBatch(std::vector<bool>& next_active_blocks, Metrics& best_metrics) {
+    HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+
+    // Cut hyperedges and seeds are prepared sequentially, because exposing
+    // the cut hyperedges of a block pair lazily updates the scheduler.
+    _batch_cut_hes.clear();
+    _batch_seeds.clear();
+    for (const BlockPair& pair : _batch) {
+      _batch_cut_hes.push_back(&_scheduler.exposeBlockPairCutHyperedges(pair.first, pair.second));
+      _batch_seeds.push_back(Randomize::instance().newRandomSeed());
+    }
+    while (_flow_results.size() < _batch.size()) {
+      _flow_results.emplace_back();
+    }
+
+    const size_t num_refiners = std::min(_pool->numThreads(), _batch.size());
+    _pool->parallelFor(0, num_refiners, 1,
+                       [&](const size_t, const size_t begin, const size_t end) {
+        // The random number generator of the calling thread participates
+        // in the flow computations and is therefore restored afterwards.
+        Randomize& randomize = Randomize::instance();
+        const std::mt19937 generator = randomize.getGenerator();
+        for (size_t r = begin; r < end; ++r) {
+          // Refiner r always processes the pairs r, r + num_refiners, ... of the batch.
+          // This does not depend on the executing thread and keeps results reproducible.
+          TwoWayFlowRefiner& refiner = flowRefiner(r);
+          for (size_t i = r; i < _batch.size(); i += num_refiners) {
+            randomize.setSeed(_batch_seeds[i]);
+            refiner.updateConfiguration(_batch[i].first, _batch[i].second, &_scheduler, true);
+            refiner.computeFlowImprovement(*_batch_cut_hes[i], _flow_results[i]);
+          }
+        }
+        randomize.getGenerator() = generator;
+      });
+
+    bool improvement = false;
+    for (size_t i = 0; i < _batch.size(); ++i) {
+      const FlowResult& result = _flow_results[i];
+      if (result.should_update) {
+        const PartitionID block_0 = _batch[i].first;
+        const PartitionID block_1 = _batch[i].second;
+        _twoway_flow_refiner.updateConfiguration(block_0, block_1, &_scheduler, true);
+        _twoway_flow_refiner.applyFlowImprovement(result, best_metrics);
+        improvement = true;
+        if (result.refinement_result >= RefinementResult::GlobalBalanceImproved) {
+          next_active_blocks[block_0] = true;
+          next_active_blocks[block_1] = true;
+          _num_improvements[block_0][block_1]++;
+        }
+      }
+    }
+
+    HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    _context.timer->add(_context, Timepoint::flow_refinement, std::chrono::duration<double>(end - start).count());
+    return improvement;
+  }
+
+  TwoWayFlowRefiner& flowRefiner(const size_t i) {
+    return i == 0 ? _twoway_flow_refiner : *_flow_refiners[i - 1];
+  }
+
+  static std::unique_ptr<ThreadPool> makePool(const Context& context) {
+    if (context.partition.num_threads > 1 && context.partition.k > 3) {
+      return std::make_unique<ThreadPool>(std::min(context.partition.num_threads,
+                                                   static_cast<size_t>(context.partition.k / 2)));
+    }
+    return nullptr;
+  }
+
   void printMetric(bool newline = false, bool endline = false) {
     if (newline) {
       DBG << "";
@@ -160,16 +310,30 @@ class KWayHyperFlowCutterRefiner final : public IRefiner,
     _is_initialized = true;
     _flow_execution_policy.initialize(_hg, _context);
     _twoway_flow_refiner.initialize(max_gain);
+    for (std::unique_ptr<TwoWayFlowRefiner>& refiner : _flow_refiners) {
+      refiner->initialize(max_gain);
+    }
   }
 
   using IRefiner::_is_initialized;
 
   using Base::_hg;
   using Base::_context;
-  using Base::_original_part_id;
   using Base::_flow_execution_policy;
 
   TwoWayHyperFlowCutterRefiner<FlowExecutionPolicy> _twoway_flow_refiner;
+  QuotientGraphBlockScheduler _scheduler;
   std::vector<std::vector<size_t> > _num_improvements;
+
+  // Data used for parallel flow refinement (only if context.partition.num_threads > 1)
+  std::unique_ptr<ThreadPool> _pool;
+  std::vector<std::unique_ptr<TwoWayFlowRefiner> > _flow_refiners;
+  std::vector<BlockPair> _pending_pairs;
+  std::vector<BlockPair> _deferred_pairs;
+  std::vector<BlockPair> _batch;
+  std::vector<std::vector<HyperedgeID>*> _batch_cut_hes;
+  std::vector<int> _batch_seeds;
+  std::vector<FlowResult> _flow_results;
+  ds::FastResetFlagArray<> _block_in_batch;
 };
 }  // namespace kahypar
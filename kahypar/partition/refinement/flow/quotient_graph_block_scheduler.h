@@ -25,6 +25,7 @@
 #include <array>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -36,42 +37,95 @@
 #include "kahypar/utils/randomize.h"
 
 namespace kahypar {
-class QuotientGraphBlockScheduler {
+/*!
+ * The quotient graph contains an edge between two blocks if there is at least one
+ * hyperedge connecting them. For each such block pair, the scheduler stores the
+ * hyperedges cut between the two blocks.
+ *
+ * Block pairs are stored sparsely, i.e. memory is only allocated for adjacent blocks.
+ * After the initial construction, the quotient graph is maintained incrementally:
+ * The scheduler registers itself as connectivity observer of the hypergraph and is
+ * therefore notified about each hyperedge that gets connected to an additional block.
+ * Hyperedges that are no longer cut between a block pair are removed lazily, when
+ * the cut hyperedges of the block pair are requested or when the quotient graph is
+ * rebuilt.
+ */
+class QuotientGraphBlockScheduler final : public Hypergraph::ConnectivityObserver {
   typedef std::pair<PartitionID, PartitionID> edge;
   using ConstIncidenceIterator = std::vector<edge>::const_iterator;
   using ConstCutHyperedgeIterator = std::vector<HyperedgeID>::const_iterator;
 
+  struct BlockPair {
+    BlockPair(const PartitionID b0, const PartitionID b1) :
+      block0(b0),
+      block1(b1),
+      cut_hes() { }
+
+    PartitionID block0;
+    PartitionID block1;
+    std::vector<HyperedgeID> cut_hes;
+  };
+
  public:
   QuotientGraphBlockScheduler(Hypergraph& hypergraph, const Context& context) :
     _hg(hypergraph),
     _context(context),
+    _is_initialized(false),
     _quotient_graph(),
-    _block_pair_cut_he(context.partition.k,
-                       std::vector<std::vector<HyperedgeID> >(context.partition.k,
-                                                              std::vector<HyperedgeID>())),
+    _block_pairs(),
+    _block_pair_index(),
     _visited(_hg.initialNumEdges()) { }
 
+  ~QuotientGraphBlockScheduler() override {
+    if (_is_initialized) {
+      _hg.setConnectivityObserver(nullptr);
+    }
+  }
+
   QuotientGraphBlockScheduler(const QuotientGraphBlockScheduler&) = delete;
   QuotientGraphBlockScheduler(QuotientGraphBlockScheduler&&) = delete;
   QuotientGraphBlockScheduler& operator= (const QuotientGraphBlockScheduler&) = delete;
   QuotientGraphBlockScheduler& operator= (QuotientGraphBlockScheduler&&) = delete;
 
+  /*!
+   * The first call scans all hyperedges of the hypergraph. Subsequent calls only
+   * remove stale cut hyperedges and block pairs that are no longer adjacent, since
+   * all additions were already recorded via the connectivity observer.
+   */
   void buildQuotientGraph() {
-    std::set<edge> edge_list;
-    for (const HyperedgeID& he : _hg.edges()) {
-      if (_hg.connectivity(he) > 1) {
-        for (const PartitionID& block0 : _hg.connectivitySet(he)) {
-          for (const PartitionID& block1 : _hg.connectivitySet(he)) {
-            if (block0 < block1) {
-              edge_list.insert(std::make_pair(block0, block1));
-              _block_pair_cut_he[block0][block1].push_back(he);
+    if (!_is_initialized) {
+      for (const HyperedgeID& he : _hg.edges()) {
+        if (_hg.connectivity(he) > 1) {
+          for (const PartitionID& block0 : _hg.connectivitySet(he)) {
+            for (const PartitionID& block1 : _hg.connectivitySet(he)) {
+              if (block0 < block1) {
+                blockPair(block0, block1).cut_hes.push_back(he);
+              }
             }
           }
         }
       }
+      _hg.setConnectivityObserver(this);
+      _is_initialized = true;
     }
-    for (const edge& e : edge_list) {
-      _quotient_graph.push_back(e);
+
+    _quotient_graph.clear();
+    for (BlockPair& block_pair : _block_pairs) {
+      updateBlockPairCutHyperedges(block_pair);
+      if (!block_pair.cut_hes.empty()) {
+        _quotient_graph.emplace_back(block_pair.block0, block_pair.block1);
+      }
+    }
+    std::sort(_quotient_graph.begin(), _quotient_graph.end());
+  }
+
+  void blockAddedToConnectivitySet(const HyperedgeID he, const PartitionID block) override {
+    for (const PartitionID& part : _hg.connectivitySet(he)) {
+      if (block < part) {
+        blockPair(block, part).cut_hes.push_back(he);
+      } else if (block > part) {
+        blockPair(part, block).cut_hes.push_back(he);
+      }
     }
   }
 
@@ -86,16 +140,17 @@ class QuotientGraphBlockScheduler {
   void assignBlockPairCutHyperedges(PartitionID block0, PartitionID block1, std::vector<HyperedgeID>&& cut_hes) {
     if (block1 < block0)
       std::swap(block0, block1);
-    _block_pair_cut_he[block0][block1] = std::move(cut_hes);
+    blockPair(block0, block1).cut_hes = std::move(cut_hes);
   }
 
   std::pair<ConstCutHyperedgeIterator, ConstCutHyperedgeIterator> blockPairCutHyperedges(const PartitionID block0, const PartitionID block1) {
     ASSERT(block0 < block1, V(block0) << " < " << V(block1));
-    updateBlockPairCutHyperedges(block0, block1);
+    BlockPair& block_pair = blockPair(block0, block1);
+    updateBlockPairCutHyperedges(block_pair);
 
     ASSERT([&]() {
         std::set<HyperedgeID> cut_hyperedges;
-        for (const HyperedgeID& he : _block_pair_cut_he[block0][block1]) {
+        for (const HyperedgeID& he : block_pair.cut_hes) {
           if (cut_hyperedges.find(he) != cut_hyperedges.end()) {
             LOG << "Hyperedge " << he << " is contained more than once!";
             return false;
@@ -125,59 +180,68 @@ class QuotientGraphBlockScheduler {
         return true;
       } (), "Cut hyperedge set between " << V(block0) << " and " << V(block1) << " is wrong!");
 
-    return std::make_pair(_block_pair_cut_he[block0][block1].cbegin(),
-                          _block_pair_cut_he[block0][block1].cend());
+    return std::make_pair(block_pair.cut_hes.cbegin(), block_pair.cut_hes.cend());
   }
 
   std::vector<HyperedgeID> & exposeBlockPairCutHyperedges(const PartitionID block0, const PartitionID block1) {
-    updateBlockPairCutHyperedges(block0, block1);
-    return _block_pair_cut_he[block0][block1];
+    BlockPair& block_pair = blockPair(block0, block1);
+    updateBlockPairCutHyperedges(block_pair);
+    return block_pair.cut_hes;
   }
 
+  // ! Moves hn from block from to block to. Newly cut hyperedges are added
+  // ! to the block pair lists via the connectivity observer.
   void changeNodePart(const HypernodeID hn, const PartitionID from, const PartitionID to) {
+    ASSERT(_is_initialized, "Quotient graph is not built");
     if (from != to) {
       _hg.changeNodePart(hn, from, to);
-      for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
-        if (_hg.pinCountInPart(he, to) == 1) {
-          for (const PartitionID& part : _hg.connectivitySet(he)) {
-            if (to < part) {
-              _block_pair_cut_he[to][part].push_back(he);
-            } else if (to > part) {
-              _block_pair_cut_he[part][to].push_back(he);
-            }
-          }
-        }
-      }
     }
   }
 
  private:
   static constexpr bool debug = false;
 
-  void updateBlockPairCutHyperedges(const PartitionID block0, const PartitionID block1) {
+  BlockPair& blockPair(const PartitionID block0, const PartitionID block1) {
+    ASSERT(block0 < block1, V(block0) << " < " << V(block1));
+    const size_t key = static_cast<size_t>(block0) * _context.partition.k + block1;
+    const auto it = _block_pair_index.find(key);
+    if (it != _block_pair_index.end()) {
+      return _block_pairs[it->second];
+    }
+    _block_pair_index.emplace(key, _block_pairs.size());
+    _block_pairs.emplace_back(block0, block1);
+    return _block_pairs.back();
+  }
+
+  void updateBlockPairCutHyperedges(BlockPair& block_pair) {
     _visited.reset();
-    size_t N = _block_pair_cut_he[block0][block1].size();
+    std::vector<HyperedgeID>& cut_hes = block_pair.cut_hes;
+    size_t N = cut_hes.size();
     for (size_t i = 0; i < N; ++i) {
-      const HyperedgeID he = _block_pair_cut_he[block0][block1][i];
-      if (_hg.pinCountInPart(he, block0) == 0 ||
-          _hg.pinCountInPart(he, block1) == 0 ||
+      const HyperedgeID he = cut_hes[i];
+      if (!_hg.edgeIsEnabled(he) ||
+          _hg.pinCountInPart(he, block_pair.block0) == 0 ||
+          _hg.pinCountInPart(he, block_pair.block1) == 0 ||
           _visited[he]) {
-        std::swap(_block_pair_cut_he[block0][block1][i],
-                  _block_pair_cut_he[block0][block1][N - 1]);
-        _block_pair_cut_he[block0][block1].pop_back();
+        std::swap(cut_hes[i], cut_hes[N - 1]);
+        cut_hes.pop_back();
         --i;
         --N;
+      } else {
+        _visited.set(he, true);
       }
-      _visited.set(he, true);
     }
   }
 
   Hypergraph& _hg;
   const Context& _context;
+  bool _is_initialized;
   std::vector<edge> _quotient_graph;
 
-  // Contains the cut hyperedges for each pair of blocks.
-  std::vector<std::vector<std::vector<HyperedgeID> > > _block_pair_cut_he;
+  // Cut hyperedges of all adjacent block pairs. Pairs are only allocated on demand.
+  std::vector<BlockPair> _block_pairs;
+  // Maps block0 * k + block1 to the position of the block pair in _block_pairs.
+  std::unordered_map<size_t, size_t> _block_pair_index;
   ds::FastResetFlagArray<> _visited;
 };
 }  // namespace kahypar
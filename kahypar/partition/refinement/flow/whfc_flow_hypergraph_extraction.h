@@ -20,12 +20,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 #include <kahypar/definitions.h>
 #include <kahypar/partition/context.h>
 #include <kahypar/utils/randomize.h>
-#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/epoch_hash_map.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
@@ -33,7 +38,6 @@
 #include <WHFC/datastructure/flow_hypergraph_builder.h>
 #include <WHFC/datastructure/node_border.h>
 #include "WHFC/datastructure/flow_hypergraph.h"
-#include "WHFC/datastructure/queue.h"
 
 #pragma GCC diagnostic pop
 
@@ -48,15 +52,11 @@ class FlowHypergraphExtractor {
   static constexpr PartitionID invalid_part = std::numeric_limits<PartitionID>::max();
   static constexpr bool debug = false;
 
-  // Note(gottesbueren) if this takes too much memory, we can set tighter bounds for the memory of flow_hg_builder, e.g. 2*max_part_weight for numNodes
+  // The memory of the extractor is bounded by the size of the largest flow hypergraph
+  // the size constraint admits instead of the size of the input hypergraph. The ID maps
+  // are reused for all block pairs and levels and are reset in constant time.
   FlowHypergraphExtractor(const Hypergraph& hg, const Context& context) :
-    flow_hg_builder(hg.initialNumNodes(), hg.initialNumEdges(), hg.initialNumPins()),
-    nodeIDMap(hg.initialNumNodes() + 2, whfc::invalidNode),
-    visitedNode(hg.initialNumNodes() + 2),
-    visitedHyperedge(hg.initialNumEdges()),
-    queue(hg.initialNumNodes() + 2) {
-    removeHyperedgesWithPinsOutsideRegion = context.partition.objective == Objective::cut;
-  }
+    FlowHypergraphExtractor(context, flowHypergraphCapacity(hg, context)) { }
 
   struct AdditionalData {
     whfc::Node source;
@@ -77,32 +77,27 @@ class FlowHypergraphExtractor {
     std::shuffle(cut_hes.begin(), cut_hes.end(), Randomize::instance().getGenerator());
 
     // collect b0
-    result.source = whfc::Node::fromOtherValueType(queue.queueEnd());
-    queue.push(globalSourceID);         // we abuse the queue as local2global ID mapper. --> assign a local ID for global source node
-    queue.reinitialize();               // and kill the queue
-    flow_hg_builder.addNode(whfc::NodeWeight(0));               // dummy weight for source. set at the end
+    result.source = addTerminal(globalSourceID);
     BreadthFirstSearch(hg, b0, b1, cut_hes, w0, maxW0, result.source, -hop_distance_delta, distanceFromCut);
 
     // collect b1
-    result.target = whfc::Node::fromOtherValueType(queue.queueEnd());
-    queue.push(globalTargetID);
-    queue.reinitialize();
-    flow_hg_builder.addNode(whfc::NodeWeight(0));
+    result.target = addTerminal(globalTargetID);
     BreadthFirstSearch(hg, b1, b0, cut_hes, w1, maxW1, result.target, hop_distance_delta, distanceFromCut);
 
     // collect cut hyperedges and their pins
     for (const HyperedgeID e : cut_hes) {
-      ASSERT(!visitedHyperedge[e], "Cut HE list contains duplicates");
+      ASSERT(!visitedHyperedge.contains(e), "Cut HE list contains duplicates");
       if (canHyperedgeBeDropped(hg, e))
         continue;
       result.cutAtStake += hg.edgeWeight(e);
       bool connectToSource = false;
       bool connectToTarget = false;
-      visitedHyperedge.set(e);
+      visitedHyperedge.insert(e, true);
       flow_hg_builder.startHyperedge(hg.edgeWeight(e));
       for (const HypernodeID v : hg.pins(e)) {
-        if (visitedNode[v]) {
-          flow_hg_builder.addPin(nodeIDMap[v]);
+        const whfc::Node vLocal = global2local(v);
+        if (vLocal != whfc::invalidNode) {
+          flow_hg_builder.addPin(vLocal);
         } else {
           connectToSource |= hg.inPart(v, b0);
           connectToTarget |= hg.inPart(v, b1);
@@ -150,22 +145,118 @@ class FlowHypergraphExtractor {
     return result;
   }
 
-  auto localNodeIDs() const { return boost::irange<whfc::Node>(whfc::Node(0), whfc::Node::fromOtherValueType(queue.queueEnd())); }
-  whfc::Node global2local(const HypernodeID x) const { ASSERT(x != globalSourceID && x != globalTargetID); return nodeIDMap[x]; }
-  HypernodeID local2global(const whfc::Node x) const { return queue.elementAt(x); }
+  auto localNodeIDs() const { return boost::irange<whfc::Node>(whfc::Node(0), whfc::Node::fromOtherValueType(local2globalIDs.size())); }
+  whfc::Node global2local(const HypernodeID x) const {
+    ASSERT(x != globalSourceID && x != globalTargetID);
+    const whfc::Node* local = nodeIDMap.find(x);
+    return local != nullptr ? *local : whfc::invalidNode;
+  }
+  HypernodeID local2global(const whfc::Node x) const { return local2globalIDs[x]; }
 
  private:
+  struct Capacity {
+    double weight;                              // upper bound for maxW0 + maxW1
+    size_t nodes;
+    size_t hyperedges;
+    size_t pins;
+  };
+
+  FlowHypergraphExtractor(const Context& context, const Capacity& capacity) :
+    flow_hg_builder(capacity.nodes, capacity.hyperedges, capacity.pins),
+    maxRegionWeight(capacity.weight),
+    maxNumNodes(capacity.nodes),
+    nodeIDMap(),
+    visitedHyperedge(),
+    local2globalIDs() {
+    removeHyperedgesWithPinsOutsideRegion = context.partition.objective == Objective::cut;
+  }
+
+  // Node weights are positive. Hence, a flow hypergraph whose region weighs at most W has at most W + 2 nodes,
+  // which stem from at most W nodes of the input hypergraph. If the extractor is created before coarsening,
+  // each flow hyperedge is incident to one of these input nodes and has at most as many pins as in the input.
+  // Terminals add at most one pin per hyperedge, since hyperedges connected to both terminals are removed.
+  static Capacity flowHypergraphCapacity(const Hypergraph& hg, const Context& context) {
+    Capacity capacity = { maxFlowHypergraphWeight(context), hg.initialNumNodes() + 2,
+                          hg.initialNumEdges(), hg.initialNumPins() };
+    if (capacity.weight >= hg.initialNumNodes()) {
+      return capacity;
+    }
+
+    const size_t max_region_nodes = capacity.weight;
+    capacity.nodes = max_region_nodes + 2;
+    if (hg.currentNumNodes() == hg.initialNumNodes()) {
+      std::vector<HyperedgeID> degrees;
+      degrees.reserve(hg.initialNumNodes());
+      for (const HypernodeID& hn : hg.nodes()) {
+        degrees.push_back(hg.nodeDegree(hn));
+      }
+      std::nth_element(degrees.begin(), degrees.begin() + max_region_nodes, degrees.end(),
+                       std::greater<HyperedgeID>());
+      const size_t max_region_degree = std::accumulate(degrees.begin(), degrees.begin() + max_region_nodes,
+                                                       static_cast<size_t>(0));
+      capacity.hyperedges = std::min<size_t>(hg.initialNumEdges(), max_region_degree);
+      capacity.pins = std::min<size_t>(hg.initialNumPins(), 2 * max_region_degree);
+    }
+    return capacity;
+  }
+
+  static double maxFlowHypergraphWeight(const Context& context) {
+    const double a = context.local_search.hyperflowcutter.snapshot_scaling;
+    const FlowHypergraphSizeConstraint constraint = context.local_search.hyperflowcutter.flowhypergraph_size_constraint;
+    if (constraint == FlowHypergraphSizeConstraint::max_part_weight_fraction &&
+        !context.partition.max_part_weights.empty()) {
+      return 2.0 * a * *std::max_element(context.partition.max_part_weights.begin(),
+                                         context.partition.max_part_weights.end());
+    } else if (constraint == FlowHypergraphSizeConstraint::scaled_max_part_weight_fraction_minus_opposite_side &&
+               !context.partition.perfect_balance_part_weights.empty()) {
+      return 2.0 * maxPartWeightScale(context) *
+             *std::max_element(context.partition.perfect_balance_part_weights.begin(),
+                               context.partition.perfect_balance_part_weights.end());
+    }
+    // part_weight_fraction depends on the current partition and is only bounded by the total weight
+    return std::numeric_limits<double>::max();
+  }
+
+  static double maxPartWeightScale(const Context& context) {
+    const double a = context.local_search.hyperflowcutter.snapshot_scaling;
+    if (!context.partition.use_individual_part_weights) {
+      // with a = 16 (default value) this starts to get really slow for epsilon > 0.05.
+      // for epsilon > 0.05, whfc flow network size still scales with epsilon,
+      // if hg.partWeight(b1) is close to max_part_weight. but only with multiplier 1
+      return 1.0 + a * std::min(0.05, context.partition.epsilon);
+    }
+    return 1.0 + (a - 1) * std::min(0.05, context.partition.adjusted_epsilon_for_individual_part_weights);
+  }
+
+  // we use the local2global ID mapper as BFS queue. --> assign a local ID for the terminal
+  // and start a new queue behind it
+  whfc::Node addTerminal(const HypernodeID globalTerminalID) {
+    const whfc::Node terminal = whfc::Node::fromOtherValueType(local2globalIDs.size());
+    local2globalIDs.push_back(globalTerminalID);
+    queueFront = local2globalIDs.size();
+    layerEnd = local2globalIDs.size();
+    flow_hg_builder.addNode(whfc::NodeWeight(0));               // dummy weight for terminal. set at the end
+    return terminal;
+  }
+
   bool canHyperedgeBeDropped(const Hypergraph& hg, const HyperedgeID e) {
     return removeHyperedgesWithPinsOutsideRegion && hg.hasPinsInOtherBlocks(e, b0, b1);
   }
 
-  inline void visitNode(const HypernodeID v, const Hypergraph& hg, HypernodeWeight& w) {
-    nodeIDMap[v] = whfc::Node::fromOtherValueType(queue.queueEnd());
-    ASSERT(nodeIDMap[v] == flow_hg_builder.numNodes());
+  inline bool canVisitNode(const HypernodeID v, const Hypergraph& hg, const HypernodeWeight w,
+                           const double sizeConstraint) const {
+    return w + hg.nodeWeight(v) <= sizeConstraint && !hg.isFixedVertex(v)
+           && local2globalIDs.size() < maxNumNodes;
+  }
+
+  inline whfc::Node visitNode(const HypernodeID v, const Hypergraph& hg, HypernodeWeight& w) {
+    const whfc::Node vLocal = whfc::Node::fromOtherValueType(local2globalIDs.size());
+    ASSERT(vLocal == flow_hg_builder.numNodes());
+    nodeIDMap.insert(v, vLocal);
     flow_hg_builder.addNode(whfc::NodeWeight(hg.nodeWeight(v)));
-    queue.push(v);
-    visitedNode.set(v);
+    local2globalIDs.push_back(v);
     w += hg.nodeWeight(v);
+    return vLocal;
   }
 
   void BreadthFirstSearch(const Hypergraph& hg, const PartitionID myBlock, const PartitionID otherBlock,
@@ -175,35 +266,34 @@ class FlowHypergraphExtractor {
     whfc::HopDistance d = d_delta;
     for (const HyperedgeID e : cut_hes) {
       for (const HypernodeID u: hg.pins(e)) {
-        if (!visitedNode[u] && hg.inPart(u, myBlock)
-            && hg.nodeWeight(u) + w <= sizeConstraint && !hg.isFixedVertex(u)) {
-          visitNode(u, hg, w);
-          distanceFromCut[nodeIDMap[u]] = d;
+        if (hg.inPart(u, myBlock) && !nodeIDMap.contains(u) && canVisitNode(u, hg, w, sizeConstraint)) {
+          distanceFromCut[visitNode(u, hg, w)] = d;
         }
       }
     }
 
-    while (!queue.empty()) {
-      if (queue.currentLayerEmpty()) {
-        queue.finishNextLayer();
+    while (queueFront < local2globalIDs.size()) {
+      if (queueFront == layerEnd) {
+        layerEnd = local2globalIDs.size();
         d += d_delta;
       }
-      HypernodeID u = queue.pop();
+      HypernodeID u = local2globalIDs[queueFront++];
       for (const HyperedgeID e : hg.incidentEdges(u)) {
         if (!hg.hasPinsInPart(e, otherBlock)  /* cut hyperedges are collected later */ && hg.pinCountInPart(e, myBlock) > 1 &&
-            (!canHyperedgeBeDropped(hg, e)) && !visitedHyperedge[e]) {
-          visitedHyperedge.set(e);
+            (!canHyperedgeBeDropped(hg, e)) && !visitedHyperedge.contains(e)) {
+          visitedHyperedge.insert(e, true);
           flow_hg_builder.startHyperedge(hg.edgeWeight(e));
           bool connectToTerminal = false;
           for (const HypernodeID v : hg.pins(e)) {
             if (hg.inPart(v, myBlock)) {
-              if (!visitedNode[v] && w + hg.nodeWeight(v) <= sizeConstraint && !hg.isFixedVertex(v)) {
-                visitNode(v, hg, w);
-                distanceFromCut[nodeIDMap[v]] = d;
+              whfc::Node vLocal = global2local(v);
+              if (vLocal == whfc::invalidNode && canVisitNode(v, hg, w, sizeConstraint)) {
+                vLocal = visitNode(v, hg, w);
+                distanceFromCut[vLocal] = d;
               }
 
-              if (visitedNode[v])
-                flow_hg_builder.addPin(nodeIDMap[v]);
+              if (vLocal != whfc::invalidNode)
+                flow_hg_builder.addPin(vLocal);
               else
                 connectToTerminal = true;
             }
@@ -222,22 +312,25 @@ class FlowHypergraphExtractor {
   whfc::FlowHypergraphBuilder flow_hg_builder;
 
  private:
+  double maxRegionWeight;
+  size_t maxNumNodes;
   PartitionID b0 = invalid_part, b1 = invalid_part;
   HypernodeID globalSourceID = invalid_node, globalTargetID = invalid_node;
-  std::vector<whfc::Node> nodeIDMap;
-  ds::FastResetFlagArray<> visitedNode;
-  ds::FastResetFlagArray<> visitedHyperedge;
-  using Queue = LayeredQueue<HypernodeID>;
-  Queue queue;
+  ds::EpochHashMap<HypernodeID, whfc::Node> nodeIDMap;
+  ds::EpochHashMap<HyperedgeID, bool> visitedHyperedge;
+  std::vector<HypernodeID> local2globalIDs;           // also serves as BFS queue
+  size_t queueFront = 0, layerEnd = 0;
   bool removeHyperedgesWithPinsOutsideRegion = false;
 
   void reset(const Hypergraph& hg, const PartitionID _b0, const PartitionID _b1) {
     b0 = _b0;
     b1 = _b1;
     flow_hg_builder.clear();
-    visitedNode.reset();
-    visitedHyperedge.reset();
-    queue.clear();
+    nodeIDMap.clear();
+    visitedHyperedge.clear();
+    local2globalIDs.clear();
+    queueFront = 0;
+    layerEnd = 0;
 
     globalSourceID = hg.initialNumNodes();
     globalTargetID = hg.initialNumNodes() + 1;
@@ -254,15 +347,7 @@ class FlowHypergraphExtractor {
       mw0 = a * context.partition.max_part_weights[b0];
       mw1 = a * context.partition.max_part_weights[b1];
     } else if (context.local_search.hyperflowcutter.flowhypergraph_size_constraint == FlowHypergraphSizeConstraint::scaled_max_part_weight_fraction_minus_opposite_side) {
-      double scale;
-      if (!context.partition.use_individual_part_weights) {
-        // with a = 16 (default value) this starts to get really slow for epsilon > 0.05.
-        // for epsilon > 0.05, whfc flow network size still scales with epsilon,
-        // if hg.partWeight(b1) is close to max_part_weight. but only with multiplier 1
-        scale = 1.0 + a * std::min(0.05, context.partition.epsilon);
-      } else {
-        scale = 1.0 + (a-1) * std::min(0.05, context.partition.adjusted_epsilon_for_individual_part_weights);
-      }
+      const double scale = maxPartWeightScale(context);
       mw0 = scale * context.partition.perfect_balance_part_weights[b1] - hg.partWeight(b1);
       mw1 = scale * context.partition.perfect_balance_part_weights[b0] - hg.partWeight(b0);
     } else {
@@ -273,6 +358,13 @@ class FlowHypergraphExtractor {
     mw0 = std::max(mw0, 0.0);
     mw1 = std::min(mw1, hg.partWeight(b1) * 0.9999);
     mw1 = std::max(mw1, 0.0);
+
+    if (mw0 + mw1 > maxRegionWeight) {
+      // flow_hg_builder is only sized for regions of weight maxRegionWeight
+      const double shrink = maxRegionWeight / (mw0 + mw1);
+      mw0 *= shrink;
+      mw1 *= shrink;
+    }
     return std::make_pair(mw0, mw1);
   }
 };
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <vector>
@@ -29,14 +31,31 @@
 #include "kahypar/partition/refinement/gain_cache_element.h"
 
 namespace kahypar {
+/*!
+ * Gain cache for k-way FM refinement. The cache elements of all hypernodes are
+ * stored in a single arena that is allocated once:
+ *  - For k <= kMaxDenseK, the arena is a dense slab in which the element of
+ *    hypernode hn is located at position hn.
+ *  - For larger k, elements are handed out in the order in which hypernodes are
+ *    touched for the first time. Since k-way FM only touches border nodes, the
+ *    memory pages that are actually used stay proportional to their number.
+ *
+ * Clearing the whole cache only increments the current epoch. An element whose
+ * epoch differs from the current one is considered empty and is reinitialized
+ * lazily on its next modification.
+ */
 template <typename Gain = Mandatory>
 class KwayGainCache {
  private:
   static const bool debug = false;
   static const HypernodeID hn_to_debug = 2;
 
+  static constexpr PartitionID kMaxDenseK = 16;
+  static constexpr size_t kNoSlot = std::numeric_limits<size_t>::max();
+
   using Byte = char;
   using KFMCacheElement = CacheElement<Gain>;
+  using Epoch = uint32_t;
 
  public:
   static constexpr HyperedgeWeight kNotCached = KFMCacheElement::kNotCached;
@@ -47,14 +66,15 @@ class KwayGainCache {
     _cache_element_size(static_cast<size_t>(sizeof(KFMCacheElement)) +
                         _k * sizeof(typename KFMCacheElement::Element) +
                         _k * sizeof(PartitionID)),
-    _cache(std::make_unique<KFMCacheElement*[]>(num_hns)),
+    // Intentionally not value-initialized, i.e., untouched pages are never committed.
+    _arena(new Byte[static_cast<size_t>(num_hns) * _cache_element_size]),
+    _slots(k <= kMaxDenseK ? 0 : num_hns, kNoSlot),
+    _num_used_slots(0),
+    _epochs(num_hns, 0),
+    _current_epoch(1),
     _deltas() { }
 
-  ~KwayGainCache() {
-    for (size_t i = 0; i < _num_hns; ++i) {
-      delete[] (reinterpret_cast<Byte*>(_cache[i]));
-    }
-  }
+  ~KwayGainCache() = default;
 
   KwayGainCache(const KwayGainCache&) = delete;
   KwayGainCache& operator= (const KwayGainCache&) = delete;
@@ -64,29 +84,28 @@ class KwayGainCache {
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Gain entry(const HypernodeID hn, const PartitionID part) const {
     DBGC(hn == hn_to_debug) << "entry access for HN" << hn << "and part" << part;
-    ASSERT(_cache[hn] != nullptr);
     ASSERT(part < _k, V(part));
-    return cacheElement(hn)->gain(part);
+    return entryExists(hn) ? cacheElement(hn)->gain(part) : kNotCached;
   }
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool entryExists(const HypernodeID hn,
                                                    const PartitionID part) const {
     ASSERT(part < _k, V(part));
     DBGC(hn == hn_to_debug) << "existence check for HN" << hn << "and part" << part
-                            << "=" << cacheElement(hn)->contains(part);
-    return _cache[hn] != nullptr && cacheElement(hn)->contains(part);
+                            << "=" << (entryExists(hn) && cacheElement(hn)->contains(part));
+    return entryExists(hn) && cacheElement(hn)->contains(part);
   }
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool entryExists(const HypernodeID hn) const {
     DBGC(hn == hn_to_debug) << "existence check for HN" << hn;
-    return _cache[hn] != nullptr;
+    return _epochs[hn] == _current_epoch;
   }
 
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void removeEntryDueToConnectivityDecrease(const HypernodeID hn,
                                                                             const PartitionID part) {
     ASSERT(part < _k, V(part));
-    ASSERT(_cache[hn] != nullptr);
+    ASSERT(entryExists(hn), V(hn));
     _deltas.emplace_back(hn, part, cacheElement(hn)->gain(part), RollbackAction::do_add);
     DBGC(hn == hn_to_debug) << "removeEntryDueToConnectivityDecrease for" << hn
                             << "and part" << part << "previous cache entry ="
@@ -99,9 +118,7 @@ class KwayGainCache {
                                                                          const PartitionID part,
                                                                          const Gain gain) {
     ASSERT(part < _k, V(part));
-    if (unlikely(_cache[hn] == nullptr)) {
-      _cache[hn] = new(new Byte[_cache_element_size])KFMCacheElement(_k);
-    }
+    touch(hn);
     ASSERT(!entryExists(hn, part), V(hn) << V(part));
     cacheElement(hn)->add(part, gain);
     DBGC(hn == hn_to_debug) << "addEntryDueToConnectivityIncrease for" << hn
@@ -115,7 +132,7 @@ class KwayGainCache {
                                                                     const PartitionID from_part,
                                                                     const PartitionID to_part,
                                                                     const bool remains_connected_to_from_part) {
-    ASSERT(_cache[moved_hn] != nullptr);
+    ASSERT(entryExists(moved_hn), V(moved_hn));
     if (remains_connected_to_from_part) {
       DBGC(moved_hn == hn_to_debug) << "updateFromAndToPartOfMovedHN(" << moved_hn
                                     << "," << from_part << "," << to_part << ")";
@@ -137,7 +154,7 @@ class KwayGainCache {
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void clear(const HypernodeID hn) {
     DBGC(hn == hn_to_debug) << "clear(" << hn << ")";
-    if (_cache[hn] != nullptr) {
+    if (entryExists(hn)) {
       cacheElement(hn)->clear();
     }
   }
@@ -145,9 +162,7 @@ class KwayGainCache {
   void initializeEntry(const HypernodeID hn, const PartitionID part, const Gain value) {
     ASSERT(part < _k, V(part));
     DBGC(hn == hn_to_debug) << "initializeEntry(" << hn << "," << part << "," << value << ")";
-    if (unlikely(_cache[hn] == nullptr)) {
-      _cache[hn] = new(new Byte[_cache_element_size])KFMCacheElement(_k);
-    }
+    touch(hn);
     cacheElement(hn)->add(part, value);
   }
 
@@ -163,7 +178,6 @@ class KwayGainCache {
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void updateExistingEntry(const HypernodeID hn,
                                                            const PartitionID part,
                                                            const Gain delta) {
-    ASSERT(_cache[hn] != nullptr);
     ASSERT(part < _k, V(part));
     ASSERT(entryExists(hn, part), V(hn) << V(part));
     ASSERT(cacheElement(hn)->gain(part) != kNotCached, V(hn) << V(part));
@@ -178,6 +192,7 @@ class KwayGainCache {
       const HypernodeID hn = rit->hn;
       const PartitionID part = rit->part;
       const Gain delta = rit->delta;
+      ASSERT(entryExists(hn), V(hn));
       if (cacheElement(hn)->contains(part)) {
         DBGC(hn == hn_to_debug) << "rollback:" << "G[" << hn << "," << part << "]="
                                 << cacheElement(hn)->gain(part) << "+" << delta << "="
@@ -203,32 +218,56 @@ class KwayGainCache {
   }
 
   const KFMCacheElement & adjacentParts(const HypernodeID hn) const {
-    return *cacheElement(hn);
+    return entryExists(hn) ? *cacheElement(hn) : emptyElement();
   }
 
+  // ! Invalidates all cache elements in O(1).
   void clear() {
-    for (HypernodeID hn = 0; hn < _num_hns; ++hn) {
-      if (_cache[hn] != nullptr) {  /// workaround
-        delete[] (reinterpret_cast<Byte*>(_cache[hn]));
-        _cache[hn] = new(new Byte[_cache_element_size])KFMCacheElement(_k);
-      }
+    ASSERT(_deltas.empty(), V(_deltas.size()));
+    if (unlikely(_current_epoch == std::numeric_limits<Epoch>::max())) {
+      std::fill(_epochs.begin(), _epochs.end(), 0);
+      _current_epoch = 0;
     }
+    ++_current_epoch;
   }
 
  private:
+  // ! Ensures that hn owns an element that is valid in the current epoch.
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void touch(const HypernodeID hn) {
+    if (unlikely(_epochs[hn] != _current_epoch)) {
+      if (_k > kMaxDenseK && _slots[hn] == kNoSlot) {
+        _slots[hn] = _num_used_slots++;
+      }
+      new(cacheElement(hn))KFMCacheElement(_k);
+      _epochs[hn] = _current_epoch;
+    }
+  }
+
   const KFMCacheElement* cacheElement(const HypernodeID hn) const {
-    return _cache[hn];
+    const size_t slot = _k <= kMaxDenseK ? hn : _slots[hn];
+    ASSERT(slot < _num_hns, V(hn) << V(slot));
+    return reinterpret_cast<const KFMCacheElement*>(_arena.get() + slot * _cache_element_size);
   }
 
   // To avoid code duplication we implement non-const version in terms of const version
   KFMCacheElement* cacheElement(const HypernodeID hn) {
-    return _cache[hn];
+    return const_cast<KFMCacheElement*>(static_cast<const KwayGainCache&>(*this).cacheElement(hn));
+  }
+
+  // ! Adjacent parts of hypernodes that are not contained in the cache
+  static const KFMCacheElement & emptyElement() {
+    static const KFMCacheElement empty(0);
+    return empty;
   }
 
   PartitionID _k;
   HypernodeID _num_hns;
   const size_t _cache_element_size;
-  std::unique_ptr<KFMCacheElement*[]> _cache;
+  std::unique_ptr<Byte[]> _arena;
+  std::vector<size_t> _slots;
+  size_t _num_used_slots;
+  std::vector<Epoch> _epochs;
+  Epoch _current_epoch;
   std::vector<RollbackElement> _deltas;
 };
 
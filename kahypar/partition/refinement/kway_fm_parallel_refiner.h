@@ -0,0 +1,453 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/partition/refinement/move.h"
+#include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
+#include "kahypar/utils/float_compare.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
+
+namespace kahypar {
+/*!
+ * Multi-threaded k-way FM refinement for the cut and the (lambda - 1) metric.
+ *
+ * Each call to refine() proceeds in two phases:
+ *  1.) The border nodes among the refinement nodes are split into disjoint seed
+ *      sets of at most kSeedsPerSearch nodes. Each seed set starts a localized
+ *      FM search that only expands to the neighbors of moved nodes. Searches run
+ *      concurrently and never modify the hypergraph: each search works on a view
+ *      consisting of the partition at the beginning of the call and its own
+ *      thread-local pin count, part weight and part size deltas. Each search uses
+ *      its own priority queue whose gains are recomputed lazily w.r.t. this view
+ *      and keeps the best prefix of its move sequence.
+ *  2.) The move sequences are concatenated in the order of the seed sets and
+ *      applied to the hypergraph sequentially. Since searches may interfere with
+ *      each other, the gain of each move is recomputed before it is performed.
+ *      Moves of nodes that were already moved by a preceding search and moves
+ *      that would violate the balance constraint are dropped. Afterwards, the
+ *      partition is rolled back to the best prefix of the merged sequence.
+ *
+ * Since neither the seed sets nor the searches depend on the thread that executes
+ * them, the result only depends on the seed of the random number generator.
+ */
+template <class StoppingPolicy = Mandatory,
+          class FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased>
+class KWayParallelFMRefiner final : public IRefiner {
+ private:
+  static constexpr bool enable_heavy_assert = false;
+  static constexpr bool debug = false;
+
+  static constexpr size_t kSeedsPerSearch = 16;
+
+  // ! Thread-local data of a localized search.
+  struct SearchData {
+    SearchData(const HypernodeID num_nodes, const PartitionID k) :
+      pq(num_nodes),
+      target(num_nodes, Hypergraph::kInvalidPartition),
+      touched(num_nodes),
+      moved(num_nodes),
+      local_part(num_nodes, Hypergraph::kInvalidPartition),
+      pin_count_delta(),
+      part_weight_delta(k, 0),
+      part_size_delta(k, 0),
+      to_parts(),
+      is_to_part(k),
+      candidates(),
+      is_candidate(k),
+      tmp_gains(k, 0) { }
+
+    void reset() {
+      pq.clear();
+      touched.reset();
+      moved.reset();
+      pin_count_delta.clear();
+      std::fill(part_weight_delta.begin(), part_weight_delta.end(), 0);
+      std::fill(part_size_delta.begin(), part_size_delta.end(), 0);
+      to_parts.clear();
+      is_to_part.reset();
+    }
+
+    ds::BinaryMaxHeap<HypernodeID, Gain> pq;
+    std::vector<PartitionID> target;
+    ds::FastResetFlagArray<> touched;
+    ds::FastResetFlagArray<> moved;
+    std::vector<PartitionID> local_part;
+    std::unordered_map<size_t, int> pin_count_delta;
+    std::vector<HypernodeWeight> part_weight_delta;
+    std::vector<int> part_size_delta;
+    // Blocks that received at least one node during the search.
+    std::vector<PartitionID> to_parts;
+    ds::FastResetFlagArray<> is_to_part;
+    std::vector<PartitionID> candidates;
+    ds::FastResetFlagArray<> is_candidate;
+    std::vector<Gain> tmp_gains;
+  };
+
+ public:
+  KWayParallelFMRefiner(Hypergraph& hypergraph, const Context& context) :
+    _hg(hypergraph),
+    _context(context),
+    _pool(context.partition.num_threads),
+    _search_data(),
+    _seeds(),
+    _search_moves(),
+    _performed_moves() {
+    for (size_t i = 0; i < _pool.numThreads(); ++i) {
+      _search_data.emplace_back(std::make_unique<SearchData>(_hg.initialNumNodes(),
+                                                             _context.partition.k));
+    }
+  }
+
+  ~KWayParallelFMRefiner() override = default;
+
+  KWayParallelFMRefiner(const KWayParallelFMRefiner&) = delete;
+  KWayParallelFMRefiner& operator= (const KWayParallelFMRefiner&) = delete;
+
+  KWayParallelFMRefiner(KWayParallelFMRefiner&&) = delete;
+  KWayParallelFMRefiner& operator= (KWayParallelFMRefiner&&) = delete;
+
+ private:
+  bool refineImpl(std::vector<HypernodeID>& refinement_nodes,
+                  const std::array<HypernodeWeight, 2>&,
+                  const UncontractionGainChanges&,
+                  Metrics& best_metrics) override final {
+    ASSERT(_context.partition.objective == Objective::cut ||
+           _context.partition.objective == Objective::km1, V(_context.partition.objective));
+    HEAVY_REFINEMENT_ASSERT(objective(best_metrics) == currentObjective(),
+                            V(objective(best_metrics)) << V(currentObjective()));
+    HEAVY_REFINEMENT_ASSERT(FloatingPoint<double>(best_metrics.imbalance).AlmostEquals(
+                              FloatingPoint<double>(metrics::imbalance(_hg, _context))),
+                            V(best_metrics.imbalance) << V(metrics::imbalance(_hg, _context)));
+
+    _seeds.clear();
+    for (const HypernodeID& hn : refinement_nodes) {
+      if (!_hg.isFixedVertex(hn) && _hg.isBorderNode(hn)) {
+        _seeds.push_back(hn);
+      }
+    }
+    if (_seeds.empty()) {
+      return false;
+    }
+    Randomize::instance().shuffleVector(_seeds, _seeds.size());
+
+    const size_t num_searches = (_seeds.size() + kSeedsPerSearch - 1) / kSeedsPerSearch;
+    if (_search_moves.size() < num_searches) {
+      _search_moves.resize(num_searches);
+    }
+    const HyperedgeWeight initial_objective = objective(best_metrics);
+    const double beta = log(_hg.currentNumNodes());
+    _pool.parallelFor(0, num_searches, 1,
+                      [&](const size_t worker, const size_t begin, const size_t end) {
+        for (size_t search = begin; search < end; ++search) {
+          const size_t first_seed = search * kSeedsPerSearch;
+          const size_t last_seed = std::min(first_seed + kSeedsPerSearch, _seeds.size());
+          localizedSearch(*_search_data[worker], first_seed, last_seed, initial_objective, beta,
+                          _search_moves[search]);
+        }
+      });
+
+    const double initial_imbalance = best_metrics.imbalance;
+    applyBestPrefix(num_searches, best_metrics);
+
+    HEAVY_REFINEMENT_ASSERT(objective(best_metrics) == currentObjective(),
+                            V(objective(best_metrics)) << V(currentObjective()));
+    ASSERT(objective(best_metrics) <= initial_objective,
+           V(initial_objective) << V(objective(best_metrics)));
+
+    return FMImprovementPolicy::improvementFound(objective(best_metrics), initial_objective,
+                                                 best_metrics.imbalance, initial_imbalance,
+                                                 _context.partition.epsilon);
+  }
+
+  // ! Runs an FM search starting from _seeds[first_seed, last_seed) without
+  // ! modifying the hypergraph and stores the best prefix of its moves in moves.
+  void localizedSearch(SearchData& search, const size_t first_seed, const size_t last_seed,
+                       const HyperedgeWeight initial_objective, const double beta,
+                       std::vector<Move>& moves) const {
+    search.reset();
+    moves.clear();
+    for (size_t i = first_seed; i < last_seed; ++i) {
+      search.touched.set(_seeds[i]);
+      insertIntoPQ(search, _seeds[i]);
+    }
+
+    StoppingPolicy stopping_policy;
+    stopping_policy.resetStatistics();
+    Gain current_gain = 0;
+    Gain best_gain = 0;
+    size_t best_prefix = 0;
+    uint32_t touched_hns_since_last_improvement = 0;
+    while (!search.pq.empty() &&
+           !stopping_policy.searchShouldStop(touched_hns_since_last_improvement, _context, beta,
+                                             initial_objective - best_gain,
+                                             initial_objective - current_gain)) {
+      const HypernodeID hn = search.pq.top();
+      const Gain queued_gain = search.pq.topKey();
+      search.pq.pop();
+
+      // Gains in the queue are not updated when neighbors move. Nodes whose
+      // gain decreased in the meantime are therefore re-inserted with their
+      // current gain.
+      PartitionID to_part = Hypergraph::kInvalidPartition;
+      Gain gain = 0;
+      computeBestMove(search, hn, to_part, gain);
+      if (to_part == Hypergraph::kInvalidPartition) {
+        continue;
+      } else if (gain < queued_gain) {
+        search.target[hn] = to_part;
+        search.pq.push(hn, gain);
+        continue;
+      }
+
+      const PartitionID from_part = partID(search, hn);
+      moveHypernode(search, hn, from_part, to_part);
+      moves.emplace_back(hn, from_part, to_part);
+      current_gain += gain;
+      stopping_policy.updateStatistics(gain);
+      ++touched_hns_since_last_improvement;
+      if (current_gain > best_gain) {
+        best_gain = current_gain;
+        best_prefix = moves.size();
+        touched_hns_since_last_improvement = 0;
+        stopping_policy.resetStatistics();
+      }
+
+      for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+        if (_hg.edgeSize(he) > _context.partition.hyperedge_size_threshold) {
+          continue;
+        }
+        for (const HypernodeID& pin : _hg.pins(he)) {
+          if (!search.touched[pin] && !_hg.isFixedVertex(pin)) {
+            search.touched.set(pin);
+            insertIntoPQ(search, pin);
+          }
+        }
+      }
+    }
+
+    while (moves.size() > best_prefix) {
+      moves.pop_back();
+    }
+    DBG << V(first_seed) << V(last_seed) << V(best_gain) << V(moves.size());
+  }
+
+  // ! Sequentially applies the moves of all searches and keeps the best prefix.
+  void applyBestPrefix(const size_t num_searches, Metrics& best_metrics) {
+    _performed_moves.clear();
+    HyperedgeWeight current_objective = objective(best_metrics);
+    double current_imbalance = best_metrics.imbalance;
+    size_t best_index = 0;
+    for (size_t search = 0; search < num_searches; ++search) {
+      for (const Move& move : _search_moves[search]) {
+        if (_hg.partID(move.hn) != move.from ||
+            _hg.partSize(move.from) == 1 ||
+            _hg.partWeight(move.to) + _hg.nodeWeight(move.hn) >
+            _context.partition.max_part_weights[move.to]) {
+          continue;
+        }
+        current_objective -= exactGain(move.hn, move.from, move.to);
+        _hg.changeNodePart(move.hn, move.from, move.to);
+        _performed_moves.emplace_back(move.hn, move.from, move.to);
+        current_imbalance = metrics::imbalance(_hg, _context);
+
+        const bool improved_objective_within_balance =
+          (current_imbalance <= _context.partition.epsilon) &&
+          (current_objective < objective(best_metrics));
+        const bool improved_balance_less_equal_objective =
+          (current_imbalance < best_metrics.imbalance) &&
+          (current_objective <= objective(best_metrics));
+        if (improved_objective_within_balance || improved_balance_less_equal_objective) {
+          objective(best_metrics) = current_objective;
+          best_metrics.imbalance = current_imbalance;
+          best_index = _performed_moves.size();
+        }
+      }
+    }
+    DBG << "KWayParallelFM performed" << _performed_moves.size() << "moves of"
+        << num_searches << "searches ( best_index=" << best_index << ")";
+
+    while (_performed_moves.size() > best_index) {
+      const Move& move = _performed_moves.back();
+      _hg.changeNodePart(move.hn, move.to, move.from);
+      _performed_moves.pop_back();
+    }
+  }
+
+  void insertIntoPQ(SearchData& search, const HypernodeID hn) const {
+    PartitionID to_part = Hypergraph::kInvalidPartition;
+    Gain gain = 0;
+    computeBestMove(search, hn, to_part, gain);
+    if (to_part != Hypergraph::kInvalidPartition) {
+      search.target[hn] = to_part;
+      search.pq.push(hn, gain);
+    }
+  }
+
+  void moveHypernode(SearchData& search, const HypernodeID hn, const PartitionID from_part,
+                     const PartitionID to_part) const {
+    search.moved.set(hn);
+    search.local_part[hn] = to_part;
+    search.part_weight_delta[from_part] -= _hg.nodeWeight(hn);
+    search.part_weight_delta[to_part] += _hg.nodeWeight(hn);
+    --search.part_size_delta[from_part];
+    ++search.part_size_delta[to_part];
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      --search.pin_count_delta[static_cast<size_t>(he) * _context.partition.k + from_part];
+      ++search.pin_count_delta[static_cast<size_t>(he) * _context.partition.k + to_part];
+    }
+    if (!search.is_to_part[to_part]) {
+      search.is_to_part.set(to_part);
+      search.to_parts.push_back(to_part);
+    }
+  }
+
+  /*!
+   * Determines the block that maximizes the gain of hn w.r.t. the view of the search
+   * among all blocks that can take hn without becoming overloaded. Ties are broken
+   * in favor of lighter blocks. to_part is invalid if no such block exists.
+   */
+  void computeBestMove(SearchData& search, const HypernodeID hn,
+                       PartitionID& to_part, Gain& gain) const {
+    const PartitionID from_part = partID(search, hn);
+    to_part = Hypergraph::kInvalidPartition;
+    if (_hg.partSize(from_part) + search.part_size_delta[from_part] <= 1) {
+      return;
+    }
+
+    // A block can only be adjacent to hn in the view of the search if it is
+    // adjacent at the beginning of the refinement or if it received a node.
+    search.candidates.clear();
+    search.is_candidate.reset();
+    const auto add_candidate = [&](const PartitionID part) {
+                                 if (part != from_part && !search.is_candidate[part]) {
+                                   search.is_candidate.set(part);
+                                   search.candidates.push_back(part);
+                                   search.tmp_gains[part] = 0;
+                                 }
+                               };
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      for (const PartitionID& part : _hg.connectivitySet(he)) {
+        add_candidate(part);
+      }
+    }
+    for (const PartitionID& part : search.to_parts) {
+      add_candidate(part);
+    }
+
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      const HyperedgeWeight he_weight = _hg.edgeWeight(he);
+      const HypernodeID pins_in_from_part = pinCountInPart(search, he, from_part);
+      if (_context.partition.objective == Objective::km1) {
+        const Gain removal_gain = pins_in_from_part == 1 ? he_weight : 0;
+        for (const PartitionID& part : search.candidates) {
+          search.tmp_gains[part] += removal_gain -
+                                    (pinCountInPart(search, he, part) == 0 ? he_weight : 0);
+        }
+      } else {
+        const HypernodeID edge_size = _hg.edgeSize(he);
+        const Gain removal_gain = pins_in_from_part < edge_size ? he_weight : 0;
+        for (const PartitionID& part : search.candidates) {
+          search.tmp_gains[part] += removal_gain -
+                                    (pinCountInPart(search, he, part) + 1 < edge_size ?
+                                     he_weight : 0);
+        }
+      }
+    }
+
+    const HypernodeWeight hn_weight = _hg.nodeWeight(hn);
+    HypernodeWeight to_part_weight = 0;
+    for (const PartitionID& part : search.candidates) {
+      const HypernodeWeight part_weight = _hg.partWeight(part) + search.part_weight_delta[part];
+      if (part_weight + hn_weight > _context.partition.max_part_weights[part]) {
+        continue;
+      }
+      if (to_part == Hypergraph::kInvalidPartition || search.tmp_gains[part] > gain ||
+          (search.tmp_gains[part] == gain && part_weight < to_part_weight)) {
+        to_part = part;
+        gain = search.tmp_gains[part];
+        to_part_weight = part_weight;
+      }
+    }
+  }
+
+  // ! Gain of moving hn from from_part to to_part w.r.t. the current partition.
+  Gain exactGain(const HypernodeID hn, const PartitionID from_part,
+                 const PartitionID to_part) const {
+    Gain gain = 0;
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      const HyperedgeWeight he_weight = _hg.edgeWeight(he);
+      if (_context.partition.objective == Objective::km1) {
+        gain += (_hg.pinCountInPart(he, from_part) == 1 ? he_weight : 0) -
+                (_hg.pinCountInPart(he, to_part) == 0 ? he_weight : 0);
+      } else {
+        gain += (_hg.pinCountInPart(he, from_part) < _hg.edgeSize(he) ? he_weight : 0) -
+                (_hg.pinCountInPart(he, to_part) + 1 < _hg.edgeSize(he) ? he_weight : 0);
+      }
+    }
+    return gain;
+  }
+
+  PartitionID partID(const SearchData& search, const HypernodeID hn) const {
+    return search.moved[hn] ? search.local_part[hn] : _hg.partID(hn);
+  }
+
+  HypernodeID pinCountInPart(const SearchData& search, const HyperedgeID he,
+                             const PartitionID part) const {
+    const auto delta = search.pin_count_delta.find(
+      static_cast<size_t>(he) * _context.partition.k + part);
+    return delta == search.pin_count_delta.end() ?
+           _hg.pinCountInPart(he, part) : _hg.pinCountInPart(he, part) + delta->second;
+  }
+
+  HyperedgeWeight& objective(Metrics& metrics) const {
+    return _context.partition.objective == Objective::km1 ? metrics.km1 : metrics.cut;
+  }
+
+  HyperedgeWeight currentObjective() const {
+    return _context.partition.objective == Objective::km1 ?
+           metrics::km1(_hg) : metrics::hyperedgeCut(_hg);
+  }
+
+  Hypergraph& _hg;
+  const Context& _context;
+  ThreadPool _pool;
+  std::vector<std::unique_ptr<SearchData> > _search_data;
+  std::vector<HypernodeID> _seeds;
+  std::vector<std::vector<Move> > _search_moves;
+  std::vector<Move> _performed_moves;
+};
+}  // namespace kahypar
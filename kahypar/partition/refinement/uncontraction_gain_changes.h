@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "kahypar/definitions.h"
@@ -28,7 +29,8 @@ namespace kahypar {
 struct UncontractionGainChanges {
   UncontractionGainChanges() :
     representative(),
-    contraction_partner() { }
+    contraction_partner(),
+    uncontracted_pairs() { }
   ~UncontractionGainChanges() = default;
 
   UncontractionGainChanges(const UncontractionGainChanges&) = delete;
@@ -38,5 +40,11 @@ struct UncontractionGainChanges {
 
   std::vector<Gain> representative;
   std::vector<Gain> contraction_partner;
+  // ! If several contractions are undone before refinement (see
+  // ! LocalSearchParameters::uncontraction_batch_size), the i-th entry contains
+  // ! the (representative, contraction partner) pair the gain changes at position i
+  // ! belong to. Otherwise it is empty and the pair corresponds to the first two
+  // ! refinement nodes.
+  std::vector<std::pair<HypernodeID, HypernodeID> > uncontracted_pairs;
 };
 }  // namespace kahypar
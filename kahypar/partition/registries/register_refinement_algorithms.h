@@ -35,6 +35,7 @@
 #include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_flow_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_parallel_refiner.h"
 #include "kahypar/partition/refinement/policies/fm_stop_policy.h"
 
 #define REGISTER_DISPATCHED_REFINER(id, dispatcher, ...)          \
@@ -70,6 +71,10 @@ REGISTER_DISPATCHED_REFINER(RefinementAlgorithm::kway_fm_km1,
                             KWayKMinusOneFactoryDispatcher,
                             meta::PolicyRegistry<RefinementStoppingRule>::getInstance().getPolicy(
                               context.local_search.fm.stopping_rule));
+REGISTER_DISPATCHED_REFINER(RefinementAlgorithm::kway_fm_parallel,
+                            KWayParallelFMFactoryDispatcher,
+                            meta::PolicyRegistry<RefinementStoppingRule>::getInstance().getPolicy(
+                              context.local_search.fm.stopping_rule));
 REGISTER_DISPATCHED_REFINER(RefinementAlgorithm::twoway_hyperflow_cutter,
                             TwoWayHyperFlowCutterFactoryDispatcher,
                             meta::PolicyRegistry<FlowExecutionMode>::getInstance().getPolicy(
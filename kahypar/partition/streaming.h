@@ -0,0 +1,483 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+
+namespace kahypar {
+namespace streaming {
+// ! Streams the enabled hyperedges of an in-memory hypergraph.
+class HypergraphNetStream {
+ public:
+  explicit HypergraphNetStream(const Hypergraph& hypergraph) :
+    _hg(hypergraph),
+    _next_net(0) { }
+
+  HypergraphNetStream(const HypergraphNetStream&) = delete;
+  HypergraphNetStream& operator= (const HypergraphNetStream&) = delete;
+
+  HypergraphNetStream(HypergraphNetStream&&) = delete;
+  HypergraphNetStream& operator= (HypergraphNetStream&&) = delete;
+
+  ~HypergraphNetStream() = default;
+
+  HypernodeID numNodes() const {
+    return _hg.initialNumNodes();
+  }
+
+  HyperedgeID numNets() const {
+    return _hg.initialNumEdges();
+  }
+
+  HypernodeWeight nodeWeight(const HypernodeID hn) const {
+    return _hg.nodeIsEnabled(hn) ? _hg.nodeWeight(hn) : 0;
+  }
+
+  bool next(std::vector<HypernodeID>& pins, HyperedgeWeight& weight) {
+    while (_next_net < _hg.initialNumEdges() && !_hg.edgeIsEnabled(_next_net)) {
+      ++_next_net;
+    }
+    if (_next_net == _hg.initialNumEdges()) {
+      return false;
+    }
+    pins.assign(_hg.pins(_next_net).first, _hg.pins(_next_net).second);
+    weight = _hg.edgeWeight(_next_net);
+    ++_next_net;
+    return true;
+  }
+
+  void rewind() {
+    _next_net = 0;
+  }
+
+ private:
+  const Hypergraph& _hg;
+  HyperedgeID _next_net;
+};
+
+/*!
+ * Single-pass partitioner for hypergraphs that are too large to be kept in
+ * memory. Hyperedges are read once from a NetStream (see HMetisNetStream and
+ * HypergraphNetStream) and each unassigned pin is greedily placed into the block
+ * maximizing the Fennel objective
+ *
+ *   w(e) * |e ∩ V_b| - alpha * gamma * c(V_b)^(gamma - 1) * c(v)
+ *
+ * subject to the balance constraint. Since all pins of a hyperedge are assigned
+ * when it is read, its connectivity is final and the objective is accumulated
+ * on the fly. Optional restreaming passes collect consecutive hyperedges into
+ * windows of bounded size, build the window hypergraph and refine it with k-way
+ * FM. Vertices that have hyperedges outside of the window are treated as fixed
+ * vertices, such that all gains computed on the window are exact.
+ *
+ * Memory is O(n + k + window size): the partitioner only stores the block, the
+ * weight and the degree of each vertex.
+ */
+template <typename NetStream>
+class StreamingPartitioner {
+ private:
+  static constexpr bool debug = false;
+  static constexpr HypernodeID kInvalidID = std::numeric_limits<HypernodeID>::max();
+
+  using KWayKMinusOneRefinerSimpleStopping = KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch>;
+  using KWayCutRefinerSimpleStopping = KWayFMRefiner<NumberOfFruitlessMovesStopsSearch>;
+
+ public:
+  StreamingPartitioner(NetStream& stream, const Context& context) :
+    _stream(stream),
+    _context(context),
+    _part(stream.numNodes(), Hypergraph::kInvalidPartition),
+    _degree(stream.numNodes(), 0),
+    _fixed(),
+    _part_weight(context.partition.k, 0),
+    _part_size(context.partition.k, 0),
+    _pin_count(context.partition.k, 0),
+    _connectivity_set(),
+    _pins(),
+    _local_id(),
+    _window_nodes(),
+    _window_degree(),
+    _window_index(),
+    _window_pins(),
+    _window_weights(),
+    _cut(0),
+    _km1(0) {
+    ASSERT(context.partition.max_part_weights.size() == static_cast<size_t>(context.partition.k));
+    _connectivity_set.reserve(context.partition.k);
+  }
+
+  StreamingPartitioner(const StreamingPartitioner&) = delete;
+  StreamingPartitioner& operator= (const StreamingPartitioner&) = delete;
+
+  StreamingPartitioner(StreamingPartitioner&&) = delete;
+  StreamingPartitioner& operator= (StreamingPartitioner&&) = delete;
+
+  ~StreamingPartitioner() = default;
+
+  static HypernodeWeight totalWeight(const NetStream& stream) {
+    HypernodeWeight total_weight = 0;
+    for (HypernodeID hn = 0; hn < stream.numNodes(); ++hn) {
+      total_weight += stream.nodeWeight(hn);
+    }
+    return total_weight;
+  }
+
+  // ! Assigns hn to block part before streaming. hn is never moved afterwards.
+  void fixVertex(const HypernodeID hn, const PartitionID part) {
+    ASSERT(_part[hn] == Hypergraph::kInvalidPartition, V(hn));
+    if (_fixed.empty()) {
+      _fixed.resize(_part.size(), false);
+    }
+    _fixed[hn] = true;
+    assign(hn, part);
+  }
+
+  void partition() {
+    HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    streamingPass();
+    HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    _context.timer->add(_context, Timepoint::initial_partitioning,
+                        std::chrono::duration<double>(end - start).count());
+    printPass(0);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t pass = 1; pass <= _context.streaming.restreaming_passes; ++pass) {
+      const HyperedgeWeight objective_before = objective();
+      restreamingPass();
+      printPass(pass);
+      if (objective() == objective_before) {
+        break;
+      }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    _context.timer->add(_context, Timepoint::local_search,
+                        std::chrono::duration<double>(end - start).count());
+  }
+
+  PartitionID partID(const HypernodeID hn) const {
+    return _part[hn];
+  }
+
+  const std::vector<PartitionID>& partIDs() const {
+    return _part;
+  }
+
+  HypernodeWeight partWeight(const PartitionID part) const {
+    return _part_weight[part];
+  }
+
+  HypernodeID partSize(const PartitionID part) const {
+    return _part_size[part];
+  }
+
+  HyperedgeWeight cut() const {
+    return _cut;
+  }
+
+  HyperedgeWeight km1() const {
+    return _km1;
+  }
+
+  HyperedgeWeight objective() const {
+    return _context.partition.objective == Objective::cut ? _cut : _km1;
+  }
+
+  double imbalance() const {
+    double max_balance = 0.0;
+    for (PartitionID part = 0; part != _context.partition.k; ++part) {
+      max_balance = std::max(max_balance, _part_weight[part] /
+                             static_cast<double>(
+                               _context.partition.perfect_balance_part_weights[part]));
+    }
+    return max_balance - 1.0;
+  }
+
+ private:
+  void streamingPass() {
+    const double gamma = _context.streaming.gamma;
+    const double total_weight = std::max(totalWeight(_stream), 1);
+    // Fennel's choice of alpha, where the number of hyperedges replaces the number of edges.
+    const double alpha = _stream.numNets() * std::pow(_context.partition.k, gamma - 1.0) /
+                         std::pow(total_weight, gamma);
+
+    _stream.rewind();
+    HyperedgeWeight weight = 0;
+    while (_stream.next(_pins, weight)) {
+      if (_pins.size() < 2) {
+        // single-pin hyperedges never contribute to the objective
+        continue;
+      }
+      for (const HypernodeID& pin : _pins) {
+        ++_degree[pin];
+        if (_part[pin] != Hypergraph::kInvalidPartition) {
+          addToConnectivitySet(_part[pin]);
+        }
+      }
+      for (const HypernodeID& pin : _pins) {
+        if (_part[pin] == Hypergraph::kInvalidPartition) {
+          const PartitionID part = bestPart(pin, weight, alpha, gamma);
+          assign(pin, part);
+          addToConnectivitySet(part);
+        }
+      }
+      const HyperedgeWeight connectivity = _connectivity_set.size();
+      _km1 += (connectivity - 1) * weight;
+      _cut += connectivity > 1 ? weight : 0;
+      for (const PartitionID& part : _connectivity_set) {
+        _pin_count[part] = 0;
+      }
+      _connectivity_set.clear();
+    }
+
+    // vertices without hyperedges only affect the balance
+    for (HypernodeID hn = 0; hn < _part.size(); ++hn) {
+      if (_part[hn] == Hypergraph::kInvalidPartition) {
+        assign(hn, lightestPart(_stream.nodeWeight(hn)));
+      }
+    }
+  }
+
+  PartitionID bestPart(const HypernodeID hn, const HyperedgeWeight weight,
+                       const double alpha, const double gamma) const {
+    const HypernodeWeight hn_weight = _stream.nodeWeight(hn);
+    PartitionID best_part = Hypergraph::kInvalidPartition;
+    double best_score = std::numeric_limits<double>::lowest();
+    for (PartitionID part = 0; part != _context.partition.k; ++part) {
+      if (_part_weight[part] + hn_weight > _context.partition.max_part_weights[part]) {
+        continue;
+      }
+      const double score = static_cast<double>(weight) * _pin_count[part] -
+                           alpha * gamma * std::pow(_part_weight[part], gamma - 1.0) * hn_weight;
+      if (score > best_score ||
+          (score == best_score && _part_weight[part] < _part_weight[best_part])) {
+        best_score = score;
+        best_part = part;
+      }
+    }
+    return best_part != Hypergraph::kInvalidPartition ? best_part : lightestPart(hn_weight);
+  }
+
+  // ! Block with the largest remaining capacity.
+  PartitionID lightestPart(const HypernodeWeight hn_weight) const {
+    PartitionID best_part = 0;
+    HypernodeWeight best_capacity = std::numeric_limits<HypernodeWeight>::min();
+    for (PartitionID part = 0; part != _context.partition.k; ++part) {
+      const HypernodeWeight capacity = _context.partition.max_part_weights[part] -
+                                       _part_weight[part] - hn_weight;
+      if (capacity > best_capacity) {
+        best_capacity = capacity;
+        best_part = part;
+      }
+    }
+    return best_part;
+  }
+
+  void assign(const HypernodeID hn, const PartitionID part) {
+    ASSERT(part >= 0 && part < _context.partition.k, V(part));
+    _part[hn] = part;
+    _part_weight[part] += _stream.nodeWeight(hn);
+    ++_part_size[part];
+  }
+
+  void addToConnectivitySet(const PartitionID part) {
+    if (_pin_count[part]++ == 0) {
+      _connectivity_set.push_back(part);
+    }
+  }
+
+  void restreamingPass() {
+    if (_local_id.empty()) {
+      _local_id.resize(_part.size(), kInvalidID);
+    }
+    _stream.rewind();
+    HyperedgeWeight weight = 0;
+    _window_index.assign(1, 0);
+    while (_stream.next(_pins, weight)) {
+      if (_pins.size() < 2) {
+        continue;
+      }
+      for (const HypernodeID& pin : _pins) {
+        if (_local_id[pin] == kInvalidID) {
+          _local_id[pin] = _window_nodes.size();
+          _window_nodes.push_back(pin);
+          _window_degree.push_back(0);
+        }
+        ++_window_degree[_local_id[pin]];
+        _window_pins.push_back(_local_id[pin]);
+      }
+      _window_index.push_back(_window_pins.size());
+      _window_weights.push_back(weight);
+      if (_window_pins.size() >= _context.streaming.window_size) {
+        refineWindow();
+      }
+    }
+    refineWindow();
+  }
+
+  void refineWindow() {
+    if (!_window_weights.empty()) {
+      Hypergraph hypergraph(_window_nodes.size(), _window_weights.size(), _window_index,
+                            _window_pins, _context.partition.k, &_window_weights);
+      std::vector<HypernodeID> refinement_nodes;
+      for (HypernodeID hn = 0; hn < _window_nodes.size(); ++hn) {
+        const HypernodeID original_hn = _window_nodes[hn];
+        hypergraph.setNodeWeight(hn, _stream.nodeWeight(original_hn));
+        if (_window_degree[hn] < _degree[original_hn] ||
+            (!_fixed.empty() && _fixed[original_hn])) {
+          hypergraph.setFixedVertex(hn, _part[original_hn]);
+        } else {
+          refinement_nodes.push_back(hn);
+        }
+        hypergraph.setNodePart(hn, _part[original_hn]);
+      }
+      if (!refinement_nodes.empty()) {
+        refine(hypergraph, refinement_nodes);
+      }
+    }
+
+    for (const HypernodeID& hn : _window_nodes) {
+      _local_id[hn] = kInvalidID;
+    }
+    _window_nodes.clear();
+    _window_degree.clear();
+    _window_index.assign(1, 0);
+    _window_pins.clear();
+    _window_weights.clear();
+  }
+
+  void refine(Hypergraph& hypergraph, const std::vector<HypernodeID>& refinement_nodes) {
+    hypergraph.initializeNumCutHyperedges();
+
+    // The window may only use the capacity that is not occupied by the rest of the hypergraph.
+    Context context(_context);
+    context.partition.mode = Mode::direct_kway;
+    context.partition.use_individual_part_weights = true;
+    for (PartitionID part = 0; part != context.partition.k; ++part) {
+      context.partition.max_part_weights[part] -= _part_weight[part] - hypergraph.partWeight(part);
+    }
+
+    HyperedgeWeight max_gain = 0;
+    for (const HypernodeID& hn : refinement_nodes) {
+      HyperedgeWeight gain = 0;
+      for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+        gain += hypergraph.edgeWeight(he);
+      }
+      max_gain = std::max(max_gain, gain);
+    }
+
+    const HyperedgeWeight cut_before = metrics::hyperedgeCut(hypergraph);
+    const HyperedgeWeight km1_before = metrics::km1(hypergraph);
+    Metrics metrics = { cut_before, km1_before, metrics::imbalance(hypergraph, context) };
+    if (context.partition.objective == Objective::cut) {
+      KWayCutRefinerSimpleStopping refiner(hypergraph, context);
+      refineUntilNoImprovement(refiner, refinement_nodes, max_gain, metrics);
+    } else {
+      KWayKMinusOneRefinerSimpleStopping refiner(hypergraph, context);
+      refineUntilNoImprovement(refiner, refinement_nodes, max_gain, metrics);
+    }
+
+    for (HypernodeID hn = 0; hn < _window_nodes.size(); ++hn) {
+      const HypernodeID original_hn = _window_nodes[hn];
+      const PartitionID from = _part[original_hn];
+      const PartitionID to = hypergraph.partID(hn);
+      if (from != to) {
+        _part_weight[from] -= hypergraph.nodeWeight(hn);
+        --_part_size[from];
+        _part[original_hn] = Hypergraph::kInvalidPartition;
+        assign(original_hn, to);
+      }
+    }
+    // All hyperedges of moved vertices are part of the window.
+    _cut += metrics::hyperedgeCut(hypergraph) - cut_before;
+    _km1 += metrics::km1(hypergraph) - km1_before;
+  }
+
+  template <typename Refiner>
+  void refineUntilNoImprovement(Refiner& refiner, const std::vector<HypernodeID>& refinement_nodes,
+                                const HyperedgeWeight max_gain, Metrics& metrics) {
+    UncontractionGainChanges changes;
+    changes.representative.push_back(0);
+    changes.contraction_partner.push_back(0);
+    refiner.initialize(max_gain);
+    std::vector<HypernodeID> nodes;
+    bool improved = true;
+    while (improved) {
+      nodes = refinement_nodes;
+      improved = refiner.refine(nodes, { 0, 0 }, changes, metrics);
+    }
+  }
+
+  void printPass(const uint32_t pass) const {
+    if (_context.partition.verbose_output && !_context.partition.quiet_mode) {
+      LOG << (pass == 0 ? "Streaming pass" : "Restreaming pass") << pass << ": cut =" << _cut
+          << "km1 =" << _km1 << "imbalance =" << imbalance();
+    }
+  }
+
+  NetStream& _stream;
+  const Context& _context;
+  std::vector<PartitionID> _part;
+  std::vector<HyperedgeID> _degree;
+  std::vector<bool> _fixed;
+  std::vector<HypernodeWeight> _part_weight;
+  std::vector<HypernodeID> _part_size;
+  std::vector<HypernodeID> _pin_count;
+  std::vector<PartitionID> _connectivity_set;
+  std::vector<HypernodeID> _pins;
+
+  // restreaming window
+  std::vector<HypernodeID> _local_id;
+  std::vector<HypernodeID> _window_nodes;
+  std::vector<HyperedgeID> _window_degree;
+  HyperedgeIndexVector _window_index;
+  HyperedgeVector _window_pins;
+  HyperedgeWeightVector _window_weights;
+
+  HyperedgeWeight _cut;
+  HyperedgeWeight _km1;
+};
+
+// ! Streaming partitioning of an in-memory hypergraph (e.g., if it was given via the library interface).
+static inline void partition(Hypergraph& hypergraph, const Context& context) {
+  HypergraphNetStream stream(hypergraph);
+  StreamingPartitioner<HypergraphNetStream> partitioner(stream, context);
+  for (const HypernodeID& hn : hypergraph.fixedVertices()) {
+    partitioner.fixVertex(hn, hypergraph.fixedVertexPartID(hn));
+  }
+  partitioner.partition();
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, partitioner.partID(hn));
+  }
+}
+}  // namespace streaming
+}  // namespace kahypar
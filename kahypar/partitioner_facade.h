@@ -23,6 +23,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -30,12 +31,14 @@
 
 #include "kahypar/definitions.h"
 #include "kahypar/io/hypergraph_io.h"
+#include "kahypar/io/hypergraph_stream.h"
 #include "kahypar/io/partitioning_output.h"
 #include "kahypar/io/sql_plottools_serializer.h"
 #include "kahypar/kahypar.h"
 #include "kahypar/macros.h"
 #include "kahypar/partition/evo_partitioner.h"
 #include "kahypar/partition/metrics.h"
+#include "kahypar/partition/streaming.h"
 #include "kahypar/utils/math.h"
 #include "kahypar/utils/randomize.h"
 
@@ -48,9 +51,11 @@ class PartitionerFacade {
     sanityCheck(hypergraph, context);
 
     Randomize::instance().setSeed(context.partition.seed);
+    context.timer->clear();
 
     if (!context.partition.fixed_vertex_filename.empty()) {
-      io::readFixedVertexFile(hypergraph, context.partition.fixed_vertex_filename);
+      io::readFixedVertexFile(hypergraph, context.partition.fixed_vertex_filename,
+                              context.partition.num_threads);
     }
 
     if (!context.partition.input_partition_filename.empty()) {
@@ -71,6 +76,70 @@ class PartitionerFacade {
     }
   }
 
+  // ! Streaming mode: partitions the hypergraph file without loading it into memory.
+  void partitionStream(Context& context) {
+    using StreamingPartitioner = streaming::StreamingPartitioner<io::HMetisNetStream>;
+    io::printBanner(context);
+
+    ALWAYS_ASSERT(context.partition.mode == Mode::streaming, context.partition.mode);
+    checkStreamingMode(context);
+    if (!context.partition.fixed_vertex_filename.empty() ||
+        !context.partition.input_partition_filename.empty()) {
+      LOG << "Fixed vertices and input partitions are not supported in streaming mode";
+      std::exit(0);
+    }
+
+    Randomize::instance().setSeed(context.partition.seed);
+    context.timer->clear();
+    context.partition.start_time = std::chrono::high_resolution_clock::now();
+
+    io::HMetisNetStream stream(context.partition.graph_filename);
+    const HypernodeWeight total_weight = StreamingPartitioner::totalWeight(stream);
+    if (context.partition.use_individual_part_weights &&
+        (context.partition.max_part_weights.size() != static_cast<size_t>(context.partition.k) ||
+         std::accumulate(context.partition.max_part_weights.begin(),
+                         context.partition.max_part_weights.end(), 0) < total_weight)) {
+      LOG << "Individual part weights have to be specified for each block and"
+          << "their sum has to be at least the sum of vertex weights";
+      std::exit(-1);
+    }
+    context.setupPartWeights(total_weight);
+    if (!context.partition.quiet_mode) {
+      LOG << context;
+    }
+
+    StreamingPartitioner partitioner(stream, context);
+    partitioner.partition();
+    const std::chrono::duration<double> elapsed_seconds =
+      std::chrono::high_resolution_clock::now() - context.partition.start_time;
+
+    if (!context.partition.quiet_mode) {
+      LOG << "********************************************************************************";
+      LOG << "*                             Partitioning Result                              *";
+      LOG << "********************************************************************************";
+      LOG << "Objectives:";
+      LOG << "Hyperedge Cut  (minimize) =" << partitioner.cut();
+      LOG << "(k-1)          (minimize) =" << partitioner.km1();
+      LOG << "Imbalance                 =" << partitioner.imbalance();
+      LOG << "\nPartition sizes and weights: ";
+      for (PartitionID i = 0; i != context.partition.k; ++i) {
+        LOG << "|part" << i << "| =" << partitioner.partSize(i)
+            << " w(" << i << ") =" << partitioner.partWeight(i);
+      }
+      const auto& timings = context.timer->result();
+      LOG << "\nTimings:";
+      LOG << "Partition time                     =" << elapsed_seconds.count() << "s";
+      LOG << "  + Streaming                      =" << timings.total_initial_partitioning << "s";
+      LOG << "  + Restreaming                    =" << timings.total_local_search << "s";
+      LOG << "";
+    }
+    if (context.partition.write_partition_file) {
+      io::writePartitionFile(partitioner.partIDs(), context.partition.graph_partition_filename);
+    }
+    io::serializer::serializeStreaming(context, partitioner, stream.numNodes(), stream.numNets(),
+                                       total_weight, elapsed_seconds);
+  }
+
  private:
   void setupVcycleRefinement(Hypergraph& hypergraph, Context& context) {
     // We perform direct k-way V-cycle refinements.
@@ -168,7 +237,7 @@ class PartitionerFacade {
   void performEvolutionaryPartitioning(Hypergraph& hypergraph, Context& context) {
     EvoPartitioner evo_partitioner(context);
     evo_partitioner.partition(hypergraph, context);
-    const std::vector<PartitionID>& best_partition = evo_partitioner.bestPartition();
+    const std::vector<PartitionID> best_partition = evo_partitioner.bestPartition();
 
     hypergraph.reset();
     for (const auto& hn : hypergraph.nodes()) {
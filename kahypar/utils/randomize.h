@@ -34,8 +34,9 @@ class Randomize {
   Randomize& operator= (const Randomize&) = delete;
   Randomize& operator= (Randomize&&) = delete;
 
+  // ! Each thread owns its own generator, i.e., threads have to be seeded individually.
   static Randomize & instance() {
-    static Randomize instance;
+    static thread_local Randomize instance;
     return instance;
   }
 
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <array>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -59,13 +60,15 @@ class Stats {
     _context(context),
     _oss(),
     _parent(nullptr),
-    _logs() { }
+    _logs(),
+    _mutex() { }
 
   Stats(const Context& context, Stats* parent) :
     _context(context),
     _oss(),
     _parent(parent),
-    _logs() { }
+    _logs(),
+    _mutex() { }
 
   ~Stats() {
     if (_parent != nullptr) {
@@ -80,10 +83,12 @@ class Stats {
   Stats& operator= (Stats&&) = delete;
 
   void set(const StatTag& tag, const std::string& key, const double& value) {
+    std::lock_guard<std::mutex> lock(_mutex);
     _logs[static_cast<size_t>(tag)][key] = value;
   }
 
   void add(const StatTag& tag, const std::string& key, const double& value) {
+    std::lock_guard<std::mutex> lock(_mutex);
     _logs[static_cast<size_t>(tag)][key] += value;
   }
 
@@ -107,7 +112,10 @@ class Stats {
     return _oss;
   }
 
+  // Stats of contexts used by concurrent sub-tasks (e.g., parallel recursive
+  // bisection) are serialized into the same top-level stream.
   void serializeToParent() {
+    std::lock_guard<std::mutex> lock(topLevel()._mutex);
     std::ostringstream& oss = parentOutputStream();
     for (int i = 0; i < static_cast<int>(StatTag::COUNT); ++i) {
       serialize(_logs[i], static_cast<StatTag>(i), oss);
@@ -128,5 +136,6 @@ class Stats {
   std::ostringstream _oss;
   Stats* _parent;
   std::array<Log, static_cast<int>(StatTag::COUNT)> _logs;
+  std::mutex _mutex;
 };
 }  // namespace kahypar
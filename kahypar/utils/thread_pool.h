@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kahypar/macros.h"
+
+namespace kahypar {
+/*!
+ * Fixed-size pool of worker threads. The thread that owns the pool always
+ * participates in the work, i.e., a pool with num_threads = 1 does not spawn
+ * any threads and executes everything sequentially.
+ *
+ * Threads waiting for the result of a task (see wait()) execute pending tasks
+ * in the meantime. Thus tasks may themselves submit tasks to the same pool
+ * and wait for them without running into a deadlock.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(const size_t num_threads) :
+    _workers(),
+    _tasks(),
+    _mutex(),
+    _task_available(),
+    _stop(false) {
+    ASSERT(num_threads > 0, V(num_threads));
+    for (size_t i = 1; i < num_threads; ++i) {
+      _workers.emplace_back([this]() {
+          work();
+        });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator= (const ThreadPool&) = delete;
+
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator= (ThreadPool&&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _task_available.notify_all();
+    for (std::thread& worker : _workers) {
+      worker.join();
+    }
+  }
+
+  size_t numThreads() const {
+    return _workers.size() + 1;
+  }
+
+  // ! Enqueues task f. Sequential pools execute f immediately.
+  template <typename F>
+  std::future<std::invoke_result_t<F> > submit(F&& f) {
+    using Result = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<Result()> >(std::forward<F>(f));
+    std::future<Result> result = task->get_future();
+    if (_workers.empty()) {
+      (*task)();
+    } else {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.emplace([task]() {
+            (*task)();
+          });
+      }
+      _task_available.notify_one();
+    }
+    return result;
+  }
+
+  // ! Blocks until the result is available and helps executing pending tasks meanwhile.
+  // ! Exceptions thrown by the task are rethrown.
+  template <typename T>
+  T wait(std::future<T>& result) {
+    while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      if (!runPendingTask()) {
+        result.wait_for(std::chrono::microseconds(100));
+      }
+    }
+    return result.get();
+  }
+
+  /*!
+   * Calls f(worker, chunk_begin, chunk_end) for consecutive chunks of at most
+   * chunk_size elements that together cover [begin, end). Chunks are handed out
+   * dynamically, so busy threads do not stall the others. worker is in
+   * [0, numThreads()) and no two concurrent calls share the same worker id,
+   * which allows f to use per-worker scratch data.
+   *
+   * Which worker processes which chunk is not deterministic. Callers that
+   * need reproducible results therefore must not let the result of a chunk
+   * depend on the worker id.
+   */
+  template <typename F>
+  void parallelFor(const size_t begin, const size_t end, const size_t chunk_size, const F& f) {
+    ASSERT(chunk_size > 0, V(chunk_size));
+    if (begin >= end) {
+      return;
+    }
+    std::atomic<size_t> next_chunk(begin);
+    auto process_chunks = [&](const size_t worker) {
+                            size_t chunk_begin = next_chunk.fetch_add(chunk_size);
+                            while (chunk_begin < end) {
+                              f(worker, chunk_begin, std::min(chunk_begin + chunk_size, end));
+                              chunk_begin = next_chunk.fetch_add(chunk_size);
+                            }
+                          };
+    const size_t num_chunks = (end - begin + chunk_size - 1) / chunk_size;
+    const size_t num_helpers = std::min(_workers.size(), num_chunks - 1);
+    std::vector<std::future<void> > helpers;
+    for (size_t worker = 1; worker <= num_helpers; ++worker) {
+      helpers.emplace_back(submit([&process_chunks, worker]() {
+          process_chunks(worker);
+        }));
+    }
+    process_chunks(0);
+    for (std::future<void>& helper : helpers) {
+      wait(helper);
+    }
+  }
+
+ private:
+  void work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _task_available.wait(lock, [this]() {
+            return _stop || !_tasks.empty();
+          });
+        if (_stop && _tasks.empty()) {
+          return;
+        }
+        task = std::move(_tasks.front());
+        _tasks.pop();
+      }
+      task();
+    }
+  }
+
+  bool runPendingTask() {
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_tasks.empty()) {
+        return false;
+      }
+      task = std::move(_tasks.front());
+      _tasks.pop();
+    }
+    task();
+    return true;
+  }
+
+  std::vector<std::thread> _workers;
+  std::queue<std::function<void()> > _tasks;
+  std::mutex _mutex;
+  std::condition_variable _task_available;
+  bool _stop;
+};
+}  // namespace kahypar
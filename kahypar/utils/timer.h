@@ -21,10 +21,12 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "kahypar/definitions.h"
+#include "kahypar/partition/context_enum_classes.h"
 
 namespace kahypar {
 enum class Timepoint : uint8_t {
@@ -70,6 +72,7 @@ class Timer {
     int rk;
     double time;
 
+    template <typename Context>
     Timing(const Context& context, const Timepoint& timepoint, const double& time) :
       type(context.type),
       mode(context.partition.mode),
@@ -106,16 +109,32 @@ class Timer {
   };
 
  public:
-  void add(const Context& context, const Timepoint& timepoint, const double& time) {
-    _timings.emplace_back(context, timepoint, time);
+  Timer() :
+    _mutex(),
+    _current_timing(),
+    _start(),
+    _end(),
+    _timings(),
+    _result(),
+    _evaluated(false) {
+    _timings.reserve(1024);
   }
 
-  static Timer & instance() {
-    static Timer instance;
-    return instance;
+  Timer(const Timer&) = delete;
+  Timer& operator= (const Timer&) = delete;
+
+  Timer(Timer&&) = delete;
+  Timer& operator= (Timer&&) = delete;
+
+  // ! Thread-safe, i.e., concurrent (sub-)partitioning tasks may share a timer.
+  template <typename Context>
+  void add(const Context& context, const Timepoint& timepoint, const double& time) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _timings.emplace_back(context, timepoint, time);
   }
 
   void clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
     _timings.clear();
     _evaluated = false;
     _result = Result { };
@@ -123,6 +142,7 @@ class Timer {
 
 
   const Result & result() {
+    std::lock_guard<std::mutex> lock(_mutex);
     if (!_evaluated) {
       evaluate();
       _evaluated = true;
@@ -130,6 +150,7 @@ class Timer {
     return _result;
   }
   const Result & evolutionaryResult() {
+    std::lock_guard<std::mutex> lock(_mutex);
     _result.total_evolutionary = 0;
     std::vector<double> time_vector;
     for (const Timing& timing : _timings) {
@@ -143,16 +164,6 @@ class Timer {
   }
 
  private:
-  Timer() :
-    _current_timing(),
-    _start(),
-    _end(),
-    _timings(),
-    _result(),
-    _evaluated(false) {
-    _timings.reserve(1024);
-  }
-
   void evaluate() {
     int bisection_no = 0;
     for (const Timing& timing : _timings) {
@@ -173,7 +184,7 @@ class Timer {
             break;
         }
 
-        if (timing.mode == Mode::direct_kway) {
+        if (timing.mode == Mode::direct_kway || timing.mode == Mode::streaming) {
           if (timing.v_cycle == 0) {
             switch (timing.timepoint) {
               case Timepoint::coarsening:
@@ -247,6 +258,7 @@ class Timer {
     _result.total_postprocessing = _result.post_sparsifier_restore;
   }
 
+  std::mutex _mutex;
   Timepoint _current_timing;
   HighResClockTimepoint _start;
   HighResClockTimepoint _end;
@@ -24,9 +24,78 @@
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/macros.h"
 #include "kahypar/partition/context.h"
+#include "kahypar/partition/streaming.h"
 #include "kahypar/partitioner_facade.h"
 #include "kahypar/utils/randomize.h"
 
+namespace kahypar {
+namespace streaming {
+// ! Hyperedge stream given via the callbacks of the library interface.
+class CallbackNetStream {
+ public:
+  CallbackNetStream(const HypernodeID num_nodes, const HyperedgeID num_nets,
+                    const HypernodeWeight* node_weights,
+                    const kahypar_next_hyperedge_t next_hyperedge,
+                    const kahypar_rewind_stream_t rewind_stream, void* stream) :
+    _num_nodes(num_nodes),
+    _num_nets(num_nets),
+    _node_weights(node_weights),
+    _next_hyperedge(next_hyperedge),
+    _rewind_stream(rewind_stream),
+    _stream(stream),
+    _is_rewound(true) { }
+
+  CallbackNetStream(const CallbackNetStream&) = delete;
+  CallbackNetStream& operator= (const CallbackNetStream&) = delete;
+
+  CallbackNetStream(CallbackNetStream&&) = delete;
+  CallbackNetStream& operator= (CallbackNetStream&&) = delete;
+
+  ~CallbackNetStream() = default;
+
+  HypernodeID numNodes() const {
+    return _num_nodes;
+  }
+
+  HyperedgeID numNets() const {
+    return _num_nets;
+  }
+
+  HypernodeWeight nodeWeight(const HypernodeID hn) const {
+    return _node_weights == nullptr ? 1 : _node_weights[hn];
+  }
+
+  bool next(std::vector<HypernodeID>& pins, HyperedgeWeight& weight) {
+    size_t num_pins = 0;
+    const kahypar_hypernode_id_t* first_pin = nullptr;
+    _is_rewound = false;
+    if (_next_hyperedge(_stream, &num_pins, &first_pin, &weight) == 0) {
+      return false;
+    }
+    pins.assign(first_pin, first_pin + num_pins);
+    return true;
+  }
+
+  void rewind() {
+    if (!_is_rewound) {
+      ALWAYS_ASSERT(_rewind_stream != nullptr, "Restreaming requires a rewind_stream callback");
+      _rewind_stream(_stream);
+      _is_rewound = true;
+    }
+  }
+
+ private:
+  const HypernodeID _num_nodes;
+  const HyperedgeID _num_nets;
+  const HypernodeWeight* _node_weights;
+  const kahypar_next_hyperedge_t _next_hyperedge;
+  const kahypar_rewind_stream_t _rewind_stream;
+  void* _stream;
+  bool _is_rewound;
+};
+}  // namespace streaming
+}  // namespace kahypar
+
 
 kahypar_context_t* kahypar_context_new() {
   return reinterpret_cast<kahypar_context_t*>(new kahypar::Context());
@@ -77,16 +146,9 @@ void kahypar_set_fixed_vertices(kahypar_hypergraph_t* kahypar_hypergraph,
 }
 
 kahypar_hypergraph_t* kahypar_create_hypergraph_from_file(const char* file_name, const kahypar_partition_id_t num_blocks) {
-  kahypar::HypernodeID num_hypernodes;
-  kahypar::HyperedgeID num_hyperedges;
-  kahypar::HyperedgeIndexVector index_vector;
-  kahypar::HyperedgeVector edge_vector;
-  kahypar::HypernodeWeightVector hypernode_weights;
-  kahypar::HyperedgeWeightVector hyperedge_weights;
-  kahypar::io::readHypergraphFile(file_name, num_hypernodes, num_hyperedges,
-                                  index_vector, edge_vector, &hyperedge_weights, &hypernode_weights);
-  return reinterpret_cast<kahypar_hypergraph_t*>(new kahypar::Hypergraph(num_hypernodes, num_hyperedges, index_vector, edge_vector,
-                                                                         num_blocks, &hyperedge_weights, &hypernode_weights));
+  return reinterpret_cast<kahypar_hypergraph_t*>(new kahypar::Hypergraph(
+                                                   kahypar::io::createHypergraphFromFile(file_name,
+                                                                                         num_blocks)));
 }
 
 KAHYPAR_API kahypar_hypergraph_t* kahypar_create_hypergraph(const kahypar_partition_id_t num_blocks,
@@ -305,3 +367,46 @@ void kahypar_improve_partition(const kahypar_hypernode_id_t num_vertices,
                     kahypar_context,
                     improved_partition);
 }
+
+
+void kahypar_partition_stream(const kahypar_hypernode_id_t num_vertices,
+                              const kahypar_hyperedge_id_t num_hyperedges,
+                              const double epsilon,
+                              const kahypar_partition_id_t num_blocks,
+                              const kahypar_hypernode_weight_t* vertex_weights,
+                              kahypar_next_hyperedge_t next_hyperedge,
+                              kahypar_rewind_stream_t rewind_stream,
+                              void* stream,
+                              kahypar_hyperedge_weight_t* objective,
+                              kahypar_context_t* kahypar_context,
+                              kahypar_partition_id_t* partition) {
+  using StreamingPartitioner = kahypar::streaming::StreamingPartitioner<
+    kahypar::streaming::CallbackNetStream>;
+  kahypar::Context& context = *reinterpret_cast<kahypar::Context*>(kahypar_context);
+  ALWAYS_ASSERT(context.partition.mode == kahypar::Mode::streaming,
+                "Partitioning a hyperedge stream is only possible in streaming mode");
+  ASSERT(!context.partition.use_individual_part_weights ||
+         !context.partition.max_part_weights.empty());
+  ASSERT(partition != nullptr);
+
+  context.partition.k = num_blocks;
+  context.partition.epsilon = epsilon;
+  context.partition.write_partition_file = false;
+  kahypar::checkStreamingMode(context);
+
+  kahypar::Randomize::instance().setSeed(context.partition.seed);
+  context.timer->clear();
+
+  kahypar::streaming::CallbackNetStream net_stream(num_vertices, num_hyperedges, vertex_weights,
+                                                   next_hyperedge, rewind_stream, stream);
+  context.setupPartWeights(StreamingPartitioner::totalWeight(net_stream));
+
+  StreamingPartitioner partitioner(net_stream, context);
+  partitioner.partition();
+
+  *objective = partitioner.objective();
+  std::copy(partitioner.partIDs().begin(), partitioner.partIDs().end(), partition);
+
+  context.partition.perfect_balance_part_weights.clear();
+  context.partition.max_part_weights.clear();
+}
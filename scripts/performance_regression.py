@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+################################################################################
+# scripts/performance_regression.py
+#
+# This file is part of KaHyPar.
+#
+# Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+#
+# KaHyPar is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# KaHyPar is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+################################################################################
+"""End-to-end performance regression driver for the KaHyPar binary.
+
+Runs every combination of instances x configs x k x seeds of a matrix file,
+records the per-phase running times reported by the Timer (via the RESULT line
+of --sp-process), the peak resident set size of each run and the final
+km1/cut. Results are written as JSON and CSV. If a baseline (a JSON file
+written by a previous invocation) is given, all measurements are compared
+against it: a metric regresses if its mean got worse by more than a relative
+threshold AND a one-sided Welch t-test over the seeds deems the difference
+significant. The script exits with status 1 if any metric regressed.
+
+Example:
+  performance_regression.py --kahypar build/kahypar/application/KaHyPar \\
+      --matrix scripts/performance_matrix.json --output results \\
+      --baseline old_results.json
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import subprocess
+import sys
+
+# Timer results in the RESULT line that are tracked as phases.
+PHASES = {
+    "preprocessing": ["minHashSparsifierTime", "communityDetectionTime"],
+    "coarsening": ["coarseningTime"],
+    "initial_partitioning": ["initialPartitionTime"],
+    "local_search": ["uncoarseningRefinementTime"],
+    "flow": ["flowTime"],
+    "postprocessing": ["postMinHashSparsifierTime"],
+    "total": ["totalPartitionTime"],
+}
+
+
+def read_config_option(config, option):
+    with open(config) as ini:
+        for line in ini:
+            line = line.split("#", 1)[0].strip()
+            if line.startswith(option + "="):
+                return line.split("=", 1)[1].strip()
+    raise ValueError("%s does not specify '%s'" % (config, option))
+
+
+def parse_result_line(output):
+    for line in output.splitlines():
+        if line.startswith("RESULT "):
+            return dict(entry.split("=", 1) for entry in line.split()[1:] if "=" in entry)
+    raise ValueError("KaHyPar did not print a RESULT line")
+
+
+def run_kahypar(kahypar, instance, config, k, epsilon, seed, timeout):
+    objective = read_config_option(config, "objective")
+    mode = read_config_option(config, "mode")
+    command = [kahypar, "-h", instance, "-k", str(k), "-e", str(epsilon),
+               "--seed", str(seed), "-o", objective, "-m", mode, "-p", config,
+               "--sp-process=true", "-q", "true"]
+    if timeout is not None:
+        command += ["--time-limit", str(timeout)]
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                               universal_newlines=True)
+    output = process.stdout.read()
+    process.stdout.close()
+    # wait4 yields the resource usage of exactly this child process
+    _, status, rusage = os.wait4(process.pid, 0)
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        raise RuntimeError("'%s' failed with exit code %d:\n%s"
+                           % (" ".join(command), process.returncode, output))
+    result = parse_result_line(output)
+
+    run = {
+        "instance": os.path.basename(instance),
+        "config": os.path.basename(config),
+        "k": k,
+        "epsilon": epsilon,
+        "seed": seed,
+        "objective": objective,
+        "mode": mode,
+        "km1": int(result["km1"]),
+        "cut": int(result["cut"]),
+        "imbalance": float(result["imbalance"]),
+        # ru_maxrss is given in KiB on Linux
+        "peak_rss_mib": rusage.ru_maxrss / 1024.0,
+        "git": result.get("git", ""),
+    }
+    for phase, keys in PHASES.items():
+        run["time_" + phase] = sum(float(result.get(key, 0.0)) for key in keys)
+    return run
+
+
+def resolve(path, directory):
+    return path if os.path.isabs(path) else os.path.normpath(os.path.join(directory, path))
+
+
+def run_matrix(kahypar, matrix_file, timeout):
+    with open(matrix_file) as f:
+        matrix = json.load(f)
+    # paths in the matrix file are relative to the file itself
+    directory = os.path.dirname(os.path.abspath(matrix_file))
+    instances = [resolve(instance, directory) for instance in matrix["instances"]]
+    configs = [resolve(config, directory) for config in matrix["configs"]]
+    epsilon = matrix.get("epsilon", 0.03)
+
+    runs = []
+    num_runs = len(instances) * len(configs) * len(matrix["k"]) * len(matrix["seeds"])
+    for instance in instances:
+        for config in configs:
+            for k in matrix["k"]:
+                for seed in matrix["seeds"]:
+                    run = run_kahypar(kahypar, instance, config, k, epsilon, seed, timeout)
+                    runs.append(run)
+                    print("[%d/%d] %s %s k=%d seed=%d: km1=%d cut=%d time=%.3fs rss=%.1fMiB"
+                          % (len(runs), num_runs, run["instance"], run["config"], k, seed,
+                             run["km1"], run["cut"], run["time_total"], run["peak_rss_mib"]),
+                          flush=True)
+    return runs
+
+
+def write_results(runs, output):
+    with open(output + ".json", "w") as f:
+        json.dump({"runs": runs}, f, indent=2)
+    with open(output + ".csv", "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=list(runs[0].keys()))
+        writer.writeheader()
+        writer.writerows(runs)
+
+
+def mean(values):
+    return sum(values) / len(values)
+
+
+def variance(values):
+    if len(values) < 2:
+        return 0.0
+    m = mean(values)
+    return sum((v - m) ** 2 for v in values) / (len(values) - 1)
+
+
+def incomplete_beta(a, b, x):
+    """Regularized incomplete beta function I_x(a, b) via Lentz's continued fraction."""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    if x > (a + 1.0) / (a + b + 2.0):
+        return 1.0 - incomplete_beta(b, a, 1.0 - x)
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+                     + a * math.log(x) + b * math.log(1.0 - x)) / a
+    tiny = 1e-300
+    c, d = 1.0, 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    f = d
+    for i in range(2, 400):
+        m = i // 2
+        if i % 2 == 0:
+            numerator = m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m))
+        else:
+            numerator = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0))
+        d = 1.0 + numerator * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + numerator / c
+        c = c if abs(c) > tiny else tiny
+        f *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return front * f
+
+
+def welch_p_value(baseline, current):
+    """One-sided p-value for the hypothesis mean(current) > mean(baseline)."""
+    se2 = variance(baseline) / len(baseline) + variance(current) / len(current)
+    difference = mean(current) - mean(baseline)
+    if se2 == 0.0:
+        # deterministic measurements (e.g., quality for fixed seeds)
+        return 0.0 if difference > 0.0 else 1.0
+    if len(baseline) < 2 or len(current) < 2:
+        return 1.0
+    t = difference / math.sqrt(se2)
+    df = se2 ** 2 / ((variance(baseline) / len(baseline)) ** 2 / (len(baseline) - 1)
+                     + (variance(current) / len(current)) ** 2 / (len(current) - 1))
+    tail = 0.5 * incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+    return tail if t > 0.0 else 1.0 - tail
+
+
+def group(runs):
+    groups = {}
+    for run in runs:
+        groups.setdefault((run["instance"], run["config"], run["k"]), []).append(run)
+    return groups
+
+
+def compare(baseline_runs, current_runs, args):
+    """Returns the list of regressions as human-readable strings."""
+    metrics = [("time_" + phase, args.time_threshold, args.min_time_delta) for phase in PHASES]
+    metrics.append(("peak_rss_mib", args.rss_threshold, 0.0))
+    regressions = []
+    baseline_groups = group(baseline_runs)
+    for key, runs in sorted(group(current_runs).items()):
+        if key not in baseline_groups:
+            print("no baseline for %s %s k=%d" % key)
+            continue
+        base = baseline_groups[key]
+        objective = runs[0]["objective"]
+        quality = "km1" if objective == "km1" else "cut"
+        for metric, threshold, min_delta in metrics + [(quality, args.quality_threshold, 0.0)]:
+            base_values = [run[metric] for run in base]
+            current_values = [run[metric] for run in runs]
+            base_mean, current_mean = mean(base_values), mean(current_values)
+            delta = current_mean - base_mean
+            change = delta / base_mean if base_mean > 0.0 else (math.inf if delta > 0.0 else 0.0)
+            p_value = welch_p_value(base_values, current_values)
+            regressed = change > threshold and delta > min_delta and p_value < args.alpha
+            line = ("%-10s %s %s k=%d %-27s %12.4f -> %12.4f (%+7.2f%%, p=%.4f)"
+                    % ("REGRESSION" if regressed else "ok", key[0], key[1], key[2], metric,
+                       base_mean, current_mean, 100.0 * change, p_value))
+            if regressed or args.verbose:
+                print(line)
+            if regressed:
+                regressions.append(line)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--kahypar", required=True, help="path to the KaHyPar binary")
+    parser.add_argument("--matrix", required=True,
+                        help="JSON file with lists of instances, configs, k and seeds")
+    parser.add_argument("--output", default="performance_results",
+                        help="results are written to <output>.json and <output>.csv")
+    parser.add_argument("--baseline", help="results of a previous run to compare against")
+    parser.add_argument("--timeout", type=int, help="time limit per run in seconds")
+    parser.add_argument("--alpha", type=float, default=0.05,
+                        help="significance level of the one-sided Welch t-test")
+    parser.add_argument("--time-threshold", type=float, default=0.10,
+                        help="max. relative slowdown of a phase")
+    parser.add_argument("--min-time-delta", type=float, default=0.05,
+                        help="slowdowns below this number of seconds are ignored")
+    parser.add_argument("--rss-threshold", type=float, default=0.10,
+                        help="max. relative increase of the peak RSS")
+    parser.add_argument("--quality-threshold", type=float, default=0.01,
+                        help="max. relative increase of the objective")
+    parser.add_argument("--verbose", action="store_true", help="also print unchanged metrics")
+    args = parser.parse_args()
+
+    runs = run_matrix(args.kahypar, args.matrix, args.timeout)
+    write_results(runs, args.output)
+    print("results written to %s.json and %s.csv" % (args.output, args.output))
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline_runs = json.load(f)["runs"]
+        regressions = compare(baseline_runs, runs, args)
+        if regressions:
+            print("%d metrics regressed compared to %s" % (len(regressions), args.baseline))
+            return 1
+        print("no regressions compared to %s" % args.baseline)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
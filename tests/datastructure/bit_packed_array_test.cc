@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/bit_packed_array.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+TEST(ABitPackedArray, UsesTheMinimumNumberOfBitsPerEntry) {
+  ASSERT_THAT(BitPackedArray::bitsFor(0), Eq(1));
+  ASSERT_THAT(BitPackedArray::bitsFor(1), Eq(1));
+  ASSERT_THAT(BitPackedArray::bitsFor(2), Eq(2));
+  ASSERT_THAT(BitPackedArray::bitsFor(7), Eq(3));
+  ASSERT_THAT(BitPackedArray::bitsFor(8), Eq(4));
+  ASSERT_THAT(BitPackedArray::bitsFor(~uint64_t(0)), Eq(64));
+}
+
+TEST(ABitPackedArray, StoresEntriesThatSpanTwoWords) {
+  // 5 bits per entry: entries 12, 25, 38, ... cross a word boundary
+  BitPackedArray array(100, 31);
+  ASSERT_THAT(array.bitsPerEntry(), Eq(5));
+  ASSERT_THAT(array.sizeInBytes(), Eq(8 * 8));
+  for (size_t i = 0; i < array.size(); ++i) {
+    array.set(i, (i * 7) % 32);
+  }
+  for (size_t i = 0; i < array.size(); ++i) {
+    ASSERT_THAT(array[i], Eq((i * 7) % 32));
+  }
+}
+
+TEST(ABitPackedArray, OverwritesEntriesWithoutTouchingItsNeighbors) {
+  BitPackedArray array(30, 6);
+  for (size_t i = 0; i < array.size(); ++i) {
+    array.set(i, 6);
+  }
+  array.set(21, 0);
+  array.set(10, 1);
+  for (size_t i = 0; i < array.size(); ++i) {
+    ASSERT_THAT(array[i], Eq(i == 21 ? 0 : (i == 10 ? 1 : 6)));
+  }
+}
+
+TEST(ABitPackedArray, StoresPartitionsWithLogKBitsPerHypernode) {
+  const PartitionID k = 128;
+  std::vector<PartitionID> partition(1000);
+  for (size_t i = 0; i < partition.size(); ++i) {
+    partition[i] = (i * 31) % k;
+  }
+  BitPackedArray array(partition.size(), k - 1);
+  for (size_t i = 0; i < partition.size(); ++i) {
+    array.set(i, partition[i]);
+  }
+  ASSERT_THAT(array.bitsPerEntry(), Eq(7));
+  ASSERT_LT(array.sizeInBytes(), partition.size() * sizeof(PartitionID) / 4);
+  for (size_t i = 0; i < partition.size(); ++i) {
+    ASSERT_THAT(static_cast<PartitionID>(array[i]), Eq(partition[i]));
+  }
+}
+}  // namespace ds
+}  // namespace kahypar
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/epoch_hash_map.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+class AnEpochHashMap : public Test {
+ public:
+  AnEpochHashMap() :
+    map(4) { }
+
+  EpochHashMap<HypernodeID, HypernodeID> map;
+};
+
+TEST_F(AnEpochHashMap, ReturnsStoredValues) {
+  ASSERT_TRUE(map.insert(5, 50));
+  ASSERT_TRUE(map.insert(1000000, 7));
+  ASSERT_THAT(map.get(5), Eq(50));
+  ASSERT_THAT(map.get(1000000), Eq(7));
+  ASSERT_FALSE(map.contains(6));
+  ASSERT_THAT(map.size(), Eq(2));
+}
+
+TEST_F(AnEpochHashMap, DoesNotOverwriteContainedKeys) {
+  map.insert(5, 50);
+  ASSERT_FALSE(map.insert(5, 51));
+  ASSERT_THAT(map.get(5), Eq(50));
+  ASSERT_THAT(map.size(), Eq(1));
+}
+
+TEST_F(AnEpochHashMap, ForgetsAllElementsOnClear) {
+  map.insert(5, 50);
+  map.insert(6, 60);
+  map.clear();
+  ASSERT_FALSE(map.contains(5));
+  ASSERT_FALSE(map.contains(6));
+  ASSERT_THAT(map.size(), Eq(0));
+  map.insert(6, 61);
+  ASSERT_THAT(map.get(6), Eq(61));
+}
+
+TEST_F(AnEpochHashMap, KeepsElementsWhenGrowing) {
+  const size_t initial_capacity = map.capacity();
+  for (HypernodeID key = 0; key < 1000; ++key) {
+    map.insert(3 * key, key);
+  }
+  ASSERT_GT(map.capacity(), initial_capacity);
+  for (HypernodeID key = 0; key < 1000; ++key) {
+    ASSERT_THAT(map.get(3 * key), Eq(key));
+    ASSERT_FALSE(map.contains(3 * key + 1));
+  }
+}
+
+TEST_F(AnEpochHashMap, KeepsItsCapacityAcrossRounds) {
+  for (HypernodeID key = 0; key < 100; ++key) {
+    map.insert(key, key);
+  }
+  const size_t capacity = map.capacity();
+  for (size_t round = 0; round < 10; ++round) {
+    map.clear();
+    for (HypernodeID key = 0; key < 100; ++key) {
+      map.insert(key + round, key);
+    }
+    ASSERT_THAT(map.size(), Eq(100));
+    ASSERT_THAT(map.capacity(), Eq(capacity));
+  }
+}
+}  // namespace ds
+}  // namespace kahypar
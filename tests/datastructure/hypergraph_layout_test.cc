@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/hypergraph.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+template <typename Layout>
+using LayoutHypergraph = GenericHypergraph<HypernodeID, HyperedgeID, HypernodeWeight,
+                                           HyperedgeWeight, PartitionID, meta::Empty,
+                                           meta::Empty, DensePinCountInPart, Layout>;
+
+template <typename Hypergraph>
+class AHypergraphLayout : public Test {
+ public:
+  AHypergraphLayout() :
+    hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+               HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }, 4) { }
+
+  Hypergraph hypergraph;
+};
+
+using HypergraphLayoutTypes = ::testing::Types<LayoutHypergraph<ArrayOfStructsLayout>,
+                                               LayoutHypergraph<StructOfArraysLayout> >;
+
+TYPED_TEST_CASE(AHypergraphLayout, HypergraphLayoutTypes);
+
+TYPED_TEST(AHypergraphLayout, SkipsDisabledElementsDuringIteration) {
+  this->hypergraph.removeEdge(1);
+  this->hypergraph.contract(3, 4);
+
+  std::vector<HypernodeID> nodes;
+  for (const HypernodeID& hn : this->hypergraph.nodes()) {
+    nodes.push_back(hn);
+  }
+  std::vector<HyperedgeID> edges;
+  for (const HyperedgeID& he : this->hypergraph.edges()) {
+    edges.push_back(he);
+  }
+  ASSERT_THAT(nodes, Eq(std::vector<HypernodeID>({ 0, 1, 2, 3, 5, 6 })));
+  ASSERT_THAT(edges, Eq(std::vector<HyperedgeID>({ 0, 2, 3 })));
+}
+
+TYPED_TEST(AHypergraphLayout, MaintainsPartitionInformationDuringUncoarsening) {
+  auto& hypergraph = this->hypergraph;
+  const auto memento = hypergraph.contract(3, 4);
+  ASSERT_THAT(hypergraph.nodeWeight(3), Eq(2));
+  hypergraph.setNodePart(0, 0);
+  hypergraph.setNodePart(1, 1);
+  hypergraph.setNodePart(2, 0);
+  hypergraph.setNodePart(3, 3);
+  hypergraph.setNodePart(5, 2);
+  hypergraph.setNodePart(6, 2);
+  hypergraph.initializeNumCutHyperedges();
+  ASSERT_THAT(hypergraph.connectivity(1), Eq(3));
+  ASSERT_TRUE(hypergraph.isBorderNode(3));
+  ASSERT_THAT(hypergraph.connectivity(0), Eq(1));
+
+  hypergraph.uncontract(memento);
+  ASSERT_THAT(hypergraph.partID(4), Eq(3));
+  ASSERT_THAT(hypergraph.nodeWeight(3), Eq(1));
+  ASSERT_THAT(hypergraph.edgeSize(1), Eq(4));
+  ASSERT_THAT(hypergraph.partWeight(3), Eq(2));
+
+  hypergraph.changeNodePart(1, 1, 3);
+  ASSERT_THAT(hypergraph.connectivity(1), Eq(2));
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 3), Eq(3));
+
+  hypergraph.resetHypernodeState();
+  hypergraph.activate(5);
+  hypergraph.mark(5);
+  ASSERT_TRUE(hypergraph.marked(5));
+  ASSERT_FALSE(hypergraph.active(6));
+}
+
+TYPED_TEST(AHypergraphLayout, StoresAdditionalEdgeInformation) {
+  auto& hypergraph = this->hypergraph;
+  hypergraph.setEdgeWeight(2, 5);
+  ASSERT_THAT(hypergraph.edgeWeight(2), Eq(5));
+  const size_t hash = hypergraph.edgeHash(2);
+  hypergraph.contract(3, 4);
+  ASSERT_THAT(hypergraph.edgeHash(2), Eq(hash - math::hash(4)));
+  hypergraph.resetEdgeHashes();
+  ASSERT_THAT(hypergraph.edgeHash(2), Eq(TypeParam::kEdgeHashSeed + math::hash(3) + math::hash(6)));
+}
+}  // namespace ds
+}  // namespace kahypar
@@ -455,11 +455,14 @@ TEST_F(AHypergraph, InvalidatesPartitionPinCountsOnHyperedgeRemoval) {
 
   hypergraph.removeEdge(1);
 
+#ifndef KAHYPAR_USE_SPARSE_PIN_COUNTS
+  // sparse pin counts do not store any entries for invalidated nets
   for (PartitionID part = 0; part < hypergraph._k; ++part) {
     // bypass pinCountInPart because of assertions
-    const HypernodeID num_pins = hypergraph._pins_in_part[1 * hypergraph._k + part];
+    const HypernodeID num_pins = hypergraph._pins_in_part.get(1, part);
     ASSERT_THAT(num_pins, Eq(hypergraph.kInvalidCount));
   }
+#endif
 }
 
 TEST_F(AHypergraph, RestoresInvalidatedPartitionPinCountsOnHyperedgeRestore) {
@@ -713,10 +716,12 @@ TEST_F(AHypergraph, ExtractedFromAPartitionedHypergraphHasInitializedPartitionIn
   auto extr_part0 = extractPartAsUnpartitionedHypergraphForBisection(hypergraph, 0, Objective::cut);
 
   ASSERT_THAT(extr_part0.first->_part_info.size(), Eq(2));
-  ASSERT_THAT(extr_part0.first->_pins_in_part.size(), Eq(8));
 
   for (const HyperedgeID& he : extr_part0.first->edges()) {
     ASSERT_THAT(extr_part0.first->connectivity(he), Eq(0));
+    for (PartitionID part = 0; part < 2; ++part) {
+      ASSERT_THAT(extr_part0.first->pinCountInPart(he, part), Eq(0));
+    }
   }
 
   for (const HypernodeID& hn : extr_part0.first->nodes()) {
@@ -812,6 +817,86 @@ TEST_F(APartitionedHypergraph, CanBeResetToUnpartitionedState) {
 }
 
 
+TEST_F(APartitionedHypergraph, TracksCutKm1AndSoedMetrics) {
+  ASSERT_THAT(hypergraph.cut(), Eq(2));
+  ASSERT_THAT(hypergraph.km1(), Eq(2));
+  ASSERT_THAT(hypergraph.soed(), Eq(4));
+
+  hypergraph.changeNodePart(6, 1, 0);
+  ASSERT_THAT(hypergraph.cut(), Eq(2));
+  ASSERT_THAT(hypergraph.km1(), Eq(2));
+  ASSERT_THAT(hypergraph.soed(), Eq(4));
+
+  hypergraph.changeNodePart(2, 1, 0);
+  ASSERT_THAT(hypergraph.cut(), Eq(1));
+  ASSERT_THAT(hypergraph.km1(), Eq(1));
+  ASSERT_THAT(hypergraph.soed(), Eq(2));
+}
+
+TEST_F(APartitionedHypergraph, TracksMetricsOnEdgeWeightChangesAndEdgeRemoval) {
+  hypergraph.setEdgeWeight(2, 5);
+  ASSERT_THAT(hypergraph.cut(), Eq(6));
+  ASSERT_THAT(hypergraph.km1(), Eq(6));
+  ASSERT_THAT(hypergraph.soed(), Eq(12));
+
+  hypergraph.removeEdge(0);
+  ASSERT_THAT(hypergraph.cut(), Eq(5));
+  ASSERT_THAT(hypergraph.km1(), Eq(5));
+  ASSERT_THAT(hypergraph.soed(), Eq(10));
+
+  hypergraph.restoreEdge(0);
+  ASSERT_THAT(hypergraph.cut(), Eq(6));
+  ASSERT_THAT(hypergraph.km1(), Eq(6));
+  ASSERT_THAT(hypergraph.soed(), Eq(12));
+
+  hypergraph.resetPartitioning();
+  ASSERT_THAT(hypergraph.cut(), Eq(0));
+  ASSERT_THAT(hypergraph.km1(), Eq(0));
+  ASSERT_THAT(hypergraph.soed(), Eq(0));
+}
+
+TEST(AKWayPartitionedHypergraph, TracksMetricsDuringUncoarseningAndRefinement) {
+  Hypergraph hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                        HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }, 4);
+  std::stack<Memento> mementos;
+  mementos.push(hypergraph.contract(3, 4));
+  mementos.push(hypergraph.contract(0, 2));
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, hn % 4);
+  }
+
+  const auto verify = [&]() {
+      HyperedgeWeight cut = 0;
+      HyperedgeWeight km1 = 0;
+      HyperedgeWeight soed = 0;
+      for (const HyperedgeID& he : hypergraph.edges()) {
+        if (hypergraph.connectivity(he) > 1) {
+          cut += hypergraph.edgeWeight(he);
+          km1 += (hypergraph.connectivity(he) - 1) * hypergraph.edgeWeight(he);
+          soed += hypergraph.connectivity(he) * hypergraph.edgeWeight(he);
+        }
+      }
+      ASSERT_THAT(hypergraph.cut(), Eq(cut));
+      ASSERT_THAT(hypergraph.km1(), Eq(km1));
+      ASSERT_THAT(hypergraph.soed(), Eq(soed));
+    };
+
+  verify();
+  while (!mementos.empty()) {
+    hypergraph.uncontract(mementos.top());
+    mementos.pop();
+    verify();
+  }
+  for (HypernodeID i = 0; i < 50; ++i) {
+    const HypernodeID hn = (3 * i) % 7;
+    const PartitionID to = (i * 5) % 4;
+    if (hypergraph.partID(hn) != to) {
+      hypergraph.changeNodePart(hn, hypergraph.partID(hn), to);
+    }
+    verify();
+  }
+}
+
 TEST_F(APartitionedHypergraph, IdentifiesBorderHypernodes) {
   hypergraph.initializeNumCutHyperedges();
   ASSERT_THAT(hypergraph.isBorderNode(0), Eq(true));
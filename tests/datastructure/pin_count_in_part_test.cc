@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/pin_count_in_part.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+template <typename PinCountInPart>
+class APinCountInPart : public Test {
+ public:
+  APinCountInPart() :
+    edge_sizes({ 2, 100, 5, 1 }),
+    pin_counts() {
+    pin_counts.initialize(edge_sizes.size(), 64, [&](const HyperedgeID he) {
+        return edge_sizes[he];
+      });
+  }
+
+  std::vector<HypernodeID> edge_sizes;
+  PinCountInPart pin_counts;
+};
+
+using PinCountInPartTypes =
+  ::testing::Types<DensePinCountInPart<HypernodeID, HyperedgeID, PartitionID>,
+                   SparsePinCountInPart<HypernodeID, HyperedgeID, PartitionID> >;
+
+TYPED_TEST_CASE(APinCountInPart, PinCountInPartTypes);
+
+TYPED_TEST(APinCountInPart, IsZeroInitialized) {
+  for (HyperedgeID he = 0; he < this->edge_sizes.size(); ++he) {
+    for (PartitionID part = 0; part < 64; ++part) {
+      ASSERT_THAT(this->pin_counts.get(he, part), Eq(0));
+    }
+  }
+}
+
+TYPED_TEST(APinCountInPart, ReturnsNewValueOnIncrementAndDecrement) {
+  ASSERT_THAT(this->pin_counts.increment(2, 17), Eq(1));
+  ASSERT_THAT(this->pin_counts.increment(2, 17), Eq(2));
+  ASSERT_THAT(this->pin_counts.increment(2, 33), Eq(1));
+  ASSERT_THAT(this->pin_counts.decrement(2, 17), Eq(1));
+  ASSERT_THAT(this->pin_counts.get(2, 17), Eq(1));
+  ASSERT_THAT(this->pin_counts.get(2, 33), Eq(1));
+  ASSERT_THAT(this->pin_counts.get(2, 1), Eq(0));
+}
+
+TYPED_TEST(APinCountInPart, HandlesCollidingBlocksOfSmallNets) {
+  // blocks 1, 5, 9 and 13 are all mapped to the same slot of a net of size 5
+  for (const PartitionID part : { 1, 5, 9, 13, 17 }) {
+    this->pin_counts.increment(2, part);
+  }
+  this->pin_counts.decrement(2, 5);
+  this->pin_counts.decrement(2, 1);
+  ASSERT_THAT(this->pin_counts.get(2, 1), Eq(0));
+  ASSERT_THAT(this->pin_counts.get(2, 5), Eq(0));
+  ASSERT_THAT(this->pin_counts.get(2, 9), Eq(1));
+  ASSERT_THAT(this->pin_counts.get(2, 13), Eq(1));
+  ASSERT_THAT(this->pin_counts.get(2, 17), Eq(1));
+}
+
+TYPED_TEST(APinCountInPart, DoesNotInfluenceOtherNets) {
+  this->pin_counts.increment(0, 3);
+  this->pin_counts.increment(1, 3);
+  this->pin_counts.reset(0);
+  ASSERT_THAT(this->pin_counts.get(0, 3), Eq(0));
+  ASSERT_THAT(this->pin_counts.get(1, 3), Eq(1));
+}
+
+TYPED_TEST(APinCountInPart, MatchesAReferenceImplementationForRandomUpdates) {
+  std::mt19937 prng(42);
+  std::vector<std::vector<HypernodeID> > expected(this->edge_sizes.size(),
+                                                  std::vector<HypernodeID>(64, 0));
+  std::vector<std::vector<PartitionID> > pin_parts(this->edge_sizes.size());
+  for (HyperedgeID he = 0; he < this->edge_sizes.size(); ++he) {
+    for (HypernodeID pin = 0; pin < this->edge_sizes[he]; ++pin) {
+      const PartitionID part = prng() % 64;
+      pin_parts[he].push_back(part);
+      this->pin_counts.increment(he, part);
+      ++expected[he][part];
+    }
+  }
+  for (size_t i = 0; i < 10000; ++i) {
+    const HyperedgeID he = prng() % this->edge_sizes.size();
+    const HypernodeID pin = prng() % this->edge_sizes[he];
+    const PartitionID to = prng() % 64;
+    this->pin_counts.decrement(he, pin_parts[he][pin]);
+    --expected[he][pin_parts[he][pin]];
+    this->pin_counts.increment(he, to);
+    ++expected[he][to];
+    pin_parts[he][pin] = to;
+  }
+  for (HyperedgeID he = 0; he < this->edge_sizes.size(); ++he) {
+    for (PartitionID part = 0; part < 64; ++part) {
+      ASSERT_THAT(this->pin_counts.get(he, part), Eq(expected[he][part]));
+    }
+  }
+}
+
+TEST(ASparsePinCountInPart, ConsumesMemoryProportionalToThePinsForLargeK) {
+  SparsePinCountInPart<HypernodeID, HyperedgeID, PartitionID> sparse;
+  DensePinCountInPart<HypernodeID, HyperedgeID, PartitionID> dense;
+  auto edge_size = [](const HyperedgeID) {
+                     return 3;
+                   };
+  sparse.initialize(1000, 1024, edge_size);
+  dense.initialize(1000, 1024, edge_size);
+  ASSERT_LT(sparse.memoryConsumption() * 50, dense.memoryConsumption());
+}
+
+using SparseHypergraph = GenericHypergraph<HypernodeID, HyperedgeID, HypernodeWeight,
+                                           HyperedgeWeight, PartitionID, meta::Empty,
+                                           meta::Empty, SparsePinCountInPart>;
+
+TEST(AHypergraphWithSparsePinCounts, MaintainsPinCountsDuringContractionAndUncontraction) {
+  SparseHypergraph hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                              HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }, 4);
+  const auto memento = hypergraph.contract(3, 4);
+  hypergraph.setNodePart(0, 0);
+  hypergraph.setNodePart(1, 1);
+  hypergraph.setNodePart(2, 0);
+  hypergraph.setNodePart(3, 3);
+  hypergraph.setNodePart(5, 2);
+  hypergraph.setNodePart(6, 2);
+  hypergraph.initializeNumCutHyperedges();
+
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 0), Eq(1));
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 1), Eq(1));
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 3), Eq(1));
+  ASSERT_THAT(hypergraph.pinCountInPart(2, 3), Eq(1));
+  ASSERT_THAT(hypergraph.connectivity(1), Eq(3));
+
+  hypergraph.uncontract(memento);
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 3), Eq(2));
+  ASSERT_THAT(hypergraph.pinCountInPart(2, 3), Eq(2));
+
+  hypergraph.changeNodePart(1, 1, 3);
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 1), Eq(0));
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 3), Eq(3));
+  ASSERT_THAT(hypergraph.connectivity(1), Eq(2));
+}
+}  // namespace ds
+}  // namespace kahypar
@@ -84,6 +84,31 @@ TEST_F(KaHyParK, ComputesDirectKwayKm1Partitioning) {
   ASSERT_EQ(metrics::km1(hypergraph), metrics::km1(verification_hypergraph));
 }
 
+TEST_F(KaHyParK, ComputesDirectKwayKm1PartitioningWithParallelFlowRefinement) {
+  parseIniToContext(context, "../../../config/km1_kKaHyPar_sea20.ini");
+  context.partition.k = 8;
+  context.partition.epsilon = 0.03;
+  context.partition.objective = Objective::km1;
+  context.partition.num_threads = 4;
+
+  Hypergraph hypergraph(
+    kahypar::io::createHypergraphFromFile(context.partition.graph_filename,
+                                          context.partition.k));
+
+  PartitionerFacade().partition(hypergraph, context);
+
+  Hypergraph verification_hypergraph(
+    kahypar::io::createHypergraphFromFile(context.partition.graph_filename,
+                                          context.partition.k));
+
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    verification_hypergraph.setNodePart(hn, hypergraph.partID(hn));
+  }
+
+  ASSERT_LE(metrics::imbalance(hypergraph, context), context.partition.epsilon);
+  ASSERT_EQ(metrics::km1(hypergraph), metrics::km1(verification_hypergraph));
+}
+
 
 TEST_F(KaHyParR, ComputesRecursiveBisectionCutPartitioning) {
   parseIniToContext(context, "../../../config/old_reference_configs/cut_rb_alenex16.ini");
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "include/libkahypar.h"
+
+#include "kahypar/partition/context.h"
+
+using ::testing::ContainerEq;
+using ::testing::Eq;
+
+namespace kahypar {
+struct PartitioningResult {
+  kahypar_hyperedge_weight_t objective = 0;
+  std::vector<kahypar_partition_id_t> partition;
+};
+
+class ConcurrentInterfaceCalls : public ::testing::Test {
+ public:
+  ConcurrentInterfaceCalls() :
+    num_vertices(0),
+    num_hyperedges(0),
+    hyperedge_indices(nullptr),
+    hyperedges(nullptr),
+    hyperedge_weights(nullptr),
+    vertex_weights(nullptr) {
+    kahypar_read_hypergraph_from_file("../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr",
+                                      &num_vertices, &num_hyperedges, &hyperedge_indices,
+                                      &hyperedges, &hyperedge_weights, &vertex_weights);
+  }
+
+  ~ConcurrentInterfaceCalls() {
+    delete[] hyperedge_indices;
+    delete[] hyperedges;
+    delete[] hyperedge_weights;
+    delete[] vertex_weights;
+  }
+
+  // ! Each instance uses a different seed and number of blocks.
+  PartitioningResult partition(const int instance) const {
+    kahypar_context_t* kahypar_context = kahypar_context_new();
+    kahypar_configure_context_from_file(kahypar_context, "../../../config/km1_kKaHyPar_sea20.ini");
+    Context& context = *reinterpret_cast<Context*>(kahypar_context);
+    context.partition.seed = instance;
+    context.partition.quiet_mode = true;
+
+    PartitioningResult result;
+    result.partition.resize(num_vertices, -1);
+    kahypar_partition(num_vertices, num_hyperedges, 0.03, 2 + instance % 3,
+                      vertex_weights, hyperedge_weights, hyperedge_indices, hyperedges,
+                      &result.objective, kahypar_context, result.partition.data());
+    kahypar_context_free(kahypar_context);
+    return result;
+  }
+
+  kahypar_hypernode_id_t num_vertices;
+  kahypar_hyperedge_id_t num_hyperedges;
+  size_t* hyperedge_indices;
+  kahypar_hyperedge_id_t* hyperedges;
+  kahypar_hyperedge_weight_t* hyperedge_weights;
+  kahypar_hypernode_weight_t* vertex_weights;
+};
+
+TEST_F(ConcurrentInterfaceCalls, ComputeTheSamePartitionsAsSequentialCalls) {
+  const int num_instances = 8;
+  std::vector<PartitioningResult> sequential_results;
+  for (int instance = 0; instance < num_instances; ++instance) {
+    sequential_results.push_back(partition(instance));
+  }
+
+  std::vector<PartitioningResult> concurrent_results(num_instances);
+  std::vector<std::thread> threads;
+  for (int instance = 0; instance < num_instances; ++instance) {
+    threads.emplace_back([&, instance]() {
+        concurrent_results[instance] = partition(instance);
+      });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (int instance = 0; instance < num_instances; ++instance) {
+    ASSERT_THAT(concurrent_results[instance].objective,
+                Eq(sequential_results[instance].objective));
+    ASSERT_THAT(concurrent_results[instance].partition,
+                ContainerEq(sequential_results[instance].partition));
+  }
+}
+}  // namespace kahypar
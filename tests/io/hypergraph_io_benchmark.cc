@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+
+using namespace kahypar;
+
+struct ParsedHypergraph {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector;
+  HyperedgeVector edge_vector;
+  HyperedgeWeightVector hyperedge_weights;
+  HypernodeWeightVector hypernode_weights;
+
+  bool operator== (const ParsedHypergraph& other) const {
+    return num_hypernodes == other.num_hypernodes &&
+           num_hyperedges == other.num_hyperedges &&
+           index_vector == other.index_vector &&
+           edge_vector == other.edge_vector &&
+           hyperedge_weights == other.hyperedge_weights &&
+           hypernode_weights == other.hypernode_weights;
+  }
+};
+
+// ! Returns the fastest of the given number of runs of parse in seconds.
+template <typename F>
+static double measure(const size_t repetitions, ParsedHypergraph& result, const F& parse) {
+  double best_time = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < repetitions; ++i) {
+    result = ParsedHypergraph();
+    const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    parse(result);
+    const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    best_time = std::min(best_time, std::chrono::duration<double>(end - start).count());
+  }
+  return best_time;
+}
+
+// Compares the load time of the sequential and the multi-threaded hMetis parser.
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 4) {
+    std::cout << "Usage: hypergraph_io_benchmark <.hgr> [max threads] [repetitions]" << std::endl;
+    exit(0);
+  }
+  const std::string hgr_filename(argv[1]);
+  const size_t max_threads = argc > 2 ? std::stoul(argv[2]) : 8;
+  const size_t repetitions = argc > 3 ? std::stoul(argv[3]) : 3;
+
+  ParsedHypergraph sequential;
+  const double sequential_time = measure(repetitions, sequential, [&](ParsedHypergraph& hg) {
+      io::readHypergraphFile(hgr_filename, hg.num_hypernodes, hg.num_hyperedges,
+                             hg.index_vector, hg.edge_vector, &hg.hyperedge_weights,
+                             &hg.hypernode_weights);
+    });
+  std::cout << "RESULT file=" << hgr_filename << " parser=sequential threads=1"
+            << " time=" << sequential_time << " speedup=1" << std::endl;
+
+  for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    ParsedHypergraph parallel;
+    const double parallel_time = measure(repetitions, parallel, [&](ParsedHypergraph& hg) {
+        io::readHypergraphFileParallel(hgr_filename, hg.num_hypernodes, hg.num_hyperedges,
+                                       hg.index_vector, hg.edge_vector, &hg.hyperedge_weights,
+                                       &hg.hypernode_weights, num_threads);
+      });
+    if (!(parallel == sequential)) {
+      std::cerr << "Error: Parsers produced different hypergraphs" << std::endl;
+      exit(1);
+    }
+    std::cout << "RESULT file=" << hgr_filename << " parser=parallel threads=" << num_threads
+              << " time=" << parallel_time << " speedup=" << sequential_time / parallel_time
+              << std::endl;
+  }
+  return 0;
+}
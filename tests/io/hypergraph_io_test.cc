@@ -18,13 +18,21 @@
  *
  ******************************************************************************/
 
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <tuple>
+
 #include "gmock/gmock.h"
 
 #include "kahypar/io/hypergraph_io.h"
 #include "tests/io/hypergraph_io_test_fixtures.h"
 
+using ::testing::Combine;
 using ::testing::Eq;
 using ::testing::ContainerEq;
+using ::testing::TestWithParam;
+using ::testing::Values;
 
 namespace kahypar {
 namespace io {
@@ -256,5 +264,121 @@ TEST(DuplicatePins, GetRemovedDuringParsing) {
   ASSERT_THAT(hypergraph.initialNumPins(), Eq(4));
 }
 
+TEST_F(AnUnweightedHypergraph, CanBeWrittenToBinaryFile) {
+  writeBinaryHypergraphFile(*_hypergraph, _filename);
+  ASSERT_THAT(isBinaryHypergraphFile(_filename), Eq(true));
+
+  Hypergraph hypergraph2 = createHypergraphFromFile(_filename, 2);
+  ASSERT_THAT(hypergraph2.type(), Eq(HypergraphType::Unweighted));
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(*_hypergraph, hypergraph2), Eq(true));
+}
+
+TEST_F(AHypergraphWithHypernodeAndHyperedgeWeights, CanBeWrittenToBinaryFile) {
+  writeBinaryHypergraphFile(*_hypergraph, _filename);
+
+  Hypergraph hypergraph2 = createHypergraphFromFile(_filename, 2);
+  ASSERT_THAT(hypergraph2.type(), Eq(HypergraphType::EdgeAndNodeWeights));
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(*_hypergraph, hypergraph2), Eq(true));
+}
+
+TEST_F(AHypergraphWithHyperedgeWeights, CanBeParsedFromBinaryFileIntoVectors) {
+  writeBinaryHypergraphFile(*_hypergraph, _filename);
+
+  readHypergraphFile(_filename, _num_hypernodes, _num_hyperedges, _written_index_vector,
+                     _written_edge_vector, &_written_hyperedge_weights, nullptr);
+  Hypergraph hypergraph2(_num_hypernodes, _num_hyperedges, _written_index_vector,
+                         _written_edge_vector, 2, &_written_hyperedge_weights);
+  ASSERT_THAT(_written_index_vector, ContainerEq(_index_vector));
+  ASSERT_THAT(_written_edge_vector, ContainerEq(_edge_vector));
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(*_hypergraph, hypergraph2), Eq(true));
+}
+
+TEST_F(AnUnweightedHypergraph, KeepsFixedVerticesAndCommunitiesInBinaryFile) {
+  _hypergraph->setFixedVertex(0, 1);
+  _hypergraph->setFixedVertex(5, 0);
+  _hypergraph->setCommunities({ 0, 0, 1, 1, 2, 2, 3 });
+  writeBinaryHypergraphFile(*_hypergraph, _filename);
+
+  Hypergraph hypergraph2 = createHypergraphFromFile(_filename, 2);
+  ASSERT_THAT(hypergraph2.containsFixedVertices(), Eq(true));
+  for (const HypernodeID& hn : _hypergraph->nodes()) {
+    ASSERT_THAT(hypergraph2.fixedVertexPartID(hn), Eq(_hypergraph->fixedVertexPartID(hn)));
+  }
+  ASSERT_THAT(hypergraph2.communities(), ContainerEq(_hypergraph->communities()));
+}
+
+TEST(AHypergraphFile, IsNotDetectedAsBinaryFileIfItIsInHMetisFormat) {
+  ASSERT_THAT(isBinaryHypergraphFile("test_instances/unweighted_hypergraph.hgr"), Eq(false));
+}
+
+TEST_F(AnUnweightedHypergraph, LeadsToProgramExitIfBinaryFileIsTruncated) {
+  writeBinaryHypergraphFile(*_hypergraph, _filename);
+  std::string content;
+  {
+    std::ifstream file(_filename, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  std::ofstream(_filename, std::ios::binary).write(content.data(), content.size() - 8);
+  EXPECT_EXIT(createHypergraphFromFile(_filename, 2), ::testing::ExitedWithCode(1),
+              "is truncated or corrupted");
+}
+
+// Parameters: hypergraph file, number of threads and chunk size in bytes
+class AParallelHypergraphParser : public TestWithParam<std::tuple<std::string, size_t, size_t> >{ };
+
+INSTANTIATE_TEST_CASE_P(
+  TestInstances, AParallelHypergraphParser,
+  Combine(Values("test_instances/unweighted_hypergraph.hgr",
+                 "test_instances/weighted_hyperedges_hypergraph.hgr",
+                 "test_instances/weighted_hypernodes_hypergraph.hgr",
+                 "test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr",
+                 "test_instances/hypergraph_without_hyperedges.hgr",
+                 "test_instances/corrupted_hypergraph_with_multiple_identical_pins.hgr",
+                 "test_instances/star_like_structure.hgr"),
+          Values(1, 4),
+          Values(1, 16, internal::kParserChunkSize)));
+
+TEST_P(AParallelHypergraphParser, ProducesTheSameResultAsTheSequentialParser) {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector;
+  HyperedgeVector edge_vector;
+  HyperedgeWeightVector hyperedge_weights;
+  HypernodeWeightVector hypernode_weights;
+  readHypergraphFile(std::get<0>(GetParam()), num_hypernodes, num_hyperedges, index_vector,
+                     edge_vector, &hyperedge_weights, &hypernode_weights);
+
+  HypernodeID parsed_num_hypernodes = 0;
+  HyperedgeID parsed_num_hyperedges = 0;
+  HyperedgeIndexVector parsed_index_vector;
+  HyperedgeVector parsed_edge_vector;
+  HyperedgeWeightVector parsed_hyperedge_weights;
+  HypernodeWeightVector parsed_hypernode_weights;
+  readHypergraphFileParallel(std::get<0>(GetParam()), parsed_num_hypernodes,
+                             parsed_num_hyperedges, parsed_index_vector, parsed_edge_vector,
+                             &parsed_hyperedge_weights, &parsed_hypernode_weights,
+                             std::get<1>(GetParam()), std::get<2>(GetParam()));
+
+  ASSERT_THAT(parsed_num_hypernodes, Eq(num_hypernodes));
+  ASSERT_THAT(parsed_num_hyperedges, Eq(num_hyperedges));
+  ASSERT_THAT(parsed_index_vector, ContainerEq(index_vector));
+  ASSERT_THAT(parsed_edge_vector, ContainerEq(edge_vector));
+  ASSERT_THAT(parsed_hyperedge_weights, ContainerEq(hyperedge_weights));
+  ASSERT_THAT(parsed_hypernode_weights, ContainerEq(hypernode_weights));
+}
+
+TEST_F(AnUnweightedHypergraph, ReadsFixedVerticesInParallel) {
+  {
+    std::ofstream fixed_vertex_file(_filename);
+    fixed_vertex_file << "-1\n1\n-1\n0\n-1\n-1\n1\n";
+  }
+  readFixedVertexFileParallel(*_hypergraph, _filename, 4, 2);
+  ASSERT_THAT(_hypergraph->fixedVertexPartID(0), Eq(Hypergraph::kInvalidPartition));
+  ASSERT_THAT(_hypergraph->fixedVertexPartID(1), Eq(1));
+  ASSERT_THAT(_hypergraph->fixedVertexPartID(3), Eq(0));
+  ASSERT_THAT(_hypergraph->fixedVertexPartID(5), Eq(Hypergraph::kInvalidPartition));
+  ASSERT_THAT(_hypergraph->fixedVertexPartID(6), Eq(1));
+}
+
 }  // namespace io
 }  // namespace kahypar
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/partition/coarsening/i_coarsener.h"
+#include "kahypar/partition/coarsening/vertex_pair_coarsener_base.h"
+#include "kahypar/partition/coarsening/ml_coarsener.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/2way_fm_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+
+using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Lt;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+namespace kahypar {
+using Coarsener = MLCoarsener<HeavyEdgeScore,
+                              NoWeightPenalty,
+                              UseCommunityStructure,
+                              NormalPartitionPolicy,
+                              BestRatingPreferringUnmatched<RandomRatingWins>,
+                              AllowFreeOnFixedFreeOnFreeFixedOnFixed,
+                              RatingType>;
+
+class MultilevelPartitioning {
+ public:
+  MultilevelPartitioning(const HypernodeID uncontraction_batch_size, const PartitionID k,
+                         const Objective objective, const RefinementAlgorithm algorithm) :
+    context(),
+    hypergraph(io::createHypergraphFromFile(
+                 "../../../../tests/partition/refinement/test_instances/ibm01.hgr", k)) {
+    context.partition.k = k;
+    context.partition.objective = objective;
+    context.partition.mode = k == 2 ? Mode::recursive_bisection : Mode::direct_kway;
+    context.partition.epsilon = 0.03;
+    context.partition.seed = 42;
+    const HypernodeWeight perfect_weight = ceil(hypergraph.totalWeight() / static_cast<double>(k));
+    for (PartitionID i = 0; i < k; ++i) {
+      context.partition.perfect_balance_part_weights.push_back(perfect_weight);
+      context.partition.max_part_weights.push_back((1 + context.partition.epsilon) * perfect_weight);
+    }
+    context.coarsening.max_allowed_node_weight = 100;
+    context.local_search.algorithm = algorithm;
+    context.local_search.fm.max_number_of_fruitless_moves = 50;
+    context.local_search.fm.stopping_rule = RefinementStoppingRule::simple;
+    context.local_search.uncontraction_batch_size = uncontraction_batch_size;
+  }
+
+  // ! Coarsens the hypergraph, assigns each coarse node to the lightest block
+  // ! and returns the objective after uncoarsening.
+  template <typename Refiner>
+  HyperedgeWeight run() {
+    Randomize::instance().setSeed(context.partition.seed);
+    Refiner refiner(hypergraph, context);
+    Coarsener coarsener(hypergraph, context, 1);
+    coarsener.coarsen(150);
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      PartitionID lightest_part = 0;
+      for (PartitionID part = 1; part < context.partition.k; ++part) {
+        if (hypergraph.partWeight(part) < hypergraph.partWeight(lightest_part)) {
+          lightest_part = part;
+        }
+      }
+      hypergraph.setNodePart(hn, lightest_part);
+    }
+    hypergraph.initializeNumCutHyperedges();
+    coarsener.uncoarsen(refiner);
+    return context.partition.objective == Objective::cut ?
+           metrics::hyperedgeCut(hypergraph) : metrics::km1(hypergraph);
+  }
+
+  Context context;
+  Hypergraph hypergraph;
+};
+
+class ABatchUncoarsening : public TestWithParam<HypernodeID>{ };
+
+INSTANTIATE_TEST_CASE_P(BatchSizes, ABatchUncoarsening, Values(2, 16, 256));
+
+TEST_P(ABatchUncoarsening, UncontractsAllHypernodesUsingTwoWayFM) {
+  MultilevelPartitioning partitioning(GetParam(), 2, Objective::cut,
+                                      RefinementAlgorithm::twoway_fm);
+  partitioning.run<TwoWayFMRefiner<NumberOfFruitlessMovesStopsSearch> >();
+  ASSERT_THAT(partitioning.hypergraph.currentNumNodes(),
+              Eq(partitioning.hypergraph.initialNumNodes()));
+  ASSERT_THAT(metrics::imbalance(partitioning.hypergraph, partitioning.context),
+              Le(partitioning.context.partition.epsilon));
+}
+
+TEST_P(ABatchUncoarsening, UncontractsAllHypernodesUsingKWayKMinusOneFM) {
+  MultilevelPartitioning partitioning(GetParam(), 4, Objective::km1,
+                                      RefinementAlgorithm::kway_fm_km1);
+  partitioning.run<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch> >();
+  ASSERT_THAT(partitioning.hypergraph.currentNumNodes(),
+              Eq(partitioning.hypergraph.initialNumNodes()));
+  ASSERT_THAT(metrics::imbalance(partitioning.hypergraph, partitioning.context),
+              Le(partitioning.context.partition.epsilon));
+}
+
+TEST(ASmallUncontractionBatch, ProducesSimilarQualityAsNLevelRefinement) {
+  MultilevelPartitioning n_level(1, 2, Objective::cut, RefinementAlgorithm::twoway_fm);
+  MultilevelPartitioning batched(16, 2, Objective::cut, RefinementAlgorithm::twoway_fm);
+  const HyperedgeWeight n_level_cut =
+    n_level.run<TwoWayFMRefiner<NumberOfFruitlessMovesStopsSearch> >();
+  const HyperedgeWeight batched_cut =
+    batched.run<TwoWayFMRefiner<NumberOfFruitlessMovesStopsSearch> >();
+  ASSERT_THAT(batched_cut, Lt(1.2 * n_level_cut));
+}
+}  // namespace kahypar
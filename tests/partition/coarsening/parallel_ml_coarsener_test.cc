@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/partition/coarsening/parallel_ml_coarsener.h"
+#include "kahypar/partition/refinement/do_nothing_refiner.h"
+
+using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Test;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+namespace kahypar {
+using CoarsenerType = ParallelMLCoarsener<HeavyEdgeScore,
+                                          MultiplicativePenalty,
+                                          UseCommunityStructure,
+                                          NormalPartitionPolicy,
+                                          BestRatingPreferringUnmatched<RandomRatingWins>,
+                                          AllowFreeOnFixedFreeOnFreeFixedOnFixed,
+                                          RatingType>;
+
+class AParallelMLCoarsener : public TestWithParam<size_t>{
+ public:
+  AParallelMLCoarsener() :
+    context(),
+    hypergraph(io::createHypergraphFromFile("../../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr", 2)),
+    refiner(new DoNothingRefiner()) {
+    context.partition.k = 2;
+    context.partition.objective = Objective::km1;
+    context.partition.mode = Mode::direct_kway;
+    context.partition.epsilon = 0.03;
+    context.partition.seed = 42;
+    context.partition.num_threads = GetParam();
+    context.partition.perfect_balance_part_weights.push_back(ceil(hypergraph.totalWeight() / 2.0));
+    context.partition.perfect_balance_part_weights.push_back(ceil(hypergraph.totalWeight() / 2.0));
+    context.partition.max_part_weights.push_back((1 + context.partition.epsilon)
+                                                 * context.partition.perfect_balance_part_weights[0]);
+    context.partition.max_part_weights.push_back((1 + context.partition.epsilon)
+                                                 * context.partition.perfect_balance_part_weights[1]);
+    context.coarsening.max_allowed_node_weight = 50;
+    refiner->initialize(999999);
+  }
+
+  // ! Returns the representative of each hypernode after coarsening.
+  std::vector<HypernodeID> coarsenWithSeed(const int seed) {
+    Hypergraph copy(io::createHypergraphFromFile("../../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr", 2));
+    Randomize::instance().setSeed(seed);
+    CoarsenerType coarsener(copy, context, 1);
+    coarsener.coarsen(200);
+    std::vector<HypernodeID> enabled_nodes;
+    for (const HypernodeID& hn : copy.nodes()) {
+      enabled_nodes.push_back(hn);
+    }
+    return enabled_nodes;
+  }
+
+  Context context;
+  Hypergraph hypergraph;
+  std::unique_ptr<IRefiner> refiner;
+};
+
+INSTANTIATE_TEST_CASE_P(NumThreads, AParallelMLCoarsener, Values(1, 2, 4));
+
+TEST_P(AParallelMLCoarsener, CoarsensUntilContractionLimit) {
+  Randomize::instance().setSeed(context.partition.seed);
+  CoarsenerType coarsener(hypergraph, context, 1);
+  coarsener.coarsen(2000);
+  ASSERT_THAT(hypergraph.currentNumNodes(), Le(2000));
+}
+
+TEST_P(AParallelMLCoarsener, RespectsTheMaximumAllowedNodeWeight) {
+  Randomize::instance().setSeed(context.partition.seed);
+  CoarsenerType coarsener(hypergraph, context, 1);
+  coarsener.coarsen(200);
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    ASSERT_THAT(hypergraph.nodeWeight(hn), Le(context.coarsening.max_allowed_node_weight));
+  }
+}
+
+TEST_P(AParallelMLCoarsener, RestoresTheInputHypergraphDuringUncoarsening) {
+  Hypergraph input(io::createHypergraphFromFile("../../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr", 2));
+  Randomize::instance().setSeed(context.partition.seed);
+  CoarsenerType coarsener(hypergraph, context, 1);
+  coarsener.coarsen(200);
+  PartitionID part = 0;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, part);
+    part = 1 - part;
+  }
+  hypergraph.initializeNumCutHyperedges();
+  coarsener.uncoarsen(*refiner);
+  ASSERT_THAT(verifyEquivalenceWithoutPartitionInfo(hypergraph, input), Eq(true));
+}
+
+TEST_P(AParallelMLCoarsener, ProducesTheSameHierarchyForTheSameSeed) {
+  ASSERT_THAT(coarsenWithSeed(42), Eq(coarsenWithSeed(42)));
+}
+
+TEST_P(AParallelMLCoarsener, ProducesTheSameHierarchyAsASingleThread) {
+  const std::vector<HypernodeID> parallel = coarsenWithSeed(42);
+  context.partition.num_threads = 1;
+  ASSERT_THAT(coarsenWithSeed(42), Eq(parallel));
+}
+}  // namespace kahypar
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/coarsening/rating_kernels.h"
+
+using ::testing::Test;
+
+namespace kahypar {
+namespace rating {
+class ARatingKernel : public ::testing::TestWithParam<Kernel>{
+ public:
+  ARatingKernel() :
+    score(),
+    penalty(),
+    weight() {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<RatingType> score_distribution(0.01, 10.0);
+    std::uniform_int_distribution<HypernodeWeight> weight_distribution(0, 20);
+    // 203 candidates to also cover the scalar remainder of the vectorized kernels
+    for (size_t i = 0; i < 203; ++i) {
+      score.push_back(score_distribution(generator));
+      weight.push_back(weight_distribution(generator));
+      // every fifth penalty is zero to exercise the fallback penalty
+      penalty.push_back(i % 5 == 0 ? 0 : weight_distribution(generator) + 1);
+    }
+  }
+
+  std::vector<RatingType> score;
+  std::vector<HypernodeWeight> penalty;
+  std::vector<HypernodeWeight> weight;
+};
+
+TEST_P(ARatingKernel, ComputesTheSameRatingsAsTheScalarKernel) {
+  if (!isSupported(GetParam())) {
+    return;
+  }
+  for (const HypernodeWeight weight_u : { 0, 1, 7, 25 }) {
+    std::vector<RatingType> expected(score.size());
+    std::vector<RatingType> actual(score.size());
+    computeRatingsScalar(score.data(), penalty.data(), weight.data(), weight_u,
+                         score.size(), expected.data());
+    kernelFunction(GetParam())(score.data(), penalty.data(), weight.data(), weight_u,
+                               score.size(), actual.data());
+    for (size_t i = 0; i < score.size(); ++i) {
+      ASSERT_EQ(actual[i], expected[i]) << V(i) << V(weight_u);
+    }
+  }
+}
+
+TEST_P(ARatingKernel, UsesTheLargerNodeWeightIfThePenaltyIsZero) {
+  if (!isSupported(GetParam())) {
+    return;
+  }
+  const std::vector<RatingType> scores(9, 12.0);
+  const std::vector<HypernodeWeight> penalties { 0, 0, 0, 0, 0, 0, 0, 0, 3 };
+  const std::vector<HypernodeWeight> weights { 0, 1, 2, 3, 4, 6, 0, 1, 0 };
+  std::vector<RatingType> ratings(scores.size());
+  kernelFunction(GetParam())(scores.data(), penalties.data(), weights.data(), 3,
+                             scores.size(), ratings.data());
+  const std::vector<RatingType> expected { 4.0, 4.0, 4.0, 4.0, 3.0, 2.0, 4.0, 4.0, 4.0 };
+  ASSERT_EQ(ratings, expected);
+}
+
+INSTANTIATE_TEST_CASE_P(AllKernels, ARatingKernel,
+                        ::testing::Values(Kernel::scalar, Kernel::avx2, Kernel::avx512));
+}  // namespace rating
+}  // namespace kahypar
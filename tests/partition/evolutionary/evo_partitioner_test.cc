@@ -56,7 +56,7 @@ class TheEvoPartitioner : public Test {
     context.evolutionary.mutation_chance = 0.2;
     context.evolutionary.diversify_interval = -1;
     context.preprocessing.enable_community_detection = false;
-    Timer::instance().clear();
+    context.timer->clear();
   }
   Context context;
 
@@ -103,7 +103,7 @@ TEST_F(TheEvoPartitioner, ProperlyGeneratesTheInitialPopulation) {
   evo_part.generateInitialPopulation(hypergraph, context);
   ASSERT_EQ(evo_part._population.size(), std::min(50.0, std::max(3.0, std::round(context.evolutionary.dynamic_population_amount_of_time
                                                                                  * context.partition.time_limit
-                                                                                 / Timer::instance().evolutionaryResult().evolutionary.at(0)))));
+                                                                                 / context.timer->evolutionaryResult().evolutionary.at(0)))));
 }
 TEST_F(TheEvoPartitioner, RespectsTheTimeLimit) {
   context.partition.quiet_mode = true;
@@ -114,9 +114,53 @@ TEST_F(TheEvoPartitioner, RespectsTheTimeLimit) {
 
   EvoPartitioner evo_part(context);
   evo_part.partition(hypergraph, context);
-  std::vector<double> times = Timer::instance().evolutionaryResult().evolutionary;
-  double total_time = Timer::instance().evolutionaryResult().total_evolutionary;
+  std::vector<double> times = context.timer->evolutionaryResult().evolutionary;
+  double total_time = context.timer->evolutionaryResult().total_evolutionary;
   ASSERT_GT(total_time, context.partition.time_limit);
   ASSERT_LT(total_time - times.at(times.size() - 1), context.partition.time_limit);
 }
+
+TEST_F(TheEvoPartitioner, MigratesTheBestIndividualToTheNextIsland) {
+  context.partition.quiet_mode = true;
+  context.evolutionary.population_size = 5;
+  context.evolutionary.dynamic_population_size = false;
+  EvoPartitioner::Mailbox first_inbox;
+  EvoPartitioner::Mailbox second_inbox;
+  EvoPartitioner first(context);
+  first._inbox = &first_inbox;
+  first._outbox = &second_inbox;
+  EvoPartitioner second(context);
+  second._inbox = &second_inbox;
+  second._outbox = &first_inbox;
+  first.generateInitialPopulation(hypergraph, context);
+  second.generateInitialPopulation(hypergraph, context);
+
+  first.migrate(hypergraph, context);
+  ASSERT_EQ(second_inbox.partitions.size(), 1);
+  ASSERT_EQ(second_inbox.partitions[0], first.bestPartition());
+
+  second.migrate(hypergraph, context);
+  ASSERT_TRUE(second_inbox.partitions.empty());
+  ASSERT_EQ(first_inbox.partitions.size(), 1);
+  ASSERT_EQ(second._population.size(), 5);
+}
+
+TEST_F(TheEvoPartitioner, EvolvesIslandsInParallel) {
+  context.partition.quiet_mode = true;
+  context.partition.time_limit = 1;
+  context.partition.num_threads = 3;
+  context.evolutionary.population_size = 5;
+  context.evolutionary.dynamic_population_size = false;
+  context.evolutionary.migration_interval = 2;
+
+  EvoPartitioner evo_part(context);
+  evo_part.partition(hypergraph, context);
+  ASSERT_GT(context.timer->evolutionaryResult().total_evolutionary, context.partition.time_limit);
+  ASSERT_GT(context.evolutionary.iteration, 3 * context.evolutionary.population_size);
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    ASSERT_EQ(hypergraph.partID(hn), evo_part.bestPartition()[hn]);
+  }
+  ASSERT_EQ(metrics::correctMetric(hypergraph, context),
+            evo_part._population.individualAt(evo_part._population.best()).fitness());
+}
 }  // namespace kahypar
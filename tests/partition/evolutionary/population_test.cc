@@ -239,6 +239,36 @@ TEST_F(APopulation, IsCorrectlyReplacingWithStrongDiverseStrategy) {
   ind1 = Individual(hypergraph, context);
   ASSERT_EQ(population.difference(ind1, 0, true), 0);
 }
+TEST_F(APopulation, EstimatesTheDifferenceExactlyForSmallCutEdgeSets) {
+  parseIniToContext(context, "../../../../config/old_reference_configs/km1_direct_kway_gecco18.ini");
+  context.partition.k = 4;
+  context.partition.epsilon = 0.03;
+  context.partition.objective = Objective::km1;
+  context.partition.mode = Mode::direct_kway;
+  context.initial_partitioning.bp_algo = BinPackingAlgorithm::worst_fit;
+  context.local_search.algorithm = RefinementAlgorithm::kway_fm;
+  const std::vector<std::vector<PartitionID> > partitions {
+    { 0, 1, 2, 3, 0, 1, 2, 3 },
+    { 0, 0, 2, 2, 3, 1, 1, 3 },
+    { 0, 2, 2, 0, 1, 1, 3, 3 },
+    { 0, 0, 1, 1, 2, 2, 3, 3 }
+  };
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    hypergraph.reset();
+    population.generateIndividual(hypergraph, context);
+    hypergraph.reset();
+    hypergraph.setPartition(partitions[i]);
+    population.forceInsert(Individual(hypergraph, context), i);
+  }
+  for (size_t i = 0; i < population.size(); ++i) {
+    for (size_t j = 0; j < population.size(); ++j) {
+      for (const bool strong_set : { false, true }) {
+        ASSERT_EQ(population.estimatedDifference(population.individualAt(i), j, strong_set),
+                  population.difference(population.individualAt(i), j, strong_set));
+      }
+    }
+  }
+}
 TEST_F(APopulation, IsPerformingTournamentSelection) {
   parseIniToContext(context, "../../../../config/old_reference_configs/km1_direct_kway_gecco18.ini");
   context.partition.k = 4;
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2018 Tobias Heuer <tobias.heuer@gmx.net>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/fixed_vertices.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace fixed_vertices {
+static HyperedgeWeight matchingWeight(const BipartiteMatchingGraph& graph, const Matching& matching) {
+  HyperedgeWeight weight = 0;
+  for (const auto& matched_edge : matching) {
+    weight += graph.weight(matched_edge.first, matched_edge.second);
+  }
+  return weight;
+}
+
+static HyperedgeWeight bruteForceMaximumMatchingWeight(const BipartiteMatchingGraph& graph) {
+  std::vector<PartitionID> permutation(graph.k(), 0);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  HyperedgeWeight best = std::numeric_limits<HyperedgeWeight>::min();
+  do {
+    HyperedgeWeight weight = 0;
+    for (PartitionID i = 0; i < graph.k(); ++i) {
+      weight += graph.weight(i, permutation[i]);
+    }
+    best = std::max(best, weight);
+  } while (std::next_permutation(permutation.begin(), permutation.end()));
+  return best;
+}
+
+TEST(AMaximumWeightedBipartiteMatching, IsPerfect) {
+  BipartiteMatchingGraph graph(4);
+  graph.addEdge(0, 1, 3);
+  graph.addEdge(2, 1, 5);
+  const Matching matching = findMaximumWeightedBipartiteMatching(graph);
+  ASSERT_THAT(matching.size(), Eq(4));
+  ASSERT_TRUE(verify(matching, 4));
+  ASSERT_THAT(matchingWeight(graph, matching), Eq(5));
+}
+
+TEST(AMaximumWeightedBipartiteMatching, AvoidsAssignmentsViolatingTheBalanceConstraint) {
+  BipartiteMatchingGraph graph(2);
+  graph.addEdge(0, 0, 10);
+  graph.addEdge(1, 1, 1);
+  // Fixed vertices of block 0 do not fit into block 0
+  graph.setBalanceConstraint({ 3, 1 }, { 5, 2 }, { 6, 10 }, -100);
+  const Matching matching = findMaximumWeightedBipartiteMatching(graph);
+  ASSERT_THAT(matchingWeight(graph, matching), Eq(0));
+  for (const auto& matched_edge : matching) {
+    ASSERT_TRUE(graph.isFeasible(matched_edge.first, matched_edge.second));
+  }
+}
+
+TEST(AMaximumWeightedBipartiteMatching, HasTheSameWeightAsAnOptimalAssignment) {
+  std::mt19937 generator(42);
+  for (size_t trial = 0; trial < 200; ++trial) {
+    const PartitionID k = 1 + generator() % 7;
+    BipartiteMatchingGraph graph(k);
+    for (PartitionID i = 0; i < k; ++i) {
+      for (PartitionID j = 0; j < k; ++j) {
+        if (generator() % 3 == 0) {
+          graph.addEdge(i, j, generator() % 20);
+        }
+      }
+    }
+    if (trial % 2 == 0) {
+      std::vector<HypernodeWeight> fixed_vertex_part_weight(k);
+      std::vector<HypernodeWeight> part_weight(k);
+      for (PartitionID i = 0; i < k; ++i) {
+        fixed_vertex_part_weight[i] = generator() % 5;
+        part_weight[i] = generator() % 5;
+      }
+      graph.setBalanceConstraint(std::move(fixed_vertex_part_weight), std::move(part_weight),
+                                 std::vector<HypernodeWeight>(k, 6), -1000);
+    }
+    const Matching matching = findMaximumWeightedBipartiteMatching(graph);
+    ASSERT_THAT(matching.size(), Eq(static_cast<size_t>(k)));
+    ASSERT_TRUE(verify(matching, k));
+    ASSERT_THAT(matchingWeight(graph, matching), Eq(bruteForceMaximumMatchingWeight(graph)));
+  }
+}
+}  // namespace fixed_vertices
+}  // namespace kahypar
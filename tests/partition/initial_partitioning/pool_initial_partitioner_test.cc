@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/initial_partitioning/pool_initial_partitioner.h"
+#include "kahypar/partition/initial_partitioning/random_initial_partitioner.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/utils/randomize.h"
+
+using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Ne;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+namespace kahypar {
+// The parameter is the objective that is optimized by the pool.
+class AParallelPoolInitialPartitioner : public TestWithParam<Objective>{
+ public:
+  AParallelPoolInitialPartitioner() :
+    hypergraph(io::createHypergraphFromFile("test_instances/ibm01.hgr", 4)),
+    context() {
+    context.partition.k = 4;
+    context.partition.epsilon = 0.03;
+    context.partition.objective = GetParam();
+    context.initial_partitioning.k = 4;
+    context.initial_partitioning.nruns = 3;
+    context.initial_partitioning.bp_algo = BinPackingAlgorithm::worst_fit;
+    context.initial_partitioning.refinement = true;
+    context.initial_partitioning.local_search.algorithm = GetParam() == Objective::cut ?
+                                                          RefinementAlgorithm::kway_fm :
+                                                          RefinementAlgorithm::kway_fm_km1;
+    context.initial_partitioning.local_search.fm.stopping_rule = RefinementStoppingRule::simple;
+    context.initial_partitioning.local_search.fm.max_number_of_fruitless_moves = 50;
+    context.initial_partitioning.local_search.iterations_per_level =
+      std::numeric_limits<int>::max();
+    context.local_search = context.initial_partitioning.local_search;
+    context.setupPartWeights(hypergraph.totalWeight());
+    context.setupInitialPartitioningPartWeights();
+  }
+
+  template <typename InitialPartitioner>
+  std::vector<PartitionID> partition(const size_t num_threads) {
+    Context ip_context(context);
+    ip_context.partition.num_threads = num_threads;
+    Randomize::instance().setSeed(42);
+    hypergraph.resetPartitioning();
+    InitialPartitioner partitioner(hypergraph, ip_context);
+    partitioner.partition();
+
+    std::vector<PartitionID> partition;
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      EXPECT_THAT(hypergraph.partID(hn), Ne(Hypergraph::kInvalidPartition));
+      partition.push_back(hypergraph.partID(hn));
+    }
+    return partition;
+  }
+
+  Hypergraph hypergraph;
+  Context context;
+};
+
+INSTANTIATE_TEST_CASE_P(CutAndKm1, AParallelPoolInitialPartitioner,
+                        Values(Objective::cut, Objective::km1));
+
+TEST_P(AParallelPoolInitialPartitioner, ComputesTheSamePartitionForAnyNumberOfThreads) {
+  const std::vector<PartitionID> expected = partition<PoolInitialPartitioner>(2);
+  ASSERT_THAT(partition<PoolInitialPartitioner>(4), Eq(expected));
+  ASSERT_THAT(partition<PoolInitialPartitioner>(7), Eq(expected));
+}
+
+TEST_P(AParallelPoolInitialPartitioner, ComputesABalancedPartition) {
+  partition<PoolInitialPartitioner>(4);
+  ASSERT_THAT(metrics::imbalance(hypergraph, context), Le(context.partition.epsilon));
+}
+
+TEST_P(AParallelPoolInitialPartitioner, RespectsFixedVertices) {
+  for (HypernodeID hn = 0; hn < hypergraph.initialNumNodes(); hn += 50) {
+    hypergraph.setFixedVertex(hn, hn % context.partition.k);
+  }
+  partition<PoolInitialPartitioner>(4);
+  for (const HypernodeID& hn : hypergraph.fixedVertices()) {
+    ASSERT_THAT(hypergraph.partID(hn), Eq(hypergraph.fixedVertexPartID(hn)));
+  }
+}
+
+TEST_P(AParallelPoolInitialPartitioner, PerformsTheRunsOfASingleAlgorithmInParallel) {
+  const std::vector<PartitionID> expected = partition<RandomInitialPartitioner>(2);
+  ASSERT_THAT(partition<RandomInitialPartitioner>(4), Eq(expected));
+}
+}  // namespace kahypar
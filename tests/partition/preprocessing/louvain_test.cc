@@ -20,6 +20,7 @@
  ******************************************************************************/
 
 #include <fstream>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -31,6 +32,8 @@
 #include "kahypar/macros.h"
 #include "kahypar/partition/preprocessing/louvain.h"
 #include "kahypar/partition/preprocessing/modularity.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/thread_pool.h"
 
 using ::testing::Eq;
 using ::testing::Test;
@@ -241,5 +244,82 @@ TEST(Louvain, WorksOnGraphDSThatChangesHypergraphIntoGraph) {
     ASSERT_EQ(louvain.clusterID(node), expected_comm[node]);
   }
 }
+
+class AParallelLouvain : public Test {
+ public:
+  AParallelLouvain() :
+    context(),
+    hypergraph(nullptr) {
+    context.partition.k = 2;
+    context.partition.graph_filename = "../../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr";
+    context.preprocessing.community_detection.max_pass_iterations = 100;
+    context.preprocessing.community_detection.min_eps_improvement = 0.0001;
+    context.preprocessing.community_detection.edge_weight = LouvainEdgeWeight::non_uniform;
+    hypergraph = std::make_unique<Hypergraph>(
+      io::createHypergraphFromFile(context.partition.graph_filename, context.partition.k));
+  }
+
+  EdgeWeight detectCommunities(const size_t num_threads, std::vector<ClusterID>& communities) {
+    context.partition.num_threads = num_threads;
+    Randomize::instance().setSeed(42);
+    Louvain<Modularity> louvain(*hypergraph, context);
+    const EdgeWeight quality = louvain.run();
+    communities.clear();
+    for (const HypernodeID& hn : hypergraph->nodes()) {
+      communities.push_back(louvain.hypernodeClusterID(hn));
+    }
+    return quality;
+  }
+
+  Context context;
+  std::unique_ptr<Hypergraph> hypergraph;
+};
+
+TEST_F(AParallelLouvain, ConstructsAndContractsTheSameGraphAsTheSequentialVersion) {
+  ThreadPool pool(4);
+  Graph sequential(*hypergraph, context);
+  Graph parallel(*hypergraph, context, &pool);
+  ASSERT_EQ(parallel.numNodes(), sequential.numNodes());
+  ASSERT_EQ(parallel.numEdges(), sequential.numEdges());
+  ASSERT_LE(std::abs(parallel.totalWeight() - sequential.totalWeight()), Graph::kEpsilon);
+
+  for (const NodeID& node : sequential.nodes()) {
+    sequential.setClusterID(node, node / 7);
+    parallel.setClusterID(node, node / 7);
+  }
+  auto sequential_contraction = sequential.contractClusters();
+  auto parallel_contraction = parallel.contractClusters();
+  ASSERT_EQ(parallel_contraction.second, sequential_contraction.second);
+  const Graph& contracted_sequential = sequential_contraction.first;
+  const Graph& contracted_parallel = parallel_contraction.first;
+  ASSERT_EQ(contracted_parallel.numNodes(), contracted_sequential.numNodes());
+  for (const NodeID& node : contracted_sequential.nodes()) {
+    ASSERT_EQ(contracted_parallel.degree(node), contracted_sequential.degree(node));
+    auto e_par = contracted_parallel.firstEdge(node);
+    for (const Edge& e : contracted_sequential.incidentEdges(node)) {
+      ASSERT_EQ(e_par->target_node, e.target_node);
+      ASSERT_EQ(e_par->weight, e.weight);
+      ++e_par;
+    }
+    ASSERT_EQ(contracted_parallel.selfloopWeight(node), contracted_sequential.selfloopWeight(node));
+  }
+}
+
+TEST_F(AParallelLouvain, ComputesTheSameCommunitiesForAnyNumberOfThreads) {
+  std::vector<ClusterID> expected;
+  const EdgeWeight expected_quality = detectCommunities(2, expected);
+  for (const size_t num_threads : { 3, 4 }) {
+    std::vector<ClusterID> communities;
+    ASSERT_EQ(detectCommunities(num_threads, communities), expected_quality);
+    ASSERT_EQ(communities, expected);
+  }
+}
+
+TEST_F(AParallelLouvain, ReachesAModularitySimilarToTheSequentialVersion) {
+  std::vector<ClusterID> communities;
+  const EdgeWeight sequential_quality = detectCommunities(1, communities);
+  const EdgeWeight parallel_quality = detectCommunities(4, communities);
+  ASSERT_GT(parallel_quality, 0.98L * sequential_quality);
+}
 }  // namespace ds
 }  // namespace kahypar
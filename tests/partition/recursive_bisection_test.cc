@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/application/command_line_options.h"
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/recursive_bisection.h"
+#include "kahypar/utils/randomize.h"
+
+using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Ne;
+using ::testing::Test;
+
+namespace kahypar {
+class ParallelRecursiveBisection : public Test {
+ public:
+  ParallelRecursiveBisection() :
+    context() {
+    parseIniToContext(context, "../../../config/km1_rKaHyPar_sea20.ini");
+    context.partition.k = 8;
+    context.partition.epsilon = 0.03;
+    context.partition.objective = Objective::km1;
+    context.partition.mode = Mode::recursive_bisection;
+    context.partition.seed = 42;
+    context.partition.parallel_recursive_bisection = true;
+    context.partition.quiet_mode = true;
+    context.preprocessing.enable_community_detection = false;
+  }
+
+  std::vector<PartitionID> partition(const size_t num_threads, Hypergraph& hypergraph) {
+    Context rb_context(context);
+    rb_context.partition.num_threads = num_threads;
+    rb_context.setupPartWeights(hypergraph.totalWeight());
+    Randomize::instance().setSeed(context.partition.seed);
+    recursive_bisection::partition(hypergraph, rb_context);
+
+    std::vector<PartitionID> partition;
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      EXPECT_THAT(hypergraph.partID(hn), Ne(Hypergraph::kInvalidPartition));
+      partition.push_back(hypergraph.partID(hn));
+    }
+    EXPECT_THAT(metrics::imbalance(hypergraph, rb_context), Le(context.partition.epsilon));
+    return partition;
+  }
+
+  std::vector<PartitionID> partition(const size_t num_threads) {
+    Hypergraph hypergraph(
+      io::createHypergraphFromFile("../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr",
+                                   context.partition.k));
+    return partition(num_threads, hypergraph);
+  }
+
+  Context context;
+};
+
+TEST_F(ParallelRecursiveBisection, ComputesTheSamePartitionForAnyNumberOfThreads) {
+  const std::vector<PartitionID> expected = partition(2);
+  ASSERT_THAT(partition(3), Eq(expected));
+  ASSERT_THAT(partition(8), Eq(expected));
+}
+
+TEST_F(ParallelRecursiveBisection, HandlesKThatIsNotAPowerOfTwo) {
+  context.partition.k = 7;
+  const std::vector<PartitionID> expected = partition(2);
+  ASSERT_THAT(partition(4), Eq(expected));
+}
+
+TEST_F(ParallelRecursiveBisection, RespectsFixedVertices) {
+  Hypergraph hypergraph(
+    io::createHypergraphFromFile("../../../tests/end_to_end/test_instances/ISPD98_ibm01.hgr",
+                                 context.partition.k));
+  for (HypernodeID hn = 0; hn < hypergraph.initialNumNodes(); hn += 100) {
+    hypergraph.setFixedVertex(hn, hn % context.partition.k);
+  }
+  partition(4, hypergraph);
+  for (const HypernodeID& hn : hypergraph.fixedVertices()) {
+    ASSERT_THAT(hypergraph.partID(hn), Eq(hypergraph.fixedVertexPartID(hn)));
+  }
+}
+}  // namespace kahypar
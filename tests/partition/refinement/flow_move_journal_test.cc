@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/refinement/flow/flow_refiner_base.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+class AFlowMoveJournal : public Test {
+ public:
+  AFlowMoveJournal() :
+    hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9, 12 },
+               HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }, 3),
+    journal(hypergraph.initialNumNodes()) {
+    hypergraph.setNodePart(0, 0);
+    hypergraph.setNodePart(1, 0);
+    hypergraph.setNodePart(2, 0);
+    hypergraph.setNodePart(3, 1);
+    hypergraph.setNodePart(4, 1);
+    hypergraph.setNodePart(5, 2);
+    hypergraph.setNodePart(6, 2);
+  }
+
+  void move(const HypernodeID hn, const PartitionID to) {
+    journal.record(hn, hypergraph.partID(hn));
+    hypergraph.changeNodePart(hn, hypergraph.partID(hn), to);
+  }
+
+  Hypergraph hypergraph;
+  FlowMoveJournal journal;
+};
+
+TEST_F(AFlowMoveJournal, RestoresOriginalPartitionOnRollback) {
+  move(5, 1);
+  move(1, 2);
+  move(5, 0);
+
+  const std::vector<Move> moves = journal.rollback(hypergraph);
+
+  ASSERT_THAT(moves.size(), Eq(2));
+  ASSERT_THAT(moves[0].hn, Eq(1));
+  ASSERT_THAT(moves[0].from, Eq(0));
+  ASSERT_THAT(moves[0].to, Eq(2));
+  ASSERT_THAT(moves[1].hn, Eq(5));
+  ASSERT_THAT(moves[1].from, Eq(2));
+  ASSERT_THAT(moves[1].to, Eq(0));
+  ASSERT_THAT(hypergraph.partID(1), Eq(0));
+  ASSERT_THAT(hypergraph.partID(5), Eq(2));
+  ASSERT_THAT(journal.size(), Eq(0));
+}
+
+TEST_F(AFlowMoveJournal, SkipsHypernodesThatReturnedToTheirOriginalBlock) {
+  move(3, 0);
+  move(3, 1);
+
+  ASSERT_THAT(journal.size(), Eq(1));
+  ASSERT_TRUE(journal.rollback(hypergraph).empty());
+  ASSERT_THAT(hypergraph.partID(3), Eq(1));
+}
+
+TEST_F(AFlowMoveJournal, UsesCurrentPartitionAsRollbackTargetAfterClear) {
+  move(0, 1);
+  journal.clear();
+  move(0, 2);
+
+  const std::vector<Move> moves = journal.rollback(hypergraph);
+
+  ASSERT_THAT(moves.size(), Eq(1));
+  ASSERT_THAT(moves[0].from, Eq(1));
+  ASSERT_THAT(hypergraph.partID(0), Eq(1));
+}
+}  // namespace kahypar
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/kway_fm_parallel_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+
+using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Lt;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+namespace kahypar {
+using KWayParallelFMRefinerSimpleStopping = KWayParallelFMRefiner<NumberOfFruitlessMovesStopsSearch>;
+
+static Hypergraph createRoundRobinPartitionedHypergraph(const PartitionID k) {
+  Hypergraph hypergraph(io::createHypergraphFromFile(
+                          "../../../../tests/partition/refinement/test_instances/ibm01.hgr", k));
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, hn % k);
+  }
+  hypergraph.initializeNumCutHyperedges();
+  return hypergraph;
+}
+
+// ! Refines the partition using all nodes as refinement nodes until no further improvement is found.
+static Metrics refineUntilNoImprovement(Hypergraph& hypergraph, const Context& context) {
+  Randomize::instance().setSeed(42);
+  KWayParallelFMRefinerSimpleStopping refiner(hypergraph, context);
+  refiner.initialize(0);
+  Metrics metrics = { metrics::hyperedgeCut(hypergraph),
+                      metrics::km1(hypergraph),
+                      metrics::imbalance(hypergraph, context) };
+  std::vector<HypernodeID> refinement_nodes;
+  UncontractionGainChanges changes;
+  changes.representative.push_back(0);
+  changes.contraction_partner.push_back(0);
+  bool improved = true;
+  while (improved) {
+    refinement_nodes.clear();
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      refinement_nodes.push_back(hn);
+    }
+    improved = refiner.refine(refinement_nodes, { 0, 0 }, changes, metrics);
+  }
+  return metrics;
+}
+
+class AKWayParallelFMRefiner : public TestWithParam<size_t>{
+ public:
+  AKWayParallelFMRefiner() :
+    context(),
+    hypergraph(createRoundRobinPartitionedHypergraph(4)) {
+    context.partition.k = 4;
+    context.partition.mode = Mode::direct_kway;
+    context.partition.epsilon = 0.03;
+    context.partition.num_threads = GetParam();
+    context.local_search.fm.max_number_of_fruitless_moves = 50;
+    const HypernodeWeight perfect_weight = ceil(hypergraph.totalWeight() / 4.0);
+    for (PartitionID i = 0; i < context.partition.k; ++i) {
+      context.partition.perfect_balance_part_weights.push_back(perfect_weight);
+      context.partition.max_part_weights.push_back((1 + context.partition.epsilon) * perfect_weight);
+    }
+  }
+
+  Context context;
+  Hypergraph hypergraph;
+};
+
+INSTANTIATE_TEST_CASE_P(NumThreads, AKWayParallelFMRefiner, Values(1, 2, 4));
+
+TEST_P(AKWayParallelFMRefiner, ImprovesTheConnectivityObjective) {
+  context.partition.objective = Objective::km1;
+  const HyperedgeWeight initial_km1 = metrics::km1(hypergraph);
+  const Metrics metrics = refineUntilNoImprovement(hypergraph, context);
+  ASSERT_THAT(metrics.km1, Lt(initial_km1));
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(hypergraph)));
+  ASSERT_THAT(metrics::imbalance(hypergraph, context), Le(context.partition.epsilon));
+}
+
+TEST_P(AKWayParallelFMRefiner, ImprovesTheCutObjective) {
+  context.partition.objective = Objective::cut;
+  const HyperedgeWeight initial_cut = metrics::hyperedgeCut(hypergraph);
+  const Metrics metrics = refineUntilNoImprovement(hypergraph, context);
+  ASSERT_THAT(metrics.cut, Lt(initial_cut));
+  ASSERT_THAT(metrics.cut, Eq(metrics::hyperedgeCut(hypergraph)));
+  ASSERT_THAT(metrics::imbalance(hypergraph, context), Le(context.partition.epsilon));
+}
+
+TEST_P(AKWayParallelFMRefiner, ComputesTheSamePartitionAsASingleThread) {
+  context.partition.objective = Objective::km1;
+  refineUntilNoImprovement(hypergraph, context);
+
+  Hypergraph sequential_hypergraph(createRoundRobinPartitionedHypergraph(4));
+  Context sequential_context(context);
+  sequential_context.partition.num_threads = 1;
+  refineUntilNoImprovement(sequential_hypergraph, sequential_context);
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    ASSERT_THAT(hypergraph.partID(hn), Eq(sequential_hypergraph.partID(hn)));
+  }
+}
+}  // namespace kahypar
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+namespace kahypar {
+using GainCache = KwayGainCache<Gain>;
+
+// The parameter selects between the dense slab (small k) and the
+// first-touch layout (large k) of the arena.
+class AKwayGainCache : public TestWithParam<PartitionID>{
+ public:
+  AKwayGainCache() :
+    k(GetParam()),
+    cache(10, k) { }
+
+  std::vector<PartitionID> adjacentParts(const HypernodeID hn) const {
+    return std::vector<PartitionID>(cache.adjacentParts(hn).begin(),
+                                    cache.adjacentParts(hn).end());
+  }
+
+  const PartitionID k;
+  GainCache cache;
+};
+
+INSTANTIATE_TEST_CASE_P(DenseAndFirstTouchArena, AKwayGainCache, Values(4, 64));
+
+TEST_P(AKwayGainCache, InitiallyDoesNotContainAnyEntries) {
+  for (HypernodeID hn = 0; hn < 10; ++hn) {
+    ASSERT_THAT(cache.entryExists(hn), Eq(false));
+    ASSERT_THAT(cache.entryExists(hn, k - 1), Eq(false));
+    ASSERT_THAT(cache.entry(hn, k - 1), Eq(GainCache::kNotCached));
+    ASSERT_THAT(adjacentParts(hn).empty(), Eq(true));
+  }
+}
+
+TEST_P(AKwayGainCache, StoresEntriesOfDifferentHypernodesIndependently) {
+  cache.initializeEntry(7, 1, 3);
+  cache.initializeEntry(2, k - 1, -5);
+  cache.initializeEntry(7, 2, 4);
+  ASSERT_THAT(cache.entry(7, 1), Eq(3));
+  ASSERT_THAT(cache.entry(7, 2), Eq(4));
+  ASSERT_THAT(cache.entry(2, k - 1), Eq(-5));
+  ASSERT_THAT(cache.entryExists(2, 1), Eq(false));
+  ASSERT_THAT(adjacentParts(7), ElementsAre(1, 2));
+}
+
+TEST_P(AKwayGainCache, InvalidatesAllEntriesOnClear) {
+  cache.initializeEntry(7, 1, 3);
+  cache.initializeEntry(2, k - 1, -5);
+  cache.clear();
+  ASSERT_THAT(cache.entryExists(7), Eq(false));
+  ASSERT_THAT(cache.entryExists(7, 1), Eq(false));
+  ASSERT_THAT(cache.entryExists(2, k - 1), Eq(false));
+  ASSERT_THAT(adjacentParts(7).empty(), Eq(true));
+
+  cache.initializeEntry(7, 0, 1);
+  ASSERT_THAT(cache.entryExists(7, 1), Eq(false));
+  ASSERT_THAT(adjacentParts(7), ElementsAre(0));
+}
+
+TEST_P(AKwayGainCache, RestoresAllEntriesOnRollback) {
+  cache.initializeEntry(3, 0, 10);
+  cache.initializeEntry(3, 1, 20);
+  cache.updateExistingEntry(3, 0, 5);
+  cache.removeEntryDueToConnectivityDecrease(3, 1);
+  cache.addEntryDueToConnectivityIncrease(3, k - 1, 7);
+  cache.addEntryDueToConnectivityIncrease(4, 2, 1);
+  cache.rollbackDelta();
+  ASSERT_THAT(cache.entry(3, 0), Eq(10));
+  ASSERT_THAT(cache.entry(3, 1), Eq(20));
+  ASSERT_THAT(cache.entryExists(3, k - 1), Eq(false));
+  ASSERT_THAT(cache.entryExists(4, 2), Eq(false));
+}
+}  // namespace kahypar
@@ -19,6 +19,7 @@
  *
 ******************************************************************************/
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -119,4 +120,43 @@ TEST_F(AQuotientGraphBlockScheduler, HasCorrectCutHyperedgesAfterMove) {
     ASSERT_EQ(e, 2);
   }
 }
+
+TEST_F(AQuotientGraphBlockScheduler, TracksMovesPerformedDirectlyOnTheHypergraph) {
+  scheduler->buildQuotientGraph();
+
+  // Moves performed by other refiners are reported via the connectivity observer.
+  hypergraph.changeNodePart(0, 0, 1);
+  hypergraph.changeNodePart(5, 3, 1);
+  scheduler->buildQuotientGraph();
+
+  std::vector<std::pair<PartitionID, PartitionID> > adjacentBlocks = { std::make_pair(1, 2),
+                                                                       std::make_pair(1, 3),
+                                                                       std::make_pair(2, 3) };
+  std::vector<std::pair<PartitionID, PartitionID> > edges;
+  for (const auto& e : scheduler->quotientGraphEdges()) {
+    edges.push_back(e);
+  }
+  ASSERT_EQ(adjacentBlocks, edges);
+
+  std::vector<HyperedgeID> cut_hes(scheduler->blockPairCutHyperedges(1, 3).first,
+                                   scheduler->blockPairCutHyperedges(1, 3).second);
+  std::sort(cut_hes.begin(), cut_hes.end());
+  ASSERT_EQ(std::vector<HyperedgeID>({ 0, 3 }), cut_hes);
+  for (const auto& e : scheduler->blockPairCutHyperedges(1, 2)) {
+    ASSERT_EQ(e, 1);
+  }
+}
+
+TEST_F(AQuotientGraphBlockScheduler, DoesNotContainDuplicateCutHyperedges) {
+  scheduler->buildQuotientGraph();
+
+  hypergraph.changeNodePart(2, 3, 0);
+  hypergraph.changeNodePart(2, 0, 3);
+  hypergraph.changeNodePart(2, 3, 0);
+
+  std::vector<HyperedgeID> cut_hes(scheduler->blockPairCutHyperedges(0, 3).first,
+                                   scheduler->blockPairCutHyperedges(0, 3).second);
+  std::sort(cut_hes.begin(), cut_hes.end());
+  ASSERT_EQ(std::vector<HyperedgeID>({ 3 }), cut_hes);
+}
 }  // namespace kahypar
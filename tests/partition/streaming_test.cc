@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_stream.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/streaming.h"
+
+using ::testing::Test;
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+namespace kahypar {
+namespace streaming {
+using HypergraphStreamingPartitioner = StreamingPartitioner<HypergraphNetStream>;
+
+static Hypergraph createRandomHypergraph(const HypernodeID num_hypernodes,
+                                         const HyperedgeID num_hyperedges,
+                                         const PartitionID k) {
+  std::mt19937 prng(42);
+  std::uniform_int_distribution<HypernodeID> size(2, 6);
+  // pins of a hyperedge are close to each other, such that there is a good partition
+  std::uniform_int_distribution<HypernodeID> offset(0, 20);
+  HyperedgeIndexVector index_vector = { 0 };
+  HyperedgeVector edge_vector;
+  for (HyperedgeID he = 0; he < num_hyperedges; ++he) {
+    const HypernodeID first = prng() % (num_hypernodes - 21);
+    std::vector<HypernodeID> pins;
+    for (HypernodeID i = size(prng); i > 0; --i) {
+      pins.push_back(first + offset(prng));
+    }
+    std::sort(pins.begin(), pins.end());
+    pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+    edge_vector.insert(edge_vector.end(), pins.begin(), pins.end());
+    index_vector.push_back(edge_vector.size());
+  }
+  return Hypergraph(num_hypernodes, num_hyperedges, index_vector, edge_vector, k);
+}
+
+class AStreamingPartitioner : public Test {
+ public:
+  AStreamingPartitioner() :
+    hypergraph(createRandomHypergraph(2000, 3000, 4)),
+    context() {
+    context.partition.k = 4;
+    context.partition.mode = Mode::streaming;
+    context.partition.objective = Objective::km1;
+    context.partition.epsilon = 0.03;
+    context.local_search.fm.max_number_of_fruitless_moves = 50;
+    context.streaming.window_size = 500;
+    context.setupPartWeights(hypergraph.totalWeight());
+  }
+
+  void applyPartition(const HypergraphStreamingPartitioner& partitioner) {
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      hypergraph.setNodePart(hn, partitioner.partID(hn));
+    }
+  }
+
+  Hypergraph hypergraph;
+  Context context;
+};
+
+TEST_F(AStreamingPartitioner, ComputesABalancedPartitionInASinglePass) {
+  context.streaming.restreaming_passes = 0;
+  HypergraphNetStream stream(hypergraph);
+  HypergraphStreamingPartitioner partitioner(stream, context);
+  partitioner.partition();
+  applyPartition(partitioner);
+
+  for (PartitionID part = 0; part != context.partition.k; ++part) {
+    ASSERT_LE(hypergraph.partWeight(part), context.partition.max_part_weights[part]);
+    ASSERT_EQ(hypergraph.partWeight(part), partitioner.partWeight(part));
+    ASSERT_EQ(hypergraph.partSize(part), partitioner.partSize(part));
+  }
+  ASSERT_DOUBLE_EQ(metrics::imbalance(hypergraph, context), partitioner.imbalance());
+}
+
+TEST_F(AStreamingPartitioner, AccumulatesTheObjectiveWhileStreaming) {
+  context.streaming.restreaming_passes = 0;
+  HypergraphNetStream stream(hypergraph);
+  HypergraphStreamingPartitioner partitioner(stream, context);
+  partitioner.partition();
+  applyPartition(partitioner);
+
+  ASSERT_EQ(metrics::km1(hypergraph), partitioner.km1());
+  ASSERT_EQ(metrics::hyperedgeCut(hypergraph), partitioner.cut());
+}
+
+TEST_F(AStreamingPartitioner, ImprovesTheObjectiveViaRestreaming) {
+  context.streaming.restreaming_passes = 0;
+  HypergraphNetStream stream(hypergraph);
+  HypergraphStreamingPartitioner single_pass(stream, context);
+  single_pass.partition();
+
+  context.streaming.restreaming_passes = 3;
+  HypergraphStreamingPartitioner partitioner(stream, context);
+  partitioner.partition();
+  applyPartition(partitioner);
+
+  ASSERT_LT(partitioner.km1(), single_pass.km1());
+  ASSERT_EQ(metrics::km1(hypergraph), partitioner.km1());
+  ASSERT_EQ(metrics::hyperedgeCut(hypergraph), partitioner.cut());
+  for (PartitionID part = 0; part != context.partition.k; ++part) {
+    ASSERT_LE(hypergraph.partWeight(part), context.partition.max_part_weights[part]);
+  }
+}
+
+TEST_F(AStreamingPartitioner, OptimizesTheCutMetricViaRestreaming) {
+  context.partition.objective = Objective::cut;
+  context.streaming.restreaming_passes = 3;
+  HypergraphNetStream stream(hypergraph);
+  HypergraphStreamingPartitioner partitioner(stream, context);
+  partitioner.partition();
+  applyPartition(partitioner);
+
+  ASSERT_EQ(metrics::hyperedgeCut(hypergraph), partitioner.cut());
+  ASSERT_EQ(metrics::km1(hypergraph), partitioner.km1());
+}
+
+TEST_F(AStreamingPartitioner, DoesNotMoveFixedVertices) {
+  for (HypernodeID hn = 0; hn < 100; ++hn) {
+    hypergraph.setFixedVertex(hn, hn % context.partition.k);
+  }
+  context.streaming.restreaming_passes = 3;
+  streaming::partition(hypergraph, context);
+
+  for (HypernodeID hn = 0; hn < 100; ++hn) {
+    ASSERT_EQ(hypergraph.partID(hn), static_cast<PartitionID>(hn % context.partition.k));
+  }
+}
+
+class AnHMetisNetStream : public Test {
+ public:
+  AnHMetisNetStream() :
+    filename("streaming_test_hypergraph.hgr") {
+    std::ofstream out_stream(filename);
+    out_stream << "% comment\n"
+               << "3 4 11\n"
+               << "2 1 2\n"
+               << "% comment\n"
+               << "3 2 3 4 3\n"
+               << "1 4 1\n"
+               << "5\n6\n7\n8\n";
+  }
+
+  ~AnHMetisNetStream() {
+    std::remove(filename.c_str());
+  }
+
+  std::string filename;
+};
+
+TEST_F(AnHMetisNetStream, ReadsHyperedgesAndHypernodeWeights) {
+  io::HMetisNetStream stream(filename);
+  ASSERT_EQ(stream.numNodes(), 4);
+  ASSERT_EQ(stream.numNets(), 3);
+  ASSERT_THAT(std::vector<HypernodeWeight>({ stream.nodeWeight(0), stream.nodeWeight(1),
+                                             stream.nodeWeight(2), stream.nodeWeight(3) }),
+              ElementsAre(5, 6, 7, 8));
+
+  std::vector<HypernodeID> pins;
+  HyperedgeWeight weight = 0;
+  ASSERT_TRUE(stream.next(pins, weight));
+  ASSERT_EQ(weight, 2);
+  ASSERT_THAT(pins, ElementsAre(0, 1));
+  ASSERT_TRUE(stream.next(pins, weight));
+  ASSERT_EQ(weight, 3);
+  ASSERT_THAT(pins, ElementsAre(1, 2, 3));
+  ASSERT_TRUE(stream.next(pins, weight));
+  ASSERT_EQ(weight, 1);
+  ASSERT_THAT(pins, ElementsAre(0, 3));
+  ASSERT_FALSE(stream.next(pins, weight));
+}
+
+TEST_F(AnHMetisNetStream, StartsOverAfterRewind) {
+  io::HMetisNetStream stream(filename);
+  std::vector<HypernodeID> pins;
+  HyperedgeWeight weight = 0;
+  while (stream.next(pins, weight)) { }
+
+  stream.rewind();
+  ASSERT_TRUE(stream.next(pins, weight));
+  ASSERT_EQ(weight, 2);
+  ASSERT_THAT(pins, ElementsAre(0, 1));
+}
+}  // namespace streaming
+}  // namespace kahypar
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/utils/thread_pool.h"
+
+using ::testing::Eq;
+using ::testing::Lt;
+
+namespace kahypar {
+TEST(AThreadPool, ProcessesEachElementOfAParallelForExactlyOnce) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int> > visited(10007);
+  pool.parallelFor(0, visited.size(), 100, [&](const size_t worker, const size_t begin,
+                                               const size_t end) {
+      ASSERT_THAT(worker, Lt(pool.numThreads()));
+      for (size_t i = begin; i < end; ++i) {
+        ++visited[i];
+      }
+    });
+  for (const std::atomic<int>& count : visited) {
+    ASSERT_THAT(count.load(), Eq(1));
+  }
+}
+
+TEST(AThreadPool, ExecutesTasksSequentiallyIfItHasOnlyOneThread) {
+  ThreadPool pool(1);
+  std::future<int> result = pool.submit([]() {
+      return 42;
+    });
+  ASSERT_THAT(result.wait_for(std::chrono::seconds(0)), Eq(std::future_status::ready));
+  ASSERT_THAT(pool.wait(result), Eq(42));
+}
+
+TEST(AThreadPool, AllowsTasksToWaitForNestedTasks) {
+  ThreadPool pool(2);
+  std::vector<std::future<int> > results;
+  for (int i = 0; i < 16; ++i) {
+    results.emplace_back(pool.submit([&pool, i]() {
+        std::future<int> nested = pool.submit([i]() {
+            return i;
+          });
+        return 2 * pool.wait(nested);
+      }));
+  }
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_THAT(pool.wait(results[i]), Eq(2 * i));
+  }
+}
+}  // namespace kahypar
@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2019 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/sparse_map.h"
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/macros.h"
+#include "kahypar/partition/coarsening/rating_kernels.h"
+#include "kahypar/partition/coarsening/vertex_pair_rater.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/utils/randomize.h"
+
+using namespace kahypar;
+
+using Rater = VertexPairRater<HeavyEdgeScore, MultiplicativePenalty, UseCommunityStructure,
+                              NormalPartitionPolicy, BestRatingWithTieBreaking<>,
+                              AllowFreeOnFixedFreeOnFreeFixedOnFixed, RatingType>;
+
+// Rating loop of the VertexPairRater before the candidates were processed in batches.
+class ReferenceRater {
+ public:
+  ReferenceRater(const Hypergraph& hypergraph, const Context& context) :
+    _hg(hypergraph),
+    _context(context),
+    _tmp_ratings(hypergraph.initialNumNodes()),
+    _already_matched(hypergraph.initialNumNodes()) { }
+
+  HypernodeID rate(const HypernodeID u) {
+    const HypernodeWeight weight_u = _hg.nodeWeight(u);
+    for (const HyperedgeID& he : _hg.incidentEdges(u)) {
+      if (_hg.edgeSize(he) <= _context.partition.hyperedge_size_threshold) {
+        const RatingType score = HeavyEdgeScore::score(_hg, he, _context);
+        for (const HypernodeID& v : _hg.pins(he)) {
+          if (v != u && weight_u + _hg.nodeWeight(v) <= _context.coarsening.max_allowed_node_weight &&
+              NormalPartitionPolicy::accept(_hg, _context, u, v)) {
+            _tmp_ratings[v] += score;
+          }
+        }
+      }
+    }
+
+    RatingType max_rating = std::numeric_limits<RatingType>::min();
+    HypernodeID target = std::numeric_limits<HypernodeID>::max();
+    for (auto it = _tmp_ratings.end() - 1; it >= _tmp_ratings.begin(); --it) {
+      const HypernodeID tmp_target = it->key;
+      const HypernodeWeight target_weight = _hg.nodeWeight(tmp_target);
+      HypernodeWeight penalty = MultiplicativePenalty::penalty(weight_u, target_weight);
+      penalty = penalty == 0 ? std::max(std::max(weight_u, target_weight), 1) : penalty;
+      const RatingType tmp_rating = it->value / static_cast<double>(penalty);
+      if (UseCommunityStructure::sameCommunity(_hg.communities(), u, tmp_target) &&
+          BestRatingWithTieBreaking<>::acceptRating(tmp_rating, max_rating,
+                                                    target, tmp_target, _already_matched) &&
+          AllowFreeOnFixedFreeOnFreeFixedOnFixed::acceptContraction(_hg, _context, u, tmp_target)) {
+        max_rating = tmp_rating;
+        target = tmp_target;
+      }
+    }
+    _tmp_ratings.clear();
+    return target;
+  }
+
+ private:
+  const Hypergraph& _hg;
+  const Context& _context;
+  ds::SparseMap<HypernodeID, RatingType> _tmp_ratings;
+  ds::FastResetFlagArray<> _already_matched;
+};
+
+template <typename F>
+static double measure(const Hypergraph& hypergraph, const int repetitions,
+                      std::vector<HypernodeID>& targets, const F& rate) {
+  Randomize::instance().setSeed(1);
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      targets[hn] = rate(hn);
+    }
+  }
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cout << "Usage: VertexPairRaterBenchmark <.hgr> [repetitions]" << std::endl;
+    exit(0);
+  }
+  const std::string hgr_filename(argv[1]);
+  const int repetitions = argc > 2 ? std::stoi(argv[2]) : 5;
+
+  Hypergraph hypergraph(io::createHypergraphFromFile(hgr_filename, 2));
+  Context context;
+  context.coarsening.max_allowed_node_weight = std::numeric_limits<HypernodeWeight>::max() / 2;
+
+  size_t num_candidates = 0;
+  {
+    ds::SparseMap<HypernodeID, RatingType> neighbors(hypergraph.initialNumNodes());
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+        for (const HypernodeID& pin : hypergraph.pins(he)) {
+          if (pin != hn) {
+            neighbors[pin] += 1;
+          }
+        }
+      }
+      num_candidates += neighbors.size();
+      neighbors.clear();
+    }
+  }
+
+  std::cout << "Instance:     " << hgr_filename << std::endl;
+  std::cout << "Nodes:        " << hypergraph.currentNumNodes() << std::endl;
+  std::cout << "Candidates:   " << num_candidates << " (avg "
+            << static_cast<double>(num_candidates) / hypergraph.currentNumNodes()
+            << " per node)" << std::endl;
+  std::cout << "Repetitions:  " << repetitions << std::endl;
+  std::cout << "Best kernel:  " << rating::toString(rating::detectKernel()) << std::endl;
+
+  const auto report = [&](const std::string& name, const double seconds, const double reference) {
+                        const double rated = static_cast<double>(hypergraph.currentNumNodes()) * repetitions;
+                        std::cout << std::left << std::setw(12) << name << std::right
+                                  << std::setw(10) << std::fixed << std::setprecision(4) << seconds << " s"
+                                  << std::setw(10) << std::setprecision(1) << 1e9 * seconds / rated << " ns/node"
+                                  << std::setw(10) << std::setprecision(1)
+                                  << num_candidates * repetitions / seconds / 1e6 << " M candidates/s"
+                                  << std::setw(8) << std::setprecision(2) << reference / seconds << "x"
+                                  << std::endl;
+                      };
+
+  std::vector<HypernodeID> expected_targets(hypergraph.initialNumNodes());
+  ReferenceRater reference_rater(hypergraph, context);
+  const double reference = measure(hypergraph, repetitions, expected_targets, [&](const HypernodeID hn) {
+      return reference_rater.rate(hn);
+    });
+  report("reference", reference, reference);
+
+  for (const rating::Kernel kernel : { rating::Kernel::scalar, rating::Kernel::avx2, rating::Kernel::avx512 }) {
+    if (!rating::isSupported(kernel)) {
+      continue;
+    }
+    rating::useKernel(kernel);
+    std::vector<HypernodeID> targets(hypergraph.initialNumNodes());
+    Rater rater(hypergraph, context);
+    const double seconds = measure(hypergraph, repetitions, targets, [&](const HypernodeID hn) {
+        return rater.rate(hn).target;
+      });
+    report(rating::toString(kernel), seconds, reference);
+    if (targets != expected_targets) {
+      std::cout << "ERROR: " << rating::toString(kernel)
+                << " kernel computed different contraction partners" << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}